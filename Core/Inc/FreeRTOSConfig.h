@@ -52,6 +52,12 @@
   #include <stdint.h>
   extern uint32_t SystemCoreClock;
   void xPortSysTickHandler(void);
+/* USER CODE BEGIN 0 */
+  extern void configureTimerForRunTimeStats(void);
+  extern unsigned long getRunTimeCounterValue(void);
+  void RtosStats_TaskSwitchedIn(uint32_t task_number);
+  #include "trace_recorder.h"
+/* USER CODE END 0 */
 #endif
 #ifndef CMSIS_device_header
 #define CMSIS_device_header "stm32f4xx.h"
@@ -65,13 +71,15 @@
 #define configSUPPORT_DYNAMIC_ALLOCATION         1
 #define configUSE_IDLE_HOOK                      0
 #define configUSE_TICK_HOOK                      0
+#define configUSE_MALLOC_FAILED_HOOK             1
 #define configCPU_CLOCK_HZ                       ( SystemCoreClock )
 #define configTICK_RATE_HZ                       ((TickType_t)1000)
 #define configMAX_PRIORITIES                     ( 56 )
 #define configMINIMAL_STACK_SIZE                 ((uint16_t)128)
-#define configTOTAL_HEAP_SIZE                    ((size_t)15360)
+#define configTOTAL_HEAP_SIZE                    ((size_t)4096)
 #define configMAX_TASK_NAME_LEN                  ( 16 )
 #define configUSE_TRACE_FACILITY                 1
+#define configGENERATE_RUN_TIME_STATS            1
 #define configUSE_16_BIT_TICKS                   0
 #define configUSE_MUTEXES                        1
 #define configQUEUE_REGISTRY_SIZE                8
@@ -155,6 +163,12 @@ header file. */
 #define configASSERT( x ) if ((x) == 0) {taskDISABLE_INTERRUPTS(); for( ;; );}
 /* USER CODE END 1 */
 
+/* USER CODE BEGIN 2 */
+/* Definitions needed when configGENERATE_RUN_TIME_STATS is on */
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS configureTimerForRunTimeStats
+#define portGET_RUN_TIME_COUNTER_VALUE getRunTimeCounterValue
+/* USER CODE END 2 */
+
 /* Definitions that map the FreeRTOS port interrupt handlers to their CMSIS
 standard names. */
 #define vPortSVCHandler    SVC_Handler
@@ -166,6 +180,22 @@ standard names. */
 
 /* USER CODE BEGIN Defines */
 /* Section where parameter definitions can be added (for instance, to override default ones in FreeRTOS.h) */
+/* ucHeap is defined in freertos.c and placed in CCM RAM (nothing allocated from it is used by DMA).
+   The application's RTOS objects are static (rtos_objects.c); the heap is a reserve for objects
+   created at run time, and its use is part of the boot report. */
+#define configAPPLICATION_ALLOCATED_HEAP         1
+/* Context switch counts per task for the run time statistics (rtos_stats.c) and the kernel trace
+   records (trace_recorder.c). pxCurrentTCB is the task vTaskSwitchContext() switches out or in;
+   queue objects are numbered by the RTOS object registry (rtos_objects.c) */
+#define traceTASK_SWITCHED_IN()                  do { RtosStats_TaskSwitchedIn(pxCurrentTCB->uxTCBNumber); \
+                                                      TRACE_RECORD(TRACE_EV_TASK_IN, pxCurrentTCB->uxTCBNumber, 0); } while (0)
+#define traceTASK_SWITCHED_OUT()                 TRACE_RECORD(TRACE_EV_TASK_OUT, pxCurrentTCB->uxTCBNumber, 0)
+#define traceQUEUE_SEND(pxQueue)                 TRACE_RECORD(TRACE_EV_QUEUE_SEND, (pxQueue)->uxQueueNumber, (pxQueue)->uxMessagesWaiting)
+#define traceQUEUE_SEND_FROM_ISR(pxQueue)        TRACE_RECORD(TRACE_EV_QUEUE_SEND, (pxQueue)->uxQueueNumber, (pxQueue)->uxMessagesWaiting)
+#define traceQUEUE_RECEIVE(pxQueue)              TRACE_RECORD(TRACE_EV_QUEUE_RECEIVE, (pxQueue)->uxQueueNumber, (pxQueue)->uxMessagesWaiting)
+#define traceQUEUE_RECEIVE_FROM_ISR(pxQueue)     TRACE_RECORD(TRACE_EV_QUEUE_RECEIVE, (pxQueue)->uxQueueNumber, (pxQueue)->uxMessagesWaiting)
+#define traceBLOCKING_ON_QUEUE_SEND(pxQueue)     TRACE_RECORD(TRACE_EV_QUEUE_BLOCK_SEND, (pxQueue)->uxQueueNumber, (pxQueue)->uxMessagesWaiting)
+#define traceBLOCKING_ON_QUEUE_RECEIVE(pxQueue)  TRACE_RECORD(TRACE_EV_QUEUE_BLOCK_RECEIVE, (pxQueue)->uxQueueNumber, (pxQueue)->uxMessagesWaiting)
 /* USER CODE END Defines */
 
 #endif /* FREERTOS_CONFIG_H */
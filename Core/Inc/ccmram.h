@@ -0,0 +1,48 @@
+/**
+ * @file    ccmram.h
+ * @author  Ted Wang
+ * @date    2026-10-17
+ * @brief   Placement of CPU-only data in the 64 KB core coupled memory (CCM RAM).
+ *
+ * @details
+ * The STM32F429 has 64 KB of CCM RAM at 0x10000000 on the CPU data bus: zero wait states and no
+ * contention with the DMA streams, which share SRAM1/SRAM2 (192 KB at 0x20000000) with the CPU.
+ * The DMA controllers cannot reach CCM RAM at all.
+ *
+ * Mark a zero-initialized static or global variable with CCM_RAM to place it there:
+ * @code
+ *   static StackType_t task_stack[512] CCM_RAM;
+ * @endcode
+ * The linker collects the ".bss.ccmram" sections into the RW_IRAM2 execution region of
+ * MDK-ARM/stm32f429zi_ccm.sct, which the C library startup clears like any other ZI data.
+ *
+ * Only CPU data belongs there: task stacks and control blocks, the FreeRTOS heap, frame buffers,
+ * caches and tables. Anything handed to HAL_*_DMA() (the OLED bus slots in OLED_Display_t, UART
+ * DMA buffers) must stay in SRAM, and so must locals passed to DMA from a task whose stack is in
+ * CCM RAM. Check the placement with Tools/memmap/memmap_report.py.
+ *
+ * On other compilers (host builds of the drivers) CCM_RAM expands to nothing.
+ */
+
+#ifndef CCMRAM_H
+#define CCMRAM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @def CCM_RAM
+ * @brief Places a zero-initialized variable in CCM RAM (Arm Compiler 6; no effect elsewhere).
+ */
+#if defined(__ARMCC_VERSION)
+#define CCM_RAM                     __attribute__((section(".bss.ccmram")))
+#else
+#define CCM_RAM
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CCMRAM_H
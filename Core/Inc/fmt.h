@@ -0,0 +1,119 @@
+/**
+ * @file    fmt.h
+ * @author  Ted Wang
+ * @date    2026-10-17
+ * @brief   Allocation-free text formatting into a caller buffer (replaces snprintf on hot paths).
+ *
+ * @details
+ * A message is built piece by piece into a fixed buffer: strings, characters, unsigned and signed
+ * integers in decimal or hexadecimal, fixed-point values and hex byte strings (UIDs). The number
+ * format (base, field width, zero padding) is a compile-time constant built from FMT_* flags, so no
+ * format string is parsed at run time and no variadic arguments are walked.
+ *
+ * Every call keeps the buffer NUL terminated. Output that does not fit is cut off like snprintf()
+ * and flagged in Fmt_t.truncated; len is the number of characters in the buffer, so UART output
+ * needs no strlen(). The module uses no heap, no locale and at most a few dozen bytes of stack
+ * (see Tools/oled_host/fmt_bench.c for the comparison with snprintf).
+ *
+ * Example:
+ * @code
+ *   char msg[48];
+ *   Fmt_t f;
+ *   Fmt_Init(&f, msg, sizeof(msg));
+ *   Fmt_Str(&f, "UID: ");
+ *   Fmt_HexBytes(&f, uid, 4);
+ *   Fmt_Str(&f, ", tagType: ");
+ *   Fmt_Uint(&f, tag_type, FMT_X4);
+ *   UartLog_Write(msg, f.len);
+ * @endcode
+ */
+
+#ifndef FMT_H
+#define FMT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stddef.h>
+
+/* Exported constants --------------------------------------------------------*/
+/**
+ * @brief Number format flags; combine with FMT_WIDTH() into a compile-time spec.
+ */
+#define FMT_DEC             0x0000u                         /**< Decimal (default) */
+#define FMT_HEX             0x0100u                         /**< Upper case hexadecimal */
+#define FMT_ZERO            0x0200u                         /**< Pad with '0' instead of ' ' */
+#define FMT_WIDTH(n)        ((uint16_t)((n) & 0x1Fu))       /**< Minimum field width (0..31) */
+
+/**
+ * @brief Common specs.
+ */
+#define FMT_D               (FMT_DEC)                       /**< %u / %d */
+#define FMT_D2              (FMT_DEC | FMT_ZERO | FMT_WIDTH(2))     /**< %02u */
+#define FMT_X2              (FMT_HEX | FMT_ZERO | FMT_WIDTH(2))     /**< %02X */
+#define FMT_X4              (FMT_HEX | FMT_ZERO | FMT_WIDTH(4))     /**< %04X */
+#define FMT_X8              (FMT_HEX | FMT_ZERO | FMT_WIDTH(8))     /**< %08X */
+
+/* Exported types ------------------------------------------------------------*/
+/**
+ * @brief Output buffer being formatted.
+ */
+typedef struct {
+    char *buf;              /**< Caller buffer (always NUL terminated) */
+    uint16_t size;          /**< Size of buf including the terminator */
+    uint16_t len;           /**< Characters written */
+    uint8_t truncated;      /**< 1 if output was cut off */
+} Fmt_t;
+
+/* Exported functions --------------------------------------------------------*/
+/**
+ * @brief Starts formatting into buf (size includes the terminator, at least 1).
+ */
+void Fmt_Init(Fmt_t *f, char *buf, size_t size);
+
+
+/**
+ * @brief Appends a NUL terminated string.
+ */
+void Fmt_Str(Fmt_t *f, const char *s);
+
+
+/**
+ * @brief Appends one character.
+ */
+void Fmt_Char(Fmt_t *f, char c);
+
+
+/**
+ * @brief Appends an unsigned integer formatted by spec (FMT_* flags).
+ */
+void Fmt_Uint(Fmt_t *f, uint32_t value, uint16_t spec);
+
+
+/**
+ * @brief Appends a signed integer formatted by spec (decimal; the sign counts towards the width).
+ */
+void Fmt_Int(Fmt_t *f, int32_t value, uint16_t spec);
+
+
+/**
+ * @brief Appends a fixed-point value: value / 10^decimals with exactly decimals fraction digits.
+ *
+ * Example: Fmt_Fixed(&f, 123, 1) appends "12.3", Fmt_Fixed(&f, -5, 2) appends "-0.05".
+ */
+void Fmt_Fixed(Fmt_t *f, int32_t value, uint8_t decimals);
+
+
+/**
+ * @brief Appends bytes as upper case hex pairs without separators (e.g. a card UID).
+ */
+void Fmt_HexBytes(Fmt_t *f, const uint8_t *bytes, uint8_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FMT_H
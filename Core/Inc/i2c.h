@@ -41,7 +41,11 @@ extern I2C_HandleTypeDef hi2c2;
 void MX_I2C2_Init(void);
 
 /* USER CODE BEGIN Prototypes */
-
+/**
+ * @brief Recovers a stuck I2C2 bus: peripheral reset, 9 SCL clocks + STOP, re-initialization.
+ * @retval 1 SDA is released (bus idle), 0 SDA is still held low by a slave
+ */
+uint8_t I2C2_BusRecover(void);
 /* USER CODE END Prototypes */
 
 #ifdef __cplusplus
@@ -57,6 +57,12 @@ void Error_Handler(void);
 /* USER CODE END EFP */
 
 /* Private defines -----------------------------------------------------------*/
+#define OLED_RES_Pin GPIO_PIN_3
+#define OLED_RES_GPIO_Port GPIOE
+#define OLED_CS_Pin GPIO_PIN_4
+#define OLED_CS_GPIO_Port GPIOE
+#define OLED_DC_Pin GPIO_PIN_5
+#define OLED_DC_GPIO_Port GPIOE
 #define OLED_SDA_Pin GPIO_PIN_0
 #define OLED_SDA_GPIO_Port GPIOF
 #define OLED_SCL_Pin GPIO_PIN_1
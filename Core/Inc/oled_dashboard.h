@@ -0,0 +1,104 @@
+
+/**
+ * @file    oled_dashboard.h
+ * @author  Ted Wang
+ * @date    2026-10-17
+ * @brief   Dashboard screen of the OLED display task (time, door state, access history, reader health).
+ *
+ * @details
+ * Built from retained widgets (oled_ui.h): every update only changes widget properties, and a render
+ * sends only the tiles whose content changed. The module does not use any RTOS or HAL services; the
+ * caller passes the current time, so the host benchmark (Tools/oled_host) can replay it.
+ *
+ * Layout (128x64):
+ *   - y  0: project name (left), uptime clock hh:mm:ss (right)
+ *   - y 12: lock icon, door state, unlock countdown bar
+ *   - y 31: last three access events (list)
+ *   - y 56: reader health (last report age, number of reads)
+ */
+
+#ifndef OLED_DASHBOARD_H
+#define OLED_DASHBOARD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "oled_ui.h"
+#include "rc522_rtos_task.h"
+
+/* Exported constants --------------------------------------------------------*/
+/**
+ * @def OLED_DASHBOARD_UNLOCK_MS
+ * @brief Time the door stays unlocked after a granted card (milliseconds).
+ */
+#define OLED_DASHBOARD_UNLOCK_MS         3000
+
+/**
+ * @def OLED_DASHBOARD_READER_TIMEOUT_MS
+ * @brief Reader is reported as stale if it has not posted a reading for this long (milliseconds).
+ */
+#define OLED_DASHBOARD_READER_TIMEOUT_MS 6000
+
+/**
+ * @def OLED_DASHBOARD_HISTORY
+ * @brief Number of access events shown in the history list.
+ */
+#define OLED_DASHBOARD_HISTORY           3
+
+/* Exported types ------------------------------------------------------------*/
+/**
+ * @brief Dashboard state and widgets.
+ */
+typedef struct {
+    OLED_UiScreen_t screen;                         /**< Widget screen */
+    OLED_UiLabel_t title;                           /**< Project name */
+    OLED_UiLabel_t clock;                           /**< Uptime clock */
+    OLED_UiIcon_t lock_icon;                        /**< Locked/unlocked icon */
+    OLED_UiLabel_t door;                            /**< Door state text */
+    OLED_UiProgress_t unlock_bar;                   /**< Remaining unlock time */
+    OLED_UiList_t history;                          /**< Last access events */
+    OLED_UiLabel_t health;                          /**< Reader health */
+    char events[OLED_DASHBOARD_HISTORY][24];        /**< History strings (newest first) */
+    const char *event_ptrs[OLED_DASHBOARD_HISTORY]; /**< Item pointers for the list */
+    uint8_t event_count;                            /**< Number of valid history entries */
+    uint8_t last_status;                            /**< Status of the previous reading */
+    uint32_t unlock_until_ms;                       /**< End of the unlock period (0 = locked) */
+    uint32_t last_report_ms;                        /**< Time of the last reading */
+    uint32_t reads;                                 /**< Number of readings received */
+} OLED_Dashboard_t;
+
+/* Exported functions --------------------------------------------------------*/
+/**
+ * @brief Creates the dashboard widgets; the first render draws the whole screen.
+ *
+ * @param dash Dashboard to initialize
+ * @param u8g2 Display object (full buffer mode)
+ */
+void OLED_Dashboard_Init(OLED_Dashboard_t *dash, u8g2_t *u8g2);
+
+
+/**
+ * @brief Updates the dashboard state.
+ *
+ * @param dash       Dashboard
+ * @param rc522_data New RC522 reading, or NULL if only the time advanced
+ * @param now_ms     Current time in milliseconds (e.g. kernel tick count)
+ */
+void OLED_Dashboard_Update(OLED_Dashboard_t *dash, const RC522_Data_t *rc522_data, uint32_t now_ms);
+
+
+/**
+ * @brief Sends the tiles changed since the last render.
+ *
+ * @param dash Dashboard
+ * @return Number of tiles sent
+ */
+uint16_t OLED_Dashboard_Render(OLED_Dashboard_t *dash);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // OLED_DASHBOARD_H
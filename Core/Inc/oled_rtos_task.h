@@ -27,9 +27,131 @@ extern "C" {
 /* Exported constants --------------------------------------------------------*/
 /**
  * @def OLED_ANIMATION_DELAY_MS
- * @brief Animation frame delay for OLED display (milliseconds).
+ * @brief Animation frame period for OLED display (milliseconds).
+ *
+ * Frame period of the status page slide-in and unlock bar; the spinner steps every third frame
+ * (see oled_status_screen.h). Animations are timed from their start, so a dropped frame does not
+ * slow them down.
+ */
+#define OLED_ANIMATION_DELAY_MS      40
+
+/**
+ * @def OLED_ANIMATION_ENABLE
+ * @brief Set to 1 to animate the status page (spinner while no card is present, slide-in and
+ *        unlock countdown on a granted access; see oled_anim.h). Requires the full frame buffer.
+ *
+ * Between readings only the animated tiles are sent; without an active animation the task blocks
+ * on the queue as before.
  */
-#define OLED_ANIMATION_DELAY_MS      200
+#define OLED_ANIMATION_ENABLE        0
+
+/**
+ * @def OLED_ACCESS_LOG_ENABLE
+ * @brief Set to 1 to show a hardware-scrolled access log instead of the status page.
+ *
+ * Each detected card (and each change to "no card") appends one line; a new line costs a single
+ * display page transfer (see oled_log.h).
+ */
+#define OLED_ACCESS_LOG_ENABLE       0
+
+/**
+ * @def OLED_MIRROR_ENABLE
+ * @brief Set to 1 to mirror every displayed frame over UART3 (see oled_mirror.h).
+ *
+ * Requires the full frame buffer. While a mirror frame is being sent, blocking debug output on
+ * UART3 is dropped (HAL_BUSY).
+ */
+#define OLED_MIRROR_ENABLE           0
+
+/**
+ * @def OLED_STATUS_TILETEXT_ENABLE
+ * @brief Set to 1 to render the UID and status word of the status page as u8x8 tile text; a new
+ *        reading then sends only the changed characters (see oled_tiletext.h). Requires the full
+ *        frame buffer.
+ */
+#define OLED_STATUS_TILETEXT_ENABLE  0
+
+/**
+ * @def OLED_DASHBOARD_ENABLE
+ * @brief Set to 1 to show the widget dashboard (time, door state, history, reader health) instead
+ *        of the status page (see oled_dashboard.h). Requires the full frame buffer.
+ */
+#define OLED_DASHBOARD_ENABLE        0
+
+/**
+ * @def OLED_DASHBOARD_TICK_MS
+ * @brief Dashboard refresh period while no RC522 data arrives (milliseconds).
+ *
+ * Frames without visible changes send nothing, so a short period only costs the update check.
+ */
+#define OLED_DASHBOARD_TICK_MS       100
+
+/**
+ * @def OLED_OUTSIDE_DISPLAY_ENABLE
+ * @brief Set to 1 to show the status page on a second (outside) panel at OLED_OUTSIDE_ADDRESS.
+ *
+ * The outside panel has its own render task (OLED_OUTSIDE_TASK_THREAD_NAME), which draws every
+ * reading next to the inside screen, whichever one is selected. Both panels share I2C2; their
+ * transfers are interleaved by the bus scheduler, the inside panel first (see oled_bus.h). Every
+ * OLED_BUS_REPORT_MS the frame rate and late transfers of each panel are printed on UART3.
+ * Off by default: it needs the second panel on the bus.
+ */
+#define OLED_OUTSIDE_DISPLAY_ENABLE  0
+
+/**
+ * @def OLED_BUS_REPORT_MS
+ * @brief Period of the per-display frame rate report on UART3 (milliseconds).
+ */
+#define OLED_BUS_REPORT_MS           5000
+
+/**
+ * @def OLED_OUTSIDE_TASK_STACK_SIZE_BYTES
+ * @brief Stack size (in bytes) of the outside panel render task.
+ */
+#define OLED_OUTSIDE_TASK_STACK_SIZE_BYTES  (512 * 4)
+
+/**
+ * @def OLED_OUTSIDE_TASK_THREAD_NAME
+ * @brief Name of the outside panel render task.
+ */
+#define OLED_OUTSIDE_TASK_THREAD_NAME       "OLED_Outside"
+
+/**
+ * @def OLED_OUTSIDE_TASK_THREAD_PRIORITY
+ * @brief Priority of the outside panel render task (below the OLED task: it renders while the
+ *        inside frame waits for the bus).
+ */
+#define OLED_OUTSIDE_TASK_THREAD_PRIORITY   osPriorityBelowNormal
+
+/**
+ * @def OLED_IDLE_ENABLE
+ * @brief Set to 1 to dim, sleep and pixel-shift the status page when no card is presented (oled_idle.h).
+ *
+ * A card event (a card, or the card leaving) is activity. OLED_IDLE_DIM_MS after the last one the
+ * contrast ramps down over OLED_IDLE_RAMP_MS to OLED_IDLE_CONTRAST_DIM, and after OLED_IDLE_SLEEP_MS
+ * the inside panel enters power save. The next card event wakes it with the new frame; wakes slower than
+ * OLED_IDLE_WAKE_MAX_MS are counted and reported on UART3. Every OLED_IDLE_SHIFT_MS the layout moves
+ * by one pixel on a 3x3 orbit (picture loop renderer only; the tile text renderer keeps its grid).
+ * The other screens (log, dashboard, animations) stay at full contrast.
+ */
+#define OLED_IDLE_ENABLE             1
+
+#define OLED_IDLE_DIM_MS             30000      /**< Inactivity before the contrast ramp */
+#define OLED_IDLE_RAMP_MS            2000       /**< Duration of the contrast ramp */
+#define OLED_IDLE_SLEEP_MS           300000     /**< Inactivity before power save (0 = never) */
+#define OLED_IDLE_SHIFT_MS           60000      /**< Pixel shift period (0 = off) */
+#define OLED_IDLE_WAKE_MAX_MS        50         /**< Wake-to-first-frame latency bound */
+#define OLED_IDLE_CONTRAST_FULL      0xCF       /**< Contrast while active (SH1106 init value) */
+#define OLED_IDLE_CONTRAST_DIM       0x10       /**< Contrast at the end of the ramp */
+
+/**
+ * @def OLED_TRANSPORT
+ * @brief Transport of the inside panel: OLED_TRANSPORT_I2C (I2C2) or OLED_TRANSPORT_SPI (SPI4 with DMA).
+ *
+ * The time of the first full frame is printed on UART3 at startup, to compare the transports on the
+ * target (see the table at OLED_Transport_t).
+ */
+#define OLED_TRANSPORT               OLED_TRANSPORT_I2C
 
 /**
  * @def OLED_SHOW_PROJECT_NAME
@@ -55,6 +177,25 @@ extern "C" {
  */
 #define OLED_TASK_THREAD_PRIORITY    osPriorityNormal
 
+/**
+ * @def OLED_TASK_FRAME_PERIOD_MS
+ * @brief Minimum separation of two status screen frames (start to start).
+ */
+#define OLED_TASK_FRAME_PERIOD_MS    100
+
+/**
+ * @def OLED_TASK_FRAME_DEADLINE_MS
+ * @brief Deadline of a status screen frame, from its release (message or idle step) until the frame
+ *        has been handed to the display.
+ */
+#define OLED_TASK_FRAME_DEADLINE_MS  100
+
+/**
+ * @def OLED_TASK_FRAME_BUDGET_US
+ * @brief Execution time budget of a status screen frame (render plus the blocking part of the output).
+ */
+#define OLED_TASK_FRAME_BUDGET_US    50000
+
 /**
  * @def RC522_QUEUE_SIZE
  * @brief Message queue size for RC522 data updates (shared with OLED task).
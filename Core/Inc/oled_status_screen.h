@@ -0,0 +1,161 @@
+
+/**
+ * @file    oled_status_screen.h
+ * @author  Ted Wang
+ * @date    2026-10-17
+ * @brief   Status screen of the OLED display task (project name, tag/card UID, access status).
+ *
+ * @details
+ * The screen content is kept in a small retained model that is updated from RC522 data and drawn
+ * with the u8g2 picture loop, so the same code works in full buffer and page modes. The module does
+ * not use any RTOS or HAL services and is also built by the host benchmark (Tools/oled_host).
+ *
+ * With the hybrid renderer (OLED_StatusScreen_InitTiles() / OLED_StatusScreen_RenderTiles()) the
+ * static labels stay in the framebuffer and are sent once, while the UID and the status word are
+ * u8x8 tile text rows (oled_tiletext.h): a new reading sends only the characters that changed.
+ *
+ * The animated renderer (OLED_StatusScreen_InitAnim() / OLED_StatusScreen_RenderAnimated()) adds
+ * time-based effects (oled_anim.h) in the bottom band: a spinner while no card is present, and on
+ * a granted access the status line slides in while a countdown bar shows the unlock time.
+ */
+
+#ifndef OLED_STATUS_SCREEN_H
+#define OLED_STATUS_SCREEN_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "u8g2.h"
+#include "rc522_rtos_task.h"
+#include "oled_tiletext.h"
+#include "oled_anim.h"
+
+/* Exported constants --------------------------------------------------------*/
+/**
+ * @brief Line prefixes; the hybrid renderer draws them as static labels.
+ */
+#define OLED_STATUS_UID_PREFIX          "Tag/Card: "
+#define OLED_STATUS_STATUS_PREFIX       "Status: "
+
+/**
+ * @brief Tile rows of the hybrid renderer owned by tile text (UID and status word).
+ */
+#define OLED_STATUS_TILE_UID_ROW        4
+#define OLED_STATUS_TILE_STATUS_ROW     6
+
+/**
+ * @brief Timing of the animated renderer (milliseconds); frame periods derive from
+ *        OLED_ANIMATION_DELAY_MS (oled_rtos_task.h).
+ */
+#define OLED_STATUS_SPINNER_STEP_MS     (3 * OLED_ANIMATION_DELAY_MS)
+#define OLED_STATUS_SLIDE_MS            (8 * OLED_ANIMATION_DELAY_MS)
+#define OLED_STATUS_GRANT_MS            3000
+
+/* Exported types ------------------------------------------------------------*/
+/**
+ * @brief Retained content of the status screen.
+ */
+typedef struct {
+    char uid_line[32];          /**< Middle line: tag/card UID or "Not Detected" */
+    const char *uid_text;       /**< UID part of uid_line (after OLED_STATUS_UID_PREFIX) */
+    const char *status_line;    /**< Bottom line: access status */
+    const char *status_text;    /**< Status word of status_line (after OLED_STATUS_STATUS_PREFIX) */
+    uint8_t granted;            /**< 1 if the reading was successful */
+    uint8_t shift_x;            /**< Pixel shift of the layout to the right (burn-in mitigation, oled_idle.h) */
+    uint8_t shift_y;            /**< Pixel shift of the layout down */
+} OLED_StatusScreen_t;
+
+/**
+ * @brief State of the animated renderer.
+ */
+typedef struct {
+    OLED_Animator_t animator;       /**< Scheduler; step it with OLED_Anim_Step() between readings */
+    OLED_AnimSpinner_t spinner;     /**< Shown while no card is present */
+    OLED_AnimSlide_t slide;         /**< Status line slide-in on a granted access */
+    OLED_AnimProgress_t unlock;     /**< Unlock countdown on a granted access */
+    uint8_t granted;                /**< Decision of the previous reading */
+} OLED_StatusAnim_t;
+
+/* Exported functions --------------------------------------------------------*/
+/**
+ * @brief Initializes the screen content ("Not Detected", no pixel shift).
+ *
+ * @param screen Screen content to initialize
+ */
+void OLED_StatusScreen_Init(OLED_StatusScreen_t *screen);
+
+
+/**
+ * @brief Updates the screen content from the latest RC522 data.
+ *
+ * @param screen    Screen content to update
+ * @param rc522_data Latest RC522 reading
+ */
+void OLED_StatusScreen_Update(OLED_StatusScreen_t *screen, const RC522_Data_t *rc522_data);
+
+
+/**
+ * @brief Draws the status screen into the current u8g2 buffer (one page or the full frame).
+ *
+ * The whole layout is moved by the screen's pixel shift (0..2 pixels, the layout leaves room for it).
+ *
+ * @param u8g2   Display object
+ * @param screen Retained screen content
+ */
+void OLED_StatusScreen_Draw(u8g2_t *u8g2, const OLED_StatusScreen_t *screen);
+
+
+/**
+ * @brief Renders and sends the complete status screen (u8g2 picture loop).
+ *
+ * @param u8g2   Display object
+ * @param screen Retained screen content
+ */
+void OLED_StatusScreen_Render(u8g2_t *u8g2, const OLED_StatusScreen_t *screen);
+
+
+/**
+ * @brief Sets up the hybrid renderer: draws and sends the static labels (full buffer mode only).
+ *
+ * @param u8g2  Display object
+ * @param tiles Tile text state to initialize (owns the UID and status rows)
+ */
+void OLED_StatusScreen_InitTiles(u8g2_t *u8g2, OLED_TileText_t *tiles);
+
+
+/**
+ * @brief Sends the changed characters of the UID and status word (hybrid renderer).
+ *
+ * @param tiles  Tile text state set up by OLED_StatusScreen_InitTiles()
+ * @param screen Retained screen content
+ * @return Number of character tiles sent
+ */
+uint8_t OLED_StatusScreen_RenderTiles(OLED_TileText_t *tiles, const OLED_StatusScreen_t *screen);
+
+
+/**
+ * @brief Sets up the animated renderer (full buffer mode only); no animation is active yet.
+ *
+ * @param anim Animated renderer state to initialize
+ * @param u8g2 Display object
+ * @param busy Back-pressure query passed to OLED_Anim_InitAnimator(), or NULL
+ */
+void OLED_StatusScreen_InitAnim(OLED_StatusAnim_t *anim, u8g2_t *u8g2, uint8_t (*busy)(void));
+
+
+/**
+ * @brief Starts the animations for a new reading and sends the complete screen.
+ *
+ * @param anim   Animated renderer state
+ * @param screen Retained screen content (already updated)
+ * @param now_ms Current time on the animation timeline
+ */
+void OLED_StatusScreen_RenderAnimated(OLED_StatusAnim_t *anim, const OLED_StatusScreen_t *screen, uint32_t now_ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // OLED_STATUS_SCREEN_H
@@ -0,0 +1,173 @@
+/**
+ * @file    periodic.h
+ * @author  Ted Wang
+ * @date    2026-10-17
+ * @brief   Drift-free periodic task framework with deadline, budget and jitter monitoring.
+ *
+ * @details
+ * A task declares its timing once and replaces its trailing osDelay() with Periodic_Wait():
+ * @code
+ *   static Periodic_t timing;
+ *   static const Periodic_Config_t timing_config = {
+ *       .name = "RC522_Task", .period_ms = 2000, .deadline_ms = 500, .budget_us = 100000,
+ *       .overrun = Periodic_LogOverrun
+ *   };
+ *
+ *   Periodic_Init(&timing, &timing_config);
+ *   while (1)
+ *   {
+ *       ...one job...
+ *       Periodic_Wait(&timing);
+ *   }
+ * @endcode
+ * Releases lie on a fixed grid (release + period, osDelayUntil()), so the period does not stretch
+ * with the execution time of the job. A job that ends after one or more later releases has passed
+ * starts again at once for the latest of them; the older ones are counted as skipped instead of
+ * being run back to back, so the task keeps its phase.
+ *
+ * A sporadic task (config.sporadic = 1) is released by an event, e.g. a message, through
+ * Periodic_Release(); its period is the minimum separation between the starts of two jobs.
+ *
+ * For every job Periodic_Wait() checks, in the calling task:
+ * - the response time (release to Periodic_Wait(), kernel ticks) against the deadline; a response
+ *   of exactly the deadline meets it,
+ * - the execution time (start to Periodic_Wait(), DWT cycles) against the budget; this is wall
+ *   time and includes preemption by higher priority tasks and interrupts,
+ * - the period jitter: the deviation of the start-to-start interval of two consecutive periodic
+ *   jobs that were both woken at their release from the period (DWT cycles; not measured for
+ *   periods of 2^32 / SystemCoreClock seconds or more, about 25.6 s at 168 MHz).
+ * A deadline miss, budget overrun or skipped release calls the optional overrun hook before the
+ * task sleeps. Periodic_Report() prints the counters of all registered tasks; it is part of the
+ * RTOS statistics report (RTOS_STATS_REPORT_KEY).
+ */
+
+#ifndef PERIODIC_H
+#define PERIODIC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include <stdint.h>
+
+/* Exported constants --------------------------------------------------------*/
+/**
+ * @def PERIODIC_MAX_TASKS
+ * @brief Number of periodic tasks listed by Periodic_Report().
+ */
+#define PERIODIC_MAX_TASKS              4
+
+/**
+ * @name Overrun events (bit mask passed to the overrun hook)
+ * @{
+ */
+#define PERIODIC_EVENT_DEADLINE         0x01u   /**< Response time exceeded the deadline */
+#define PERIODIC_EVENT_BUDGET           0x02u   /**< Execution time exceeded the budget */
+#define PERIODIC_EVENT_SKIPPED          0x04u   /**< Releases were skipped after a long job */
+/** @} */
+
+/* Exported types ------------------------------------------------------------*/
+/**
+ * @brief Details of an overrun, passed to the overrun hook.
+ */
+typedef struct {
+    const char *name;           /**< Task name (Periodic_Config_t.name) */
+    uint32_t events;            /**< PERIODIC_EVENT_* bits */
+    uint32_t response_ms;       /**< Response time of the job */
+    uint32_t deadline_ms;       /**< Deadline of the job */
+    uint32_t exec_us;           /**< Execution time of the job */
+    uint32_t budget_us;         /**< Budget of the job (0: none) */
+    uint32_t skipped;           /**< Releases skipped after this job */
+} Periodic_Overrun_t;
+
+/**
+ * @brief Overrun hook, called from the periodic task itself inside Periodic_Wait().
+ */
+typedef void (*Periodic_OverrunHook_t)(const Periodic_Overrun_t *overrun);
+
+/**
+ * @brief Declared timing of a task.
+ */
+typedef struct {
+    const char *name;           /**< Name in the report and the overrun details */
+    uint32_t period_ms;         /**< Period (sporadic: minimum separation of job starts) */
+    uint32_t deadline_ms;       /**< Relative deadline from the release (0: the period) */
+    uint32_t budget_us;         /**< Execution time budget (0: not checked) */
+    uint8_t sporadic;           /**< 1: jobs are released by Periodic_Release() */
+    Periodic_OverrunHook_t overrun; /**< Optional overrun hook (NULL: count only) */
+} Periodic_Config_t;
+
+/**
+ * @brief Counters of a task since Periodic_Init().
+ */
+typedef struct {
+    uint32_t jobs;              /**< Completed jobs */
+    uint32_t deadline_misses;   /**< Jobs whose response time exceeded the deadline */
+    uint32_t budget_overruns;   /**< Jobs whose execution time exceeded the budget */
+    uint32_t skipped;           /**< Releases skipped because a job ran past them */
+    uint32_t response_max_ms;   /**< Longest response time */
+    uint32_t exec_max_us;       /**< Longest execution time */
+    uint32_t jitter_max_us;     /**< Largest period jitter (periodic tasks only) */
+} Periodic_Stats_t;
+
+/**
+ * @brief State of a periodic task (owned by the task; keep it static).
+ */
+typedef struct {
+    const Periodic_Config_t *config;    /**< Declared timing */
+    uint32_t release;           /**< Release tick of the current (or last) job */
+    uint32_t start_cycles;      /**< Cycle counter at the start of the current job */
+    uint8_t active;             /**< 1 while a job runs */
+    uint8_t prev_valid;         /**< 1 if the previous start may be used for the jitter */
+    uint8_t jitter;             /**< 1 if the jitter is measured (periodic, period below 2^32 cycles) */
+    Periodic_Stats_t stats;     /**< Counters */
+} Periodic_t;
+
+/* Exported functions --------------------------------------------------------*/
+/**
+ * @brief Registers a task and, unless it is sporadic, releases its first job now.
+ *
+ * Call from the task itself, right before its loop. The configuration must stay valid.
+ */
+void Periodic_Init(Periodic_t *task, const Periodic_Config_t *config);
+
+
+/**
+ * @brief Releases a job of a sporadic task now (e.g. after the triggering message arrived).
+ */
+void Periodic_Release(Periodic_t *task);
+
+
+/**
+ * @brief Ends the current job, checks it, and sleeps until the next release.
+ *
+ * Periodic tasks return at the start of the next job; sporadic tasks return once the minimum
+ * separation has passed and wait for their event afterwards.
+ */
+void Periodic_Wait(Periodic_t *task);
+
+
+/**
+ * @brief Copies the counters of a task (any task context).
+ */
+void Periodic_GetStats(const Periodic_t *task, Periodic_Stats_t *stats);
+
+
+/**
+ * @brief Ready-made overrun hook: prints one line per overrun on UART3.
+ */
+void Periodic_LogOverrun(const Periodic_Overrun_t *overrun);
+
+
+/**
+ * @brief Prints the declared timing and counters of all registered tasks on UART3 (uart_log.h).
+ */
+void Periodic_Report(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PERIODIC_H
@@ -41,6 +41,24 @@ extern "C" {
  */
 #define RC522_TASK_THREAD_PRIORITY       osPriorityAboveNormal
 
+/**
+ * @def RC522_TASK_PERIOD_MS
+ * @brief Acquisition period of the RC522 task (release to release, does not drift).
+ */
+#define RC522_TASK_PERIOD_MS             2000
+
+/**
+ * @def RC522_TASK_DEADLINE_MS
+ * @brief Deadline of one acquisition, from its release until the result is queued for the display.
+ */
+#define RC522_TASK_DEADLINE_MS           500
+
+/**
+ * @def RC522_TASK_BUDGET_US
+ * @brief Execution time budget of one acquisition (card polling plus the blocking UART debug output).
+ */
+#define RC522_TASK_BUDGET_US             100000
+
 /**
  * @def RC522_QUEUE_SIZE
  * @brief Message queue size for RC522 data updates to display task.
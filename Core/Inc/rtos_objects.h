@@ -0,0 +1,120 @@
+/**
+ * @file    rtos_objects.h
+ * @author  Ted Wang
+ * @date    2026-10-17
+ * @brief   Registry of the statically allocated RTOS objects and the boot-time memory report.
+ *
+ * @details
+ * Every task, queue, semaphore and mutex of the application is created through the RtosObj_*New()
+ * wrappers of the CMSIS-RTOS v2 calls. They accept only static control blocks (and stacks or
+ * message storage) in the attributes; a request without them returns NULL, which the callers treat
+ * as a creation failure, so nothing is taken from the FreeRTOS heap by accident. The FreeRTOS idle
+ * and timer tasks get their static memory from this module as well (CCM RAM).
+ *
+ * Each created object is recorded with its name, kind and memory. RtosObj_Report() prints the
+ * registry, the stack left in each task (from the stack fill pattern), the heap use with its
+ * minimum ever free size and the remaining headroom of SRAM and CCM RAM on UART3.
+ *
+ * Static storage for an object is declared next to its user, e.g.
+ * @code
+ *   static StaticTask_t my_task_cb CCM_RAM;
+ *   static StackType_t my_task_stack[1024 / sizeof(StackType_t)] CCM_RAM;
+ *   const osThreadAttr_t attr = {
+ *       .name = "My_Task", .priority = osPriorityNormal,
+ *       .cb_mem = &my_task_cb, .cb_size = sizeof(my_task_cb),
+ *       .stack_mem = my_task_stack, .stack_size = sizeof(my_task_stack)
+ *   };
+ *   my_task = RtosObj_ThreadNew(My_Task, NULL, &attr);
+ * @endcode
+ */
+
+#ifndef RTOS_OBJECTS_H
+#define RTOS_OBJECTS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "cmsis_os2.h"
+#include "main.h"
+#include <stdint.h>
+
+/* Exported constants --------------------------------------------------------*/
+/**
+ * @def RTOS_OBJ_MAX
+ * @brief Maximum number of registered objects (application objects plus the idle and timer tasks).
+ */
+#define RTOS_OBJ_MAX                16
+
+/* Exported types ------------------------------------------------------------*/
+/**
+ * @brief Kind of a registered object.
+ */
+typedef enum {
+    RTOS_OBJ_THREAD = 0,
+    RTOS_OBJ_QUEUE,
+    RTOS_OBJ_SEMAPHORE,
+    RTOS_OBJ_MUTEX
+} RtosObj_Kind_t;
+
+/**
+ * @brief One registered object.
+ */
+typedef struct {
+    const char *name;       /**< Object name (from the attributes) */
+    RtosObj_Kind_t kind;    /**< Object kind */
+    void *handle;           /**< CMSIS-RTOS handle (NULL for the kernel's idle and timer tasks) */
+    const void *cb;         /**< Static control block */
+    uint32_t cb_bytes;      /**< Size of the control block */
+    const void *mem;        /**< Stack (threads) or message storage (queues), NULL otherwise */
+    uint32_t mem_bytes;     /**< Size of the stack or message storage */
+} RtosObj_Entry_t;
+
+/* Exported functions --------------------------------------------------------*/
+/**
+ * @brief osThreadNew() from a static control block and stack (attr->cb_mem and attr->stack_mem).
+ * @return Thread handle, or NULL if the attributes carry no static memory or creation failed.
+ */
+osThreadId_t RtosObj_ThreadNew(osThreadFunc_t func, void *argument, const osThreadAttr_t *attr);
+
+/**
+ * @brief osMessageQueueNew() from a static control block and message storage (attr->cb_mem and attr->mq_mem).
+ * @return Queue handle, or NULL if the attributes carry no static memory or creation failed.
+ */
+osMessageQueueId_t RtosObj_QueueNew(uint32_t msg_count, uint32_t msg_size, const osMessageQueueAttr_t *attr);
+
+/**
+ * @brief osSemaphoreNew() from a static control block (attr->cb_mem).
+ * @return Semaphore handle, or NULL if the attributes carry no static memory or creation failed.
+ */
+osSemaphoreId_t RtosObj_SemaphoreNew(uint32_t max_count, uint32_t initial_count, const osSemaphoreAttr_t *attr);
+
+/**
+ * @brief osMutexNew() from a static control block (attr->cb_mem).
+ * @return Mutex handle, or NULL if the attributes carry no static memory or creation failed.
+ */
+osMutexId_t RtosObj_MutexNew(const osMutexAttr_t *attr);
+
+/**
+ * @brief Returns the number of registered objects and, if entries is not NULL, the registry itself.
+ */
+uint32_t RtosObj_GetEntries(const RtosObj_Entry_t **entries);
+
+/**
+ * @brief Returns the unused part of a registered thread's stack in bytes (stack fill pattern scan).
+ */
+uint32_t RtosObj_GetStackFree(const RtosObj_Entry_t *entry);
+
+/**
+ * @brief Prints the registry, heap use and SRAM/CCM RAM headroom on UART3 (uart_log.h).
+ *
+ * Call once all objects exist, e.g. after the display initialization.
+ */
+void RtosObj_Report(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // RTOS_OBJECTS_H
@@ -0,0 +1,143 @@
+/**
+ * @file    rtos_stats.h
+ * @author  Ted Wang
+ * @date    2026-10-17
+ * @brief   Per-task CPU use, stack high-water marks and context switch counts (FreeRTOS run time stats).
+ *
+ * @details
+ * configGENERATE_RUN_TIME_STATS is enabled with the DWT cycle counter as the run time clock
+ * (configureTimerForRunTimeStats()/getRunTimeCounterValue() in freertos.c), so FreeRTOS accounts
+ * every time slice to the running task in CPU cycles. A traceTASK_SWITCHED_IN() hook counts the
+ * context switches of each task.
+ *
+ * A low priority "Stats" task samples the kernel every RTOS_STATS_PERIOD_MS and keeps the last
+ * RTOS_STATS_WINDOW periods, so each snapshot has the CPU share of every task over the last period
+ * and over the sliding window, the unused stack of every task (high-water mark) and its context
+ * switches. RtosStats_GetSnapshot() copies the latest snapshot for other tasks; sending
+ * RTOS_STATS_REPORT_KEY on UART3 prints it without stopping anything:
+ * @code
+ *   CPU 12.4% (10 s 12.1%), 436 switches/s, 6 tasks, sample 42
+ *   task             pri   cpu%  win%  stack  switches     /s
+ *   OLED_Task         24   10.3  10.0   1244     12433    201
+ *     ...
+ * @endcode
+ *
+ * The DWT counter wraps every 2^32 cycles (about 23 s at 180 MHz); all differences are taken
+ * modulo 2^32, so the period and the window must stay below that.
+ */
+
+#ifndef RTOS_STATS_H
+#define RTOS_STATS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "cmsis_os2.h"
+#include <stdint.h>
+
+/* Exported constants --------------------------------------------------------*/
+/**
+ * @def RTOS_STATS_PERIOD_MS
+ * @brief Sampling period of the statistics task (milliseconds).
+ */
+#define RTOS_STATS_PERIOD_MS            1000
+
+/**
+ * @def RTOS_STATS_WINDOW
+ * @brief Length of the sliding window in sampling periods (window * period must stay below ~20 s).
+ */
+#define RTOS_STATS_WINDOW               10
+
+/**
+ * @def RTOS_STATS_MAX_TASKS
+ * @brief Number of tracked tasks (indexed by the FreeRTOS task number; a power of two up to 32).
+ *
+ * Task numbers are mapped to slots modulo RTOS_STATS_MAX_TASKS, so tasks created after others were
+ * deleted can share a slot; the later one is left out and counted in collisions. With more tasks
+ * than slots no sample is taken and the report says so.
+ */
+#define RTOS_STATS_MAX_TASKS            16
+
+/**
+ * @def RTOS_STATS_REPORT_KEY
+ * @brief Character received on UART3 that prints the latest snapshot.
+ */
+#define RTOS_STATS_REPORT_KEY           's'
+
+/**
+ * @def RTOS_STATS_TASK_STACK_SIZE_BYTES
+ * @brief Stack size (in bytes) of the statistics task.
+ */
+#define RTOS_STATS_TASK_STACK_SIZE_BYTES    (256 * 4)
+
+/**
+ * @def RTOS_STATS_TASK_THREAD_NAME
+ * @brief Name of the statistics task.
+ */
+#define RTOS_STATS_TASK_THREAD_NAME     "Stats"
+
+/**
+ * @def RTOS_STATS_TASK_THREAD_PRIORITY
+ * @brief Priority of the statistics task (below the application tasks).
+ */
+#define RTOS_STATS_TASK_THREAD_PRIORITY osPriorityLow
+
+/* Exported types ------------------------------------------------------------*/
+/**
+ * @brief Statistics of one task.
+ */
+typedef struct {
+    const char *name;           /**< Task name */
+    uint32_t number;            /**< FreeRTOS task number (creation order) */
+    uint32_t priority;          /**< Current FreeRTOS priority */
+    uint16_t cpu_permille;      /**< CPU share over the last period (0.1 %) */
+    uint16_t cpu_window_permille; /**< CPU share over the sliding window (0.1 %) */
+    uint32_t stack_free;        /**< Smallest amount of unused stack so far (bytes) */
+    uint32_t switches;          /**< Times switched in since start */
+    uint32_t switches_period;   /**< Times switched in during the last period */
+} RtosStats_Task_t;
+
+/**
+ * @brief One statistics snapshot.
+ */
+typedef struct {
+    uint32_t sample;            /**< Sample number (0: no sample yet) */
+    uint32_t window;            /**< Periods in the sliding window so far (up to RTOS_STATS_WINDOW) */
+    uint16_t load_permille;     /**< CPU use of all tasks but idle over the last period (0.1 %) */
+    uint16_t load_window_permille; /**< Same over the sliding window */
+    uint32_t switches_period;   /**< Context switches during the last period */
+    uint32_t task_count;        /**< Valid entries of tasks[] */
+    uint32_t collisions;        /**< Tasks left out: task number shares a slot with a listed task */
+    uint32_t overflows;         /**< Samples skipped so far because more than RTOS_STATS_MAX_TASKS tasks existed */
+    uint32_t tasks_total;       /**< Tasks at the last skipped sample */
+    RtosStats_Task_t tasks[RTOS_STATS_MAX_TASKS];   /**< Tasks in creation order */
+} RtosStats_Snapshot_t;
+
+/* Exported functions --------------------------------------------------------*/
+/**
+ * @brief Creates the statistics task and starts listening for report requests on UART3.
+ *
+ * Call once during system initialization before the RTOS kernel starts.
+ * @note If task creation fails, outputs error via UART3 and calls Error_Handler().
+ */
+void RtosStats_Init(void);
+
+
+/**
+ * @brief Copies the latest snapshot (sample is 0 before the first period has passed).
+ */
+void RtosStats_GetSnapshot(RtosStats_Snapshot_t *snapshot);
+
+
+/**
+ * @brief Context switch hook (traceTASK_SWITCHED_IN() in FreeRTOSConfig.h, called from PendSV).
+ */
+void RtosStats_TaskSwitchedIn(uint32_t task_number);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // RTOS_STATS_H
@@ -0,0 +1,51 @@
+/**
+ * @file    spsc_bench.h
+ * @author  Ted Wang
+ * @date    2026-10-17
+ * @brief   Target measurement of the SPSC ring (spsc_ring.h) against osMessageQueue.
+ *
+ * @details
+ * Pushes and pops one 8-byte element through each, back to back and without blocking, and prints
+ * the cheapest of SPSC_BENCH_ROUNDS rounds in DWT cycles on UART3:
+ * @code
+ *   Queue cost (8 bytes, min of 64): SPSC push+pop <n> cycles, osMessageQueue put+get <m> cycles
+ * @endcode
+ * The statistics task runs it once at startup when SPSC_BENCH_ENABLE is 1.
+ */
+
+#ifndef SPSC_BENCH_H
+#define SPSC_BENCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported constants --------------------------------------------------------*/
+/**
+ * @def SPSC_BENCH_ENABLE
+ * @brief 1 runs the queue measurement once at startup (statistics task).
+ */
+#define SPSC_BENCH_ENABLE               0
+
+/**
+ * @def SPSC_BENCH_ROUNDS
+ * @brief Rounds of the measurement; the cheapest one is printed.
+ */
+#define SPSC_BENCH_ROUNDS               64
+
+/* Exported functions --------------------------------------------------------*/
+#if SPSC_BENCH_ENABLE
+/**
+ * @brief Measures the ring and the queue and prints the result on UART3 (task context).
+ */
+void SpscBench_Run(void);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SPSC_BENCH_H
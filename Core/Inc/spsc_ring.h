@@ -0,0 +1,184 @@
+/**
+ * @file    spsc_ring.h
+ * @author  Ted Wang
+ * @date    2026-10-17
+ * @brief   Header-only lock-free single-producer/single-consumer ring buffer.
+ *
+ * @details
+ * A ring of fixed-size elements between exactly one producer and one consumer, e.g. an interrupt
+ * handler and a task, or two tasks. Neither side takes a lock, masks interrupts or enters a
+ * critical section: head is written only by the producer and tail only by the consumer, and each
+ * index is published with a release store after the data (and read with an acquire load before
+ * the data). On the Cortex-M4 these are a plain LDR/STR with a DMB; LDREX/STREX are not needed
+ * because no index has two writers.
+ *
+ * The capacity is a power of two and the indices run freely (wrapping at 2^32), so all capacity
+ * elements are usable and count = head - tail. Push and pop move up to n elements with at most
+ * two memcpy() calls. Unlike osMessageQueue there is no blocking: pair the ring with a thread flag
+ * or semaphore if the consumer has to sleep until data arrives.
+ *
+ * Usage:
+ * @code
+ *   static uint32_t samples_mem[64];
+ *   static SpscRing_t samples;
+ *
+ *   SpscRing_Init(&samples, samples_mem, 64, sizeof(uint32_t));
+ *   // producer (e.g. DMA complete interrupt)
+ *   SpscRing_Push(&samples, &value, 1);
+ *   // consumer task
+ *   n = SpscRing_Pop(&samples, batch, 16);
+ * @endcode
+ * Tools/oled_host/spsc_bench.c checks the ring (also with two threads) and compares its
+ * throughput with a locked by-value queue like osMessageQueue.
+ */
+
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <string.h>
+
+/* Exported types ------------------------------------------------------------*/
+/**
+ * @brief Ring state. Place it (and its storage) where both sides can reach it.
+ */
+typedef struct {
+    uint32_t head;          /**< Elements pushed so far (producer only) */
+    uint32_t tail;          /**< Elements popped so far (consumer only) */
+    uint32_t mask;          /**< Capacity - 1 */
+    uint32_t elem_size;     /**< Element size in bytes */
+    uint8_t *buf;           /**< Storage: capacity * elem_size bytes */
+} SpscRing_t;
+
+/* Exported macros -----------------------------------------------------------*/
+/**
+ * @brief Index accessors with acquire/release ordering (GCC/Clang builtins, Arm Compiler 6 included).
+ */
+#define SPSC_RING_LOAD_ACQUIRE(p)       __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define SPSC_RING_STORE_RELEASE(p, v)   __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+
+/* Exported functions --------------------------------------------------------*/
+/**
+ * @brief Initializes an empty ring. Not thread safe: call before producer and consumer start.
+ * @param[in] buf       Storage of capacity * elem_size bytes.
+ * @param[in] capacity  Number of elements, a power of two.
+ * @param[in] elem_size Element size in bytes.
+ * @return 1 on success, 0 if capacity is not a power of two or elem_size is 0.
+ */
+static inline uint8_t SpscRing_Init(SpscRing_t *ring, void *buf, uint32_t capacity, uint32_t elem_size)
+{
+    if (capacity == 0 || (capacity & (capacity - 1u)) != 0 || elem_size == 0)
+    {
+        return 0;
+    }
+    ring->head = 0;
+    ring->tail = 0;
+    ring->mask = capacity - 1u;
+    ring->elem_size = elem_size;
+    ring->buf = (uint8_t *)buf;
+    return 1;
+}
+
+/**
+ * @brief Number of elements that can be popped (exact for the consumer, a lower bound otherwise).
+ */
+static inline uint32_t SpscRing_Count(const SpscRing_t *ring)
+{
+    return SPSC_RING_LOAD_ACQUIRE(&ring->head) - SPSC_RING_LOAD_ACQUIRE(&ring->tail);
+}
+
+/**
+ * @brief Number of elements that can be pushed (exact for the producer, a lower bound otherwise).
+ */
+static inline uint32_t SpscRing_Free(const SpscRing_t *ring)
+{
+    return ring->mask + 1u - SpscRing_Count(ring);
+}
+
+/**
+ * @brief Copies up to n elements into the ring (producer only).
+ * @return Number of elements pushed (less than n if the ring filled up).
+ */
+static inline uint32_t SpscRing_Push(SpscRing_t *ring, const void *items, uint32_t n)
+{
+    uint32_t head = ring->head;
+    uint32_t space = ring->mask + 1u - (head - SPSC_RING_LOAD_ACQUIRE(&ring->tail));
+    uint32_t start = head & ring->mask;
+    uint32_t first;
+
+    if (n > space)
+    {
+        n = space;
+    }
+    first = ring->mask + 1u - start;
+    if (first > n)
+    {
+        first = n;
+    }
+    memcpy(ring->buf + start * ring->elem_size, items, first * ring->elem_size);
+    memcpy(ring->buf, (const uint8_t *)items + first * ring->elem_size, (n - first) * ring->elem_size);
+    SPSC_RING_STORE_RELEASE(&ring->head, head + n);
+    return n;
+}
+
+/**
+ * @brief Copies up to n elements out of the ring (consumer only).
+ * @return Number of elements popped (less than n if the ring ran empty).
+ */
+static inline uint32_t SpscRing_Pop(SpscRing_t *ring, void *items, uint32_t n)
+{
+    uint32_t tail = ring->tail;
+    uint32_t avail = SPSC_RING_LOAD_ACQUIRE(&ring->head) - tail;
+    uint32_t start = tail & ring->mask;
+    uint32_t first;
+
+    if (n > avail)
+    {
+        n = avail;
+    }
+    first = ring->mask + 1u - start;
+    if (first > n)
+    {
+        first = n;
+    }
+    memcpy(items, ring->buf + start * ring->elem_size, first * ring->elem_size);
+    memcpy((uint8_t *)items + first * ring->elem_size, ring->buf, (n - first) * ring->elem_size);
+    SPSC_RING_STORE_RELEASE(&ring->tail, tail + n);
+    return n;
+}
+
+/**
+ * @brief Returns the contiguous run of elements at the read position without consuming them
+ *        (consumer only), e.g. to hand them to a DMA transfer; release them with SpscRing_Skip().
+ * @param[out] count Number of contiguous elements available (0 if the ring is empty).
+ * @return Pointer to the first element.
+ */
+static inline void *SpscRing_Peek(SpscRing_t *ring, uint32_t *count)
+{
+    uint32_t tail = ring->tail;
+    uint32_t avail = SPSC_RING_LOAD_ACQUIRE(&ring->head) - tail;
+    uint32_t start = tail & ring->mask;
+    uint32_t first = ring->mask + 1u - start;
+
+    *count = (avail < first) ? avail : first;
+    return ring->buf + start * ring->elem_size;
+}
+
+/**
+ * @brief Consumes n elements returned by SpscRing_Peek() (consumer only).
+ */
+static inline void SpscRing_Skip(SpscRing_t *ring, uint32_t n)
+{
+    SPSC_RING_STORE_RELEASE(&ring->tail, ring->tail + n);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SPSC_RING_H
@@ -0,0 +1,90 @@
+/**
+ * @file    timing.h
+ * @author  Ted Wang
+ * @date    2026-10-17
+ * @brief   RTOS-aware delay service (DWT microsecond busy-waits, millisecond task sleeps).
+ *
+ * @details
+ * Short delays (nanoseconds to microseconds) are busy-waits on the DWT cycle counter, accurate to
+ * a few CPU cycles instead of the 1 ms granularity of HAL_Delay(). Millisecond delays block the
+ * calling task with osDelay() once the scheduler runs, so other tasks use the CPU meanwhile; before
+ * the scheduler starts (or in an interrupt) they fall back to a cycle counter busy-wait.
+ *
+ * The service also accumulates how long callers busy-waited and slept, so drivers can report how
+ * much CPU time their initialization actually kept for itself.
+ */
+
+#ifndef TIMING_H
+#define TIMING_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported types ------------------------------------------------------------*/
+/**
+ * @brief Accumulated delay statistics (since Timing_Init() or Timing_ResetStats()).
+ */
+typedef struct {
+    uint32_t busy_us;       /**< Time spent in busy-waits (microseconds) */
+    uint32_t sleep_ms;      /**< Time requested as task sleeps (milliseconds) */
+} Timing_Stats_t;
+
+/* Exported functions --------------------------------------------------------*/
+/**
+ * @brief Enables the DWT cycle counter. Called lazily by the delay functions as well.
+ */
+void Timing_Init(void);
+
+
+/**
+ * @brief Busy-waits for at least ns nanoseconds (rounded up to CPU cycles).
+ */
+void Timing_DelayNs(uint32_t ns);
+
+
+/**
+ * @brief Busy-waits for at least us microseconds.
+ */
+void Timing_DelayUs(uint32_t us);
+
+
+/**
+ * @brief Waits for at least ms milliseconds; sleeps the calling task when the scheduler runs.
+ */
+void Timing_DelayMs(uint32_t ms);
+
+
+/**
+ * @brief Returns the DWT cycle counter (free running, wraps every 2^32 cycles).
+ *
+ * Differences are valid for intervals below 2^32 cycles (about 23 s at 180 MHz).
+ */
+uint32_t Timing_GetCycles(void);
+
+
+/**
+ * @brief Converts a cycle count difference to microseconds.
+ */
+uint32_t Timing_CyclesToUs(uint32_t cycles);
+
+
+/**
+ * @brief Copies the accumulated delay statistics.
+ */
+void Timing_GetStats(Timing_Stats_t *stats);
+
+
+/**
+ * @brief Clears the accumulated delay statistics.
+ */
+void Timing_ResetStats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TIMING_H
@@ -0,0 +1,183 @@
+/**
+ * @file    trace_recorder.h
+ * @author  Ted Wang
+ * @date    2026-10-17
+ * @brief   Binary kernel trace recorder (task switches, queue operations, interrupts) streamed over UART3.
+ *
+ * @details
+ * The FreeRTOS trace hook macros in FreeRTOSConfig.h and the TRACE_ISR_ENTER()/TRACE_ISR_EXIT()
+ * macros in the interrupt handlers of stm32f4xx_it.c write 8-byte records into a RAM ring:
+ * @code
+ *   uint32 timestamp (DWT cycles)  uint8 event  uint8 id  uint16 arg
+ * @endcode
+ * Recording takes a few dozen cycles with interrupts masked and never blocks. Until streaming
+ * starts the ring works as a flight recorder (the oldest records are overwritten), so the first
+ * streamed records show what led up to the request.
+ *
+ * Sending TRACE_STREAM_KEY on UART3 starts or stops streaming: a low priority "Trace" task sends
+ * the task and object names once, then the ring contents in frames of the same layout as the OLED
+ * mirror stream (shared UART3 DMA channel, text between frames is skipped by the receiver):
+ * @code
+ *   0xA5 0x5A  type  len_lo len_hi  payload[len]  sum1 sum2
+ *
+ *   type 'N' (names):   cpu_hz(u32)  { kind(u8) id(u8) name... 0 }*     kind 0: task, 1: queue object
+ *   type 'T' (records): seq(u8)  lost(u32)  record[8]*
+ * @endcode
+ * lost counts the records dropped so far because the ring was full while streaming (the UART
+ * carries about 1400 records/s at 115200 baud). Tools/trace/trace2chrome.py converts a capture to
+ * Chrome trace-event JSON for chrome://tracing or https://ui.perfetto.dev.
+ *
+ * This header is included by FreeRTOSConfig.h and therefore must not include FreeRTOS headers.
+ */
+
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported constants --------------------------------------------------------*/
+/**
+ * @def TRACE_RECORDER_ENABLE
+ * @brief 1 records the kernel events; 0 compiles the hooks and trace_recorder.c out.
+ */
+#define TRACE_RECORDER_ENABLE           1
+
+/**
+ * @def TRACE_RING_RECORDS
+ * @brief Capacity of the record ring (power of two; 8 bytes per record, CCM RAM).
+ */
+#define TRACE_RING_RECORDS              1024
+
+/**
+ * @def TRACE_FRAME_RECORDS
+ * @brief Maximum number of records per 'T' frame (transmit buffer in SRAM for the UART DMA).
+ */
+#define TRACE_FRAME_RECORDS             96
+
+/**
+ * @def TRACE_STREAM_KEY
+ * @brief Character received on UART3 that starts or stops streaming.
+ */
+#define TRACE_STREAM_KEY                't'
+
+/**
+ * @def TRACE_TASK_STACK_SIZE_BYTES
+ * @brief Stack size (in bytes) of the trace streaming task.
+ */
+#define TRACE_TASK_STACK_SIZE_BYTES     (256 * 4)
+
+/**
+ * @def TRACE_TASK_THREAD_NAME
+ * @brief Name of the trace streaming task.
+ */
+#define TRACE_TASK_THREAD_NAME          "Trace"
+
+/**
+ * @def TRACE_TASK_THREAD_PRIORITY
+ * @brief Priority of the trace streaming task (below the application tasks).
+ */
+#define TRACE_TASK_THREAD_PRIORITY      osPriorityLow
+
+/**
+ * @name Trace events
+ * @{
+ */
+#define TRACE_EV_TASK_IN                1u      /**< Task switched in (id: task number) */
+#define TRACE_EV_TASK_OUT               2u      /**< Task switched out (id: task number) */
+#define TRACE_EV_QUEUE_SEND             3u      /**< Queue send / semaphore or mutex give (id: object, arg: items before) */
+#define TRACE_EV_QUEUE_RECEIVE          4u      /**< Queue receive / semaphore or mutex take (id: object, arg: items before) */
+#define TRACE_EV_QUEUE_BLOCK_SEND       5u      /**< Task blocks on a full queue (id: object) */
+#define TRACE_EV_QUEUE_BLOCK_RECEIVE    6u      /**< Task blocks on an empty queue / taken semaphore (id: object) */
+#define TRACE_EV_ISR_ENTER              7u      /**< Interrupt handler entered (id: IRQ number) */
+#define TRACE_EV_ISR_EXIT               8u      /**< Interrupt handler left (id: IRQ number) */
+#define TRACE_EV_MARK                   9u      /**< Application mark (Trace_Mark()) */
+/** @} */
+
+/* Exported macros -----------------------------------------------------------*/
+#if TRACE_RECORDER_ENABLE
+#define TRACE_RECORD(event, id, arg)    Trace_Record((event), (uint32_t)(id), (uint32_t)(arg))
+#define TRACE_ISR_ENTER()               Trace_IsrEnter()
+#define TRACE_ISR_EXIT()                Trace_IsrExit()
+#else
+#define TRACE_RECORD(event, id, arg)
+#define TRACE_ISR_ENTER()
+#define TRACE_ISR_EXIT()
+#endif
+
+/* Exported types ------------------------------------------------------------*/
+/**
+ * @brief One trace record (little endian on the wire, as in memory).
+ */
+typedef struct {
+    uint32_t timestamp;     /**< DWT cycle counter */
+    uint8_t event;          /**< TRACE_EV_* */
+    uint8_t id;             /**< Task number, object number or IRQ number */
+    uint16_t arg;           /**< Event argument */
+} Trace_Record_t;
+
+/**
+ * @brief Recorder counters.
+ */
+typedef struct {
+    uint32_t recorded;      /**< Records written */
+    uint32_t overwritten;   /**< Records overwritten before streaming (flight recorder mode) */
+    uint32_t lost;          /**< Records dropped while streaming (ring full) */
+    uint32_t frames;        /**< Frames transmitted */
+    uint8_t streaming;      /**< 1 while streaming */
+} Trace_Stats_t;
+
+/* Exported functions --------------------------------------------------------*/
+/**
+ * @brief Creates the trace streaming task. Recording itself runs from the first kernel event.
+ *
+ * Call once during system initialization before the RTOS kernel starts.
+ * @note If task creation fails, outputs error via UART3 and calls Error_Handler().
+ */
+void Trace_Init(void);
+
+
+/**
+ * @brief Appends a record to the ring (any context, interrupts masked for the update).
+ */
+void Trace_Record(uint32_t event, uint32_t id, uint32_t arg);
+
+
+/**
+ * @brief Records an application mark (e.g. the start of a display frame).
+ */
+void Trace_Mark(uint8_t id, uint16_t arg);
+
+
+/**
+ * @brief Records the entry of the current interrupt handler (TRACE_ISR_ENTER()).
+ */
+void Trace_IsrEnter(void);
+
+
+/**
+ * @brief Records the exit of the current interrupt handler (TRACE_ISR_EXIT()).
+ */
+void Trace_IsrExit(void);
+
+
+/**
+ * @brief Starts or stops streaming (UART3 receive interrupt; wakes the trace task).
+ */
+void Trace_ToggleStreamingFromISR(void);
+
+
+/**
+ * @brief Copies the recorder counters.
+ */
+void Trace_GetStats(Trace_Stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TRACE_RECORDER_H
@@ -0,0 +1,90 @@
+/**
+ * @file    uart_log.h
+ * @author  Ted Wang
+ * @date    2026-10-17
+ * @brief   Serialized text output on the debug UART (UART3), shared by all tasks.
+ *
+ * @details
+ * Every task writes its text lines with UartLog_Write() instead of calling HAL_UART_Transmit()
+ * itself. A mutex orders the writers. The binary streams (trace recorder, OLED mirror) start their
+ * DMA frames through UartLog_TransmitDma() under the same mutex, and a line that finds a frame
+ * still on the UART waits for it instead of getting HAL_BUSY. A line that cannot be sent within
+ * UART_LOG_TIMEOUT_MS is dropped and counted; the RTOS statistics report prints the counters:
+ * @code
+ *   UART3: 214 lines, 3 waited, 0 dropped
+ * @endcode
+ * Before the scheduler starts, and from interrupts, lines are sent directly (blocking); before
+ * UartLog_Init() they are dropped.
+ */
+
+#ifndef UART_LOG_H
+#define UART_LOG_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include <stdint.h>
+
+/* Exported constants --------------------------------------------------------*/
+/**
+ * @def UART_LOG_TIMEOUT_MS
+ * @brief Longest wait of a line for the UART, including a DMA frame in flight (milliseconds).
+ *
+ * The longest DMA frame (an OLED mirror keyframe, about 1 KB) takes about 90 ms at 115200 baud.
+ */
+#define UART_LOG_TIMEOUT_MS             200
+
+/* Exported types ------------------------------------------------------------*/
+/**
+ * @brief Output counters since UartLog_Init().
+ */
+typedef struct {
+    uint32_t lines;         /**< Lines sent */
+    uint32_t waited;        /**< Lines that waited for another writer or a DMA frame */
+    uint32_t dropped;       /**< Lines refused: the UART was not free within UART_LOG_TIMEOUT_MS */
+} UartLog_Stats_t;
+
+/* Exported functions --------------------------------------------------------*/
+/**
+ * @brief Binds the writer to its UART and creates the mutex. Call once before the tasks start.
+ */
+void UartLog_Init(UART_HandleTypeDef *huart);
+
+
+/**
+ * @brief Sends a text line (blocking, any task).
+ * @retval 1 Line sent.
+ * @retval 0 Line dropped (counted).
+ */
+uint8_t UartLog_Write(const char *data, uint16_t len);
+
+
+/**
+ * @brief Starts a binary DMA frame if no line is being sent and the UART is idle (task context).
+ *
+ * The buffer must be in SRAM and stay unchanged until the UART is idle again.
+ * @retval HAL_OK   Frame started.
+ * @retval HAL_BUSY UART in use; keep the frame and try again later.
+ */
+HAL_StatusTypeDef UartLog_TransmitDma(const uint8_t *data, uint16_t len);
+
+
+/**
+ * @brief Sends a null-terminated string; see UartLog_Write().
+ */
+uint8_t UartLog_WriteString(const char *str);
+
+
+/**
+ * @brief Copies the output counters.
+ */
+void UartLog_GetStats(UartLog_Stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // UART_LOG_H
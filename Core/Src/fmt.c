@@ -0,0 +1,242 @@
+/**
+ * @file    fmt.c
+ * @author  Ted Wang
+ * @date    2026-10-17
+ * @brief   Allocation-free text formatting into a caller buffer (replaces snprintf on hot paths).
+ *
+ * @details
+ * Numbers are converted right to left into a small scratch array and then copied with their
+ * padding. Decimal conversion emits two digits per division using a table of digit pairs, which
+ * halves the divisions of a digit-by-digit loop; hexadecimal conversion only shifts and masks.
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "fmt.h"
+
+/**
+ * @brief Upper case hex digits.
+ */
+static const char fmt_hex_digits[16] = {
+    '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'
+};
+
+/**
+ * @brief Decimal digit pairs "00".."99".
+ */
+static const char fmt_dec_pairs[200] = {
+    '0','0','0','1','0','2','0','3','0','4','0','5','0','6','0','7','0','8','0','9',
+    '1','0','1','1','1','2','1','3','1','4','1','5','1','6','1','7','1','8','1','9',
+    '2','0','2','1','2','2','2','3','2','4','2','5','2','6','2','7','2','8','2','9',
+    '3','0','3','1','3','2','3','3','3','4','3','5','3','6','3','7','3','8','3','9',
+    '4','0','4','1','4','2','4','3','4','4','4','5','4','6','4','7','4','8','4','9',
+    '5','0','5','1','5','2','5','3','5','4','5','5','5','6','5','7','5','8','5','9',
+    '6','0','6','1','6','2','6','3','6','4','6','5','6','6','6','7','6','8','6','9',
+    '7','0','7','1','7','2','7','3','7','4','7','5','7','6','7','7','7','8','7','9',
+    '8','0','8','1','8','2','8','3','8','4','8','5','8','6','8','7','8','8','8','9',
+    '9','0','9','1','9','2','9','3','9','4','9','5','9','6','9','7','9','8','9','9'
+};
+
+/**
+ * @brief Appends n characters, cutting off what does not fit.
+ */
+static void Fmt_Put(Fmt_t *f, const char *s, uint16_t n)
+{
+    uint16_t room = (uint16_t)(f->size - 1u - f->len);
+
+    if (n > room)
+    {
+        n = room;
+        f->truncated = 1;
+    }
+    for (uint16_t i = 0; i < n; i++)
+    {
+        f->buf[f->len + i] = s[i];
+    }
+    f->len = (uint16_t)(f->len + n);
+    f->buf[f->len] = '\0';
+}
+
+/**
+ * @brief Appends n copies of c, cutting off what does not fit.
+ */
+static void Fmt_Fill(Fmt_t *f, char c, uint16_t n)
+{
+    uint16_t room = (uint16_t)(f->size - 1u - f->len);
+
+    if (n > room)
+    {
+        n = room;
+        f->truncated = 1;
+    }
+    for (uint16_t i = 0; i < n; i++)
+    {
+        f->buf[f->len + i] = c;
+    }
+    f->len = (uint16_t)(f->len + n);
+    f->buf[f->len] = '\0';
+}
+
+/**
+ * @brief Converts value into the end of tmp (10 bytes); returns the index of the first digit.
+ */
+static uint8_t Fmt_Convert(char tmp[10], uint32_t value, uint16_t spec)
+{
+    uint8_t pos = 10;
+
+    if (spec & FMT_HEX)
+    {
+        do
+        {
+            tmp[--pos] = fmt_hex_digits[value & 0xFu];
+            value >>= 4;
+        } while (value != 0);
+        return pos;
+    }
+    while (value >= 100)
+    {
+        uint32_t pair = (value % 100u) * 2u;
+
+        value /= 100u;
+        tmp[--pos] = fmt_dec_pairs[pair + 1];
+        tmp[--pos] = fmt_dec_pairs[pair];
+    }
+    if (value >= 10)
+    {
+        tmp[--pos] = fmt_dec_pairs[value * 2u + 1];
+        tmp[--pos] = fmt_dec_pairs[value * 2u];
+    }
+    else
+    {
+        tmp[--pos] = (char)('0' + value);
+    }
+    return pos;
+}
+
+/**
+ * @brief Appends digits with an optional sign, padded to the width of spec.
+ */
+static void Fmt_Number(Fmt_t *f, uint32_t magnitude, uint8_t negative, uint16_t spec)
+{
+    char tmp[10];
+    uint8_t pos = Fmt_Convert(tmp, magnitude, spec);
+    uint16_t digits = (uint16_t)(10u - pos);
+    uint16_t width = (uint16_t)(spec & 0x1Fu);
+    uint16_t used = (uint16_t)(digits + negative);
+    uint16_t pad = (width > used) ? (uint16_t)(width - used) : 0;
+
+    if (spec & FMT_ZERO)
+    {
+        /* Sign first, then zeros: "-007" */
+        if (negative)
+        {
+            Fmt_Put(f, "-", 1);
+        }
+        Fmt_Fill(f, '0', pad);
+    }
+    else
+    {
+        Fmt_Fill(f, ' ', pad);
+        if (negative)
+        {
+            Fmt_Put(f, "-", 1);
+        }
+    }
+    Fmt_Put(f, &tmp[pos], digits);
+}
+
+/**
+ * @brief Starts formatting into buf.
+ */
+void Fmt_Init(Fmt_t *f, char *buf, size_t size)
+{
+    f->buf = buf;
+    f->size = (uint16_t)((size > 0xFFFFu) ? 0xFFFFu : size);
+    f->len = 0;
+    f->truncated = 0;
+    buf[0] = '\0';
+}
+
+/**
+ * @brief Appends a NUL terminated string.
+ */
+void Fmt_Str(Fmt_t *f, const char *s)
+{
+    char *out = f->buf + f->len;
+    char *end = f->buf + f->size - 1;
+
+    while (*s != '\0' && out < end)
+    {
+        *out++ = *s++;
+    }
+    if (*s != '\0')
+    {
+        f->truncated = 1;
+    }
+    *out = '\0';
+    f->len = (uint16_t)(out - f->buf);
+}
+
+/**
+ * @brief Appends one character.
+ */
+void Fmt_Char(Fmt_t *f, char c)
+{
+    Fmt_Put(f, &c, 1);
+}
+
+/**
+ * @brief Appends an unsigned integer formatted by spec.
+ */
+void Fmt_Uint(Fmt_t *f, uint32_t value, uint16_t spec)
+{
+    Fmt_Number(f, value, 0, spec);
+}
+
+/**
+ * @brief Appends a signed integer formatted by spec.
+ */
+void Fmt_Int(Fmt_t *f, int32_t value, uint16_t spec)
+{
+    uint32_t magnitude = (value < 0) ? (uint32_t)0 - (uint32_t)value : (uint32_t)value;
+
+    Fmt_Number(f, magnitude, (uint8_t)(value < 0), (uint16_t)(spec & ~FMT_HEX));
+}
+
+/**
+ * @brief Appends value / 10^decimals with exactly decimals fraction digits.
+ */
+void Fmt_Fixed(Fmt_t *f, int32_t value, uint8_t decimals)
+{
+    uint32_t magnitude = (value < 0) ? (uint32_t)0 - (uint32_t)value : (uint32_t)value;
+    uint32_t scale = 1;
+
+    if (decimals > 9)
+    {
+        decimals = 9;
+    }
+    for (uint8_t i = 0; i < decimals; i++)
+    {
+        scale *= 10u;
+    }
+    Fmt_Number(f, magnitude / scale, (uint8_t)(value < 0), FMT_D);
+    if (decimals != 0)
+    {
+        Fmt_Put(f, ".", 1);
+        Fmt_Uint(f, magnitude % scale, (uint16_t)(FMT_ZERO | FMT_WIDTH(decimals)));
+    }
+}
+
+/**
+ * @brief Appends bytes as upper case hex pairs.
+ */
+void Fmt_HexBytes(Fmt_t *f, const uint8_t *bytes, uint8_t count)
+{
+    char pair[2];
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        pair[0] = fmt_hex_digits[bytes[i] >> 4];
+        pair[1] = fmt_hex_digits[bytes[i] & 0xFu];
+        Fmt_Put(f, pair, 2);
+    }
+}
@@ -25,6 +25,10 @@
 
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include "ccmram.h"
+#include "fmt.h"
+#include "timing.h"
+#include "uart_log.h"
 
 /* USER CODE END Includes */
 
@@ -45,6 +49,13 @@
 
 /* Private variables ---------------------------------------------------------*/
 /* USER CODE BEGIN Variables */
+/**
+ * @brief FreeRTOS heap (heap_4, configAPPLICATION_ALLOCATED_HEAP) in CCM RAM.
+ *
+ * The application's objects are static (rtos_objects.c); the heap only serves objects created at
+ * run time without static memory. None of them is accessed by DMA.
+ */
+uint8_t ucHeap[configTOTAL_HEAP_SIZE] CCM_RAM;
 
 /* USER CODE END Variables */
 /* Definitions for defaultTask */
@@ -64,6 +75,57 @@ void StartDefaultTask(void *argument);
 
 void MX_FREERTOS_Init(void); /* (MISRA C 2004 rule 8.1) */
 
+/* Hook prototypes */
+void configureTimerForRunTimeStats(void);
+unsigned long getRunTimeCounterValue(void);
+void vApplicationMallocFailedHook(void);
+
+/* USER CODE BEGIN 1 */
+/* Functions needed when configGENERATE_RUN_TIME_STATS is on */
+/**
+ * @brief Run time statistics clock: the DWT cycle counter (also used by timing.c).
+ *
+ * Called by vTaskStartScheduler(). The counter runs at the core clock and wraps every 2^32 cycles;
+ * rtos_stats.c only uses differences over periods shorter than that.
+ */
+void configureTimerForRunTimeStats(void)
+{
+  Timing_Init();
+}
+
+/**
+ * @brief Current run time statistics clock value (CPU cycles), read on every context switch.
+ */
+unsigned long getRunTimeCounterValue(void)
+{
+  return Timing_GetCycles();
+}
+/* USER CODE END 1 */
+
+/* USER CODE BEGIN 5 */
+/**
+ * @brief Called by pvPortMalloc() when the FreeRTOS heap cannot satisfy a request.
+ *
+ * All boot-time objects are static (rtos_objects.c), so this only fires for an object created at
+ * run time without static memory once the configTOTAL_HEAP_SIZE reserve is used up. Reports the
+ * heap state on UART3 and stops in Error_Handler().
+ */
+void vApplicationMallocFailedHook(void)
+{
+  char msg[64];
+  Fmt_t f;
+
+  Fmt_Init(&f, msg, sizeof(msg));
+  Fmt_Str(&f, "FreeRTOS heap exhausted: ");
+  Fmt_Uint(&f, (uint32_t)xPortGetFreeHeapSize(), FMT_D);
+  Fmt_Str(&f, " of ");
+  Fmt_Uint(&f, configTOTAL_HEAP_SIZE, FMT_D);
+  Fmt_Str(&f, " bytes free\r\n");
+  UartLog_Write(msg, f.len);
+  Error_Handler();
+}
+/* USER CODE END 5 */
+
 /**
   * @brief  FreeRTOS initialization
   * @param  None
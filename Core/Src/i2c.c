@@ -21,10 +21,16 @@
 #include "i2c.h"
 
 /* USER CODE BEGIN 0 */
+#include "timing.h"
 
+/**
+ * @brief Half period of the recovery clock (5 us = 100 kHz, slow enough for any slave).
+ */
+#define I2C2_RECOVERY_HALF_PERIOD_US  5
 /* USER CODE END 0 */
 
 I2C_HandleTypeDef hi2c2;
+DMA_HandleTypeDef hdma_i2c2_tx;
 
 /* I2C2 init function */
 void MX_I2C2_Init(void)
@@ -94,6 +100,31 @@ void HAL_I2C_MspInit(I2C_HandleTypeDef* i2cHandle)
 
     /* I2C2 clock enable */
     __HAL_RCC_I2C2_CLK_ENABLE();
+
+    /* I2C2 DMA Init */
+    /* I2C2_TX Init */
+    hdma_i2c2_tx.Instance = DMA1_Stream7;
+    hdma_i2c2_tx.Init.Channel = DMA_CHANNEL_7;
+    hdma_i2c2_tx.Init.Direction = DMA_MEMORY_TO_PERIPH;
+    hdma_i2c2_tx.Init.PeriphInc = DMA_PINC_DISABLE;
+    hdma_i2c2_tx.Init.MemInc = DMA_MINC_ENABLE;
+    hdma_i2c2_tx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+    hdma_i2c2_tx.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+    hdma_i2c2_tx.Init.Mode = DMA_NORMAL;
+    hdma_i2c2_tx.Init.Priority = DMA_PRIORITY_LOW;
+    hdma_i2c2_tx.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+    if (HAL_DMA_Init(&hdma_i2c2_tx) != HAL_OK)
+    {
+      Error_Handler();
+    }
+
+    __HAL_LINKDMA(i2cHandle,hdmatx,hdma_i2c2_tx);
+
+    /* I2C2 interrupt Init */
+    HAL_NVIC_SetPriority(I2C2_EV_IRQn, 5, 0);
+    HAL_NVIC_EnableIRQ(I2C2_EV_IRQn);
+    HAL_NVIC_SetPriority(I2C2_ER_IRQn, 5, 0);
+    HAL_NVIC_EnableIRQ(I2C2_ER_IRQn);
   /* USER CODE BEGIN I2C2_MspInit 1 */
 
   /* USER CODE END I2C2_MspInit 1 */
@@ -119,6 +150,12 @@ void HAL_I2C_MspDeInit(I2C_HandleTypeDef* i2cHandle)
 
     HAL_GPIO_DeInit(OLED_SCL_GPIO_Port, OLED_SCL_Pin);
 
+    /* I2C2 DMA DeInit */
+    HAL_DMA_DeInit(i2cHandle->hdmatx);
+
+    /* I2C2 interrupt Deinit */
+    HAL_NVIC_DisableIRQ(I2C2_EV_IRQn);
+    HAL_NVIC_DisableIRQ(I2C2_ER_IRQn);
   /* USER CODE BEGIN I2C2_MspDeInit 1 */
 
   /* USER CODE END I2C2_MspDeInit 1 */
@@ -127,4 +164,56 @@ void HAL_I2C_MspDeInit(I2C_HandleTypeDef* i2cHandle)
 
 /* USER CODE BEGIN 1 */
 
+/**
+ * @brief Recovers a stuck I2C2 bus: peripheral reset, 9 SCL clocks + STOP, re-initialization.
+ *
+ * A slave that was interrupted in the middle of a byte may hold SDA low until it has clocked out
+ * the rest of it; up to nine SCL pulses finish any byte plus its acknowledge, and a STOP condition
+ * returns every slave to idle. The peripheral itself is reset with SWRST (clears a stuck BUSY
+ * flag, see the STM32F42x errata) and re-initialized with MX_I2C2_Init().
+ *
+ * Must be called from task context with no I2C2 transfer in progress that is still wanted.
+ *
+ * @retval 1 SDA is released (bus idle), 0 SDA is still held low by a slave
+ */
+uint8_t I2C2_BusRecover(void)
+{
+  GPIO_InitTypeDef GPIO_InitStruct = {0};
+  uint8_t released;
+
+  hi2c2.Instance->CR1 |= I2C_CR1_SWRST;
+  hi2c2.Instance->CR1 &= ~I2C_CR1_SWRST;
+  HAL_I2C_DeInit(&hi2c2);
+
+  /* Drive the pins as open-drain GPIOs (external pull-ups) */
+  HAL_GPIO_WritePin(GPIOF, OLED_SDA_Pin|OLED_SCL_Pin, GPIO_PIN_SET);
+  GPIO_InitStruct.Pin = OLED_SDA_Pin|OLED_SCL_Pin;
+  GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_OD;
+  GPIO_InitStruct.Pull = GPIO_NOPULL;
+  GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_LOW;
+  HAL_GPIO_Init(GPIOF, &GPIO_InitStruct);
+  Timing_DelayUs(I2C2_RECOVERY_HALF_PERIOD_US);
+
+  for (uint8_t i = 0; i < 9 && HAL_GPIO_ReadPin(OLED_SDA_GPIO_Port, OLED_SDA_Pin) == GPIO_PIN_RESET; i++)
+  {
+    HAL_GPIO_WritePin(OLED_SCL_GPIO_Port, OLED_SCL_Pin, GPIO_PIN_RESET);
+    Timing_DelayUs(I2C2_RECOVERY_HALF_PERIOD_US);
+    HAL_GPIO_WritePin(OLED_SCL_GPIO_Port, OLED_SCL_Pin, GPIO_PIN_SET);
+    Timing_DelayUs(I2C2_RECOVERY_HALF_PERIOD_US);
+  }
+
+  /* STOP: SDA rises while SCL is high */
+  HAL_GPIO_WritePin(OLED_SCL_GPIO_Port, OLED_SCL_Pin, GPIO_PIN_RESET);
+  Timing_DelayUs(I2C2_RECOVERY_HALF_PERIOD_US);
+  HAL_GPIO_WritePin(OLED_SDA_GPIO_Port, OLED_SDA_Pin, GPIO_PIN_RESET);
+  Timing_DelayUs(I2C2_RECOVERY_HALF_PERIOD_US);
+  HAL_GPIO_WritePin(OLED_SCL_GPIO_Port, OLED_SCL_Pin, GPIO_PIN_SET);
+  Timing_DelayUs(I2C2_RECOVERY_HALF_PERIOD_US);
+  HAL_GPIO_WritePin(OLED_SDA_GPIO_Port, OLED_SDA_Pin, GPIO_PIN_SET);
+  Timing_DelayUs(I2C2_RECOVERY_HALF_PERIOD_US);
+  released = (HAL_GPIO_ReadPin(OLED_SDA_GPIO_Port, OLED_SDA_Pin) == GPIO_PIN_SET) ? 1 : 0;
+
+  MX_I2C2_Init();
+  return released;
+}
 /* USER CODE END 1 */
@@ -19,6 +19,7 @@
 /* Includes ------------------------------------------------------------------*/
 #include "main.h"
 #include "cmsis_os.h"
+#include "dma.h"
 #include "i2c.h"
 #include "spi.h"
 #include "usart.h"
@@ -30,6 +31,10 @@
 #include "oled_driver.h"
 #include "oled_rtos_task.h"
 #include "rc522_rtos_task.h"
+#include "timing.h"
+#include "rtos_stats.h"
+#include "trace_recorder.h"
+#include "uart_log.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -94,11 +99,13 @@ int main(void)
 
   /* Initialize all configured peripherals */
   MX_GPIO_Init();
+  MX_DMA_Init();
   MX_SPI2_Init();
   MX_USART3_UART_Init();
   MX_I2C2_Init();
+  MX_SPI4_Init();
   /* USER CODE BEGIN 2 */
-  
+  Timing_Init();
   /* USER CODE END 2 */
 
   /* Init scheduler */
@@ -106,8 +113,13 @@ int main(void)
 
   /* Call init function for freertos objects (in cmsis_os2.c) */
   //MX_FREERTOS_Init();
+  UartLog_Init(&huart3);
   OLED_Task_Init();
   RC522_Task_Init();
+  RtosStats_Init();
+#if TRACE_RECORDER_ENABLE
+  Trace_Init();
+#endif
 
   /* Start scheduler */
   osKernelStart();
@@ -0,0 +1,155 @@
+
+/**
+ * @file    oled_dashboard.c
+ * @author  Ted Wang
+ * @date    2026-10-17
+ * @brief   Dashboard screen of the OLED display task (time, door state, access history, reader health).
+ *
+ * @details
+ * The clock is the time since boot (the board has no RTC configured). The door is shown unlocked for
+ * OLED_DASHBOARD_UNLOCK_MS after a granted card, with a bar counting down the remaining time.
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "oled_dashboard.h"
+#include "oled_icons.h"
+#include "fmt.h"
+#include <string.h>
+
+/**
+ * @brief Adds an access event at the top of the history list.
+ */
+static void OLED_Dashboard_AddEvent(OLED_Dashboard_t *dash, const char *text)
+{
+    memmove(dash->events[1], dash->events[0], sizeof(dash->events[0]) * (OLED_DASHBOARD_HISTORY - 1));
+    {
+        Fmt_t f;
+        Fmt_Init(&f, dash->events[0], sizeof(dash->events[0]));
+        Fmt_Str(&f, text);
+    }
+    if (dash->event_count < OLED_DASHBOARD_HISTORY)
+    {
+        dash->event_count++;
+    }
+    OLED_UiList_SetItems(&dash->history, dash->event_ptrs, dash->event_count);
+}
+
+/**
+ * @brief Creates the dashboard widgets; the first render draws the whole screen.
+ *
+ * @param dash Dashboard to initialize
+ * @param u8g2 Display object (full buffer mode)
+ */
+void OLED_Dashboard_Init(OLED_Dashboard_t *dash, u8g2_t *u8g2)
+{
+    memset(dash, 0, sizeof(*dash));
+    dash->last_status = RC522_STATUS_UNSUCCESSFUL;
+    for (uint8_t i = 0; i < OLED_DASHBOARD_HISTORY; i++)
+    {
+        dash->event_ptrs[i] = dash->events[i];
+    }
+
+    OLED_Ui_InitScreen(&dash->screen, u8g2);
+    OLED_UiLabel_Init(&dash->title, &dash->screen, 0, 0, 80, u8g2_font_6x10_tr, OLED_TEXT_ALIGN_LEFT);
+    OLED_UiLabel_Init(&dash->clock, &dash->screen, 80, 0, 48, u8g2_font_6x10_tr, OLED_TEXT_ALIGN_RIGHT);
+    OLED_UiIcon_Init(&dash->lock_icon, &dash->screen, 0, 12, &oled_img_lock_closed);
+    OLED_UiLabel_Init(&dash->door, &dash->screen, 20, 12, 108, u8g2_font_6x10_tr, OLED_TEXT_ALIGN_LEFT);
+    OLED_UiProgress_Init(&dash->unlock_bar, &dash->screen, 20, 23, 108, 5, OLED_DASHBOARD_UNLOCK_MS);
+    OLED_UiList_Init(&dash->history, &dash->screen, 0, 31, 128, 24, u8g2_font_5x7_tr, 8);
+    OLED_UiLabel_Init(&dash->health, &dash->screen, 0, 57, 128, u8g2_font_5x7_tr, OLED_TEXT_ALIGN_LEFT);
+
+    OLED_UiLabel_SetText(&dash->title, "Access Ctrl");
+    OLED_UiLabel_SetText(&dash->door, "LOCKED");
+    OLED_Ui_SetVisible(&dash->unlock_bar.base, 0);
+    OLED_UiLabel_SetText(&dash->health, "Reader: waiting");
+    OLED_Dashboard_Update(dash, NULL, 0);
+}
+
+/**
+ * @brief Updates the dashboard state.
+ *
+ * @param dash       Dashboard
+ * @param rc522_data New RC522 reading, or NULL if only the time advanced
+ * @param now_ms     Current time in milliseconds (e.g. kernel tick count)
+ */
+void OLED_Dashboard_Update(OLED_Dashboard_t *dash, const RC522_Data_t *rc522_data, uint32_t now_ms)
+{
+    char text[32];
+    uint32_t s = now_ms / 1000u;
+    Fmt_t f;
+
+    Fmt_Init(&f, text, sizeof(text));
+    Fmt_Uint(&f, (s / 3600u) % 100u, FMT_D2);
+    Fmt_Char(&f, ':');
+    Fmt_Uint(&f, (s / 60u) % 60u, FMT_D2);
+    Fmt_Char(&f, ':');
+    Fmt_Uint(&f, s % 60u, FMT_D2);
+    OLED_UiLabel_SetText(&dash->clock, text);
+
+    if (rc522_data != NULL)
+    {
+        dash->reads++;
+        dash->last_report_ms = now_ms;
+        if (rc522_data->status == RC522_STATUS_SUCCESS)
+        {
+            Fmt_Init(&f, text, sizeof(text));
+            Fmt_HexBytes(&f, rc522_data->uid, 4);
+            Fmt_Str(&f, " granted");
+            if (dash->last_status != RC522_STATUS_SUCCESS || dash->event_count == 0 || strcmp(text, dash->events[0]) != 0)
+            {
+                OLED_Dashboard_AddEvent(dash, text);
+            }
+            dash->unlock_until_ms = now_ms + OLED_DASHBOARD_UNLOCK_MS;
+        }
+        else if (dash->last_status == RC522_STATUS_SUCCESS)
+        {
+            OLED_Dashboard_AddEvent(dash, "-- no card --");
+        }
+        dash->last_status = rc522_data->status;
+    }
+
+    if (dash->unlock_until_ms != 0 && (int32_t)(dash->unlock_until_ms - now_ms) > 0)
+    {
+        OLED_UiIcon_SetImage(&dash->lock_icon, &oled_img_lock_open);
+        OLED_UiLabel_SetText(&dash->door, "UNLOCKED");
+        OLED_Ui_SetVisible(&dash->unlock_bar.base, 1);
+        OLED_UiProgress_SetValue(&dash->unlock_bar, (uint16_t)(dash->unlock_until_ms - now_ms));
+    }
+    else
+    {
+        dash->unlock_until_ms = 0;
+        OLED_UiIcon_SetImage(&dash->lock_icon, &oled_img_lock_closed);
+        OLED_UiLabel_SetText(&dash->door, "LOCKED");
+        OLED_Ui_SetVisible(&dash->unlock_bar.base, 0);
+    }
+
+    if (dash->reads != 0)
+    {
+        uint32_t age = now_ms - dash->last_report_ms;
+        if (age > OLED_DASHBOARD_READER_TIMEOUT_MS)
+        {
+            Fmt_Init(&f, text, sizeof(text));
+            Fmt_Str(&f, "Reader STALE ");
+            Fmt_Uint(&f, age / 1000u, FMT_D);
+            Fmt_Char(&f, 's');
+        }
+        else
+        {
+            Fmt_Init(&f, text, sizeof(text));
+            Fmt_Str(&f, "Reader OK  reads ");
+            Fmt_Uint(&f, dash->reads, FMT_D);
+        }
+        OLED_UiLabel_SetText(&dash->health, text);
+    }
+}
+
+/**
+ * @brief Sends the tiles changed since the last render.
+ *
+ * @param dash Dashboard
+ * @return Number of tiles sent
+ */
+uint16_t OLED_Dashboard_Render(OLED_Dashboard_t *dash)
+{
+    return OLED_Ui_Render(&dash->screen);
+}
@@ -15,8 +15,20 @@
 #include "rc522_rtos_task.h"
 #include "main.h"
 #include "oled_driver.h"
+#include "oled_status_screen.h"
+#include "oled_dashboard.h"
+#include "oled_log.h"
+#include "oled_mirror.h"
+#include "oled_idle.h"
+#include "timing.h"
+#include "fmt.h"
+#include "ccmram.h"
+#include "rtos_objects.h"
+#include "periodic.h"
+#include "uart_log.h"
+#include "FreeRTOS.h"
+#include "task.h"
 #include <string.h>
-#include <stdio.h>
 
 
 /**
@@ -24,52 +36,175 @@
  */
 static osThreadId_t oled_task_handle;
 
+/**
+ * @brief Control block and stack of the OLED task (static, CCM RAM).
+ */
+static StaticTask_t oled_task_cb CCM_RAM;
+static StackType_t oled_task_stack[OLED_TASK_STACK_SIZE_BYTES / sizeof(StackType_t)] CCM_RAM;
+
 /**
  * @brief Queue handle for RC522 info updates.
  */
 osMessageQueueId_t display_rc522_info_queue;
 
 /**
- * @brief UART3 handle for debug/error output (defined elsewhere).
+ * @brief Control block and message storage of the RC522 info queue (static, CCM RAM).
+ */
+static StaticQueue_t display_rc522_info_queue_cb CCM_RAM;
+static uint8_t display_rc522_info_queue_mem[RC522_QUEUE_SIZE * sizeof(RC522_Data_t)] CCM_RAM;
+
+/**
+ * @brief UART3 handle for the OLED mirror stream (defined elsewhere; text goes through uart_log.h).
  */
 extern UART_HandleTypeDef huart3;
 
+#if OLED_ACCESS_LOG_ENABLE && (OLED_BUFFER_MODE != OLED_BUFFER_MODE_FULL)
+#error "OLED_ACCESS_LOG_ENABLE requires OLED_BUFFER_MODE_FULL"
+#endif
+
+#if OLED_MIRROR_ENABLE && (OLED_BUFFER_MODE != OLED_BUFFER_MODE_FULL)
+#error "OLED_MIRROR_ENABLE requires OLED_BUFFER_MODE_FULL"
+#endif
+
+#if OLED_STATUS_TILETEXT_ENABLE && (OLED_BUFFER_MODE != OLED_BUFFER_MODE_FULL)
+#error "OLED_STATUS_TILETEXT_ENABLE requires OLED_BUFFER_MODE_FULL"
+#endif
+
+#if OLED_DASHBOARD_ENABLE && (OLED_BUFFER_MODE != OLED_BUFFER_MODE_FULL)
+#error "OLED_DASHBOARD_ENABLE requires OLED_BUFFER_MODE_FULL"
+#endif
+
+#if OLED_ANIMATION_ENABLE && (OLED_BUFFER_MODE != OLED_BUFFER_MODE_FULL)
+#error "OLED_ANIMATION_ENABLE requires OLED_BUFFER_MODE_FULL"
+#endif
+
+#if OLED_ANIMATION_ENABLE && OLED_STATUS_TILETEXT_ENABLE
+#error "OLED_ANIMATION_ENABLE and OLED_STATUS_TILETEXT_ENABLE are alternative status page renderers"
+#endif
+
 /**
  * @brief OLED RTOS display task function (thread entry point).
  * @param argument Unused (required by CMSIS-RTOS API)
  */
 static void OLED_Display_Task(void *argument);
 
+#if OLED_ACCESS_LOG_ENABLE
+/**
+ * @brief Access log display loop (used instead of the status page when OLED_ACCESS_LOG_ENABLE is 1).
+ * @param u8g2 Initialized display object
+ */
+static void OLED_Access_Log_Loop(u8g2_t *u8g2);
+#endif
+
+#if OLED_DASHBOARD_ENABLE
+/**
+ * @brief Dashboard display loop (used instead of the status page when OLED_DASHBOARD_ENABLE is 1).
+ * @param u8g2 Initialized display object
+ */
+static void OLED_Dashboard_Loop(u8g2_t *u8g2);
+#endif
+
+#if OLED_ANIMATION_ENABLE
+/**
+ * @brief Animated status page loop (used when OLED_ANIMATION_ENABLE is 1).
+ * @param u8g2 Initialized display object
+ */
+static void OLED_Animated_Status_Loop(u8g2_t *u8g2);
+#endif
+
+#if OLED_IDLE_ENABLE
+/**
+ * @brief Reports a wake from power save (latency against OLED_IDLE_WAKE_MAX_MS) on UART3.
+ * @param idle Idle manager of the inside panel
+ */
+static void OLED_Idle_Report(const OLED_Idle_t *idle);
+#endif
+
+#if OLED_OUTSIDE_DISPLAY_ENABLE
+/**
+ * @brief Outside panel (visitor side), sharing I2C2 with the inside panel.
+ *
+ * Stays in SRAM: its bus slots are read by DMA (the frame buffer is in CCM RAM, see oled_driver.c).
+ */
+static OLED_Display_t outside_display;
+
+/**
+ * @brief Outside panel render task handle, control block and stack (static, CCM RAM).
+ */
+static osThreadId_t oled_outside_task_handle;
+static StaticTask_t oled_outside_task_cb CCM_RAM;
+static StackType_t oled_outside_task_stack[OLED_OUTSIDE_TASK_STACK_SIZE_BYTES / sizeof(StackType_t)] CCM_RAM;
+
+/**
+ * @brief Latest RC522 reading for the outside panel (written by the OLED task, scheduler suspended).
+ */
+static RC522_Data_t outside_rc522_data;
+
+/**
+ * @brief Thread flag of the outside task: a new reading is in outside_rc522_data.
+ */
+#define OLED_OUTSIDE_FLAG_DATA       0x0001u
+
+/**
+ * @brief Outside panel render task function (thread entry point).
+ * @param argument Unused (required by CMSIS-RTOS API)
+ */
+static void OLED_Outside_Task(void *argument);
+
+/**
+ * @brief Hands a reading to the outside task; only the latest one is rendered.
+ * @param rc522_data Reading just taken from display_rc522_info_queue
+ */
+static void OLED_Outside_Post(const RC522_Data_t *rc522_data);
+
+/**
+ * @brief Prints the frame rate and late transfers of both panels every OLED_BUS_REPORT_MS.
+ */
+static void OLED_Bus_Report(void);
+#endif
+
 
 
 /**
  * @brief  Initialize the OLED display RTOS task and message queue.
  *
  * This function creates the message queue for rc522 info updates and starts the OLED display task.
+ * Both are created from static storage in CCM RAM through the RTOS object registry, so they take
+ * nothing from the FreeRTOS heap.
  * Call once during system initialization before the RTOS kernel starts.
  *
  * @note If queue or task creation fails, outputs error via UART3 and calls Error_Handler().
  */
 void OLED_Task_Init(void)
 {
-    display_rc522_info_queue = osMessageQueueNew(RC522_QUEUE_SIZE, sizeof(RC522_Data_t), NULL);
+    const osMessageQueueAttr_t queue_attributes = {
+        .name = "RC522_Info",
+        .cb_mem = &display_rc522_info_queue_cb,
+        .cb_size = sizeof(display_rc522_info_queue_cb),
+        .mq_mem = display_rc522_info_queue_mem,
+        .mq_size = sizeof(display_rc522_info_queue_mem)
+    };
+    display_rc522_info_queue = RtosObj_QueueNew(RC522_QUEUE_SIZE, sizeof(RC522_Data_t), &queue_attributes);
     if (display_rc522_info_queue == NULL)
     {
         char msg[] = "Failed to create display RC522 info queue\r\n";
-        HAL_UART_Transmit(&huart3, (uint8_t *)msg, strlen(msg), 100);
+        UartLog_WriteString(msg);
         Error_Handler();
     }
 
     const osThreadAttr_t oled_task_attributes = {
         .name = OLED_TASK_THREAD_NAME,
         .priority = OLED_TASK_THREAD_PRIORITY,
-        .stack_size = OLED_TASK_STACK_SIZE_BYTES
+        .cb_mem = &oled_task_cb,
+        .cb_size = sizeof(oled_task_cb),
+        .stack_mem = oled_task_stack,
+        .stack_size = sizeof(oled_task_stack)
     };
-    oled_task_handle = osThreadNew(OLED_Display_Task, NULL, &oled_task_attributes);
+    oled_task_handle = RtosObj_ThreadNew(OLED_Display_Task, NULL, &oled_task_attributes);
     if (oled_task_handle == NULL)
     {
         char msg[] = "Failed to create OLED display task\r\n";
-        HAL_UART_Transmit(&huart3, (uint8_t *)msg, strlen(msg), 100);
+        UartLog_WriteString(msg);
         Error_Handler();
     }
 }
@@ -82,55 +217,494 @@ void OLED_Task_Init(void)
  * This task continuously waits for RFID (RC522) data from the message queue and updates the OLED display
  * to show the current tag/card UID and access status. The corresponding status LED is also updated.
  *
- * The display layout:
- *   - Top line: Project name (defined by OLED_SHOW_PROJECT_NAME)
- *   - Middle line: Tag/Card UID or "Not Detected"
- *   - Bottom line: Status ("Success" or "Unsuccessful")
+ * The screen layout and drawing code live in oled_status_screen.c. The frame is produced with the
+ * u8g2 picture loop, so the same code works for every OLED_BUFFER_MODE. In page modes each page is
+ * sent (by DMA, see OLED_I2C_USE_DMA) while the next one is rendered. With
+ * OLED_STATUS_TILETEXT_ENABLE the labels are sent once and each reading sends only the changed
+ * characters of the UID and status word.
+ *
+ * With OLED_IDLE_ENABLE the queue wait is bounded by the idle manager's next step (contrast ramp,
+ * power save, pixel shift). While the panel sleeps readings only update the screen content; the
+ * next card event draws the frame and then switches the panel on.
  *
  * @param argument Unused. Required by CMSIS-RTOS API for thread entry signature.
  *
  * @note This function should not be called directly. It is intended to be used as the thread entry point
- *       for the OLED display task, created via osThreadNew().
+ *       for the OLED display task, created via RtosObj_ThreadNew().
  *
  * @retval None. This function contains an infinite loop and does not return.
  */
 static void OLED_Display_Task(void *argument)
 {
-    char rc522_display_str[32];
+    OLED_StatusScreen_t screen;
     RC522_Data_t rc522_data;
-    OLED_Init();
+#if OLED_STATUS_TILETEXT_ENABLE
+    static OLED_TileText_t status_tiles;
+#endif
+#if OLED_IDLE_ENABLE
+    static const OLED_IdleConfig_t idle_config = {
+        .dim_after_ms = OLED_IDLE_DIM_MS,
+        .ramp_ms = OLED_IDLE_RAMP_MS,
+        .sleep_after_ms = OLED_IDLE_SLEEP_MS,
+        .shift_period_ms = OLED_STATUS_TILETEXT_ENABLE ? 0 : OLED_IDLE_SHIFT_MS,
+        .wake_bound_ms = OLED_IDLE_WAKE_MAX_MS,
+        .contrast_full = OLED_IDLE_CONTRAST_FULL,
+        .contrast_dim = OLED_IDLE_CONTRAST_DIM
+    };
+    static OLED_Idle_t idle;
+    uint32_t idle_wait;
+    uint8_t last_status = RC522_STATUS_UNSUCCESSFUL;
+#endif
+    static const Periodic_Config_t frame_timing_config = {
+        .name = OLED_TASK_THREAD_NAME,
+        .period_ms = OLED_TASK_FRAME_PERIOD_MS,
+        .deadline_ms = OLED_TASK_FRAME_DEADLINE_MS,
+        .budget_us = OLED_TASK_FRAME_BUDGET_US,
+        .sporadic = 1,
+        .overrun = Periodic_LogOverrun
+    };
+    static Periodic_t frame_timing CCM_RAM;
+    uint8_t show = 1;
+    Timing_Stats_t init_stats;
+    uint32_t init_busy_us;
+    uint32_t init_start = Timing_GetCycles();
+    Timing_GetStats(&init_stats);
+    init_busy_us = init_stats.busy_us;
+    OLED_Status_t init_status = OLED_Init(OLED_TRANSPORT);
     u8g2_t *u8g2 = OLED_GetDisplay();
-    if (u8g2 == NULL)
+    if (init_status == OLED_STATUS_FAILED)
     {
         char msg[] = "Failed to initialize OLED display\r\n";
-        HAL_UART_Transmit(&huart3, (uint8_t *)msg, strlen(msg), 100);
+        UartLog_WriteString(msg);
         Error_Handler();
     }
+    if (init_status == OLED_STATUS_OFFLINE)
+    {
+        // Frames are dropped until the panel answers; OLED_RepairDisplay() probes and initializes it
+        char msg[] = "OLED display not answering, probing\r\n";
+        UartLog_WriteString(msg);
+    }
+    // Display reset/power-up delays sleep the task; report wall time against CPU busy-wait time
+    Timing_GetStats(&init_stats);
+    {
+        char init_msg[64];
+        Fmt_t f;
+        Fmt_Init(&f, init_msg, sizeof(init_msg));
+        Fmt_Str(&f, "OLED_Init: ");
+        Fmt_Uint(&f, Timing_CyclesToUs(Timing_GetCycles() - init_start), FMT_D);
+        Fmt_Str(&f, " us, busy-wait ");
+        Fmt_Uint(&f, init_stats.busy_us - init_busy_us, FMT_D);
+        Fmt_Str(&f, " us\r\n");
+        UartLog_Write(init_msg, f.len);
+    }
 
-    u8g2_ClearBuffer(u8g2);
+    // One full frame on the selected transport, until the last byte has left the bus
+    init_start = Timing_GetCycles();
     u8g2_ClearDisplay(u8g2);
-    u8g2_SendBuffer(u8g2);
+    OLED_WaitTransferComplete();
+    {
+        char frame_msg[80];
+        OLED_I2C_Stats_t frame_stats;
+        Fmt_t f;
+        Fmt_Init(&f, frame_msg, sizeof(frame_msg));
+        Fmt_Str(&f, OLED_TRANSPORT == OLED_TRANSPORT_SPI ? "OLED frame (SPI): " : "OLED frame (I2C): ");
+        Fmt_Uint(&f, Timing_CyclesToUs(Timing_GetCycles() - init_start), FMT_D);
+        Fmt_Str(&f, " us");
+        // The first frame goes through the same u8x8 transfers as every later one
+        OLED_Display_GetStats(OLED_GetInsideDisplay(), &frame_stats);
+        if (frame_stats.overflows != 0) {
+            Fmt_Str(&f, ", ");
+            Fmt_Uint(&f, frame_stats.overflows, FMT_D);
+            Fmt_Str(&f, " bytes over 32-byte transfers dropped");
+        }
+        Fmt_Str(&f, "\r\n");
+        UartLog_Write(frame_msg, f.len);
+    }
     u8g2_SetFont(u8g2, u8g2_font_ncenB08_tr);
+#if OLED_MIRROR_ENABLE
+    OLED_Mirror_Init(&huart3);
+#endif
+#if OLED_OUTSIDE_DISPLAY_ENABLE
+    init_status = OLED_Display_Init(&outside_display, OLED_OUTSIDE_ADDRESS, OLED_OUTSIDE_PRIORITY, OLED_OUTSIDE_LATENCY_MS);
+    if (init_status == OLED_STATUS_FAILED)
+    {
+        char msg[] = "Failed to initialize outside OLED display\r\n";
+        UartLog_WriteString(msg);
+        Error_Handler();
+    }
+    if (init_status == OLED_STATUS_OFFLINE)
+    {
+        char msg[] = "Outside OLED display not answering, probing\r\n";
+        UartLog_WriteString(msg);
+    }
+    u8g2_ClearDisplay(OLED_Display_GetU8g2(&outside_display));
+    u8g2_SetFont(OLED_Display_GetU8g2(&outside_display), u8g2_font_ncenB08_tr);
+    {
+        const osThreadAttr_t outside_task_attributes = {
+            .name = OLED_OUTSIDE_TASK_THREAD_NAME,
+            .priority = OLED_OUTSIDE_TASK_THREAD_PRIORITY,
+            .cb_mem = &oled_outside_task_cb,
+            .cb_size = sizeof(oled_outside_task_cb),
+            .stack_mem = oled_outside_task_stack,
+            .stack_size = sizeof(oled_outside_task_stack)
+        };
+        oled_outside_task_handle = RtosObj_ThreadNew(OLED_Outside_Task, NULL, &outside_task_attributes);
+        if (oled_outside_task_handle == NULL)
+        {
+            char msg[] = "Failed to create outside OLED task\r\n";
+            UartLog_WriteString(msg);
+            Error_Handler();
+        }
+    }
+#endif
+    // Every RTOS object exists now (tasks and queue from main, display mutex/semaphores from OLED_Init)
+    RtosObj_Report();
+
+#if OLED_ACCESS_LOG_ENABLE
+    OLED_Access_Log_Loop(u8g2);
+#endif
+#if OLED_DASHBOARD_ENABLE
+    OLED_Dashboard_Loop(u8g2);
+#endif
+#if OLED_ANIMATION_ENABLE
+    OLED_Animated_Status_Loop(u8g2);
+#endif
+#if OLED_STATUS_TILETEXT_ENABLE
+    OLED_StatusScreen_InitTiles(u8g2, &status_tiles);
+#endif
+    OLED_StatusScreen_Init(&screen);
+#if OLED_IDLE_ENABLE
+    OLED_Idle_Init(&idle, u8g2, &idle_config, osKernelGetTickCount());
+    idle_wait = OLED_Idle_Step(&idle, osKernelGetTickCount());
+#endif
+    Periodic_Init(&frame_timing, &frame_timing_config);
     
     while (1) {
 
-        // Block until new data arrives
-        osStatus_t rc522Receive = osMessageQueueGet(display_rc522_info_queue, &rc522_data, NULL, osWaitForever);
-        u8g2_ClearBuffer(u8g2);
-        if (rc522_data.status == RC522_STATUS_SUCCESS) {
-            snprintf(rc522_display_str, sizeof(rc522_display_str), "Tag/Card: %02X%02X%02X%02X", rc522_data.uid[0], rc522_data.uid[1], rc522_data.uid[2], rc522_data.uid[3]);
-            u8g2_DrawStr(u8g2, 0, 28, rc522_display_str);
-            u8g2_DrawStr(u8g2, 0, 46, "Status: Success");
-            HAL_GPIO_WritePin(LED_PB14_GPIO_Port, LED_PB14_Pin, GPIO_PIN_SET);
+#if OLED_IDLE_ENABLE
+        // Block until new data arrives or the next idle step (contrast, sleep, pixel shift) is due
+        if (osMessageQueueGet(display_rc522_info_queue, &rc522_data, NULL, (idle_wait == OLED_IDLE_FOREVER) ? osWaitForever : idle_wait) != osOK) {
+            idle_wait = OLED_Idle_Step(&idle, osKernelGetTickCount());
+            if (!idle.redraw) {
+                continue;
+            }
+            // The pixel shift moved: redraw the current content at the new position
+            idle.redraw = 0;
+            OLED_Idle_GetShift(&idle, &screen.shift_x, &screen.shift_y);
         } else {
-            u8g2_DrawStr(u8g2, 0, 28, "Tag/Card: Not Detected");
-            u8g2_DrawStr(u8g2, 0, 46, "Status: Unsuccessful");
-            HAL_GPIO_WritePin(LED_PB14_GPIO_Port, LED_PB14_Pin, GPIO_PIN_RESET);
+            // A card, or the card leaving, is activity; repeated "no card" readings are not
+            if (rc522_data.status == RC522_STATUS_SUCCESS || rc522_data.status != last_status) {
+                OLED_Idle_Activity(&idle, osKernelGetTickCount());
+            }
+            last_status = rc522_data.status;
+#if OLED_OUTSIDE_DISPLAY_ENABLE
+            OLED_Outside_Post(&rc522_data);
+#endif
+            OLED_StatusScreen_Update(&screen, &rc522_data);
+            HAL_GPIO_WritePin(LED_PB14_GPIO_Port, LED_PB14_Pin, (rc522_data.status == RC522_STATUS_SUCCESS) ? GPIO_PIN_SET : GPIO_PIN_RESET);
+        }
+        show = !OLED_Idle_IsAsleep(&idle);
+#else
+        // Block until new data arrives
+        osMessageQueueGet(display_rc522_info_queue, &rc522_data, NULL, osWaitForever);
+#if OLED_OUTSIDE_DISPLAY_ENABLE
+        OLED_Outside_Post(&rc522_data);
+#endif
+        OLED_StatusScreen_Update(&screen, &rc522_data);
+        HAL_GPIO_WritePin(LED_PB14_GPIO_Port, LED_PB14_Pin, (rc522_data.status == RC522_STATUS_SUCCESS) ? GPIO_PIN_SET : GPIO_PIN_RESET);
+#endif
+        if (show) {
+            Periodic_Release(&frame_timing);
+#if OLED_STATUS_TILETEXT_ENABLE
+            OLED_StatusScreen_RenderTiles(&status_tiles, &screen);
+#else
+            OLED_StatusScreen_Render(u8g2, &screen);
+#endif
+            // After an I2C fault: full buffer modes re-send the frame, page modes draw it again
+            if (OLED_RepairDisplay() && OLED_BUFFER_MODE != OLED_BUFFER_MODE_FULL) {
+                OLED_StatusScreen_Render(u8g2, &screen);
+            }
+#if OLED_IDLE_ENABLE
+            if (idle.waking) {
+                // Woken from power save: switch the panel on once the new frame is in its RAM
+                OLED_WaitTransferComplete();
+                OLED_Idle_FrameSent(&idle, osKernelGetTickCount());
+                OLED_Idle_Report(&idle);
+            }
+            idle_wait = OLED_Idle_Step(&idle, osKernelGetTickCount());
+#endif
+#if OLED_MIRROR_ENABLE
+            OLED_Mirror_Update(u8g2);
+#endif
         }
-        // Show project name at the top line
-        u8g2_DrawStr(u8g2, 0, 10, OLED_SHOW_PROJECT_NAME);
-        u8g2_SendBuffer(u8g2);
-        osDelay(100);
+        // At most one frame per OLED_TASK_FRAME_PERIOD_MS, measured from the start of this frame
+        Periodic_Wait(&frame_timing);
         
     }
 }
+
+#if OLED_ACCESS_LOG_ENABLE
+/**
+ * @brief Access log display loop.
+ *
+ * Appends one line per detected card, and one line whenever the reader goes back to "no card".
+ * All queued readings are written first and the panel is updated once per batch: the log scrolls
+ * with the SH1106 display start line and only the tiles of the changed characters are sent.
+ *
+ * @param u8g2 Initialized display object
+ *
+ * @retval None. This function contains an infinite loop and does not return.
+ */
+static void OLED_Access_Log_Loop(u8g2_t *u8g2)
+{
+    static OLED_Log_t access_log CCM_RAM;
+    char line[32];
+    RC522_Data_t rc522_data;
+    uint8_t last_status = RC522_STATUS_UNSUCCESSFUL;
+
+    OLED_Log_Init(&access_log, u8g2, u8g2_font_5x7_tf);
+    OLED_Log_WriteString(&access_log, OLED_SHOW_PROJECT_NAME "\n");
+    OLED_Log_Flush(&access_log);
+
+    while (1) {
+        osMessageQueueGet(display_rc522_info_queue, &rc522_data, NULL, osWaitForever);
+        do {
+#if OLED_OUTSIDE_DISPLAY_ENABLE
+            OLED_Outside_Post(&rc522_data);
+#endif
+            if (rc522_data.status == RC522_STATUS_SUCCESS) {
+                Fmt_t f;
+
+                Fmt_Init(&f, line, sizeof(line));
+                Fmt_HexBytes(&f, rc522_data.uid, 4);
+                Fmt_Str(&f, " granted\n");
+                OLED_Log_WriteString(&access_log, line);
+                HAL_GPIO_WritePin(LED_PB14_GPIO_Port, LED_PB14_Pin, GPIO_PIN_SET);
+            } else {
+                if (last_status == RC522_STATUS_SUCCESS) {
+                    OLED_Log_WriteString(&access_log, "-- no card --\n");
+                }
+                HAL_GPIO_WritePin(LED_PB14_GPIO_Port, LED_PB14_Pin, GPIO_PIN_RESET);
+            }
+            last_status = rc522_data.status;
+        } while (osMessageQueueGet(display_rc522_info_queue, &rc522_data, NULL, 0) == osOK);
+
+        OLED_Log_Flush(&access_log);
+        if (OLED_RepairDisplay()) {
+            // A re-initialized panel starts at line 0; restore the scroll position
+            u8x8_SetDisplayStartLine(u8g2_GetU8x8(u8g2), (uint8_t)(access_log.top_page * 8));
+        }
+    }
+}
+#endif
+
+#if OLED_DASHBOARD_ENABLE
+/**
+ * @brief Dashboard display loop.
+ *
+ * Waits for RC522 data with a timeout of OLED_DASHBOARD_TICK_MS so the clock and the unlock
+ * countdown keep running; each render sends only the tiles that changed.
+ *
+ * @param u8g2 Initialized display object
+ *
+ * @retval None. This function contains an infinite loop and does not return.
+ */
+static void OLED_Dashboard_Loop(u8g2_t *u8g2)
+{
+    static OLED_Dashboard_t dashboard CCM_RAM;
+    RC522_Data_t rc522_data;
+
+    OLED_Dashboard_Init(&dashboard, u8g2);
+
+    while (1) {
+        if (osMessageQueueGet(display_rc522_info_queue, &rc522_data, NULL, OLED_DASHBOARD_TICK_MS) == osOK) {
+#if OLED_OUTSIDE_DISPLAY_ENABLE
+            OLED_Outside_Post(&rc522_data);
+#endif
+            OLED_Dashboard_Update(&dashboard, &rc522_data, osKernelGetTickCount());
+            HAL_GPIO_WritePin(LED_PB14_GPIO_Port, LED_PB14_Pin, (rc522_data.status == RC522_STATUS_SUCCESS) ? GPIO_PIN_SET : GPIO_PIN_RESET);
+        } else {
+            OLED_Dashboard_Update(&dashboard, NULL, osKernelGetTickCount());
+        }
+        if (OLED_Dashboard_Render(&dashboard) != 0) {
+#if OLED_MIRROR_ENABLE
+            OLED_Mirror_Update(u8g2);
+#endif
+        }
+        OLED_RepairDisplay();
+    }
+}
+#endif
+
+#if OLED_ANIMATION_ENABLE
+/**
+ * @brief Back-pressure query of the animator: busy while display transfers are still queued.
+ */
+static uint8_t OLED_Anim_TransfersPending(void)
+{
+    return (uint8_t)(OLED_GetPendingTransfers() != 0);
+}
+
+/**
+ * @brief Animated status page loop.
+ *
+ * Waits for RC522 data no longer than the animator's next frame is due; each step sends only the
+ * tiles of the animations whose frame changed. Without an active animation the wait is unbounded,
+ * so an idle page costs no CPU time or I2C traffic.
+ *
+ * @param u8g2 Initialized display object
+ *
+ * @retval None. This function contains an infinite loop and does not return.
+ */
+static void OLED_Animated_Status_Loop(u8g2_t *u8g2)
+{
+    static OLED_StatusAnim_t status_anim;
+    OLED_StatusScreen_t screen;
+    RC522_Data_t rc522_data;
+    uint32_t wait = OLED_ANIM_IDLE;
+
+    OLED_StatusScreen_InitAnim(&status_anim, u8g2, OLED_Anim_TransfersPending);
+
+    while (1) {
+        if (osMessageQueueGet(display_rc522_info_queue, &rc522_data, NULL, (wait == OLED_ANIM_IDLE) ? osWaitForever : wait) == osOK) {
+#if OLED_OUTSIDE_DISPLAY_ENABLE
+            OLED_Outside_Post(&rc522_data);
+#endif
+            OLED_StatusScreen_Update(&screen, &rc522_data);
+            HAL_GPIO_WritePin(LED_PB14_GPIO_Port, LED_PB14_Pin, (rc522_data.status == RC522_STATUS_SUCCESS) ? GPIO_PIN_SET : GPIO_PIN_RESET);
+            OLED_StatusScreen_RenderAnimated(&status_anim, &screen, osKernelGetTickCount());
+#if OLED_MIRROR_ENABLE
+            OLED_Mirror_Update(u8g2);
+#endif
+        }
+        wait = OLED_Anim_Step(&status_anim.animator, osKernelGetTickCount());
+        OLED_RepairDisplay();
+    }
+}
+#endif
+
+#if OLED_IDLE_ENABLE
+/**
+ * @brief Reports a wake from power save on UART3.
+ *
+ * Prints the latency from the card event to the panel switching on with the new frame, the worst
+ * latency so far and the number of wakes above OLED_IDLE_WAKE_MAX_MS.
+ */
+static void OLED_Idle_Report(const OLED_Idle_t *idle)
+{
+    char msg[80];
+    Fmt_t f;
+
+    Fmt_Init(&f, msg, sizeof(msg));
+    Fmt_Str(&f, "OLED wake ");
+    Fmt_Uint(&f, idle->stats.wake_last_ms, FMT_D);
+    Fmt_Str(&f, " ms (max ");
+    Fmt_Uint(&f, idle->stats.wake_max_ms, FMT_D);
+    Fmt_Str(&f, ", over ");
+    Fmt_Uint(&f, OLED_IDLE_WAKE_MAX_MS, FMT_D);
+    Fmt_Str(&f, " ms: ");
+    Fmt_Uint(&f, idle->stats.wake_late, FMT_D);
+    Fmt_Char(&f, '/');
+    Fmt_Uint(&f, idle->stats.wakes, FMT_D);
+    Fmt_Str(&f, ")\r\n");
+    UartLog_Write(msg, f.len);
+}
+#endif
+
+#if OLED_OUTSIDE_DISPLAY_ENABLE
+/**
+ * @brief Render loop of the outside panel.
+ *
+ * Runs next to the OLED task, whichever screen that one shows: each reading posted by
+ * OLED_Outside_Post() is drawn on the outside status page while the inside frame of the same
+ * reading is still being rendered and sent, so both panels' bus queues fill at the same time and
+ * oled_bus.c interleaves their transfers. Readings that arrive during a frame are merged into the
+ * next one. The wait is bounded by OLED_BUS_REPORT_MS so the frame rate report also runs while
+ * no card is presented.
+ *
+ * @param argument Unused. Required by CMSIS-RTOS API for thread entry signature.
+ *
+ * @retval None. This function contains an infinite loop and does not return.
+ */
+static void OLED_Outside_Task(void *argument)
+{
+    u8g2_t *u8g2 = OLED_Display_GetU8g2(&outside_display);
+    OLED_StatusScreen_t screen;
+    RC522_Data_t rc522_data;
+    uint32_t flags;
+
+    OLED_StatusScreen_Init(&screen);
+
+    while (1) {
+        flags = osThreadFlagsWait(OLED_OUTSIDE_FLAG_DATA, osFlagsWaitAny, OLED_BUS_REPORT_MS);
+        if ((flags & osFlagsError) == 0) {
+            vTaskSuspendAll();
+            rc522_data = outside_rc522_data;
+            (void)xTaskResumeAll();
+            OLED_StatusScreen_Update(&screen, &rc522_data);
+            OLED_StatusScreen_Render(u8g2, &screen);
+            if (OLED_Display_Repair(&outside_display) && OLED_BUFFER_MODE != OLED_BUFFER_MODE_FULL) {
+                OLED_StatusScreen_Render(u8g2, &screen);
+            }
+        }
+        OLED_Bus_Report();
+    }
+}
+
+/**
+ * @brief Hands a reading to the outside task; only the latest one is rendered.
+ */
+static void OLED_Outside_Post(const RC522_Data_t *rc522_data)
+{
+    vTaskSuspendAll();
+    outside_rc522_data = *rc522_data;
+    (void)xTaskResumeAll();
+    (void)osThreadFlagsSet(oled_outside_task_handle, OLED_OUTSIDE_FLAG_DATA);
+}
+
+/**
+ * @brief Prints the frame rate and late transfers of both panels every OLED_BUS_REPORT_MS.
+ *
+ * Frame rates are complete frames per second over the report period, in tenths; a late transfer
+ * completed after its display's latency target (OLED_INSIDE_LATENCY_MS, OLED_OUTSIDE_LATENCY_MS).
+ * Called by the outside task only.
+ */
+static void OLED_Bus_Report(void)
+{
+    static OLED_DisplayLoad_t last_inside;
+    static OLED_DisplayLoad_t last_outside;
+    static uint32_t last_ms;
+    OLED_DisplayLoad_t inside;
+    OLED_DisplayLoad_t outside;
+    uint32_t now = osKernelGetTickCount();
+    uint32_t elapsed = now - last_ms;
+    uint32_t inside_fps10;
+    uint32_t outside_fps10;
+    char msg[96];
+    Fmt_t f;
+
+    if (elapsed < OLED_BUS_REPORT_MS) {
+        return;
+    }
+    OLED_Display_GetLoad(OLED_GetInsideDisplay(), &inside);
+    OLED_Display_GetLoad(&outside_display, &outside);
+    inside_fps10 = (inside.frames - last_inside.frames) * 10000u / elapsed;
+    outside_fps10 = (outside.frames - last_outside.frames) * 10000u / elapsed;
+    Fmt_Init(&f, msg, sizeof(msg));
+    Fmt_Str(&f, "OLED fps in ");
+    Fmt_Fixed(&f, (int32_t)inside_fps10, 1);
+    Fmt_Str(&f, " out ");
+    Fmt_Fixed(&f, (int32_t)outside_fps10, 1);
+    Fmt_Str(&f, ", late ");
+    Fmt_Uint(&f, inside.late - last_inside.late, FMT_D);
+    Fmt_Char(&f, '/');
+    Fmt_Uint(&f, outside.late - last_outside.late, FMT_D);
+    Fmt_Str(&f, ", switches ");
+    Fmt_Uint(&f, OLED_GetBusSwitches(), FMT_D);
+    Fmt_Str(&f, "\r\n");
+    UartLog_Write(msg, f.len);
+    last_inside = inside;
+    last_outside = outside;
+    last_ms = now;
+}
+#endif
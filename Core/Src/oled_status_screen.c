@@ -0,0 +1,205 @@
+
+/**
+ * @file    oled_status_screen.c
+ * @author  Ted Wang
+ * @date    2026-10-17
+ * @brief   Status screen of the OLED display task (project name, tag/card UID, access status).
+ *
+ * @details
+ * The display layout:
+ *   - Top line: Project name (defined by OLED_SHOW_PROJECT_NAME), centered
+ *   - Middle line: Tag/Card UID or "Not Detected"
+ *   - Bottom line: Status ("Success" or "Unsuccessful"), centered
+ *
+ * Centered strings go through OLED_Text_DrawAligned(), which caches their widths so each glyph
+ * is looked up only once per frame.
+ *
+ * The hybrid layout keeps the same lines, with the values in 8x8 tile text:
+ *   - Tile rows 0..3: project name and the "Tag/Card:" label (framebuffer)
+ *   - Tile row 4:     UID or "Not Detected", centered (tile text)
+ *   - Tile row 5:     "Status:" label (framebuffer)
+ *   - Tile row 6:     "Success" or "Unsuccessful", centered (tile text)
+ *
+ * The animated layout is the text layout plus the bottom band (rows 52..63): a spinner while no
+ * card is present, or the unlock countdown bar after a granted access. The status line slides in
+ * from the right when access is granted.
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "oled_status_screen.h"
+#include "oled_rtos_task.h"
+#include "oled_text.h"
+#include "fmt.h"
+#include <string.h>
+
+
+/**
+ * @brief Initializes the screen content ("Not Detected", no pixel shift).
+ *
+ * @param screen Screen content to initialize
+ */
+void OLED_StatusScreen_Init(OLED_StatusScreen_t *screen)
+{
+    RC522_Data_t none;
+
+    memset(&none, 0, sizeof(none));
+    none.status = RC522_STATUS_UNSUCCESSFUL;
+    OLED_StatusScreen_Update(screen, &none);
+    screen->shift_x = 0;
+    screen->shift_y = 0;
+}
+
+/**
+ * @brief Updates the screen content from the latest RC522 data.
+ *
+ * @param screen     Screen content to update
+ * @param rc522_data Latest RC522 reading
+ */
+void OLED_StatusScreen_Update(OLED_StatusScreen_t *screen, const RC522_Data_t *rc522_data)
+{
+    if (rc522_data->status == RC522_STATUS_SUCCESS) {
+        Fmt_t f;
+
+        Fmt_Init(&f, screen->uid_line, sizeof(screen->uid_line));
+        Fmt_Str(&f, OLED_STATUS_UID_PREFIX);
+        Fmt_HexBytes(&f, rc522_data->uid, 4);
+        screen->status_line = OLED_STATUS_STATUS_PREFIX "Success";
+        screen->granted = 1;
+    } else {
+        strcpy(screen->uid_line, OLED_STATUS_UID_PREFIX "Not Detected");
+        screen->status_line = OLED_STATUS_STATUS_PREFIX "Unsuccessful";
+        screen->granted = 0;
+    }
+    screen->uid_text = screen->uid_line + sizeof(OLED_STATUS_UID_PREFIX) - 1;
+    screen->status_text = screen->status_line + sizeof(OLED_STATUS_STATUS_PREFIX) - 1;
+}
+
+/**
+ * @brief Draws the status screen into the current u8g2 buffer (one page or the full frame).
+ *
+ * @param u8g2   Display object
+ * @param screen Retained screen content
+ */
+void OLED_StatusScreen_Draw(u8g2_t *u8g2, const OLED_StatusScreen_t *screen)
+{
+    u8g2_uint_t w = u8g2_GetDisplayWidth(u8g2);
+    u8g2_uint_t x = screen->shift_x;
+    u8g2_uint_t y = screen->shift_y;
+
+    u8g2_SetFont(u8g2, u8g2_font_ncenB08_tr);
+    // Show project name at the top line
+    OLED_Text_DrawAligned(u8g2, x, 10 + y, w, OLED_SHOW_PROJECT_NAME, OLED_TEXT_ALIGN_CENTER);
+    u8g2_DrawStr(u8g2, x, 28 + y, screen->uid_line);
+    OLED_Text_DrawAligned(u8g2, x, 46 + y, w, screen->status_line, OLED_TEXT_ALIGN_CENTER);
+}
+
+/**
+ * @brief Renders and sends the complete status screen (u8g2 picture loop).
+ *
+ * In page modes the screen is drawn once per page; see OLED_BUFFER_MODE in oled_driver.h.
+ *
+ * @param u8g2   Display object
+ * @param screen Retained screen content
+ */
+void OLED_StatusScreen_Render(u8g2_t *u8g2, const OLED_StatusScreen_t *screen)
+{
+    u8g2_FirstPage(u8g2);
+    do {
+        OLED_StatusScreen_Draw(u8g2, screen);
+    } while (u8g2_NextPage(u8g2));
+}
+
+/**
+ * @brief Sets up the hybrid renderer: draws and sends the static labels (full buffer mode only).
+ *
+ * The framebuffer rows are sent once here; afterwards only tile text cells are sent.
+ *
+ * @param u8g2  Display object
+ * @param tiles Tile text state to initialize (owns the UID and status rows)
+ */
+void OLED_StatusScreen_InitTiles(u8g2_t *u8g2, OLED_TileText_t *tiles)
+{
+    u8g2_uint_t w = u8g2_GetDisplayWidth(u8g2);
+
+    OLED_TileText_Init(tiles, u8g2, u8x8_font_chroma48medium8_r,
+                       (uint8_t)((1u << OLED_STATUS_TILE_UID_ROW) | (1u << OLED_STATUS_TILE_STATUS_ROW)));
+    u8g2_ClearBuffer(u8g2);
+    u8g2_SetFont(u8g2, u8g2_font_ncenB08_tr);
+    OLED_Text_DrawAligned(u8g2, 0, 10, w, OLED_SHOW_PROJECT_NAME, OLED_TEXT_ALIGN_CENTER);
+    u8g2_DrawStr(u8g2, 0, 28, OLED_STATUS_UID_PREFIX);
+    u8g2_DrawStr(u8g2, 0, 47, OLED_STATUS_STATUS_PREFIX);
+    OLED_TileText_SendBuffer(tiles);
+}
+
+/**
+ * @brief Sends the changed characters of the UID and status word (hybrid renderer).
+ *
+ * @param tiles  Tile text state set up by OLED_StatusScreen_InitTiles()
+ * @param screen Retained screen content
+ * @return Number of character tiles sent
+ */
+uint8_t OLED_StatusScreen_RenderTiles(OLED_TileText_t *tiles, const OLED_StatusScreen_t *screen)
+{
+    uint8_t cols = u8g2_GetBufferTileWidth(tiles->u8g2);
+    uint8_t sent;
+
+    sent = OLED_TileText_Print(tiles, 0, OLED_STATUS_TILE_UID_ROW, cols, screen->uid_text, OLED_TEXT_ALIGN_CENTER);
+    sent = (uint8_t)(sent + OLED_TileText_Print(tiles, 0, OLED_STATUS_TILE_STATUS_ROW, cols, screen->status_text, OLED_TEXT_ALIGN_CENTER));
+    return sent;
+}
+
+/**
+ * @brief Sets up the animated renderer (full buffer mode only); no animation is active yet.
+ *
+ * @param anim Animated renderer state to initialize
+ * @param u8g2 Display object
+ * @param busy Back-pressure query passed to OLED_Anim_InitAnimator(), or NULL
+ */
+void OLED_StatusScreen_InitAnim(OLED_StatusAnim_t *anim, u8g2_t *u8g2, uint8_t (*busy)(void))
+{
+    OLED_Anim_InitAnimator(&anim->animator, u8g2, busy);
+    OLED_Anim_InitSpinner(&anim->spinner, 64, 57, 4, OLED_STATUS_SPINNER_STEP_MS);
+    OLED_Anim_InitSlide(&anim->slide, u8g2, u8g2_font_ncenB08_tr, 46, OLED_ANIMATION_DELAY_MS, OLED_STATUS_SLIDE_MS);
+    OLED_Anim_InitProgress(&anim->unlock, 14, 54, 100, 6, 1, OLED_ANIMATION_DELAY_MS, OLED_STATUS_GRANT_MS);
+    anim->granted = 0;
+}
+
+/**
+ * @brief Starts the animations for a new reading and sends the complete screen.
+ *
+ * The animations only change with the decision: a repeated reading of the same state keeps the
+ * running ones on their timeline. The full frame is drawn first, then the current animation
+ * frames are composed on top, so the static status line never flashes before its slide-in.
+ *
+ * @param anim   Animated renderer state
+ * @param screen Retained screen content (already updated)
+ * @param now_ms Current time on the animation timeline
+ */
+void OLED_StatusScreen_RenderAnimated(OLED_StatusAnim_t *anim, const OLED_StatusScreen_t *screen, uint32_t now_ms)
+{
+    u8g2_t *u8g2 = anim->animator.u8g2;
+
+    if (screen->granted && !anim->granted) {
+        u8g2_uint_t w = u8g2_GetDisplayWidth(u8g2);
+
+        OLED_Anim_Stop(&anim->animator, &anim->spinner.base);
+        u8g2_SetFont(u8g2, u8g2_font_ncenB08_tr);
+        /* Same end position as the centered line of OLED_StatusScreen_Draw() */
+        OLED_Anim_SetSlideText(&anim->slide, screen->status_line, (int16_t)w,
+                               (int16_t)((w - OLED_Text_GetWidth(u8g2, screen->status_line)) / 2));
+        OLED_Anim_Start(&anim->animator, &anim->slide.base, now_ms);
+        OLED_Anim_Start(&anim->animator, &anim->unlock.base, now_ms);
+    } else if (!screen->granted) {
+        OLED_Anim_Stop(&anim->animator, &anim->slide.base);
+        OLED_Anim_Stop(&anim->animator, &anim->unlock.base);
+        if (!anim->spinner.base.active) {
+            OLED_Anim_Start(&anim->animator, &anim->spinner.base, now_ms);
+        }
+    }
+    anim->granted = screen->granted;
+
+    u8g2_ClearBuffer(u8g2);
+    OLED_StatusScreen_Draw(u8g2, screen);
+    OLED_Anim_Compose(&anim->animator, now_ms);
+    u8g2_SendBuffer(u8g2);
+}
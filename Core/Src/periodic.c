@@ -0,0 +1,310 @@
+/**
+ * @file    periodic.c
+ * @author  Ted Wang
+ * @date    2026-10-17
+ * @brief   Drift-free periodic task framework with deadline, budget and jitter monitoring.
+ *
+ * @details
+ * Release times are kernel ticks on the grid release + n * period and the task sleeps with
+ * osDelayUntil() (vTaskDelayUntil()), which returns at once when the release has already passed.
+ * Execution times and jitter are measured with the DWT cycle counter. All state of a task is
+ * written by the task itself; Periodic_GetStats() and the report copy it with the scheduler
+ * suspended.
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "periodic.h"
+#include "timing.h"
+#include "fmt.h"
+#include "uart_log.h"
+#include "cmsis_os2.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include <string.h>
+
+/* Private variables ---------------------------------------------------------*/
+/**
+ * @brief Registered tasks (for the report).
+ */
+static Periodic_t *periodic_tasks[PERIODIC_MAX_TASKS];
+static uint32_t periodic_task_count;
+
+/* Private functions ---------------------------------------------------------*/
+/**
+ * @brief Returns the effective relative deadline of a task.
+ */
+static uint32_t Periodic_Deadline(const Periodic_Config_t *config)
+{
+    return (config->deadline_ms != 0) ? config->deadline_ms : config->period_ms;
+}
+
+/**
+ * @brief Ends the current job: updates the counters and returns the overrun events.
+ */
+static uint32_t Periodic_EndJob(Periodic_t *task, Periodic_Overrun_t *overrun)
+{
+    const Periodic_Config_t *config = task->config;
+    uint32_t end_cycles = Timing_GetCycles();
+    uint32_t events = 0;
+
+    overrun->response_ms = osKernelGetTickCount() - task->release;
+    overrun->exec_us = Timing_CyclesToUs(end_cycles - task->start_cycles);
+    task->active = 0;
+    task->stats.jobs++;
+    if (overrun->response_ms > task->stats.response_max_ms)
+    {
+        task->stats.response_max_ms = overrun->response_ms;
+    }
+    if (overrun->exec_us > task->stats.exec_max_us)
+    {
+        task->stats.exec_max_us = overrun->exec_us;
+    }
+    // Whole ticks: a response of exactly the deadline meets it
+    if (overrun->response_ms > overrun->deadline_ms)
+    {
+        task->stats.deadline_misses++;
+        events |= PERIODIC_EVENT_DEADLINE;
+    }
+    if (config->budget_us != 0 && overrun->exec_us > config->budget_us)
+    {
+        task->stats.budget_overruns++;
+        events |= PERIODIC_EVENT_BUDGET;
+    }
+    return events;
+}
+
+/**
+ * @brief Starts the job of a periodic task released at the given tick.
+ *
+ * The jitter is only taken between two jobs that were both woken up at their release; a job
+ * that starts late because its predecessor overran shows up as a deadline miss instead. Tasks
+ * whose period does not fit the 32-bit cycle counter (task->jitter == 0) are skipped.
+ */
+static void Periodic_StartJob(Periodic_t *task, uint32_t release, uint8_t on_time)
+{
+    uint32_t start_cycles = Timing_GetCycles();
+
+    if (task->jitter && task->prev_valid && on_time)
+    {
+        uint32_t period_cycles = task->config->period_ms * (SystemCoreClock / 1000u);
+        int32_t deviation = (int32_t)(start_cycles - task->start_cycles - period_cycles);
+        uint32_t jitter_us = Timing_CyclesToUs((uint32_t)((deviation < 0) ? -deviation : deviation));
+
+        if (jitter_us > task->stats.jitter_max_us)
+        {
+            task->stats.jitter_max_us = jitter_us;
+        }
+    }
+    task->release = release;
+    task->start_cycles = start_cycles;
+    task->active = 1;
+    task->prev_valid = on_time;
+}
+
+/**
+ * @brief Sends a formatted line.
+ */
+static void Periodic_Send(const Fmt_t *f)
+{
+    UartLog_Write(f->buf, f->len);
+}
+
+/* Exported functions --------------------------------------------------------*/
+/**
+ * @brief Registers a task and, unless it is sporadic, releases its first job now.
+ *
+ * The first job starts off the tick grid, so it is not used for the jitter. The jitter is only
+ * measured for periods below 2^32 DWT cycles, i.e. 2^32 / SystemCoreClock seconds (about 25.6 s
+ * at 168 MHz).
+ */
+void Periodic_Init(Periodic_t *task, const Periodic_Config_t *config)
+{
+    Timing_Init();
+    memset(task, 0, sizeof(*task));
+    task->config = config;
+    task->release = osKernelGetTickCount();
+    task->start_cycles = Timing_GetCycles();
+    task->active = config->sporadic ? 0 : 1;
+    task->jitter = (!config->sporadic && config->period_ms < UINT32_MAX / (SystemCoreClock / 1000u)) ? 1 : 0;
+
+    vTaskSuspendAll();
+    if (periodic_task_count < PERIODIC_MAX_TASKS)
+    {
+        periodic_tasks[periodic_task_count++] = task;
+    }
+    (void)xTaskResumeAll();
+}
+
+/**
+ * @brief Releases a job of a sporadic task now (e.g. after the triggering message arrived).
+ */
+void Periodic_Release(Periodic_t *task)
+{
+    task->release = osKernelGetTickCount();
+    task->start_cycles = Timing_GetCycles();
+    task->active = 1;
+}
+
+/**
+ * @brief Ends the current job, checks it, and sleeps until the next release.
+ *
+ * A periodic job that ran past later releases continues with the latest of them at once; the
+ * releases before it are skipped, so the grid (and the phase of the task) stays the same.
+ */
+void Periodic_Wait(Periodic_t *task)
+{
+    const Periodic_Config_t *config = task->config;
+    Periodic_Overrun_t overrun;
+    uint32_t next = task->release + config->period_ms;
+    uint8_t on_time;
+    int32_t late;
+
+    memset(&overrun, 0, sizeof(overrun));
+    overrun.name = config->name;
+    overrun.deadline_ms = Periodic_Deadline(config);
+    overrun.budget_us = config->budget_us;
+    if (task->active)
+    {
+        overrun.events = Periodic_EndJob(task, &overrun);
+    }
+
+    late = (int32_t)(osKernelGetTickCount() - next);
+    if (!config->sporadic && late >= (int32_t)config->period_ms)
+    {
+        overrun.skipped = (uint32_t)late / config->period_ms;
+        next += overrun.skipped * config->period_ms;
+        task->stats.skipped += overrun.skipped;
+        overrun.events |= PERIODIC_EVENT_SKIPPED;
+    }
+    if (overrun.events != 0 && config->overrun != NULL)
+    {
+        config->overrun(&overrun);
+    }
+
+    // Returns at once (osErrorParameter) if the release has already passed
+    on_time = ((int32_t)(next - osKernelGetTickCount()) > 0) ? 1 : 0;
+    (void)osDelayUntil(next);
+    if (!config->sporadic)
+    {
+        Periodic_StartJob(task, next, on_time);
+    }
+}
+
+/**
+ * @brief Copies the counters of a task (any task context).
+ */
+void Periodic_GetStats(const Periodic_t *task, Periodic_Stats_t *stats)
+{
+    vTaskSuspendAll();
+    memcpy(stats, &task->stats, sizeof(*stats));
+    (void)xTaskResumeAll();
+}
+
+/**
+ * @brief Ready-made overrun hook: prints one line per overrun on UART3.
+ *
+ * Output:
+ * @code
+ *   Overrun RC522_Task: deadline (612/500 ms) budget (120034/100000 us) skipped 0
+ * @endcode
+ */
+void Periodic_LogOverrun(const Periodic_Overrun_t *overrun)
+{
+    char line[96];
+    Fmt_t f;
+
+    Fmt_Init(&f, line, sizeof(line));
+    Fmt_Str(&f, "Overrun ");
+    Fmt_Str(&f, overrun->name);
+    Fmt_Str(&f, ":");
+    if (overrun->events & PERIODIC_EVENT_DEADLINE)
+    {
+        Fmt_Str(&f, " deadline (");
+        Fmt_Uint(&f, overrun->response_ms, FMT_D);
+        Fmt_Char(&f, '/');
+        Fmt_Uint(&f, overrun->deadline_ms, FMT_D);
+        Fmt_Str(&f, " ms)");
+    }
+    if (overrun->events & PERIODIC_EVENT_BUDGET)
+    {
+        Fmt_Str(&f, " budget (");
+        Fmt_Uint(&f, overrun->exec_us, FMT_D);
+        Fmt_Char(&f, '/');
+        Fmt_Uint(&f, overrun->budget_us, FMT_D);
+        Fmt_Str(&f, " us)");
+    }
+    Fmt_Str(&f, " skipped ");
+    Fmt_Uint(&f, overrun->skipped, FMT_D);
+    Fmt_Str(&f, "\r\n");
+    Periodic_Send(&f);
+}
+
+/**
+ * @brief Prints the declared timing and counters of all registered tasks on UART3 (uart_log.h).
+ *
+ * Output (period, deadline and response in ms; budget, execution time and jitter in us):
+ * @code
+ *   Periodic tasks: 2
+ *     task             period    dl  budget    jobs miss over skip  resp    exec  jitter
+ *     RC522_Task         2000   500  100000     117    0    0    0    36   35817      14
+ *     OLED_Task           100   100   50000     117    0    0    0    21   20644       -
+ * @endcode
+ * Sporadic tasks show their minimum separation as the period; they and periods too long for the
+ * cycle counter show no jitter ("-").
+ */
+void Periodic_Report(void)
+{
+    char line[96];
+    Fmt_t f;
+
+    Fmt_Init(&f, line, sizeof(line));
+    Fmt_Str(&f, "Periodic tasks: ");
+    Fmt_Uint(&f, periodic_task_count, FMT_D);
+    Fmt_Str(&f, "\r\n");
+    Periodic_Send(&f);
+    if (periodic_task_count == 0)
+    {
+        return;
+    }
+
+    Fmt_Init(&f, line, sizeof(line));
+    Fmt_Str(&f, "  task             period    dl  budget    jobs miss over skip  resp    exec  jitter\r\n");
+    Periodic_Send(&f);
+
+    for (uint32_t i = 0; i < periodic_task_count; i++)
+    {
+        const Periodic_t *task = periodic_tasks[i];
+        const Periodic_Config_t *config = task->config;
+        Periodic_Stats_t stats;
+        uint32_t start;
+
+        Periodic_GetStats(task, &stats);
+        Fmt_Init(&f, line, sizeof(line));
+        Fmt_Str(&f, "  ");
+        start = f.len;
+        Fmt_Str(&f, config->name);
+        while (f.len < start + configMAX_TASK_NAME_LEN && !f.truncated)
+        {
+            Fmt_Char(&f, ' ');
+        }
+        Fmt_Uint(&f, config->period_ms, FMT_WIDTH(7));
+        Fmt_Uint(&f, Periodic_Deadline(config), FMT_WIDTH(6));
+        Fmt_Uint(&f, config->budget_us, FMT_WIDTH(8));
+        Fmt_Uint(&f, stats.jobs, FMT_WIDTH(8));
+        Fmt_Uint(&f, stats.deadline_misses, FMT_WIDTH(5));
+        Fmt_Uint(&f, stats.budget_overruns, FMT_WIDTH(5));
+        Fmt_Uint(&f, stats.skipped, FMT_WIDTH(5));
+        Fmt_Uint(&f, stats.response_max_ms, FMT_WIDTH(6));
+        Fmt_Uint(&f, stats.exec_max_us, FMT_WIDTH(8));
+        if (task->jitter)
+        {
+            Fmt_Uint(&f, stats.jitter_max_us, FMT_WIDTH(8));
+        }
+        else
+        {
+            Fmt_Str(&f, "       -");
+        }
+        Fmt_Str(&f, "\r\n");
+        Periodic_Send(&f);
+    }
+}
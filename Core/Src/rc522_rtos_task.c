@@ -16,8 +16,14 @@
 #include "rc522.h"
 #include "main.h"
 #include "oled_driver.h"
+#include "timing.h"
+#include "fmt.h"
+#include "ccmram.h"
+#include "rtos_objects.h"
+#include "periodic.h"
+#include "uart_log.h"
+#include "FreeRTOS.h"
 #include <string.h>
-#include <stdio.h>
 
 
 /**
@@ -31,9 +37,10 @@ RC522_Data_t g_rc522_data;
 static osThreadId_t rc522_task_handle;
 
 /**
- * @brief UART3 handle for debug/error output (defined elsewhere).
+ * @brief Control block and stack of the RC522 task (static, CCM RAM).
  */
-extern UART_HandleTypeDef huart3;
+static StaticTask_t rc522_task_cb CCM_RAM;
+static StackType_t rc522_task_stack[RC522_TASK_STACK_SIZE_BYTES / sizeof(StackType_t)] CCM_RAM;
 
 /**
  * @brief RC522 RTOS task main loop (thread entry point).
@@ -46,7 +53,9 @@ static void RC522_Task(void *argument);
 /**
  * @brief  Initialize the RC522 RTOS task.
  *
- * This function creates the RC522 acquisition task. Call once during system initialization before the RTOS kernel starts.
+ * This function creates the RC522 acquisition task with its control block and stack in CCM RAM,
+ * through the RTOS object registry.
+ * Call once during system initialization before the RTOS kernel starts.
  *
  * @note If task creation fails, outputs error via UART3 and calls Error_Handler().
  */
@@ -55,13 +64,16 @@ void RC522_Task_Init(void)
     const osThreadAttr_t rc522_task_attributes = {
         .name = RC522_TASK_THREAD_NAME,
         .priority = RC522_TASK_THREAD_PRIORITY,
-        .stack_size = RC522_TASK_STACK_SIZE_BYTES
+        .cb_mem = &rc522_task_cb,
+        .cb_size = sizeof(rc522_task_cb),
+        .stack_mem = rc522_task_stack,
+        .stack_size = sizeof(rc522_task_stack)
     };
-    rc522_task_handle = osThreadNew(RC522_Task, NULL, &rc522_task_attributes);
+    rc522_task_handle = RtosObj_ThreadNew(RC522_Task, NULL, &rc522_task_attributes);
     if (rc522_task_handle == NULL)
     {
         char msg[] = "Failed to create RC522 task\r\n";
-        HAL_UART_Transmit(&huart3, (uint8_t *)msg, strlen(msg), 100);
+        UartLog_WriteString(msg);
         Error_Handler();
     }
 }
@@ -84,13 +96,41 @@ void RC522_Task_Init(void)
  *   - Populates RC522_Data_t structure with status, UID, and tag type.
  *   - Sends debug output via UART3.
  *   - Posts result to display_rc522_info_queue for UI/display.
- *   - Waits 3 seconds before next cycle.
+ *   - Waits for the next release every RC522_TASK_PERIOD_MS (Periodic_Wait(), no drift), counting
+ *     deadline misses and budget overruns.
  */
 static void RC522_Task(void *argument)
 {
-    // Initialize the RC522 hardware before entering the main loop
+    static const Periodic_Config_t rc522_timing_config = {
+        .name = RC522_TASK_THREAD_NAME,
+        .period_ms = RC522_TASK_PERIOD_MS,
+        .deadline_ms = RC522_TASK_DEADLINE_MS,
+        .budget_us = RC522_TASK_BUDGET_US,
+        .overrun = Periodic_LogOverrun
+    };
+    static Periodic_t rc522_timing CCM_RAM;
+
+    // Initialize the RC522 hardware before entering the main loop; report wall and busy-wait time
+    Timing_Stats_t init_stats;
+    uint32_t init_busy_us;
+    uint32_t init_start = Timing_GetCycles();
+    Timing_GetStats(&init_stats);
+    init_busy_us = init_stats.busy_us;
     MFRC522_Init();
+    Timing_GetStats(&init_stats);
+    {
+        char init_msg[64];
+        Fmt_t f;
+        Fmt_Init(&f, init_msg, sizeof(init_msg));
+        Fmt_Str(&f, "MFRC522_Init: ");
+        Fmt_Uint(&f, Timing_CyclesToUs(Timing_GetCycles() - init_start), FMT_D);
+        Fmt_Str(&f, " us, busy-wait ");
+        Fmt_Uint(&f, init_stats.busy_us - init_busy_us, FMT_D);
+        Fmt_Str(&f, " us\r\n");
+        UartLog_Write(init_msg, f.len);
+    }
 
+    Periodic_Init(&rc522_timing, &rc522_timing_config);
     while (1)
     {
         // Prepare a structure to hold the latest card/tag data
@@ -103,8 +143,14 @@ static void RC522_Task(void *argument)
 
         // Output request result via UART for debugging
         char debug_msg[128];
-        snprintf(debug_msg, sizeof(debug_msg), "MFRC522_Request status: %d, tagType: %02X%02X\r\n", status, tagType[0], tagType[1]);
-        HAL_UART_Transmit(&huart3, (uint8_t *)debug_msg, strlen(debug_msg), 100);
+        Fmt_t f;
+        Fmt_Init(&f, debug_msg, sizeof(debug_msg));
+        Fmt_Str(&f, "MFRC522_Request status: ");
+        Fmt_Uint(&f, status, FMT_D);
+        Fmt_Str(&f, ", tagType: ");
+        Fmt_HexBytes(&f, tagType, 2);
+        Fmt_Str(&f, "\r\n");
+        UartLog_Write(debug_msg, f.len);
 
         // Perform anti-collision to read UID
         uint8_t anticoll_status = MFRC522_Anticoll(rc522_data.uid);
@@ -114,28 +160,41 @@ static void RC522_Task(void *argument)
         rc522_data.tagType[1] = tagType[1];
 
         // Output anti-collision result and UID via UART
-        snprintf(debug_msg, sizeof(debug_msg), "MFRC522_Anticoll status: %d, UID: %02X%02X%02X%02X, UID_len: %d\r\n", anticoll_status, rc522_data.uid[0], rc522_data.uid[1], rc522_data.uid[2], rc522_data.uid[3], rc522_data.uid_length);
-        HAL_UART_Transmit(&huart3, (uint8_t *)debug_msg, strlen(debug_msg), 100);
+        Fmt_Init(&f, debug_msg, sizeof(debug_msg));
+        Fmt_Str(&f, "MFRC522_Anticoll status: ");
+        Fmt_Uint(&f, anticoll_status, FMT_D);
+        Fmt_Str(&f, ", UID: ");
+        Fmt_HexBytes(&f, rc522_data.uid, 4);
+        Fmt_Str(&f, ", UID_len: ");
+        Fmt_Uint(&f, rc522_data.uid_length, FMT_D);
+        Fmt_Str(&f, "\r\n");
+        UartLog_Write(debug_msg, f.len);
 
         // If both request and anti-collision succeed, report card/tag detected
         if (status == MI_OK && anticoll_status == MI_OK)
         {
             rc522_data.status = RC522_STATUS_SUCCESS;
-            snprintf(debug_msg, sizeof(debug_msg), "Card/Tag detected! UID: %02X%02X%02X%02X, tagType: %02X%02X\r\n", rc522_data.uid[0], rc522_data.uid[1], rc522_data.uid[2], rc522_data.uid[3], rc522_data.tagType[0], rc522_data.tagType[1]);
-            HAL_UART_Transmit(&huart3, (uint8_t *)debug_msg, strlen(debug_msg), 100);
+            Fmt_Init(&f, debug_msg, sizeof(debug_msg));
+            Fmt_Str(&f, "Card/Tag detected! UID: ");
+            Fmt_HexBytes(&f, rc522_data.uid, 4);
+            Fmt_Str(&f, ", tagType: ");
+            Fmt_HexBytes(&f, rc522_data.tagType, 2);
+            Fmt_Str(&f, "\r\n");
+            UartLog_Write(debug_msg, f.len);
         }
         else
         {
             rc522_data.status = RC522_STATUS_UNSUCCESSFUL;
             rc522_data.uid_length = 0;
-            snprintf(debug_msg, sizeof(debug_msg), "No valid card/tag or UID not found\r\n");
-            HAL_UART_Transmit(&huart3, (uint8_t *)debug_msg, strlen(debug_msg), 100);
+            Fmt_Init(&f, debug_msg, sizeof(debug_msg));
+            Fmt_Str(&f, "No valid card/tag or UID not found\r\n");
+            UartLog_Write(debug_msg, f.len);
         }
 
         // Send the result to the display queue for UI update
         osMessageQueuePut(display_rc522_info_queue, &rc522_data, 0, 0);
 
-        // Wait 2 seconds before next acquisition cycle
-        osDelay(2000);
+        // Sleep until the next release, RC522_TASK_PERIOD_MS after this one's
+        Periodic_Wait(&rc522_timing);
     }
 }
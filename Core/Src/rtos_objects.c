@@ -0,0 +1,368 @@
+/**
+ * @file    rtos_objects.c
+ * @author  Ted Wang
+ * @date    2026-10-17
+ * @brief   Registry of the statically allocated RTOS objects and the boot-time memory report.
+ *
+ * @details
+ * The wrappers check that the attributes carry static memory before calling CMSIS-RTOS v2, which
+ * then uses the xCreateStatic() FreeRTOS functions. Objects are created during initialization
+ * (before the scheduler starts or from a task's init code), so the registry is only appended to,
+ * in a critical section. Stack use is measured from the tskSTACK_FILL_BYTE pattern FreeRTOS writes
+ * into every stack (INCLUDE_uxTaskGetStackHighWaterMark), which works for the kernel's own tasks
+ * as well without their handles.
+ *
+ * Queues, semaphores and mutexes get their registry position (from 1) as FreeRTOS queue number,
+ * the object id of the kernel trace records (trace_recorder.c).
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "rtos_objects.h"
+#include "ccmram.h"
+#include "fmt.h"
+#include "uart_log.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define RTOS_OBJ_STACK_FILL_BYTE    0xA5u           /**< tskSTACK_FILL_BYTE of tasks.c */
+#define RTOS_OBJ_CCM_BASE           0x10000000u
+#define RTOS_OBJ_CCM_SIZE           0x00010000u
+#define RTOS_OBJ_SRAM_BASE          0x20000000u
+#define RTOS_OBJ_SRAM_SIZE          0x00030000u
+
+#if defined(__ARMCC_VERSION)
+/**
+ * @brief End of the zero-initialized data of the SRAM and CCM RAM regions (MDK-ARM/stm32f429zi_ccm.sct).
+ */
+extern uint8_t Image$$RW_IRAM1$$ZI$$Limit[];
+extern uint8_t Image$$RW_IRAM2$$ZI$$Limit[];
+#endif
+
+/* Private variables ---------------------------------------------------------*/
+/**
+ * @brief Registered objects (file scope only).
+ */
+static RtosObj_Entry_t rtos_objects[RTOS_OBJ_MAX];
+static uint32_t rtos_object_count;
+
+/**
+ * @brief Objects that could not be registered (registry full) or were refused (no static memory).
+ */
+static uint32_t rtos_objects_lost;
+static uint32_t rtos_objects_refused;
+
+static const char *const rtos_obj_kind_names[] = {"thread", "queue", "semaphore", "mutex"};
+
+/* Private functions ---------------------------------------------------------*/
+/**
+ * @brief Appends an object to the registry.
+ * @return Registry position from 1, or 0 if the registry is full.
+ */
+static uint32_t RtosObj_Add(const char *name, RtosObj_Kind_t kind, void *handle, const void *cb, uint32_t cb_bytes,
+                        const void *mem, uint32_t mem_bytes)
+{
+    uint32_t number = 0;
+
+    taskENTER_CRITICAL();
+    if (rtos_object_count < RTOS_OBJ_MAX)
+    {
+        RtosObj_Entry_t *entry = &rtos_objects[rtos_object_count++];
+
+        entry->name = (name != NULL) ? name : "-";
+        entry->kind = kind;
+        entry->handle = handle;
+        entry->cb = cb;
+        entry->cb_bytes = cb_bytes;
+        entry->mem = mem;
+        entry->mem_bytes = mem_bytes;
+        number = rtos_object_count;
+    }
+    else
+    {
+        rtos_objects_lost++;
+    }
+    taskEXIT_CRITICAL();
+    return number;
+}
+
+/**
+ * @brief Returns 1 if the address lies in CCM RAM.
+ */
+static uint8_t RtosObj_InCcm(const void *p)
+{
+    return ((uint32_t)(uintptr_t)p - RTOS_OBJ_CCM_BASE) < RTOS_OBJ_CCM_SIZE;
+}
+
+/**
+ * @brief Appends a string left aligned in a field of the given width.
+ */
+static void RtosObj_Field(Fmt_t *f, const char *str, uint32_t width)
+{
+    uint32_t start = f->len;
+
+    Fmt_Str(f, str);
+    while (f->len < start + width && !f->truncated)
+    {
+        Fmt_Char(f, ' ');
+    }
+}
+
+/**
+ * @brief Sends a formatted line.
+ */
+static void RtosObj_Send(const Fmt_t *f)
+{
+    UartLog_Write(f->buf, f->len);
+}
+
+/* Exported functions --------------------------------------------------------*/
+/**
+ * @brief osThreadNew() from a static control block and stack (attr->cb_mem and attr->stack_mem).
+ */
+osThreadId_t RtosObj_ThreadNew(osThreadFunc_t func, void *argument, const osThreadAttr_t *attr)
+{
+    osThreadId_t handle;
+
+    if (attr == NULL || attr->cb_mem == NULL || attr->stack_mem == NULL)
+    {
+        rtos_objects_refused++;
+        return NULL;
+    }
+    handle = osThreadNew(func, argument, attr);
+    if (handle != NULL)
+    {
+        RtosObj_Add(attr->name, RTOS_OBJ_THREAD, handle, attr->cb_mem, attr->cb_size, attr->stack_mem, attr->stack_size);
+    }
+    return handle;
+}
+
+/**
+ * @brief osMessageQueueNew() from a static control block and message storage (attr->cb_mem and attr->mq_mem).
+ */
+osMessageQueueId_t RtosObj_QueueNew(uint32_t msg_count, uint32_t msg_size, const osMessageQueueAttr_t *attr)
+{
+    osMessageQueueId_t handle;
+
+    if (attr == NULL || attr->cb_mem == NULL || attr->mq_mem == NULL)
+    {
+        rtos_objects_refused++;
+        return NULL;
+    }
+    handle = osMessageQueueNew(msg_count, msg_size, attr);
+    if (handle != NULL)
+    {
+        vQueueSetQueueNumber((QueueHandle_t)handle,
+                             RtosObj_Add(attr->name, RTOS_OBJ_QUEUE, handle, attr->cb_mem, attr->cb_size, attr->mq_mem, attr->mq_size));
+    }
+    return handle;
+}
+
+/**
+ * @brief osSemaphoreNew() from a static control block (attr->cb_mem).
+ */
+osSemaphoreId_t RtosObj_SemaphoreNew(uint32_t max_count, uint32_t initial_count, const osSemaphoreAttr_t *attr)
+{
+    osSemaphoreId_t handle;
+
+    if (attr == NULL || attr->cb_mem == NULL)
+    {
+        rtos_objects_refused++;
+        return NULL;
+    }
+    handle = osSemaphoreNew(max_count, initial_count, attr);
+    if (handle != NULL)
+    {
+        vQueueSetQueueNumber((QueueHandle_t)handle,
+                             RtosObj_Add(attr->name, RTOS_OBJ_SEMAPHORE, handle, attr->cb_mem, attr->cb_size, NULL, 0));
+    }
+    return handle;
+}
+
+/**
+ * @brief osMutexNew() from a static control block (attr->cb_mem).
+ */
+osMutexId_t RtosObj_MutexNew(const osMutexAttr_t *attr)
+{
+    osMutexId_t handle;
+
+    if (attr == NULL || attr->cb_mem == NULL)
+    {
+        rtos_objects_refused++;
+        return NULL;
+    }
+    handle = osMutexNew(attr);
+    if (handle != NULL)
+    {
+        vQueueSetQueueNumber((QueueHandle_t)handle,
+                             RtosObj_Add(attr->name, RTOS_OBJ_MUTEX, handle, attr->cb_mem, attr->cb_size, NULL, 0));
+    }
+    return handle;
+}
+
+/**
+ * @brief Static memory of the FreeRTOS idle task (overrides the weak version in cmsis_os2.c).
+ */
+void vApplicationGetIdleTaskMemory(StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer,
+                                   uint32_t *pulIdleTaskStackSize)
+{
+    static StaticTask_t idle_cb CCM_RAM;
+    static StackType_t idle_stack[configMINIMAL_STACK_SIZE] CCM_RAM;
+
+    *ppxIdleTaskTCBBuffer = &idle_cb;
+    *ppxIdleTaskStackBuffer = idle_stack;
+    *pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+    RtosObj_Add("IDLE", RTOS_OBJ_THREAD, NULL, &idle_cb, sizeof(idle_cb), idle_stack, sizeof(idle_stack));
+}
+
+/**
+ * @brief Static memory of the FreeRTOS timer task (overrides the weak version in cmsis_os2.c).
+ */
+void vApplicationGetTimerTaskMemory(StaticTask_t **ppxTimerTaskTCBBuffer, StackType_t **ppxTimerTaskStackBuffer,
+                                    uint32_t *pulTimerTaskStackSize)
+{
+    static StaticTask_t timer_cb CCM_RAM;
+    static StackType_t timer_stack[configTIMER_TASK_STACK_DEPTH] CCM_RAM;
+
+    *ppxTimerTaskTCBBuffer = &timer_cb;
+    *ppxTimerTaskStackBuffer = timer_stack;
+    *pulTimerTaskStackSize = configTIMER_TASK_STACK_DEPTH;
+    RtosObj_Add("Tmr Svc", RTOS_OBJ_THREAD, NULL, &timer_cb, sizeof(timer_cb), timer_stack,
+                sizeof(timer_stack));
+}
+
+/**
+ * @brief Returns the number of registered objects and, if entries is not NULL, the registry itself.
+ */
+uint32_t RtosObj_GetEntries(const RtosObj_Entry_t **entries)
+{
+    if (entries != NULL)
+    {
+        *entries = rtos_objects;
+    }
+    return rtos_object_count;
+}
+
+/**
+ * @brief Returns the unused part of a registered thread's stack in bytes (stack fill pattern scan).
+ *
+ * The stack grows down from the end of the buffer, so the untouched bytes are at its start.
+ */
+uint32_t RtosObj_GetStackFree(const RtosObj_Entry_t *entry)
+{
+    const uint8_t *p = (const uint8_t *)entry->mem;
+    uint32_t n = 0;
+
+    if (entry->kind != RTOS_OBJ_THREAD || p == NULL)
+    {
+        return 0;
+    }
+    while (n < entry->mem_bytes && p[n] == RTOS_OBJ_STACK_FILL_BYTE)
+    {
+        n++;
+    }
+    return n;
+}
+
+/**
+ * @brief Prints the registry, heap use and SRAM/CCM RAM headroom on UART3 (uart_log.h).
+ *
+ * Output (one line per object, then the totals):
+ * @code
+ *   RTOS objects: 7 static, 6072 bytes (6072 in CCM RAM)
+ *     thread    OLED_Task        CCM  cb   92  mem  2048  free  1244
+ *     ...
+ *   Heap: 4096 bytes, used 0, min free 4096, refused 0
+ *   RAM: SRAM 18432 used, 178176 free; CCM 21504 used, 44032 free
+ * @endcode
+ */
+void RtosObj_Report(void)
+{
+    char line[80];
+    Fmt_t f;
+    uint32_t total = 0;
+    uint32_t total_ccm = 0;
+    size_t heap_free = xPortGetFreeHeapSize();
+
+    for (uint32_t i = 0; i < rtos_object_count; i++)
+    {
+        uint32_t bytes = rtos_objects[i].cb_bytes + rtos_objects[i].mem_bytes;
+
+        total += bytes;
+        total_ccm += RtosObj_InCcm(rtos_objects[i].cb) ? rtos_objects[i].cb_bytes : 0;
+        total_ccm += RtosObj_InCcm(rtos_objects[i].mem) ? rtos_objects[i].mem_bytes : 0;
+    }
+    Fmt_Init(&f, line, sizeof(line));
+    Fmt_Str(&f, "RTOS objects: ");
+    Fmt_Uint(&f, rtos_object_count, FMT_D);
+    Fmt_Str(&f, " static, ");
+    Fmt_Uint(&f, total, FMT_D);
+    Fmt_Str(&f, " bytes (");
+    Fmt_Uint(&f, total_ccm, FMT_D);
+    Fmt_Str(&f, " in CCM RAM)");
+    if (rtos_objects_lost != 0)
+    {
+        Fmt_Str(&f, ", ");
+        Fmt_Uint(&f, rtos_objects_lost, FMT_D);
+        Fmt_Str(&f, " not listed");
+    }
+    Fmt_Str(&f, "\r\n");
+    RtosObj_Send(&f);
+
+    for (uint32_t i = 0; i < rtos_object_count; i++)
+    {
+        const RtosObj_Entry_t *entry = &rtos_objects[i];
+
+        Fmt_Init(&f, line, sizeof(line));
+        Fmt_Str(&f, "  ");
+        RtosObj_Field(&f, rtos_obj_kind_names[entry->kind], 10);
+        RtosObj_Field(&f, entry->name, configMAX_TASK_NAME_LEN + 1);
+        Fmt_Str(&f, RtosObj_InCcm(entry->cb) ? "CCM " : "SRAM");
+        Fmt_Str(&f, " cb ");
+        Fmt_Uint(&f, entry->cb_bytes, FMT_WIDTH(4));
+        if (entry->mem != NULL)
+        {
+            Fmt_Str(&f, "  mem ");
+            Fmt_Uint(&f, entry->mem_bytes, FMT_WIDTH(5));
+        }
+        if (entry->kind == RTOS_OBJ_THREAD)
+        {
+            Fmt_Str(&f, "  free ");
+            Fmt_Uint(&f, RtosObj_GetStackFree(entry), FMT_WIDTH(5));
+        }
+        Fmt_Str(&f, "\r\n");
+        RtosObj_Send(&f);
+    }
+
+    Fmt_Init(&f, line, sizeof(line));
+    Fmt_Str(&f, "Heap: ");
+    Fmt_Uint(&f, configTOTAL_HEAP_SIZE, FMT_D);
+    Fmt_Str(&f, " bytes, used ");
+    Fmt_Uint(&f, (uint32_t)(configTOTAL_HEAP_SIZE - heap_free), FMT_D);
+    Fmt_Str(&f, ", min free ");
+    Fmt_Uint(&f, (uint32_t)xPortGetMinimumEverFreeHeapSize(), FMT_D);
+    Fmt_Str(&f, ", refused ");
+    Fmt_Uint(&f, rtos_objects_refused, FMT_D);
+    Fmt_Str(&f, "\r\n");
+    RtosObj_Send(&f);
+
+#if defined(__ARMCC_VERSION)
+    {
+        uint32_t sram_used = (uint32_t)(uintptr_t)Image$$RW_IRAM1$$ZI$$Limit - RTOS_OBJ_SRAM_BASE;
+        uint32_t ccm_used = (uint32_t)(uintptr_t)Image$$RW_IRAM2$$ZI$$Limit - RTOS_OBJ_CCM_BASE;
+
+        Fmt_Init(&f, line, sizeof(line));
+        Fmt_Str(&f, "RAM: SRAM ");
+        Fmt_Uint(&f, sram_used, FMT_D);
+        Fmt_Str(&f, " used, ");
+        Fmt_Uint(&f, RTOS_OBJ_SRAM_SIZE - sram_used, FMT_D);
+        Fmt_Str(&f, " free; CCM ");
+        Fmt_Uint(&f, ccm_used, FMT_D);
+        Fmt_Str(&f, " used, ");
+        Fmt_Uint(&f, RTOS_OBJ_CCM_SIZE - ccm_used, FMT_D);
+        Fmt_Str(&f, " free\r\n");
+        RtosObj_Send(&f);
+    }
+#endif
+}
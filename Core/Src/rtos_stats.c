@@ -0,0 +1,498 @@
+/**
+ * @file    rtos_stats.c
+ * @author  Ted Wang
+ * @date    2026-10-17
+ * @brief   Per-task CPU use, stack high-water marks and context switch counts (FreeRTOS run time stats).
+ *
+ * @details
+ * The statistics task wakes every RTOS_STATS_PERIOD_MS (osDelayUntil-style deadline, no drift) and
+ * reads all tasks with uxTaskGetSystemState(). The run time counters and switch counts are
+ * cumulative; the task keeps the difference of each period in a small ring per task, so the last
+ * period and the sliding window are both plain sums. The snapshot is built in a buffer owned by
+ * the task (also the source of the UART report) and then copied, with the scheduler suspended, to
+ * the buffer RtosStats_GetSnapshot() reads.
+ *
+ * The UART3 receiver listens for single characters with HAL_UART_Receive_IT(); the report key sets
+ * a thread flag, so the report is printed by the statistics task at its low priority while the
+ * application keeps running. The report ends with the output counters of UART3 (lines that had to
+ * wait or were dropped, uart_log.h) and the timing counters of the periodic tasks
+ * (Periodic_Report()).
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "rtos_stats.h"
+#include "rtos_objects.h"
+#include "trace_recorder.h"
+#include "periodic.h"
+#include "spsc_bench.h"
+#include "ccmram.h"
+#include "fmt.h"
+#include "uart_log.h"
+#include "main.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include <string.h>
+
+/* Private defines -----------------------------------------------------------*/
+#define RTOS_STATS_FLAG_REPORT      0x0001u         /**< Thread flag: print the latest snapshot */
+#define RTOS_STATS_INDEX(n)         ((n) & (RTOS_STATS_MAX_TASKS - 1u))
+
+_Static_assert((RTOS_STATS_MAX_TASKS & (RTOS_STATS_MAX_TASKS - 1)) == 0, "RTOS_STATS_MAX_TASKS must be a power of two");
+_Static_assert(RTOS_STATS_MAX_TASKS <= 32, "RTOS_STATS_MAX_TASKS must fit the 32-bit slot masks");
+
+/* Private types -------------------------------------------------------------*/
+/**
+ * @brief Accumulated state of one task number.
+ */
+typedef struct {
+    uint32_t number;                            /**< Task number owning the slot (0: free) */
+    uint32_t run_prev;                          /**< Run time counter at the last sample */
+    uint32_t run_delta[RTOS_STATS_WINDOW];      /**< Run time of each period in the window */
+    uint32_t switches_prev;                     /**< Switch count at the last sample */
+} RtosStats_Slot_t;
+
+/* Private variables ---------------------------------------------------------*/
+/**
+ * @brief UART3 handle for the report and the report requests (defined elsewhere).
+ */
+extern UART_HandleTypeDef huart3;
+
+/**
+ * @brief Statistics task handle, control block and stack (static, CCM RAM).
+ */
+static osThreadId_t stats_task_handle;
+static StaticTask_t stats_task_cb CCM_RAM;
+static StackType_t stats_task_stack[RTOS_STATS_TASK_STACK_SIZE_BYTES / sizeof(StackType_t)] CCM_RAM;
+
+/**
+ * @brief Context switches per task number (written by the switch hook only) and the running task.
+ */
+static volatile uint32_t stats_switches[RTOS_STATS_MAX_TASKS];
+static uint32_t stats_current_task;
+
+/**
+ * @brief Sampling state: per task slots, total run time of each period, sample counter.
+ */
+static RtosStats_Slot_t stats_slots[RTOS_STATS_MAX_TASKS] CCM_RAM;
+static uint32_t stats_total_delta[RTOS_STATS_WINDOW];
+static uint32_t stats_total_prev;
+static uint32_t stats_switches_total_prev;
+static uint32_t stats_sample;
+
+/**
+ * @brief uxTaskGetSystemState() output, the snapshot being built/printed and the published copy.
+ */
+static TaskStatus_t stats_status[RTOS_STATS_MAX_TASKS] CCM_RAM;
+static RtosStats_Snapshot_t stats_work CCM_RAM;
+static RtosStats_Snapshot_t stats_published CCM_RAM;
+
+/**
+ * @brief UART3 receive buffer (one character).
+ */
+static uint8_t stats_rx_byte;
+
+/* Private function prototypes -----------------------------------------------*/
+static void RtosStats_Task(void *argument);
+
+/* Private functions ---------------------------------------------------------*/
+/**
+ * @brief Returns part / total in 0.1 % (0 if total is 0).
+ */
+static uint16_t RtosStats_Permille(uint32_t part, uint32_t total)
+{
+    uint64_t permille;
+
+    if (total == 0)
+    {
+        return 0;
+    }
+    permille = ((uint64_t)part * 1000u + total / 2u) / total;
+    return (uint16_t)((permille > 1000u) ? 1000u : permille);
+}
+
+/**
+ * @brief Returns the sum of a window ring.
+ */
+static uint32_t RtosStats_Sum(const uint32_t *ring)
+{
+    uint32_t sum = 0;
+
+    for (uint32_t i = 0; i < RTOS_STATS_WINDOW; i++)
+    {
+        sum += ring[i];
+    }
+    return sum;
+}
+
+/**
+ * @brief Reads all tasks and advances the window; with publish == 0 only the baselines are taken.
+ *
+ * If more tasks exist than RTOS_STATS_MAX_TASKS, uxTaskGetSystemState() lists none: the sample is
+ * skipped and counted, and the published snapshot keeps its last task data. A task whose number
+ * maps to the slot of another listed task is left out (the slot stays with its owner) and counted.
+ */
+static void RtosStats_Sample(uint8_t publish)
+{
+    RtosStats_Snapshot_t *snap = &stats_work;
+    uint32_t pos = stats_sample % RTOS_STATS_WINDOW;
+    uint32_t seen = 0;
+    uint32_t owned = 0;
+    uint32_t total;
+    uint32_t switches_total = 0;
+    uint32_t idle_period = 0;
+    uint32_t idle_window = 0;
+    uint32_t total_window;
+    uint32_t count;
+
+    count = (uint32_t)uxTaskGetSystemState(stats_status, RTOS_STATS_MAX_TASKS, &total);
+    if (count == 0)
+    {
+        // The baselines stay, so the next sample covers the skipped periods as well
+        snap->overflows++;
+        snap->tasks_total = (uint32_t)uxTaskGetNumberOfTasks();
+        vTaskSuspendAll();
+        stats_published.overflows = snap->overflows;
+        stats_published.tasks_total = snap->tasks_total;
+        (void)xTaskResumeAll();
+        return;
+    }
+    stats_total_delta[pos] = total - stats_total_prev;
+    stats_total_prev = total;
+    total_window = RtosStats_Sum(stats_total_delta);
+
+    // Slots whose owner is still listed; another task mapping to one of them is left out
+    for (uint32_t i = 0; i < count; i++)
+    {
+        uint32_t index = RTOS_STATS_INDEX(stats_status[i].xTaskNumber);
+
+        if (stats_slots[index].number == stats_status[i].xTaskNumber)
+        {
+            owned |= 1u << index;
+        }
+    }
+
+    snap->task_count = 0;
+    snap->collisions = 0;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        const TaskStatus_t *status = &stats_status[i];
+        uint32_t index = RTOS_STATS_INDEX(status->xTaskNumber);
+        RtosStats_Slot_t *slot = &stats_slots[index];
+        uint32_t switches = stats_switches[index];
+        RtosStats_Task_t *task;
+        uint32_t run_window;
+        uint32_t j;
+
+        if ((seen & (1u << index)) != 0 || ((owned & (1u << index)) != 0 && slot->number != status->xTaskNumber))
+        {
+            snap->collisions++;
+            continue;
+        }
+        // A new task (or a new owner of a slot) starts from zero run time and its current switch count
+        if (slot->number != status->xTaskNumber)
+        {
+            memset(slot, 0, sizeof(*slot));
+            slot->number = status->xTaskNumber;
+            slot->switches_prev = switches;
+        }
+        seen |= 1u << index;
+        slot->run_delta[pos] = status->ulRunTimeCounter - slot->run_prev;
+        slot->run_prev = status->ulRunTimeCounter;
+        run_window = RtosStats_Sum(slot->run_delta);
+        switches_total += switches;
+        if (status->uxCurrentPriority == tskIDLE_PRIORITY)
+        {
+            idle_period += slot->run_delta[pos];
+            idle_window += run_window;
+        }
+
+        // Insert in task number (creation) order; uxTaskGetSystemState() lists by state
+        for (j = snap->task_count; j > 0 && snap->tasks[j - 1].number > status->xTaskNumber; j--)
+        {
+            snap->tasks[j] = snap->tasks[j - 1];
+        }
+        task = &snap->tasks[j];
+        task->name = status->pcTaskName;
+        task->number = status->xTaskNumber;
+        task->priority = status->uxCurrentPriority;
+        task->cpu_permille = RtosStats_Permille(slot->run_delta[pos], stats_total_delta[pos]);
+        task->cpu_window_permille = RtosStats_Permille(run_window, total_window);
+        task->stack_free = (uint32_t)status->usStackHighWaterMark * sizeof(StackType_t);
+        task->switches = switches;
+        task->switches_period = switches - slot->switches_prev;
+        slot->switches_prev = switches;
+        snap->task_count++;
+    }
+    // Slots of deleted tasks
+    for (uint32_t i = 0; i < RTOS_STATS_MAX_TASKS; i++)
+    {
+        if ((seen & (1u << i)) == 0)
+        {
+            stats_slots[i].number = 0;
+        }
+    }
+    snap->switches_period = switches_total - stats_switches_total_prev;
+    stats_switches_total_prev = switches_total;
+
+    if (!publish)
+    {
+        memset(stats_total_delta, 0, sizeof(stats_total_delta));
+        for (uint32_t i = 0; i < RTOS_STATS_MAX_TASKS; i++)
+        {
+            memset(stats_slots[i].run_delta, 0, sizeof(stats_slots[i].run_delta));
+        }
+        return;
+    }
+
+    stats_sample++;
+    snap->sample = stats_sample;
+    snap->window = (stats_sample < RTOS_STATS_WINDOW) ? stats_sample : RTOS_STATS_WINDOW;
+    snap->load_permille = 1000u - RtosStats_Permille(idle_period, stats_total_delta[pos]);
+    snap->load_window_permille = 1000u - RtosStats_Permille(idle_window, total_window);
+
+    vTaskSuspendAll();
+    memcpy(&stats_published, snap, sizeof(stats_published));
+    (void)xTaskResumeAll();
+}
+
+/**
+ * @brief (Re)starts the reception of one character on UART3 if the receiver is idle.
+ *
+ * Called every period as well, since a reception refused while the transmitter held the handle
+ * lock or aborted by a receive error would otherwise end the listening.
+ */
+static void RtosStats_Listen(void)
+{
+    if (huart3.RxState == HAL_UART_STATE_READY)
+    {
+        (void)HAL_UART_Receive_IT(&huart3, &stats_rx_byte, 1);
+    }
+}
+
+/**
+ * @brief Appends a 0.1 % value right aligned in a field of the given width.
+ */
+static void RtosStats_Percent(Fmt_t *f, uint16_t permille, uint32_t width)
+{
+    uint32_t digits = (permille >= 1000u) ? 5u : (permille >= 100u) ? 4u : 3u;
+
+    while (digits < width)
+    {
+        Fmt_Char(f, ' ');
+        digits++;
+    }
+    Fmt_Fixed(f, permille, 1);
+}
+
+/**
+ * @brief Sends a formatted line.
+ */
+static void RtosStats_Send(const Fmt_t *f)
+{
+    UartLog_Write(f->buf, f->len);
+}
+
+/**
+ * @brief Prints the samples skipped for too many tasks and the tasks left out for a shared slot.
+ */
+static void RtosStats_ReportGaps(const RtosStats_Snapshot_t *snap)
+{
+    char line[80];
+    Fmt_t f;
+
+    if (snap->overflows != 0)
+    {
+        Fmt_Init(&f, line, sizeof(line));
+        Fmt_Str(&f, "  skipped samples: ");
+        Fmt_Uint(&f, snap->overflows, FMT_D);
+        Fmt_Str(&f, " (");
+        Fmt_Uint(&f, snap->tasks_total, FMT_D);
+        Fmt_Str(&f, " tasks > RTOS_STATS_MAX_TASKS ");
+        Fmt_Uint(&f, RTOS_STATS_MAX_TASKS, FMT_D);
+        Fmt_Str(&f, ")\r\n");
+        RtosStats_Send(&f);
+    }
+    if (snap->collisions != 0)
+    {
+        Fmt_Init(&f, line, sizeof(line));
+        Fmt_Str(&f, "  tasks left out (shared slot): ");
+        Fmt_Uint(&f, snap->collisions, FMT_D);
+        Fmt_Str(&f, "\r\n");
+        RtosStats_Send(&f);
+    }
+}
+
+/**
+ * @brief Prints the latest snapshot on UART3 (uart_log.h, statistics task only).
+ */
+static void RtosStats_Report(void)
+{
+    const RtosStats_Snapshot_t *snap = &stats_work;
+    UartLog_Stats_t log_stats;
+    char line[80];
+    Fmt_t f;
+
+    Fmt_Init(&f, line, sizeof(line));
+    if (snap->sample == 0)
+    {
+        Fmt_Str(&f, "CPU: no sample yet\r\n");
+        RtosStats_Send(&f);
+        RtosStats_ReportGaps(snap);
+        return;
+    }
+    Fmt_Str(&f, "CPU ");
+    Fmt_Fixed(&f, snap->load_permille, 1);
+    Fmt_Str(&f, "% (");
+    Fmt_Uint(&f, snap->window * RTOS_STATS_PERIOD_MS / 1000u, FMT_D);
+    Fmt_Str(&f, " s ");
+    Fmt_Fixed(&f, snap->load_window_permille, 1);
+    Fmt_Str(&f, "%), ");
+    Fmt_Uint(&f, snap->switches_period * 1000u / RTOS_STATS_PERIOD_MS, FMT_D);
+    Fmt_Str(&f, " switches/s, ");
+    Fmt_Uint(&f, snap->task_count, FMT_D);
+    Fmt_Str(&f, " tasks, sample ");
+    Fmt_Uint(&f, snap->sample, FMT_D);
+    Fmt_Str(&f, "\r\n");
+    RtosStats_Send(&f);
+    RtosStats_ReportGaps(snap);
+
+    Fmt_Init(&f, line, sizeof(line));
+    Fmt_Str(&f, "  task             pri   cpu%  win%  stack  switches     /s\r\n");
+    RtosStats_Send(&f);
+
+    for (uint32_t i = 0; i < snap->task_count; i++)
+    {
+        const RtosStats_Task_t *task = &snap->tasks[i];
+        uint32_t start;
+
+        Fmt_Init(&f, line, sizeof(line));
+        Fmt_Str(&f, "  ");
+        start = f.len;
+        Fmt_Str(&f, task->name);
+        while (f.len < start + configMAX_TASK_NAME_LEN && !f.truncated)
+        {
+            Fmt_Char(&f, ' ');
+        }
+        Fmt_Uint(&f, task->priority, FMT_WIDTH(4));
+        RtosStats_Percent(&f, task->cpu_permille, 7);
+        RtosStats_Percent(&f, task->cpu_window_permille, 6);
+        Fmt_Uint(&f, task->stack_free, FMT_WIDTH(7));
+        Fmt_Uint(&f, task->switches, FMT_WIDTH(10));
+        Fmt_Uint(&f, task->switches_period * 1000u / RTOS_STATS_PERIOD_MS, FMT_WIDTH(7));
+        Fmt_Str(&f, "\r\n");
+        RtosStats_Send(&f);
+    }
+
+    UartLog_GetStats(&log_stats);
+    Fmt_Init(&f, line, sizeof(line));
+    Fmt_Str(&f, "UART3: ");
+    Fmt_Uint(&f, log_stats.lines, FMT_D);
+    Fmt_Str(&f, " lines, ");
+    Fmt_Uint(&f, log_stats.waited, FMT_D);
+    Fmt_Str(&f, " waited, ");
+    Fmt_Uint(&f, log_stats.dropped, FMT_D);
+    Fmt_Str(&f, " dropped\r\n");
+    RtosStats_Send(&f);
+    Periodic_Report();
+}
+
+/**
+ * @brief Statistics task: samples every RTOS_STATS_PERIOD_MS, prints the snapshot on request.
+ * @param argument Unused (required by CMSIS-RTOS API)
+ */
+static void RtosStats_Task(void *argument)
+{
+    uint32_t next = osKernelGetTickCount() + RTOS_STATS_PERIOD_MS;
+
+    (void)argument;
+#if SPSC_BENCH_ENABLE
+    SpscBench_Run();
+#endif
+    RtosStats_Sample(0);
+    while (1)
+    {
+        int32_t wait = (int32_t)(next - osKernelGetTickCount());
+
+        RtosStats_Listen();
+        if (wait > 0 && osThreadFlagsWait(RTOS_STATS_FLAG_REPORT, osFlagsWaitAny, (uint32_t)wait) == RTOS_STATS_FLAG_REPORT)
+        {
+            RtosStats_Report();
+            continue;
+        }
+        // Deadlines advance by whole periods, so sampling does not drift with the report time
+        RtosStats_Sample(1);
+        next += RTOS_STATS_PERIOD_MS;
+    }
+}
+
+/* Exported functions --------------------------------------------------------*/
+/**
+ * @brief Creates the statistics task and starts listening for report requests on UART3.
+ */
+void RtosStats_Init(void)
+{
+    const osThreadAttr_t stats_task_attributes = {
+        .name = RTOS_STATS_TASK_THREAD_NAME,
+        .priority = RTOS_STATS_TASK_THREAD_PRIORITY,
+        .cb_mem = &stats_task_cb,
+        .cb_size = sizeof(stats_task_cb),
+        .stack_mem = stats_task_stack,
+        .stack_size = sizeof(stats_task_stack)
+    };
+    stats_task_handle = RtosObj_ThreadNew(RtosStats_Task, NULL, &stats_task_attributes);
+    if (stats_task_handle == NULL)
+    {
+        char msg[] = "Failed to create statistics task\r\n";
+        UartLog_WriteString(msg);
+        Error_Handler();
+    }
+}
+
+/**
+ * @brief Copies the latest snapshot (sample is 0 before the first period has passed).
+ *
+ * Task context only: the copy runs with the scheduler suspended.
+ */
+void RtosStats_GetSnapshot(RtosStats_Snapshot_t *snapshot)
+{
+    vTaskSuspendAll();
+    memcpy(snapshot, &stats_published, sizeof(*snapshot));
+    (void)xTaskResumeAll();
+}
+
+/**
+ * @brief Context switch hook (traceTASK_SWITCHED_IN() in FreeRTOSConfig.h, called from PendSV).
+ *
+ * FreeRTOS calls the hook on every scheduling decision, also when the running task is selected
+ * again; only real switches are counted.
+ */
+void RtosStats_TaskSwitchedIn(uint32_t task_number)
+{
+    if (task_number != stats_current_task)
+    {
+        stats_current_task = task_number;
+        stats_switches[RTOS_STATS_INDEX(task_number)]++;
+    }
+}
+
+/**
+ * @brief UART receive complete: a report request wakes the statistics task, the trace key switches
+ *        trace streaming; listen again.
+ */
+void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)
+{
+    if (huart == &huart3)
+    {
+        if (stats_rx_byte == RTOS_STATS_REPORT_KEY && stats_task_handle != NULL)
+        {
+            (void)osThreadFlagsSet(stats_task_handle, RTOS_STATS_FLAG_REPORT);
+        }
+#if TRACE_RECORDER_ENABLE
+        else if (stats_rx_byte == TRACE_STREAM_KEY)
+        {
+            Trace_ToggleStreamingFromISR();
+        }
+#endif
+        (void)HAL_UART_Receive_IT(&huart3, &stats_rx_byte, 1);
+    }
+}
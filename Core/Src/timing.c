@@ -0,0 +1,127 @@
+/**
+ * @file    timing.c
+ * @author  Ted Wang
+ * @date    2026-10-17
+ * @brief   RTOS-aware delay service (DWT microsecond busy-waits, millisecond task sleeps).
+ *
+ * @details
+ * The DWT cycle counter runs at the core clock (SystemCoreClock), so a busy-wait compares the
+ * elapsed cycles with the requested ones; unsigned subtraction keeps this correct across the
+ * counter wrap. Millisecond sleeps use osDelay() with one extra tick, because osDelay(n) may
+ * return up to one tick early when called just before a tick interrupt.
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "timing.h"
+#include "main.h"
+#include "cmsis_os2.h"
+
+/**
+ * @brief Accumulated delay statistics (diagnostics; concurrent callers may lose an update).
+ */
+static Timing_Stats_t timing_stats;
+
+/**
+ * @brief Enables the DWT cycle counter. Called lazily by the delay functions as well.
+ */
+void Timing_Init(void)
+{
+    if ((DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk) == 0)
+    {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+}
+
+/**
+ * @brief Busy-waits for the given number of core clock cycles.
+ */
+static void Timing_DelayCycles(uint32_t cycles)
+{
+    uint32_t start;
+
+    Timing_Init();
+    start = DWT->CYCCNT;
+    while ((DWT->CYCCNT - start) < cycles)
+    {
+    }
+}
+
+/**
+ * @brief Busy-waits for at least ns nanoseconds (rounded up to CPU cycles).
+ */
+void Timing_DelayNs(uint32_t ns)
+{
+    uint32_t mhz = SystemCoreClock / 1000000U;
+
+    Timing_DelayCycles((ns * mhz + 999U) / 1000U);
+}
+
+/**
+ * @brief Busy-waits for at least us microseconds.
+ */
+void Timing_DelayUs(uint32_t us)
+{
+    Timing_DelayCycles(us * (SystemCoreClock / 1000000U));
+    timing_stats.busy_us += us;
+}
+
+/**
+ * @brief Waits for at least ms milliseconds; sleeps the calling task when the scheduler runs.
+ *
+ * Before the scheduler starts and in interrupt context the wait is a busy-wait.
+ */
+void Timing_DelayMs(uint32_t ms)
+{
+    if (ms == 0)
+    {
+        return;
+    }
+    if (__get_IPSR() == 0U && osKernelGetState() == osKernelRunning)
+    {
+        uint32_t ticks = (ms * osKernelGetTickFreq() + 999U) / 1000U;
+
+        osDelay(ticks + 1U);
+        timing_stats.sleep_ms += ms;
+        return;
+    }
+    while (ms-- != 0)
+    {
+        Timing_DelayUs(1000U);
+    }
+}
+
+/**
+ * @brief Returns the DWT cycle counter (free running, wraps every 2^32 cycles).
+ */
+uint32_t Timing_GetCycles(void)
+{
+    Timing_Init();
+    return DWT->CYCCNT;
+}
+
+/**
+ * @brief Converts a cycle count difference to microseconds.
+ */
+uint32_t Timing_CyclesToUs(uint32_t cycles)
+{
+    return cycles / (SystemCoreClock / 1000000U);
+}
+
+/**
+ * @brief Copies the accumulated delay statistics.
+ */
+void Timing_GetStats(Timing_Stats_t *stats)
+{
+    *stats = timing_stats;
+}
+
+/**
+ * @brief Clears the accumulated delay statistics.
+ */
+void Timing_ResetStats(void)
+{
+    timing_stats.busy_us = 0;
+    timing_stats.sleep_ms = 0;
+}
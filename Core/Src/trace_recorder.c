@@ -0,0 +1,361 @@
+/**
+ * @file    trace_recorder.c
+ * @author  Ted Wang
+ * @date    2026-10-17
+ * @brief   Binary kernel trace recorder (task switches, queue operations, interrupts) streamed over UART3.
+ *
+ * @details
+ * The ring is indexed by free-running head/tail counters and only changed with interrupts masked
+ * (PRIMASK), which covers the kernel hooks (PendSV, critical sections), every interrupt priority
+ * and the streaming task taking records out. The ring is CPU-only and lives in CCM RAM; the
+ * streaming task copies records into trace_tx in SRAM, which the UART DMA reads.
+ *
+ * Frames are started through UartLog_TransmitDma(), under the mutex of the text output, and only
+ * when the UART is idle (the OLED mirror shares it as well). A frame refused because a text line
+ * or another frame is on the UART is kept and sent again, so a busy UART never loses records that
+ * already left the ring. Text lines wait for the frame in flight (about 70 ms for a full frame at
+ * 115200 baud) instead of failing; a line that still finds no free UART within
+ * UART_LOG_TIMEOUT_MS is counted as dropped in the 's' report.
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "trace_recorder.h"
+#include "rtos_objects.h"
+#include "uart_log.h"
+#include "ccmram.h"
+#include "main.h"
+#include "cmsis_os2.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include <string.h>
+
+#if TRACE_RECORDER_ENABLE
+
+/* Private defines -----------------------------------------------------------*/
+#define TRACE_SYNC0                 0xA5u
+#define TRACE_SYNC1                 0x5Au
+#define TRACE_HEADER_BYTES          5u              /**< Sync, type, length */
+#define TRACE_TRAILER_BYTES         2u              /**< Fletcher-16 */
+#define TRACE_RECORDS_HEADER_BYTES  5u              /**< seq, lost */
+#define TRACE_TX_BYTES              (TRACE_HEADER_BYTES + TRACE_RECORDS_HEADER_BYTES + \
+                                     TRACE_FRAME_RECORDS * sizeof(Trace_Record_t) + TRACE_TRAILER_BYTES)
+#define TRACE_MAX_TASKS             16u             /**< Tasks listed in the names frame */
+#define TRACE_FLAG_WAKE             0x0001u         /**< Thread flag: streaming started or stopped */
+#define TRACE_POLL_MS               10u             /**< Wait for new records or for the UART */
+
+/* Private variables ---------------------------------------------------------*/
+/**
+ * @brief UART3 handle (defined elsewhere): trace_tx may only be refilled while it is idle.
+ */
+extern UART_HandleTypeDef huart3;
+
+/**
+ * @brief Record ring (CPU only, CCM RAM) and its free-running indices.
+ */
+static Trace_Record_t trace_ring[TRACE_RING_RECORDS] CCM_RAM;
+static uint32_t trace_head;
+static uint32_t trace_tail;
+
+/**
+ * @brief Counters and the streaming state (switched by the UART3 receive interrupt).
+ */
+static Trace_Stats_t trace_stats;
+static volatile uint8_t trace_streaming;
+static volatile uint8_t trace_names_pending;
+
+/**
+ * @brief Frame transmit buffer. Read by the UART DMA: must stay in SRAM.
+ */
+static uint8_t trace_tx[TRACE_TX_BYTES];
+static uint16_t trace_tx_pending;
+static uint8_t trace_seq;
+
+/**
+ * @brief Task list for the names frame.
+ */
+static TaskStatus_t trace_status[TRACE_MAX_TASKS] CCM_RAM;
+
+/**
+ * @brief Streaming task handle, control block and stack (static, CCM RAM).
+ */
+static osThreadId_t trace_task_handle;
+static StaticTask_t trace_task_cb CCM_RAM;
+static StackType_t trace_task_stack[TRACE_TASK_STACK_SIZE_BYTES / sizeof(StackType_t)] CCM_RAM;
+
+/* Private functions ---------------------------------------------------------*/
+/**
+ * @brief Writes the frame header and checksum around the payload in trace_tx.
+ * @return Total frame length.
+ */
+static uint16_t Trace_Frame(uint8_t type, uint16_t len)
+{
+    uint16_t sum1 = 0;
+    uint16_t sum2 = 0;
+
+    trace_tx[0] = TRACE_SYNC0;
+    trace_tx[1] = TRACE_SYNC1;
+    trace_tx[2] = type;
+    trace_tx[3] = (uint8_t)(len & 0xFF);
+    trace_tx[4] = (uint8_t)(len >> 8);
+    for (uint16_t i = 2; i < TRACE_HEADER_BYTES + len; i++)
+    {
+        sum1 = (uint16_t)((sum1 + trace_tx[i]) % 255);
+        sum2 = (uint16_t)((sum2 + sum1) % 255);
+    }
+    trace_tx[TRACE_HEADER_BYTES + len] = (uint8_t)sum1;
+    trace_tx[TRACE_HEADER_BYTES + len + 1] = (uint8_t)sum2;
+    return (uint16_t)(TRACE_HEADER_BYTES + len + TRACE_TRAILER_BYTES);
+}
+
+/**
+ * @brief Appends a name entry to the names payload if it fits.
+ */
+static uint8_t *Trace_PutName(uint8_t *p, uint8_t kind, uint32_t id, const char *name)
+{
+    size_t n = strlen(name);
+
+    if (p + 3 + n > &trace_tx[TRACE_TX_BYTES - TRACE_TRAILER_BYTES])
+    {
+        return p;
+    }
+    *p++ = kind;
+    *p++ = (uint8_t)id;
+    memcpy(p, name, n + 1);
+    return p + n + 1;
+}
+
+/**
+ * @brief Builds the names frame: core clock, every task and every registered queue object.
+ */
+static uint16_t Trace_BuildNames(void)
+{
+    uint8_t *p = &trace_tx[TRACE_HEADER_BYTES];
+    const RtosObj_Entry_t *entries;
+    uint32_t count;
+
+    p[0] = (uint8_t)SystemCoreClock;
+    p[1] = (uint8_t)(SystemCoreClock >> 8);
+    p[2] = (uint8_t)(SystemCoreClock >> 16);
+    p[3] = (uint8_t)(SystemCoreClock >> 24);
+    p += 4;
+
+    count = (uint32_t)uxTaskGetSystemState(trace_status, TRACE_MAX_TASKS, NULL);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        p = Trace_PutName(p, 0, trace_status[i].xTaskNumber, trace_status[i].pcTaskName);
+    }
+    // Queues, semaphores and mutexes carry their registry position as queue number
+    count = RtosObj_GetEntries(&entries);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (entries[i].kind != RTOS_OBJ_THREAD)
+        {
+            p = Trace_PutName(p, 1, i + 1, entries[i].name);
+        }
+    }
+    return Trace_Frame('N', (uint16_t)(p - &trace_tx[TRACE_HEADER_BYTES]));
+}
+
+/**
+ * @brief Moves up to TRACE_FRAME_RECORDS records from the ring into a 'T' frame.
+ * @return Frame length, or 0 if the ring is empty.
+ */
+static uint16_t Trace_BuildRecords(void)
+{
+    uint8_t *p = &trace_tx[TRACE_HEADER_BYTES + TRACE_RECORDS_HEADER_BYTES];
+    uint32_t primask = __get_PRIMASK();
+    uint32_t start;
+    uint32_t first;
+    uint32_t n;
+    uint32_t lost;
+
+    __disable_irq();
+    n = trace_head - trace_tail;
+    if (n > TRACE_FRAME_RECORDS)
+    {
+        n = TRACE_FRAME_RECORDS;
+    }
+    start = trace_tail & (TRACE_RING_RECORDS - 1u);
+    first = (start + n > TRACE_RING_RECORDS) ? TRACE_RING_RECORDS - start : n;
+    memcpy(p, &trace_ring[start], first * sizeof(Trace_Record_t));
+    memcpy(p + first * sizeof(Trace_Record_t), trace_ring, (n - first) * sizeof(Trace_Record_t));
+    trace_tail += n;
+    lost = trace_stats.lost;
+    __set_PRIMASK(primask);
+
+    if (n == 0)
+    {
+        return 0;
+    }
+    p = &trace_tx[TRACE_HEADER_BYTES];
+    p[0] = trace_seq++;
+    p[1] = (uint8_t)lost;
+    p[2] = (uint8_t)(lost >> 8);
+    p[3] = (uint8_t)(lost >> 16);
+    p[4] = (uint8_t)(lost >> 24);
+    return Trace_Frame('T', (uint16_t)(TRACE_RECORDS_HEADER_BYTES + n * sizeof(Trace_Record_t)));
+}
+
+/**
+ * @brief Streaming task: sends the names, then the ring contents, while streaming is on.
+ * @param argument Unused (required by CMSIS-RTOS API)
+ */
+static void Trace_Task(void *argument)
+{
+    (void)argument;
+    while (1)
+    {
+        if (!trace_streaming)
+        {
+            trace_tx_pending = 0;
+            osThreadFlagsWait(TRACE_FLAG_WAKE, osFlagsWaitAny, osWaitForever);
+            continue;
+        }
+        if (huart3.gState != HAL_UART_STATE_READY)
+        {
+            osDelay(1);
+            continue;
+        }
+        if (trace_tx_pending == 0)
+        {
+            if (trace_names_pending)
+            {
+                trace_names_pending = 0;
+                trace_tx_pending = Trace_BuildNames();
+            }
+            else
+            {
+                trace_tx_pending = Trace_BuildRecords();
+            }
+        }
+        if (trace_tx_pending == 0)
+        {
+            osThreadFlagsWait(TRACE_FLAG_WAKE, osFlagsWaitAny, TRACE_POLL_MS);
+            continue;
+        }
+        if (UartLog_TransmitDma(trace_tx, trace_tx_pending) == HAL_OK)
+        {
+            trace_tx_pending = 0;
+            trace_stats.frames++;
+        }
+        else
+        {
+            osDelay(1);
+        }
+    }
+}
+
+/* Exported functions --------------------------------------------------------*/
+/**
+ * @brief Creates the trace streaming task. Recording itself runs from the first kernel event.
+ */
+void Trace_Init(void)
+{
+    const osThreadAttr_t trace_task_attributes = {
+        .name = TRACE_TASK_THREAD_NAME,
+        .priority = TRACE_TASK_THREAD_PRIORITY,
+        .cb_mem = &trace_task_cb,
+        .cb_size = sizeof(trace_task_cb),
+        .stack_mem = trace_task_stack,
+        .stack_size = sizeof(trace_task_stack)
+    };
+    trace_task_handle = RtosObj_ThreadNew(Trace_Task, NULL, &trace_task_attributes);
+    if (trace_task_handle == NULL)
+    {
+        char msg[] = "Failed to create trace task\r\n";
+        UartLog_WriteString(msg);
+        Error_Handler();
+    }
+}
+
+/**
+ * @brief Appends a record to the ring (any context, interrupts masked for the update).
+ *
+ * While streaming a full ring drops the new record (counted in lost); otherwise the oldest record
+ * is overwritten.
+ */
+void Trace_Record(uint32_t event, uint32_t id, uint32_t arg)
+{
+    uint32_t primask = __get_PRIMASK();
+    Trace_Record_t *rec;
+
+    __disable_irq();
+    if (trace_head - trace_tail >= TRACE_RING_RECORDS)
+    {
+        if (trace_streaming)
+        {
+            trace_stats.lost++;
+            __set_PRIMASK(primask);
+            return;
+        }
+        trace_tail++;
+        trace_stats.overwritten++;
+    }
+    rec = &trace_ring[trace_head & (TRACE_RING_RECORDS - 1u)];
+    rec->timestamp = DWT->CYCCNT;
+    rec->event = (uint8_t)event;
+    rec->id = (uint8_t)id;
+    rec->arg = (uint16_t)arg;
+    trace_head++;
+    trace_stats.recorded++;
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief Records an application mark (e.g. the start of a display frame).
+ */
+void Trace_Mark(uint8_t id, uint16_t arg)
+{
+    Trace_Record(TRACE_EV_MARK, id, arg);
+}
+
+/**
+ * @brief Records the entry of the current interrupt handler (TRACE_ISR_ENTER()).
+ */
+void Trace_IsrEnter(void)
+{
+    Trace_Record(TRACE_EV_ISR_ENTER, __get_IPSR() - 16u, 0);
+}
+
+/**
+ * @brief Records the exit of the current interrupt handler (TRACE_ISR_EXIT()).
+ */
+void Trace_IsrExit(void)
+{
+    Trace_Record(TRACE_EV_ISR_EXIT, __get_IPSR() - 16u, 0);
+}
+
+/**
+ * @brief Starts or stops streaming (UART3 receive interrupt; wakes the trace task).
+ *
+ * A new stream starts with the names frame; the records already in the ring (flight recorder)
+ * follow.
+ */
+void Trace_ToggleStreamingFromISR(void)
+{
+    if (trace_task_handle == NULL)
+    {
+        return;
+    }
+    if (!trace_streaming)
+    {
+        trace_names_pending = 1;
+    }
+    trace_streaming = !trace_streaming;
+    (void)osThreadFlagsSet(trace_task_handle, TRACE_FLAG_WAKE);
+}
+
+/**
+ * @brief Copies the recorder counters.
+ */
+void Trace_GetStats(Trace_Stats_t *stats)
+{
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    *stats = trace_stats;
+    stats->streaming = trace_streaming;
+    __set_PRIMASK(primask);
+}
+
+#endif // TRACE_RECORDER_ENABLE
@@ -0,0 +1,191 @@
+/**
+ * @file    uart_log.c
+ * @author  Ted Wang
+ * @date    2026-10-17
+ * @brief   Serialized text output on the debug UART (UART3), shared by all tasks.
+ *
+ * @details
+ * Writers take the mutex, wait (sleeping 1 ms at a time) until the UART has finished any DMA
+ * frame, and send with HAL_UART_Transmit(). DMA frames are started under the same mutex
+ * (UartLog_TransmitDma()), so no new frame can slip in between the wait and the transmit.
+ * The whole wait, mutex included, is bounded by UART_LOG_TIMEOUT_MS; a line that is not sent
+ * by then is counted as dropped. The counters are updated with interrupts masked, since a
+ * dropped line may never have held the mutex. Output before UartLog_Init() is dropped.
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "uart_log.h"
+#include "rtos_objects.h"
+#include "ccmram.h"
+#include "cmsis_os2.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include <string.h>
+
+/* Private variables ---------------------------------------------------------*/
+/**
+ * @brief UART of the log (set by UartLog_Init()).
+ */
+static UART_HandleTypeDef *uart_log_huart;
+
+/**
+ * @brief Mutex ordering the writers (static control block, CCM RAM).
+ */
+static osMutexId_t uart_log_lock;
+static StaticSemaphore_t uart_log_lock_cb CCM_RAM;
+
+/**
+ * @brief Output counters.
+ */
+static UartLog_Stats_t uart_log_stats;
+
+/* Private functions ---------------------------------------------------------*/
+/**
+ * @brief Returns 1 if lines must be sent directly: before the scheduler runs, or from an interrupt.
+ */
+static uint8_t UartLog_Direct(void)
+{
+    return (uint8_t)(__get_IPSR() != 0 || osKernelGetState() != osKernelRunning || uart_log_lock == NULL);
+}
+
+/**
+ * @brief Counts a line (interrupts masked: also called without the mutex, and from interrupts).
+ */
+static void UartLog_Count(uint8_t sent, uint8_t waited)
+{
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    if (sent)
+    {
+        uart_log_stats.lines++;
+    }
+    else
+    {
+        uart_log_stats.dropped++;
+    }
+    if (waited)
+    {
+        uart_log_stats.waited++;
+    }
+    __set_PRIMASK(primask);
+}
+
+/* Exported functions --------------------------------------------------------*/
+/**
+ * @brief Binds the writer to its UART and creates the mutex. Call once before the tasks start.
+ */
+void UartLog_Init(UART_HandleTypeDef *huart)
+{
+    static const osMutexAttr_t lock_attributes = {
+        .name = "UART_Log",
+        .attr_bits = osMutexPrioInherit,
+        .cb_mem = &uart_log_lock_cb,
+        .cb_size = sizeof(uart_log_lock_cb)
+    };
+
+    uart_log_huart = huart;
+    uart_log_lock = RtosObj_MutexNew(&lock_attributes);
+    if (uart_log_lock == NULL)
+    {
+        (void)UartLog_WriteString("Failed to create UART log mutex\r\n");
+        Error_Handler();
+    }
+}
+
+/**
+ * @brief Sends a text line (blocking, any task).
+ *
+ * The line waits for other writers and for a DMA frame on the UART, at most UART_LOG_TIMEOUT_MS
+ * in total; after that it is dropped and counted.
+ */
+uint8_t UartLog_Write(const char *data, uint16_t len)
+{
+    uint32_t start;
+    uint8_t waited = 0;
+    uint8_t sent = 0;
+
+    if (uart_log_huart == NULL)
+    {
+        // Not bound to a UART yet (UartLog_Init() not called)
+        UartLog_Count(0, 0);
+        return 0;
+    }
+    if (UartLog_Direct())
+    {
+        sent = (uint8_t)(HAL_UART_Transmit(uart_log_huart, (uint8_t *)data, len, UART_LOG_TIMEOUT_MS) == HAL_OK);
+        UartLog_Count(sent, 0);
+        return sent;
+    }
+
+    start = osKernelGetTickCount();
+    if (osMutexAcquire(uart_log_lock, 0) != osOK)
+    {
+        waited = 1;
+        if (osMutexAcquire(uart_log_lock, UART_LOG_TIMEOUT_MS) != osOK)
+        {
+            UartLog_Count(0, waited);
+            return 0;
+        }
+    }
+    // A DMA frame holds the UART (gState BUSY_TX) until its last byte is out
+    while (uart_log_huart->gState != HAL_UART_STATE_READY && osKernelGetTickCount() - start < UART_LOG_TIMEOUT_MS)
+    {
+        waited = 1;
+        osDelay(1);
+    }
+    if (uart_log_huart->gState == HAL_UART_STATE_READY)
+    {
+        sent = (uint8_t)(HAL_UART_Transmit(uart_log_huart, (uint8_t *)data, len, UART_LOG_TIMEOUT_MS) == HAL_OK);
+    }
+    osMutexRelease(uart_log_lock);
+    UartLog_Count(sent, waited);
+    return sent;
+}
+
+/**
+ * @brief Starts a binary DMA frame (trace stream, OLED mirror) on the UART (task context).
+ *
+ * Only started while no text line holds the mutex and the UART is idle, so a frame never cuts into
+ * a line and a line waits for at most the frame in flight. Never blocks: on HAL_BUSY the caller
+ * keeps its frame and tries again later.
+ */
+HAL_StatusTypeDef UartLog_TransmitDma(const uint8_t *data, uint16_t len)
+{
+    HAL_StatusTypeDef status = HAL_BUSY;
+
+    if (uart_log_huart == NULL || uart_log_lock == NULL)
+    {
+        return HAL_BUSY;
+    }
+    if (osMutexAcquire(uart_log_lock, 0) != osOK)
+    {
+        return HAL_BUSY;
+    }
+    if (uart_log_huart->gState == HAL_UART_STATE_READY)
+    {
+        status = HAL_UART_Transmit_DMA(uart_log_huart, (uint8_t *)data, len);
+    }
+    osMutexRelease(uart_log_lock);
+    return status;
+}
+
+/**
+ * @brief Sends a null-terminated string; see UartLog_Write().
+ */
+uint8_t UartLog_WriteString(const char *str)
+{
+    return UartLog_Write(str, (uint16_t)strlen(str));
+}
+
+/**
+ * @brief Copies the output counters.
+ */
+void UartLog_GetStats(UartLog_Stats_t *stats)
+{
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    *stats = uart_log_stats;
+    __set_PRIMASK(primask);
+}
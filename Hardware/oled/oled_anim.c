@@ -0,0 +1,447 @@
+/**
+ * @file oled_anim.c
+ * @author Ted Wang
+ * @date 2026-10-17
+ * @brief Time-based animation scheduler (spinner, slide-in, progress bar) for the u8g2 full buffer.
+ *
+ * This file provides:
+ *   - Frame selection from the elapsed time (frame index = elapsed / frame period)
+ *   - Per animation redraw inside its rectangle (clip window, blank, draw)
+ *   - Tile-exact transfers with u8g2_UpdateDisplayArea() and back-pressure frame dropping
+ *   - The wake-up delay for the caller (next frame boundary of any animation)
+ */
+
+#include "oled_anim.h"
+#include "oled_raster.h"
+#include "oled_region.h"
+
+/**
+ * @brief Frame index of an animation that has not been drawn yet.
+ */
+#define OLED_ANIM_NO_FRAME      0xFFFFFFFFUL
+
+/**
+ * @brief Spinner dot directions (unit vectors * 1000, clockwise from 12 o'clock).
+ */
+static const int16_t oled_anim_spinner_dir[OLED_ANIM_SPINNER_DOTS][2] = {
+    {0, -1000}, {707, -707}, {1000, 0}, {707, 707}, {0, 1000}, {-707, 707}, {-1000, 0}, {-707, -707}
+};
+
+/**
+ * @brief Elapsed time of an animation, limited to its duration.
+ */
+static uint32_t OLED_Anim_Elapsed(const OLED_Anim_t *anim, uint32_t now_ms)
+{
+    uint32_t t = now_ms - anim->start_ms;
+
+    if (anim->duration_ms != 0 && t > anim->duration_ms)
+    {
+        t = anim->duration_ms;
+    }
+    return t;
+}
+
+/**
+ * @brief Returns 1 once the duration of a finite animation has elapsed.
+ */
+static uint8_t OLED_Anim_Finished(const OLED_Anim_t *anim, uint32_t now_ms)
+{
+    return (uint8_t)(anim->duration_ms != 0 && now_ms - anim->start_ms >= anim->duration_ms);
+}
+
+/**
+ * @brief Returns 1 if the frame to show at now_ms differs from the one shown last.
+ */
+static uint8_t OLED_Anim_Due(const OLED_Anim_t *anim, uint32_t now_ms)
+{
+    return (uint8_t)(OLED_Anim_Finished(anim, now_ms) ||
+                     OLED_Anim_Elapsed(anim, now_ms) / anim->frame_ms != anim->frame);
+}
+
+/**
+ * @brief Draws one spinner frame: small dots, the current one (and its trail) larger.
+ */
+static void OLED_Anim_DrawSpinner(u8g2_t *u8g2, const OLED_AnimSpinner_t *spinner, uint32_t frame)
+{
+    uint8_t head = (uint8_t)(frame % OLED_ANIM_SPINNER_DOTS);
+
+    for (uint8_t i = 0; i < OLED_ANIM_SPINNER_DOTS; i++)
+    {
+        int32_t ux = oled_anim_spinner_dir[i][0];
+        int32_t uy = oled_anim_spinner_dir[i][1];
+        int16_t x = (int16_t)(spinner->cx + (spinner->radius * ux + (ux >= 0 ? 500 : -500)) / 1000);
+        int16_t y = (int16_t)(spinner->cy + (spinner->radius * uy + (uy >= 0 ? 500 : -500)) / 1000);
+
+        if (i == head)
+        {
+            OLED_Raster_Disc(u8g2, x, y, 1, U8G2_DRAW_ALL);
+        }
+        else if (i == (uint8_t)((head + OLED_ANIM_SPINNER_DOTS - 1) % OLED_ANIM_SPINNER_DOTS))
+        {
+            OLED_Raster_Circle(u8g2, x, y, 1, U8G2_DRAW_ALL);
+        }
+        else
+        {
+            u8g2_DrawPixel(u8g2, (u8g2_uint_t)x, (u8g2_uint_t)y);
+        }
+    }
+}
+
+/**
+ * @brief Draws the slide-in text at its eased position (cubic ease-out, 8 bit fixed point).
+ */
+static void OLED_Anim_DrawSlide(u8g2_t *u8g2, const OLED_AnimSlide_t *slide, uint32_t t)
+{
+    uint32_t d = slide->base.duration_ms;
+    int32_t x = slide->x_to;
+
+    if (slide->text == NULL)
+    {
+        return;
+    }
+    if (d != 0 && t < d)
+    {
+        uint32_t rest = ((d - t) << 8) / d;             /* 256 .. 0 */
+        uint32_t ease = (rest * rest * rest) >> 16;     /* (1 - p)^3 */
+
+        x += ((int32_t)(slide->x_from - slide->x_to) * (int32_t)ease) / 256;
+    }
+    if (x < 0)
+    {
+        /* u8g2 positions are unsigned; the text would wrap around */
+        return;
+    }
+    u8g2_SetFont(u8g2, slide->font);
+    u8g2_DrawStr(u8g2, (u8g2_uint_t)x, (u8g2_uint_t)slide->baseline, slide->text);
+}
+
+/**
+ * @brief Draws the progress bar for the elapsed time t.
+ */
+static void OLED_Anim_DrawProgress(u8g2_t *u8g2, const OLED_AnimProgress_t *progress, uint32_t t)
+{
+    const OLED_Anim_t *a = &progress->base;
+    uint32_t inner = (uint32_t)(a->w - 2);
+    uint32_t fill = (a->duration_ms != 0) ? inner * t / a->duration_ms : inner;
+
+    if (progress->countdown)
+    {
+        fill = inner - fill;
+    }
+    u8g2_DrawFrame(u8g2, a->x, a->y, a->w, a->h);
+    if (fill != 0)
+    {
+        u8g2_DrawBox(u8g2, (u8g2_uint_t)(a->x + 1), (u8g2_uint_t)(a->y + 1), (u8g2_uint_t)fill,
+                     (u8g2_uint_t)(a->h - 2));
+    }
+}
+
+/**
+ * @brief Redraws the rectangle of an animation for the time now_ms (frame buffer only).
+ */
+static void OLED_Anim_Draw(u8g2_t *u8g2, OLED_Anim_t *anim, uint32_t now_ms)
+{
+    uint32_t t = OLED_Anim_Elapsed(anim, now_ms);
+    uint8_t finished = OLED_Anim_Finished(anim, now_ms);
+
+    u8g2_SetClipWindow(u8g2, anim->x, anim->y, (u8g2_uint_t)(anim->x + anim->w), (u8g2_uint_t)(anim->y + anim->h));
+    OLED_Region_Clear(u8g2, anim->x, anim->y, anim->w, anim->h);
+    if (!(finished && anim->clear_when_done))
+    {
+        switch (anim->type)
+        {
+        case OLED_ANIM_SPINNER:
+            OLED_Anim_DrawSpinner(u8g2, (const OLED_AnimSpinner_t *)anim, t / anim->frame_ms);
+            break;
+        case OLED_ANIM_SLIDE:
+            OLED_Anim_DrawSlide(u8g2, (const OLED_AnimSlide_t *)anim, t);
+            break;
+        case OLED_ANIM_PROGRESS:
+            OLED_Anim_DrawProgress(u8g2, (const OLED_AnimProgress_t *)anim, t);
+            break;
+        }
+    }
+    u8g2_SetMaxClipWindow(u8g2);
+    anim->frame = t / anim->frame_ms;
+}
+
+/**
+ * @brief Sends the tiles covering the rectangle of an animation.
+ */
+static void OLED_Anim_Send(OLED_Animator_t *animator, const OLED_Anim_t *anim)
+{
+    uint8_t tx = (uint8_t)(anim->x / 8);
+    uint8_t ty = (uint8_t)(anim->y / 8);
+    uint8_t tw = (uint8_t)((anim->x + anim->w + 7) / 8 - tx);
+    uint8_t th = (uint8_t)((anim->y + anim->h + 7) / 8 - ty);
+
+    u8g2_UpdateDisplayArea(animator->u8g2, tx, ty, tw, th);
+    animator->frames++;
+    animator->tiles_sent += (uint32_t)tw * th;
+}
+
+/**
+ * @brief Removes an animation from the active list (frame buffer untouched).
+ */
+static void OLED_Anim_Unlink(OLED_Animator_t *animator, OLED_Anim_t *anim)
+{
+    for (OLED_Anim_t **link = &animator->first; *link != NULL; link = &(*link)->next)
+    {
+        if (*link == anim)
+        {
+            *link = anim->next;
+            break;
+        }
+    }
+    anim->next = NULL;
+    anim->active = 0;
+}
+
+/**
+ * @brief Milliseconds until the next frame of any active animation.
+ *
+ * A frame that is already due (skipped under back-pressure) is retried one frame period later.
+ */
+static uint32_t OLED_Anim_NextDelay(const OLED_Animator_t *animator, uint32_t now_ms)
+{
+    uint32_t delay = OLED_ANIM_IDLE;
+
+    for (const OLED_Anim_t *a = animator->first; a != NULL; a = a->next)
+    {
+        uint32_t t = OLED_Anim_Elapsed(a, now_ms);
+        uint32_t next = (t / a->frame_ms + 1) * a->frame_ms;
+
+        if (a->duration_ms != 0 && next > a->duration_ms)
+        {
+            next = a->duration_ms;
+        }
+        if (next <= t)
+        {
+            next = t + a->frame_ms;
+        }
+        if (next - t < delay)
+        {
+            delay = next - t;
+        }
+    }
+    return delay;
+}
+
+/**
+ * @brief Initializes an animator without active animations.
+ *
+ * @param[out] animator Animator to initialize.
+ * @param[in]  u8g2     Display object (full buffer mode).
+ * @param[in]  busy     Back-pressure query (e.g. "transfers pending"), NULL = never busy.
+ */
+void OLED_Anim_InitAnimator(OLED_Animator_t *animator, u8g2_t *u8g2, uint8_t (*busy)(void))
+{
+    animator->u8g2 = u8g2;
+    animator->first = NULL;
+    animator->busy = busy;
+    animator->frames = 0;
+    animator->dropped = 0;
+    animator->tiles_sent = 0;
+}
+
+/**
+ * @brief Fills the common header of an animation.
+ */
+static void OLED_Anim_InitBase(OLED_Anim_t *anim, OLED_AnimType_t type, u8g2_uint_t x, u8g2_uint_t y,
+                               u8g2_uint_t w, u8g2_uint_t h, uint32_t frame_ms, uint32_t duration_ms)
+{
+    anim->type = type;
+    anim->next = NULL;
+    anim->x = x;
+    anim->y = y;
+    anim->w = w;
+    anim->h = h;
+    anim->frame_ms = (frame_ms != 0) ? frame_ms : 1;
+    anim->duration_ms = duration_ms;
+    anim->start_ms = 0;
+    anim->frame = OLED_ANIM_NO_FRAME;
+    anim->active = 0;
+    anim->clear_when_done = 0;
+}
+
+/**
+ * @brief Sets up a spinner around (cx, cy); it runs until stopped.
+ *
+ * @param[in] frame_ms Time per step of the highlighted dot.
+ */
+void OLED_Anim_InitSpinner(OLED_AnimSpinner_t *spinner, int16_t cx, int16_t cy, uint8_t radius, uint32_t frame_ms)
+{
+    /* The larger dots extend one pixel beyond the circle */
+    OLED_Anim_InitBase(&spinner->base, OLED_ANIM_SPINNER, (u8g2_uint_t)(cx - radius - 1), (u8g2_uint_t)(cy - radius - 1),
+                       (u8g2_uint_t)(2 * radius + 3), (u8g2_uint_t)(2 * radius + 3), frame_ms, 0);
+    spinner->cx = cx;
+    spinner->cy = cy;
+    spinner->radius = radius;
+}
+
+/**
+ * @brief Sets up a slide-in inside the full width band of a text line.
+ *
+ * The band covers the font's bounding box, so no glyph of the font leaves the rectangle.
+ *
+ * @param[in] baseline    Baseline row of the text.
+ * @param[in] duration_ms Slide time; the text stays at x_to afterwards and the animation ends.
+ */
+void OLED_Anim_InitSlide(OLED_AnimSlide_t *slide, u8g2_t *u8g2, const uint8_t *font, int16_t baseline,
+                         uint32_t frame_ms, uint32_t duration_ms)
+{
+    int16_t top;
+    int16_t bottom;
+
+    u8g2_SetFont(u8g2, font);
+    top = (int16_t)(baseline - (u8g2_GetMaxCharHeight(u8g2) + u8g2->font_info.y_offset) + 1);
+    bottom = (int16_t)(baseline - u8g2->font_info.y_offset + 1);
+    if (top < 0)
+    {
+        top = 0;
+    }
+    OLED_Anim_InitBase(&slide->base, OLED_ANIM_SLIDE, 0, (u8g2_uint_t)top, u8g2_GetDisplayWidth(u8g2),
+                       (u8g2_uint_t)(bottom - top), frame_ms, duration_ms);
+    slide->font = font;
+    slide->text = NULL;
+    slide->x_from = 0;
+    slide->x_to = 0;
+    slide->baseline = baseline;
+}
+
+/**
+ * @brief Sets the text and path of a slide-in (call before OLED_Anim_Start()).
+ *
+ * @param[in] text   Text to show; must stay valid while the animation is active.
+ * @param[in] x_from Start position (e.g. the display width to enter from the right).
+ * @param[in] x_to   Final position.
+ */
+void OLED_Anim_SetSlideText(OLED_AnimSlide_t *slide, const char *text, int16_t x_from, int16_t x_to)
+{
+    slide->text = text;
+    slide->x_from = x_from;
+    slide->x_to = x_to;
+}
+
+/**
+ * @brief Sets up a progress bar; it is blanked when the duration has elapsed.
+ *
+ * @param[in] countdown 1 = start full and empty over the duration, 0 = fill up.
+ */
+void OLED_Anim_InitProgress(OLED_AnimProgress_t *progress, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w,
+                            u8g2_uint_t h, uint8_t countdown, uint32_t frame_ms, uint32_t duration_ms)
+{
+    OLED_Anim_InitBase(&progress->base, OLED_ANIM_PROGRESS, x, y, w, h, frame_ms, duration_ms);
+    progress->base.clear_when_done = 1;
+    progress->countdown = countdown;
+}
+
+/**
+ * @brief Starts (or restarts) an animation at now_ms; it is drawn by the next step or compose.
+ */
+void OLED_Anim_Start(OLED_Animator_t *animator, OLED_Anim_t *anim, uint32_t now_ms)
+{
+    if (!anim->active)
+    {
+        OLED_Anim_t **link = &animator->first;
+
+        while (*link != NULL)
+        {
+            link = &(*link)->next;
+        }
+        *link = anim;
+        anim->next = NULL;
+        anim->active = 1;
+    }
+    anim->start_ms = now_ms;
+    anim->frame = OLED_ANIM_NO_FRAME;
+}
+
+/**
+ * @brief Stops an animation and blanks its rectangle in the frame buffer.
+ *
+ * The display is not updated; the caller redraws or sends the area (e.g. with a full frame).
+ */
+void OLED_Anim_Stop(OLED_Animator_t *animator, OLED_Anim_t *anim)
+{
+    if (!anim->active)
+    {
+        return;
+    }
+    OLED_Anim_Unlink(animator, anim);
+    OLED_Region_Clear(animator->u8g2, anim->x, anim->y, anim->w, anim->h);
+}
+
+/**
+ * @brief Draws the current frame of every active animation into the frame buffer without sending.
+ *
+ * Used after a full redraw, before the whole buffer is sent. Animations that have finished are
+ * drawn in their final state and removed.
+ */
+void OLED_Anim_Compose(OLED_Animator_t *animator, uint32_t now_ms)
+{
+    OLED_Anim_t *anim = animator->first;
+
+    while (anim != NULL)
+    {
+        OLED_Anim_t *next = anim->next;
+
+        OLED_Anim_Draw(animator->u8g2, anim, now_ms);
+        if (OLED_Anim_Finished(anim, now_ms))
+        {
+            OLED_Anim_Unlink(animator, anim);
+        }
+        anim = next;
+    }
+}
+
+/**
+ * @brief Draws and sends the animations whose frame changed.
+ *
+ * While the busy callback reports pending transfers nothing is drawn: the due frames are skipped
+ * and the next step shows the frame of its own time. Frames skipped that way (or because the
+ * caller woke up late) are counted in animator->dropped.
+ *
+ * @param[in] now_ms Current time on the same timeline as OLED_Anim_Start() (e.g. RTOS ticks in ms).
+ * @return Milliseconds until the next frame is due, or OLED_ANIM_IDLE if no animation is active.
+ */
+uint32_t OLED_Anim_Step(OLED_Animator_t *animator, uint32_t now_ms)
+{
+    OLED_Anim_t *anim;
+    uint8_t due = 0;
+
+    if (animator->first == NULL)
+    {
+        return OLED_ANIM_IDLE;
+    }
+    for (anim = animator->first; anim != NULL; anim = anim->next)
+    {
+        due |= OLED_Anim_Due(anim, now_ms);
+    }
+    if (due && (animator->busy == NULL || animator->busy() == 0))
+    {
+        anim = animator->first;
+        while (anim != NULL)
+        {
+            OLED_Anim_t *next = anim->next;
+
+            if (OLED_Anim_Due(anim, now_ms))
+            {
+                uint32_t frame = OLED_Anim_Elapsed(anim, now_ms) / anim->frame_ms;
+
+                if (anim->frame != OLED_ANIM_NO_FRAME && frame > anim->frame + 1)
+                {
+                    animator->dropped += frame - anim->frame - 1;
+                }
+                OLED_Anim_Draw(animator->u8g2, anim, now_ms);
+                OLED_Anim_Send(animator, anim);
+                if (OLED_Anim_Finished(anim, now_ms))
+                {
+                    OLED_Anim_Unlink(animator, anim);
+                }
+            }
+            anim = next;
+        }
+    }
+    return OLED_Anim_NextDelay(animator, now_ms);
+}
@@ -0,0 +1,188 @@
+/**
+ * @file oled_anim.h
+ * @author Ted Wang
+ * @date 2026-10-17
+ * @brief Time-based animation scheduler (spinner, slide-in, progress bar) for the u8g2 full buffer.
+ *
+ * Every animation owns a rectangle of the display and draws its frame as a function of the time
+ * since it was started, never of the number of frames shown. A late or skipped frame therefore does
+ * not slow an animation down; the next frame simply shows the state of the current time.
+ *
+ * OLED_Anim_Step() is called by the display task whenever the delay it returned last time has
+ * expired. It redraws only the animations whose frame index (elapsed time / frame period) changed,
+ * with the u8g2 clip window set to the animation's rectangle, and sends just the tiles covering that
+ * rectangle with u8g2_UpdateDisplayArea(). If the busy callback reports that the transfer queue is
+ * still occupied, the due frames are dropped (counted) instead of queueing more data behind it.
+ * Without active animations the step returns OLED_ANIM_IDLE, so the caller can block indefinitely
+ * and the scheduler costs neither CPU time nor I2C bandwidth.
+ *
+ * The rest of the frame buffer is left untouched, so static content drawn by the application is
+ * kept; after a full redraw OLED_Anim_Compose() puts the current animation frames back in place
+ * before the buffer is sent. Requires OLED_BUFFER_MODE_FULL.
+ */
+
+#ifndef OLED_ANIM_H
+#define OLED_ANIM_H
+
+#include "u8g2.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @def OLED_ANIM_IDLE
+ * @brief Return value of OLED_Anim_Step() when no animation is active (wait forever).
+ */
+#define OLED_ANIM_IDLE              0xFFFFFFFFUL
+
+/**
+ * @def OLED_ANIM_SPINNER_DOTS
+ * @brief Number of dots on the spinner circle.
+ */
+#define OLED_ANIM_SPINNER_DOTS      8
+
+/**
+ * @brief Animation types.
+ */
+typedef enum {
+    OLED_ANIM_SPINNER = 0,          /**< Dots on a circle, one highlighted dot per frame (endless) */
+    OLED_ANIM_SLIDE,                /**< Text sliding horizontally into place (ease-out) */
+    OLED_ANIM_PROGRESS              /**< Bar filling up (or emptying) over the duration */
+} OLED_AnimType_t;
+
+struct OLED_Animator_s;
+
+/**
+ * @brief Common animation header (first member of every animation).
+ */
+typedef struct OLED_Anim_s {
+    OLED_AnimType_t type;               /**< Animation type */
+    struct OLED_Anim_s *next;           /**< Next active animation */
+    u8g2_uint_t x;                      /**< Left edge of the animated rectangle */
+    u8g2_uint_t y;                      /**< Top edge of the animated rectangle */
+    u8g2_uint_t w;                      /**< Width */
+    u8g2_uint_t h;                      /**< Height */
+    uint32_t frame_ms;                  /**< Frame period (milliseconds) */
+    uint32_t duration_ms;               /**< Run time, 0 = until stopped */
+    uint32_t start_ms;                  /**< Start time on the caller's timeline */
+    uint32_t frame;                     /**< Index of the frame shown last */
+    uint8_t active;                     /**< 1 while on the animator's list */
+    uint8_t clear_when_done;            /**< 1 = blank the rectangle after the last frame */
+} OLED_Anim_t;
+
+/**
+ * @brief Spinner: OLED_ANIM_SPINNER_DOTS dots on a circle, a large dot running around it.
+ */
+typedef struct {
+    OLED_Anim_t base;               /**< Animation header (rectangle derived from center/radius) */
+    int16_t cx;                     /**< Center column */
+    int16_t cy;                     /**< Center row */
+    uint8_t radius;                 /**< Circle radius */
+} OLED_AnimSpinner_t;
+
+/**
+ * @brief Slide-in: a line of text moving from x_from to x_to (decelerating).
+ */
+typedef struct {
+    OLED_Anim_t base;               /**< Animation header (full width band of the text line) */
+    const uint8_t *font;            /**< u8g2 font */
+    const char *text;               /**< Text (owned by the caller, must stay valid while active) */
+    int16_t x_from;                 /**< Text position at the start */
+    int16_t x_to;                   /**< Final text position */
+    int16_t baseline;               /**< Baseline row */
+} OLED_AnimSlide_t;
+
+/**
+ * @brief Progress bar: frame with a fill proportional to the elapsed part of the duration.
+ */
+typedef struct {
+    OLED_Anim_t base;               /**< Animation header (bar rectangle) */
+    uint8_t countdown;              /**< 1 = start full and empty over the duration */
+} OLED_AnimProgress_t;
+
+/**
+ * @brief Scheduler: list of active animations and frame statistics.
+ */
+typedef struct OLED_Animator_s {
+    u8g2_t *u8g2;                   /**< Display object (full buffer mode) */
+    OLED_Anim_t *first;             /**< First active animation (drawing order) */
+    uint8_t (*busy)(void);          /**< Returns non-zero while the transfer queue is occupied, or NULL */
+    uint32_t frames;                /**< Animation frames sent (profiling) */
+    uint32_t dropped;               /**< Frames skipped because of back-pressure or late steps */
+    uint32_t tiles_sent;            /**< Tiles sent (profiling) */
+} OLED_Animator_t;
+
+
+/**
+ * @brief Initializes an animator without active animations.
+ *
+ * @param[out] animator Animator to initialize.
+ * @param[in]  u8g2     Display object (full buffer mode).
+ * @param[in]  busy     Back-pressure query (e.g. "transfers pending"), NULL = never busy.
+ */
+void OLED_Anim_InitAnimator(OLED_Animator_t *animator, u8g2_t *u8g2, uint8_t (*busy)(void));
+
+
+/**
+ * @brief Sets up a spinner around (cx, cy).
+ */
+void OLED_Anim_InitSpinner(OLED_AnimSpinner_t *spinner, int16_t cx, int16_t cy, uint8_t radius, uint32_t frame_ms);
+
+
+/**
+ * @brief Sets up a slide-in inside the full width band of a text line.
+ *
+ * @param[in] baseline Baseline row; the band covers the font's ascent and descent.
+ * @param[in] duration_ms Slide time; the text stays at x_to afterwards and the animation ends.
+ */
+void OLED_Anim_InitSlide(OLED_AnimSlide_t *slide, u8g2_t *u8g2, const uint8_t *font, int16_t baseline,
+                         uint32_t frame_ms, uint32_t duration_ms);
+
+
+/**
+ * @brief Sets the text and path of a slide-in (call before OLED_Anim_Start()).
+ */
+void OLED_Anim_SetSlideText(OLED_AnimSlide_t *slide, const char *text, int16_t x_from, int16_t x_to);
+
+
+/**
+ * @brief Sets up a progress bar; it is blanked when the duration has elapsed.
+ */
+void OLED_Anim_InitProgress(OLED_AnimProgress_t *progress, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w,
+                            u8g2_uint_t h, uint8_t countdown, uint32_t frame_ms, uint32_t duration_ms);
+
+
+/**
+ * @brief Starts (or restarts) an animation at now_ms; it is drawn by the next step or compose.
+ */
+void OLED_Anim_Start(OLED_Animator_t *animator, OLED_Anim_t *anim, uint32_t now_ms);
+
+
+/**
+ * @brief Stops an animation and blanks its rectangle in the frame buffer (not sent).
+ */
+void OLED_Anim_Stop(OLED_Animator_t *animator, OLED_Anim_t *anim);
+
+
+/**
+ * @brief Draws the current frame of every active animation into the frame buffer without sending.
+ *
+ * Used after a full redraw, before the whole buffer is sent.
+ */
+void OLED_Anim_Compose(OLED_Animator_t *animator, uint32_t now_ms);
+
+
+/**
+ * @brief Draws and sends the animations whose frame changed.
+ *
+ * @param[in] now_ms Current time on the same timeline as OLED_Anim_Start() (e.g. RTOS ticks in ms).
+ * @return Milliseconds until the next frame is due, or OLED_ANIM_IDLE if no animation is active.
+ */
+uint32_t OLED_Anim_Step(OLED_Animator_t *animator, uint32_t now_ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // OLED_ANIM_H
@@ -0,0 +1,68 @@
+
+/**
+ * @file oled_blit.h
+ * @author Ted Wang
+ * @date 2026-10-17
+ * @brief Blitter for images in the native (vertical byte) format of the SH1106 / u8g2 buffer.
+ *
+ * u8g2_DrawXBM() and u8g2_DrawBitmap() take row-major bitmaps and draw them one horizontal run
+ * at a time through the hvline callback chain, which converts every run back into vertical bytes.
+ * Images converted ahead of time into the display's own layout (one byte = 8 vertical pixels, LSB
+ * on top, one row of bytes per 8 pixel band) can instead be combined with the frame buffer byte by
+ * byte: each destination byte is read and written once, and four columns are shifted and combined
+ * per 32-bit word.
+ *
+ * Images are produced by Tools/oled_img/png2oled.py, which writes OLED_Image_t definitions.
+ *
+ * The blitter writes the u8g2 tile buffer directly, so it assumes U8G2_R0 and a vertical-byte
+ * display (SH1106/SSD1306). It clips against the display, the current page (page modes) and the
+ * u8g2 clip window; the draw color is ignored.
+ */
+
+#ifndef OLED_BLIT_H
+#define OLED_BLIT_H
+
+#include "u8g2.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Image in native vertical byte format.
+ *
+ * data holds (height + 7) / 8 rows of width bytes; bit n of a byte is the pixel n rows below the
+ * top of its 8 pixel band. Bits below height in the last band must be zero.
+ */
+typedef struct {
+    uint8_t width;              /**< Width in pixels (bytes per band) */
+    uint8_t height;             /**< Height in pixels */
+    const uint8_t *data;        /**< Pixel data, (height + 7) / 8 * width bytes */
+} OLED_Image_t;
+
+/**
+ * @brief Combination of the image with the frame buffer.
+ */
+typedef enum {
+    OLED_BLIT_OR = 0,           /**< Set pixels set in the image (transparent background, like XBM) */
+    OLED_BLIT_AND,              /**< Clear pixels of the image area that are clear in the image */
+    OLED_BLIT_XOR               /**< Invert pixels set in the image */
+} OLED_BlitMode_t;
+
+
+/**
+ * @brief Draws a native image into the current u8g2 buffer (full frame or current page).
+ *
+ * @param[in] u8g2  Display object (U8G2_R0).
+ * @param[in] x     Left edge; may be negative or extend past the display (clipped).
+ * @param[in] y     Top edge; may be negative or extend past the display (clipped).
+ * @param[in] image Image to draw.
+ * @param[in] mode  Combination with the frame buffer.
+ */
+void OLED_Blit(u8g2_t *u8g2, int16_t x, int16_t y, const OLED_Image_t *image, OLED_BlitMode_t mode);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // OLED_BLIT_H
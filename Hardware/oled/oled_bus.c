@@ -0,0 +1,220 @@
+/**
+ * @file oled_bus.c
+ * @author Ted Wang
+ * @date 2026-10-17
+ * @brief Transfer scheduler for several displays sharing one I2C bus (priority and deadline).
+ *
+ * This file provides:
+ *   - Per display transfer rings (reserve, commit with the frame deadline, complete, flush)
+ *   - Next transfer selection: overdue heads earliest deadline first, then by priority
+ *   - Transfer, byte, late and display switch counters for the bus benchmark
+ */
+
+#include "oled_bus.h"
+#include <stddef.h>
+
+/**
+ * @brief Returns 1 if deadline a is earlier than deadline b (wrap-around safe).
+ */
+static uint8_t OLED_Bus_Earlier(uint32_t a, uint32_t b)
+{
+    return (uint8_t)((int32_t)(a - b) < 0);
+}
+
+/**
+ * @brief Returns 1 if the deadline has passed at now_ms (wrap-around safe).
+ */
+static uint8_t OLED_Bus_Overdue(uint32_t deadline_ms, uint32_t now_ms)
+{
+    return (uint8_t)((int32_t)(now_ms - deadline_ms) > 0);
+}
+
+/**
+ * @brief Initializes an idle bus without queues.
+ */
+void OLED_Bus_Init(OLED_Bus_t *bus)
+{
+    bus->count = 0;
+    bus->active = NULL;
+    bus->last = NULL;
+    bus->switches = 0;
+}
+
+/**
+ * @brief Registers an empty queue with its priority and latency target.
+ */
+uint8_t OLED_Bus_AddQueue(OLED_Bus_t *bus, OLED_BusQueue_t *queue, uint8_t priority, uint32_t latency_ms, void *context)
+{
+    if (bus->count >= OLED_BUS_MAX_QUEUES)
+    {
+        return 0;
+    }
+    queue->head = 0;
+    queue->tail = 0;
+    queue->count = 0;
+    queue->priority = priority;
+    queue->latency_ms = latency_ms;
+    queue->deadline_ms = 0;
+    queue->frame_done = 1;
+    queue->context = context;
+    queue->transfers = 0;
+    queue->bytes = 0;
+    queue->late = 0;
+    bus->queues[bus->count++] = queue;
+    return 1;
+}
+
+/**
+ * @brief Returns the slot at the head of the queue (the caller owns a free slot).
+ */
+OLED_BusSlot_t *OLED_Bus_Reserve(OLED_BusQueue_t *queue)
+{
+    return &queue->slots[queue->head];
+}
+
+/**
+ * @brief Commits the reserved slot; returns 1 if the bus is idle and has to be started.
+ */
+uint8_t OLED_Bus_Commit(OLED_Bus_t *bus, OLED_BusQueue_t *queue, uint32_t now_ms)
+{
+    if (queue->frame_done || queue->count == 0)
+    {
+        queue->deadline_ms = now_ms + queue->latency_ms;
+        queue->frame_done = 0;
+    }
+    queue->slots[queue->head].deadline_ms = queue->deadline_ms;
+    queue->head = (uint8_t)((queue->head + 1) % OLED_BUS_QUEUE_SLOTS);
+    queue->count++;
+    return (uint8_t)(bus->active == NULL);
+}
+
+/**
+ * @brief Marks the end of a frame; the next commit starts a new frame deadline.
+ */
+void OLED_Bus_EndFrame(OLED_BusQueue_t *queue)
+{
+    queue->frame_done = 1;
+}
+
+/**
+ * @brief Picks the next transfer: overdue heads earliest deadline first, then the highest priority.
+ */
+OLED_BusSlot_t *OLED_Bus_Next(OLED_Bus_t *bus, uint32_t now_ms)
+{
+    OLED_BusQueue_t *best = NULL;
+    uint8_t best_overdue = 0;
+
+    if (bus->active != NULL)
+    {
+        return NULL;
+    }
+    for (uint8_t i = 0; i < bus->count; i++)
+    {
+        OLED_BusQueue_t *queue = bus->queues[i];
+        uint32_t deadline;
+        uint8_t overdue;
+
+        if (queue->count == 0)
+        {
+            continue;
+        }
+        deadline = queue->slots[queue->tail].deadline_ms;
+        overdue = OLED_Bus_Overdue(deadline, now_ms);
+        if (best == NULL)
+        {
+            best = queue;
+            best_overdue = overdue;
+            continue;
+        }
+        {
+            uint32_t best_deadline = best->slots[best->tail].deadline_ms;
+
+            if (overdue != best_overdue)
+            {
+                /* An overdue head beats any priority */
+                if (overdue)
+                {
+                    best = queue;
+                    best_overdue = 1;
+                }
+            }
+            else if (!overdue && queue->priority != best->priority)
+            {
+                if (queue->priority > best->priority)
+                {
+                    best = queue;
+                }
+            }
+            else if (OLED_Bus_Earlier(deadline, best_deadline))
+            {
+                best = queue;
+            }
+        }
+    }
+    if (best == NULL)
+    {
+        return NULL;
+    }
+    if (bus->last != NULL && bus->last != best)
+    {
+        bus->switches++;
+    }
+    bus->active = best;
+    bus->last = best;
+    return &best->slots[best->tail];
+}
+
+/**
+ * @brief Completes the transfer in flight and counts it late if its deadline has passed.
+ */
+OLED_BusQueue_t *OLED_Bus_Complete(OLED_Bus_t *bus, uint32_t now_ms)
+{
+    OLED_BusQueue_t *queue = bus->active;
+    OLED_BusSlot_t *slot;
+
+    if (queue == NULL)
+    {
+        return NULL;
+    }
+    slot = &queue->slots[queue->tail];
+    queue->transfers++;
+    queue->bytes += slot->len;
+    if (OLED_Bus_Overdue(slot->deadline_ms, now_ms))
+    {
+        queue->late++;
+    }
+    queue->tail = (uint8_t)((queue->tail + 1) % OLED_BUS_QUEUE_SLOTS);
+    queue->count--;
+    bus->active = NULL;
+    return queue;
+}
+
+/**
+ * @brief Drops every committed transfer of a queue; returns the number of slots freed.
+ */
+uint8_t OLED_Bus_FlushQueue(OLED_Bus_t *bus, OLED_BusQueue_t *queue)
+{
+    uint8_t dropped = queue->count;
+
+    queue->count = 0;
+    queue->tail = queue->head;
+    if (bus->active == queue)
+    {
+        bus->active = NULL;
+    }
+    return dropped;
+}
+
+/**
+ * @brief Returns the number of committed transfers of all queues.
+ */
+uint8_t OLED_Bus_Pending(const OLED_Bus_t *bus)
+{
+    uint8_t pending = 0;
+
+    for (uint8_t i = 0; i < bus->count; i++)
+    {
+        pending = (uint8_t)(pending + bus->queues[i]->count);
+    }
+    return pending;
+}
@@ -0,0 +1,162 @@
+/**
+ * @file oled_bus.h
+ * @author Ted Wang
+ * @date 2026-10-17
+ * @brief Transfer scheduler for several displays sharing one I2C bus (priority and deadline).
+ *
+ * Every display owns a FIFO of transfers (one u8x8 START/END_TRANSFER each, at most 32 bytes).
+ * The bus sends one transfer at a time and picks the next one at every transfer boundary:
+ *   1. heads whose deadline has passed go first, earliest deadline first, so a low priority display
+ *      is delayed but never starved;
+ *   2. otherwise the head of the highest priority queue is sent, ties broken by the earlier deadline.
+ * The deadline belongs to a frame: the first transfer committed after OLED_Bus_EndFrame() (or into an
+ * empty queue) starts a new frame with deadline = commit time + latency target of the queue, and
+ * the following transfers inherit it. A display that keeps its queue full therefore cannot push its
+ * deadline ahead of itself transfer by transfer; once its frame is late, the rest of that frame is
+ * sent ahead of higher priority displays. Switching displays between transfers is safe because
+ * every transfer starts with its own control byte and each SH1106 keeps its own page/column state;
+ * the order within one display is never changed.
+ *
+ * The scheduler is plain data and does not lock: the caller serializes Commit() against Next() and
+ * Complete() (critical section in task context, the transfer-complete interrupt otherwise).
+ */
+
+#ifndef OLED_BUS_H
+#define OLED_BUS_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @def OLED_BUS_QUEUE_SLOTS
+ * @brief Transfers queued per display (ten slots hold one complete display page).
+ */
+#ifndef OLED_BUS_QUEUE_SLOTS
+#define OLED_BUS_QUEUE_SLOTS         10
+#endif
+
+/**
+ * @def OLED_BUS_MAX_QUEUES
+ * @brief Number of displays (queues) one bus can serve.
+ */
+#ifndef OLED_BUS_MAX_QUEUES
+#define OLED_BUS_MAX_QUEUES          2
+#endif
+
+/**
+ * @brief One queued transfer.
+ */
+typedef struct {
+    uint8_t data[32];               /**< Transfer payload (control byte + data) */
+    uint8_t len;                    /**< Number of valid bytes in data */
+    uint8_t addr;                   /**< 8-bit I2C write address */
+    uint32_t deadline_ms;           /**< Deadline of the frame the transfer belongs to */
+} OLED_BusSlot_t;
+
+/**
+ * @brief Transfer queue of one display.
+ */
+typedef struct {
+    OLED_BusSlot_t slots[OLED_BUS_QUEUE_SLOTS];    /**< Ring of transfers */
+    volatile uint8_t head;          /**< Next slot to fill */
+    volatile uint8_t tail;          /**< Oldest committed slot (sent next, or in flight) */
+    volatile uint8_t count;         /**< Committed slots that have not completed */
+    uint8_t priority;               /**< Higher value is served first */
+    uint32_t latency_ms;            /**< Frame deadline relative to the frame's first commit */
+    uint32_t deadline_ms;           /**< Deadline of the current frame */
+    uint8_t frame_done;             /**< 1 = the next commit starts a new frame */
+    void *context;                  /**< Owner (e.g. the display), for completion handling */
+    uint32_t transfers;             /**< Completed transfers (profiling) */
+    uint32_t bytes;                 /**< Completed bytes (profiling) */
+    uint32_t late;                  /**< Transfers completed after their deadline */
+} OLED_BusQueue_t;
+
+/**
+ * @brief Bus: registered queues and the transfer in flight.
+ */
+typedef struct {
+    OLED_BusQueue_t *queues[OLED_BUS_MAX_QUEUES];  /**< Registered queues */
+    uint8_t count;                  /**< Number of registered queues */
+    OLED_BusQueue_t *active;        /**< Queue whose head is in flight, NULL when the bus is idle */
+    OLED_BusQueue_t *last;          /**< Queue of the previous transfer (switch counting) */
+    uint32_t switches;              /**< Transfers that changed the display (profiling) */
+} OLED_Bus_t;
+
+
+/**
+ * @brief Initializes an idle bus without queues.
+ */
+void OLED_Bus_Init(OLED_Bus_t *bus);
+
+
+/**
+ * @brief Registers an empty queue.
+ *
+ * @param[in] priority   Higher value is served first while no deadline has passed.
+ * @param[in] latency_ms Latency target of one frame (deadline = first commit of the frame + latency_ms).
+ * @param[in] context    Owner handed back by OLED_Bus_Complete() via the queue.
+ * @return 1 on success, 0 if OLED_BUS_MAX_QUEUES queues are registered already.
+ */
+uint8_t OLED_Bus_AddQueue(OLED_Bus_t *bus, OLED_BusQueue_t *queue, uint8_t priority, uint32_t latency_ms, void *context);
+
+
+/**
+ * @brief Returns the slot to fill next (the caller must own a free slot of the queue).
+ */
+OLED_BusSlot_t *OLED_Bus_Reserve(OLED_BusQueue_t *queue);
+
+
+/**
+ * @brief Commits the reserved slot with the deadline of the current frame.
+ *
+ * The first commit after OLED_Bus_EndFrame(), or into an empty queue, starts a new frame with
+ * deadline now_ms + latency target.
+ *
+ * @return 1 if the bus is idle and the caller has to start it with OLED_Bus_Next().
+ */
+uint8_t OLED_Bus_Commit(OLED_Bus_t *bus, OLED_BusQueue_t *queue, uint32_t now_ms);
+
+
+/**
+ * @brief Marks the end of a frame; the next commit starts a new frame deadline.
+ */
+void OLED_Bus_EndFrame(OLED_BusQueue_t *queue);
+
+
+/**
+ * @brief Picks the next transfer and marks it in flight.
+ *
+ * @return Slot to send, or NULL when nothing is queued (or a transfer is already in flight).
+ */
+OLED_BusSlot_t *OLED_Bus_Next(OLED_Bus_t *bus, uint32_t now_ms);
+
+
+/**
+ * @brief Completes the transfer in flight; the bus is idle afterwards.
+ *
+ * @return Queue whose slot was freed, or NULL if nothing was in flight.
+ */
+OLED_BusQueue_t *OLED_Bus_Complete(OLED_Bus_t *bus, uint32_t now_ms);
+
+
+/**
+ * @brief Drops every committed transfer of a queue (an in-flight head included).
+ *
+ * @return Number of slots freed.
+ */
+uint8_t OLED_Bus_FlushQueue(OLED_Bus_t *bus, OLED_BusQueue_t *queue);
+
+
+/**
+ * @brief Returns the number of committed transfers of all queues.
+ */
+uint8_t OLED_Bus_Pending(const OLED_Bus_t *bus);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // OLED_BUS_H
@@ -3,31 +3,502 @@
  * @file oled_driver.c
  * @author Ted Wang
  * @date 2025-08-01
- * @brief OLED driver implementation for STM32 using u8g2 library (I2C, delay, and display access).
+ * @brief OLED driver implementation for STM32 using u8g2 library (I2C/SPI, delay, and display access).
  *
  * This file provides the implementation of the OLED driver for the NUCLEO-F429ZI board, including:
  *   - STM32-specific I2C byte transfer and delay callback functions for the u8g2/u8x8 library
- *   - Initialization of the SH1106-based 128x64 OLED display
- *   - Accessor for the internal u8g2 display object
+ *   - Initialization of SH1106-based 128x64 OLED displays (full buffer or page mode), one
+ *     OLED_Display_t per panel, each with its own u8g2 object and frame buffer
+ *   - Accessors for the driver's inside display (OLED_Init(), OLED_GetDisplay())
+ *   - An optional DMA transfer queue per display, interleaved on I2C2 by the bus scheduler
+ *     (oled_bus.h), so that I2C transfers overlap with rendering
+ *   - Bounded-latency transfers: every transfer and queue wait has a deadline; a failed or stuck
+ *     transfer triggers a bus recovery (I2C2_BusRecover()), the incomplete frame is re-sent, and a
+ *     display that stops answering is taken offline (transfers dropped, probed periodically)
+ *   - A hardware SPI transport (SPI4 with DMA, DC/CS/RES on GPIO) for a SPI panel, selected with
+ *     OLED_Init(); its byte runs go through the same queue and scheduler as the I2C transfers
  *
  * The driver is designed for use with the CMSIS HAL and u8g2 graphics library.
  */
 
 #include "oled_driver.h"
 #include "i2c.h"
+#include "spi.h"
+#include "timing.h"
+#include "ccmram.h"
+#include "rtos_objects.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include <string.h>
 
 /**
- * @brief u8g2 display object (file scope only).
+ * @brief Inside display, used by the functions without a display argument (file scope only).
+ */
+static OLED_Display_t oled_inside;
+
+/**
+ * @brief Displays set up on I2C2 and SPI4 (recovery and probing iterate over the I2C ones).
+ */
+static OLED_Display_t *oled_displays[OLED_MAX_DISPLAYS];
+static uint8_t oled_display_count;
+
+/**
+ * @brief Frame buffers of the registered displays, in CCM RAM (rendered by the CPU, copied into the
+ *        SRAM bus slots by the u8x8 byte callbacks, never read by DMA).
+ */
+static uint8_t oled_frame_buffers[OLED_MAX_DISPLAYS][OLED_BUFFER_TILE_ROWS * 128] CCM_RAM;
+
+/**
+ * @brief Control blocks of the displays' free_slots semaphores (static, CCM RAM).
+ */
+static StaticSemaphore_t oled_free_slots_cb[OLED_MAX_DISPLAYS] CCM_RAM;
+
+/**
+ * @brief Bus-wide transport counters (errors, timeouts, recoveries; task and ISR context).
+ */
+static OLED_I2C_Stats_t i2c_stats;
+
+/**
+ * @brief Bus fault flag, set by the error interrupt (DMA) until a task has recovered the bus.
  *
- * This static object holds the state and configuration for the SH1106 OLED display.
+ * Per display state lives in OLED_Display_t: offline (the display did not answer after a recovery;
+ * its transfers are dropped and it is probed every OLED_I2C_PROBE_MS by OLED_Display_Repair()),
+ * resend (a frame reached the panel incompletely) and reinit (the display came back and may have
+ * lost power).
+ */
+static volatile uint8_t i2c_fault;
+
+/**
+ * @brief Start time of the DMA transfer in flight (OS ticks), the reference of the stuck-bus check.
+ */
+static volatile uint32_t i2c_start_ms;
+
+#if OLED_I2C_USE_DMA
+/**
+ * @brief Bus hold flag: while set, OLED_I2C_StartNext() starts no DMA transfer, so a task holding
+ *        i2c_bus_lock can use hi2c2 for blocking probes and recovery (see OLED_I2C_Hold()).
  */
-static u8g2_t u8g2;
+static volatile uint8_t i2c_hold;
+#endif
+
+/**
+ * @brief Serializes bus recovery (and blocking transfers) between tasks driving different displays.
+ */
+static osMutexId_t i2c_bus_lock;
+static StaticSemaphore_t i2c_bus_lock_cb CCM_RAM;
+
+/**
+ * @brief Bus schedulers: one transfer queue per display, interleaved by priority and deadline.
+ *
+ * Slots are filled at the queue head by the display's task and sent by the DMA completion
+ * interrupt in the order chosen by OLED_Bus_Next(). A display's free_slots semaphore counts the
+ * slots available to its task. I2C2 serves the I2C displays (with OLED_I2C_USE_DMA), SPI4 the
+ * SPI display.
+ */
+static OLED_Bus_t i2c_bus;
+static OLED_Bus_t spi_bus;
+
+/**
+ * @brief Slot that collects the bytes of a transfer which is dropped (display offline, bus fault).
+ */
+static OLED_BusSlot_t oled_discard;
+
+/**
+ * @brief Drops the queues of all displays on a bus and frees their slots (interrupts masked or ISR context).
+ */
+static void OLED_FlushBus(OLED_Bus_t *bus)
+{
+    for (uint8_t i = 0; i < bus->count; i++)
+    {
+        OLED_BusQueue_t *queue = bus->queues[i];
+        uint8_t dropped = OLED_Bus_FlushQueue(bus, queue);
+
+        while (dropped-- != 0)
+        {
+            osSemaphoreRelease(((OLED_Display_t *)queue->context)->free_slots);
+        }
+    }
+}
+
+/**
+ * @brief Checks that the bus makes progress (task context).
+ *
+ * A transfer carries at most 32 bytes, 0.8 ms at 400 kHz; one that has not completed (no transfer
+ * complete or error interrupt) within OLED_I2C_TIMEOUT_MS of its start means a stuck bus, and the
+ * queues are dropped as after an error. Waits for a queue slot are no such sign: on a healthy bus
+ * they last as long as the transfers of other displays scheduled ahead.
+ *
+ * @return 1 if the bus is faulted and needs OLED_I2C_Recover().
+ */
+static uint8_t OLED_I2C_CheckProgress(void)
+{
+    taskENTER_CRITICAL();
+    if (i2c_bus.active != NULL && osKernelGetTickCount() - i2c_start_ms >= OLED_I2C_TIMEOUT_MS)
+    {
+        i2c_stats.timeouts++;
+        i2c_fault = 1;
+        OLED_FlushBus(&i2c_bus);
+    }
+    taskEXIT_CRITICAL();
+    return i2c_fault;
+}
+
+#if OLED_I2C_USE_DMA
+
+/**
+ * @brief Drops every queued transfer and flags the bus for recovery (interrupts masked or ISR context).
+ */
+static void OLED_I2C_TransferFailed(void)
+{
+    i2c_stats.errors++;
+    i2c_fault = 1;
+    OLED_FlushBus(&i2c_bus);
+}
+
+/**
+ * @brief Starts the DMA transfer the scheduler picks next (interrupts masked or ISR context).
+ */
+static void OLED_I2C_StartNext(void)
+{
+    OLED_BusSlot_t *slot;
+
+    if (i2c_hold)
+    {
+        /* Committed transfers wait in their queues until OLED_I2C_Release() */
+        return;
+    }
+    slot = OLED_Bus_Next(&i2c_bus, osKernelGetTickCount());
+    if (slot != NULL)
+    {
+        i2c_start_ms = osKernelGetTickCount();
+        if (HAL_I2C_Master_Transmit_DMA(&hi2c2, slot->addr, slot->data, slot->len) != HAL_OK)
+        {
+            /* Could not start (e.g. BUSY stuck): the task recovers the bus */
+            OLED_I2C_TransferFailed();
+        }
+    }
+}
+
+/**
+ * @brief Completes the transfer in flight, frees its slot and starts the next one (ISR context).
+ */
+static void OLED_I2C_TransferDone(void)
+{
+    OLED_BusQueue_t *queue = OLED_Bus_Complete(&i2c_bus, osKernelGetTickCount());
+
+    if (queue != NULL)
+    {
+        osSemaphoreRelease(((OLED_Display_t *)queue->context)->free_slots);
+    }
+    OLED_I2C_StartNext();
+}
+
+/**
+ * @brief HAL I2C master transmit complete callback.
+ * @param hi2c I2C handle that completed the transfer
+ */
+void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+    if (hi2c->Instance == I2C2)
+    {
+        OLED_I2C_TransferDone();
+    }
+}
+
+/**
+ * @brief HAL I2C error callback. The queues are dropped; the tasks recover the bus and re-send their frames.
+ * @param hi2c I2C handle that reported the error
+ */
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c)
+{
+    if (hi2c->Instance == I2C2)
+    {
+        OLED_I2C_TransferFailed();
+    }
+}
+
+/**
+ * @brief Takes hi2c2 from the DMA scheduler for blocking use (task context, i2c_bus_lock held).
+ *
+ * No new transfer is started from now on, and the transfer in flight is waited for; one that does
+ * not complete in time is dropped with the queues (OLED_I2C_CheckProgress()). Always pair with
+ * OLED_I2C_Release().
+ *
+ * @retval 1 The bus is idle.
+ * @retval 0 The bus is faulted and needs OLED_I2C_Recover().
+ */
+static uint8_t OLED_I2C_Hold(void)
+{
+    i2c_hold = 1;
+    while (i2c_bus.active != NULL && !OLED_I2C_CheckProgress())
+    {
+        osDelay(1);
+    }
+    return (uint8_t)!i2c_fault;
+}
+
+/**
+ * @brief Hands hi2c2 back to the DMA scheduler and starts the transfers committed meanwhile (task context).
+ */
+static void OLED_I2C_Release(void)
+{
+    taskENTER_CRITICAL();
+    i2c_hold = 0;
+    if (!i2c_fault)
+    {
+        OLED_I2C_StartNext();
+    }
+    taskEXIT_CRITICAL();
+}
+#else
+/**
+ * @brief Blocking transfers run under i2c_bus_lock, which is all the hold a probe needs.
+ */
+static uint8_t OLED_I2C_Hold(void)
+{
+    return 1;
+}
+
+/**
+ * @brief Counterpart of OLED_I2C_Hold(); nothing to restart without DMA.
+ */
+static void OLED_I2C_Release(void)
+{
+}
+#endif
+
+/**
+ * @brief Drops the SPI queue after a DMA error or timeout; the frame is re-sent by OLED_Display_Repair()
+ *        (interrupts masked or ISR context).
+ */
+static void OLED_SPI_TransferFailed(void)
+{
+    for (uint8_t i = 0; i < spi_bus.count; i++)
+    {
+        OLED_Display_t *display = (OLED_Display_t *)spi_bus.queues[i]->context;
+
+        display->stats.errors++;
+        display->resend = 1;
+    }
+    OLED_FlushBus(&spi_bus);
+    HAL_GPIO_WritePin(OLED_CS_GPIO_Port, OLED_CS_Pin, GPIO_PIN_SET);
+}
+
+/**
+ * @brief Starts the DMA transfer of the next SPI run, or deselects the panel when the queue is empty
+ *        (interrupts masked or ISR context).
+ */
+static void OLED_SPI_StartNext(void)
+{
+    OLED_BusSlot_t *slot = OLED_Bus_Next(&spi_bus, osKernelGetTickCount());
+
+    if (slot == NULL)
+    {
+        HAL_GPIO_WritePin(OLED_CS_GPIO_Port, OLED_CS_Pin, GPIO_PIN_SET);
+        return;
+    }
+    /* The previous run has left the shift register (the HAL waits for BSY before the callback),
+       so DC can change; slot->addr holds the DC level of the run */
+    HAL_GPIO_WritePin(OLED_DC_GPIO_Port, OLED_DC_Pin, slot->addr ? GPIO_PIN_SET : GPIO_PIN_RESET);
+    HAL_GPIO_WritePin(OLED_CS_GPIO_Port, OLED_CS_Pin, GPIO_PIN_RESET);
+    if (HAL_SPI_Transmit_DMA(&hspi4, slot->data, slot->len) != HAL_OK)
+    {
+        OLED_SPI_TransferFailed();
+    }
+}
+
+/**
+ * @brief HAL SPI transmit complete callback: frees the slot and chains the next run.
+ * @param hspi SPI handle that completed the transfer
+ */
+void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+    if (hspi->Instance == SPI4)
+    {
+        OLED_BusQueue_t *queue = OLED_Bus_Complete(&spi_bus, osKernelGetTickCount());
+
+        if (queue != NULL)
+        {
+            osSemaphoreRelease(((OLED_Display_t *)queue->context)->free_slots);
+        }
+        OLED_SPI_StartNext();
+    }
+}
+
+/**
+ * @brief HAL SPI error callback. The queue is dropped; the task re-sends the frame.
+ * @param hspi SPI handle that reported the error
+ */
+void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi)
+{
+    if (hspi->Instance == SPI4)
+    {
+        OLED_SPI_TransferFailed();
+    }
+}
+
+/**
+ * @brief Aborts a stuck SPI DMA transfer and drops the queue (task context).
+ */
+static void OLED_SPI_Abort(OLED_Display_t *display)
+{
+    display->stats.timeouts++;
+    HAL_SPI_Abort(&hspi4);
+    taskENTER_CRITICAL();
+    OLED_SPI_TransferFailed();
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief Reserves a queue slot for the next SPI run at the display's current DC level (task context).
+ *
+ * A queue that does not move within OLED_I2C_TIMEOUT_MS means a stuck DMA stream: the transfer is
+ * aborted and the queue dropped, and the frame is re-sent by OLED_Display_Repair().
+ */
+static void OLED_SPI_Reserve(OLED_Display_t *display)
+{
+    OLED_BusSlot_t *slot = &oled_discard;
+
+    if (osSemaphoreAcquire(display->free_slots, OLED_I2C_TIMEOUT_MS) == osOK)
+    {
+        slot = OLED_Bus_Reserve(&display->queue);
+    }
+    else
+    {
+        OLED_SPI_Abort(display);
+        if (osSemaphoreAcquire(display->free_slots, 0) == osOK)
+        {
+            slot = OLED_Bus_Reserve(&display->queue);
+        }
+    }
+    slot->len = 0;
+    slot->addr = display->dc;
+    display->slot = slot;
+}
+
+/**
+ * @brief Queues the current SPI run and starts the bus if it is idle (task context).
+ */
+static void OLED_SPI_Commit(OLED_Display_t *display)
+{
+    if (display->slot == &oled_discard)
+    {
+        display->stats.dropped++;
+        return;
+    }
+    taskENTER_CRITICAL();
+    if (OLED_Bus_Commit(&spi_bus, &display->queue, osKernelGetTickCount()))
+    {
+        OLED_SPI_StartNext();
+    }
+    taskEXIT_CRITICAL();
+    display->slot = &oled_discard;
+}
+
+/**
+ * @brief Takes a display offline after it did not acknowledge its address.
+ */
+static void OLED_I2C_SetOffline(OLED_Display_t *display)
+{
+    if (!display->offline)
+    {
+        display->stats.offline++;
+    }
+    display->offline = 1;
+    display->probe_ms = osKernelGetTickCount();
+}
+
+/**
+ * @brief Recovers the bus after a failed or stuck transfer (task context).
+ *
+ * The queued transfers of all displays are dropped (DMA), so every display that answers afterwards
+ * gets its frame re-sent; a display that does not acknowledge its address is taken offline.
+ */
+static void OLED_I2C_Recover(void)
+{
+    uint8_t released;
+
+    osMutexAcquire(i2c_bus_lock, osWaitForever);
+    /* A transfer that does not complete is dropped with the queues below */
+    (void)OLED_I2C_Hold();
+    i2c_stats.recoveries++;
+    released = I2C2_BusRecover();
+#if OLED_I2C_USE_DMA
+    taskENTER_CRITICAL();
+    OLED_FlushBus(&i2c_bus);
+    i2c_fault = 0;
+    taskEXIT_CRITICAL();
+#endif
+    for (uint8_t i = 0; i < oled_display_count; i++)
+    {
+        OLED_Display_t *display = oled_displays[i];
+
+        if (display->offline || display->transport != OLED_TRANSPORT_I2C)
+        {
+            continue;
+        }
+        if (!released || HAL_I2C_IsDeviceReady(&hi2c2, (uint16_t)(display->address << 1), 2, OLED_I2C_TIMEOUT_MS) != HAL_OK)
+        {
+            OLED_I2C_SetOffline(display);
+        }
+#if OLED_I2C_USE_DMA
+        else
+        {
+            display->resend = 1;
+        }
+#endif
+    }
+    OLED_I2C_Release();
+    osMutexRelease(i2c_bus_lock);
+}
+
+/**
+ * @brief Takes a free slot of an I2C display's DMA queue (task context).
+ *
+ * Blocks while the queue is full, i.e. while the bus is behind the renderer, for as long as the
+ * bus keeps completing transfers. A stuck or faulted bus is recovered, which drops the queues.
+ *
+ * @retval 1 Slot taken.
+ * @retval 0 No slot: the display is offline, or went offline in the recovery.
+ */
+static uint8_t OLED_I2C_AcquireSlot(OLED_Display_t *display)
+{
+    while (osSemaphoreAcquire(display->free_slots, OLED_I2C_TIMEOUT_MS) != osOK)
+    {
+        if (OLED_I2C_CheckProgress())
+        {
+            OLED_I2C_Recover();
+            return (uint8_t)(!display->offline && osSemaphoreAcquire(display->free_slots, 0) == osOK);
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief u8x8 display callback: the SH1106 driver, counting complete frames per display and ending
+ *        the display's frame on the bus (see OLED_Bus_EndFrame()).
+ */
+static uint8_t OLED_Display_Cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+    if (msg == U8X8_MSG_DISPLAY_REFRESH)
+    {
+        ((OLED_Display_t *)u8x8)->frames++;
+        /* The next transfer starts a new frame deadline on the bus (the queue is unused by
+           blocking I2C transfers) */
+        taskENTER_CRITICAL();
+        OLED_Bus_EndFrame(&((OLED_Display_t *)u8x8)->queue);
+        taskEXIT_CRITICAL();
+    }
+    return u8x8_d_sh1106_128x64_noname(u8x8, msg, arg_int, arg_ptr);
+}
 
 /**
  * @brief STM32-specific delay and GPIO callback for u8g2/u8x8.
  *
  * Provides timing and GPIO control for the u8g2 library on STM32 platforms. Handles delay messages
- * and basic GPIO operations as required by the u8g2/u8x8 interface.
+ * and basic GPIO operations as required by the u8g2/u8x8 interface. Sub-millisecond delays are DWT
+ * busy-waits, millisecond delays (display reset and power-up, 300 ms in total for the SH1106) sleep
+ * the OLED task (timing.h).
  *
  * @param[in] u8x8    Pointer to u8x8 structure.
  * @param[in] msg     Message type (U8X8_MSG_*).
@@ -41,13 +512,25 @@ uint8_t u8x8_stm32_gpio_and_delay(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, vo
     switch (msg)
     {
         case U8X8_MSG_DELAY_MILLI:
-            HAL_Delay(arg_int);
+            /* Delays are timed against the bus (e.g. after reset/power commands); the task sleeps */
+            OLED_Display_WaitTransferComplete((OLED_Display_t *)u8x8);
+            Timing_DelayMs(arg_int);
             break;
         case U8X8_MSG_DELAY_10MICRO:
-            HAL_Delay(1);
+            Timing_DelayUs(10u * arg_int);
             break;
         case U8X8_MSG_DELAY_100NANO:
-            __NOP();
+            Timing_DelayNs(100u * arg_int);
+            break;
+        case U8X8_MSG_DELAY_NANO:
+            Timing_DelayNs(arg_int);
+            break;
+        case U8X8_MSG_GPIO_RESET:
+            /* Only the SPI panel has a reset line */
+            if (((OLED_Display_t *)u8x8)->transport == OLED_TRANSPORT_SPI)
+            {
+                HAL_GPIO_WritePin(OLED_RES_GPIO_Port, OLED_RES_Pin, arg_int ? GPIO_PIN_SET : GPIO_PIN_RESET);
+            }
             break;
         default:
             return 0;
@@ -70,8 +553,139 @@ uint8_t u8x8_stm32_gpio_and_delay(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, vo
  */
 uint8_t u8x8_byte_stm32_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
 {
-    static uint8_t buffer[32];
-    static uint8_t buf_idx;
+    OLED_Display_t *display = (OLED_Display_t *)u8x8;
+#if OLED_I2C_USE_DMA
+    OLED_BusSlot_t *slot = display->slot;
+#else
+    HAL_StatusTypeDef status;
+#endif
+    uint8_t *data;
+
+    switch (msg)
+    {
+        case U8X8_MSG_BYTE_SEND:
+            data = (uint8_t *)arg_ptr;
+#if OLED_I2C_USE_DMA
+            while (arg_int > 0 && slot->len < sizeof(slot->data))
+            {
+                slot->data[slot->len++] = *data++;
+                arg_int--;
+            }
+#else
+            while (arg_int > 0 && display->tx_len < sizeof(display->tx))
+            {
+                display->tx[display->tx_len++] = *data++;
+                arg_int--;
+            }
+#endif
+            /* Unlike an SPI run, an I2C transfer cannot be continued in a new slot: the panel
+               expects a control byte after every start condition. u8x8_cad_ssd13xx_fast_i2c()
+               keeps transfers within 32 bytes; bytes beyond that are counted, not sent. */
+            if (arg_int > 0)
+            {
+                display->stats.overflows += arg_int;
+            }
+            break;
+        case U8X8_MSG_BYTE_INIT:
+            break;
+        case U8X8_MSG_BYTE_SET_DC:
+            break;
+        case U8X8_MSG_BYTE_START_TRANSFER:
+#if OLED_I2C_USE_DMA
+            if (i2c_fault)
+            {
+                OLED_I2C_Recover();
+            }
+            slot = &oled_discard;
+            if (!display->offline && OLED_I2C_AcquireSlot(display))
+            {
+                slot = OLED_Bus_Reserve(&display->queue);
+            }
+            slot->len = 0;
+            slot->addr = (uint8_t)(display->address << 1);
+            display->slot = slot;
+#else
+            display->tx_len = 0;
+#endif
+            break;
+        case U8X8_MSG_BYTE_END_TRANSFER:
+#if OLED_I2C_USE_DMA
+            if (slot == &oled_discard)
+            {
+                display->stats.dropped++;
+                break;
+            }
+            taskENTER_CRITICAL();
+            if (i2c_fault)
+            {
+                /* The error interrupt dropped the queues; this transfer goes with them */
+                slot = &oled_discard;
+            }
+            else if (OLED_Bus_Commit(&i2c_bus, &display->queue, osKernelGetTickCount()))
+            {
+                OLED_I2C_StartNext();
+            }
+            taskEXIT_CRITICAL();
+            if (slot == &oled_discard)
+            {
+                display->stats.dropped++;
+                osSemaphoreRelease(display->free_slots);
+            }
+#else
+            if (display->offline)
+            {
+                display->stats.dropped++;
+                break;
+            }
+            osMutexAcquire(i2c_bus_lock, osWaitForever);
+            status = HAL_I2C_Master_Transmit(&hi2c2, (uint16_t)(display->address << 1), display->tx, display->tx_len, OLED_I2C_TIMEOUT_MS);
+            if (status != HAL_OK)
+            {
+                /* Recover the bus and retry once; the frame is only re-sent if that fails too */
+                if (status == HAL_TIMEOUT)
+                {
+                    i2c_stats.timeouts++;
+                }
+                else
+                {
+                    i2c_stats.errors++;
+                }
+                OLED_I2C_Recover();
+                if (display->offline ||
+                    HAL_I2C_Master_Transmit(&hi2c2, (uint16_t)(display->address << 1), display->tx, display->tx_len, OLED_I2C_TIMEOUT_MS) != HAL_OK)
+                {
+                    display->stats.dropped++;
+                    display->resend = 1;
+                }
+            }
+            osMutexRelease(i2c_bus_lock);
+#endif
+            break;
+        default:
+            return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief STM32 SPI transfer callback for u8g2/u8x8 (SPI4 with DMA, DC and CS on GPIO).
+ *
+ * The bytes of a transfer are split into runs of one DC level (commands or display data) of at most
+ * 32 bytes each; every run is a slot of the display's queue and is sent by DMA while the task keeps
+ * rendering. The transfer-complete interrupt switches DC between runs and raises CS once the queue
+ * is empty.
+ *
+ * @param[in] u8x8    Pointer to u8x8 structure.
+ * @param[in] msg     Message type (U8X8_MSG_*).
+ * @param[in] arg_int Integer argument (depends on message).
+ * @param[in] arg_ptr Pointer argument (depends on message).
+ * @retval 1 Operation successful or handled.
+ * @retval 0 Operation not handled or failed.
+ */
+uint8_t u8x8_byte_stm32_spi(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+    OLED_Display_t *display = (OLED_Display_t *)u8x8;
+    OLED_BusSlot_t *slot = display->slot;
     uint8_t *data;
 
     switch (msg)
@@ -80,19 +694,54 @@ uint8_t u8x8_byte_stm32_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *ar
             data = (uint8_t *)arg_ptr;
             while (arg_int > 0)
             {
-                buffer[buf_idx++] = *data++;
+                if (slot->len >= sizeof(slot->data))
+                {
+                    OLED_SPI_Commit(display);
+                    OLED_SPI_Reserve(display);
+                    slot = display->slot;
+                }
+                slot->data[slot->len++] = *data++;
                 arg_int--;
             }
             break;
         case U8X8_MSG_BYTE_INIT:
+            HAL_GPIO_WritePin(OLED_CS_GPIO_Port, OLED_CS_Pin, GPIO_PIN_SET);
             break;
         case U8X8_MSG_BYTE_SET_DC:
+            if (arg_int == display->dc)
+            {
+                break;
+            }
+            display->dc = arg_int;
+            /* Outside of a transfer (or while it is dropped) only the level is recorded */
+            if (slot != &oled_discard)
+            {
+                if (slot->len > 0)
+                {
+                    /* The pending bytes go out at the old level, the next run at the new one */
+                    OLED_SPI_Commit(display);
+                    OLED_SPI_Reserve(display);
+                }
+                else
+                {
+                    slot->addr = arg_int;
+                }
+            }
             break;
         case U8X8_MSG_BYTE_START_TRANSFER:
-            buf_idx = 0;
+            OLED_SPI_Reserve(display);
             break;
         case U8X8_MSG_BYTE_END_TRANSFER:
-            HAL_I2C_Master_Transmit(&hi2c2, (u8x8_GetI2CAddress(u8x8) << 1), buffer, buf_idx, HAL_MAX_DELAY);
+            if (slot->len > 0)
+            {
+                OLED_SPI_Commit(display);
+            }
+            else if (slot != &oled_discard)
+            {
+                /* Unused reservation (the transfer ended on a DC switch) */
+                osSemaphoreRelease(display->free_slots);
+            }
+            display->slot = &oled_discard;
             break;
         default:
             return 0;
@@ -101,28 +750,395 @@ uint8_t u8x8_byte_stm32_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *ar
 }
 
 /**
- * @brief Initializes the OLED display (SH1106 I2C 128x64).
+ * @brief Registers a display with the driver and sets up its u8g2 object (common to both transports).
  *
- * Sets up the internal u8g2 object, configures the I2C address, initializes the display, and powers it on.
+ * The u8g2 object is set up with the display's own frame buffer from the CCM RAM pool (the
+ * u8g2_Setup_*() functions share one static buffer per configuration, which would make two
+ * displays draw into the same memory).
  *
- * @note This function must be called before any drawing operations.
+ * @param[in] bus Bus scheduler for the display's queue, NULL for blocking I2C transfers.
+ * @retval 1 Display registered.
+ * @retval 0 OLED_MAX_DISPLAYS displays registered already, or no RTOS objects left.
+ */
+static uint8_t OLED_Display_Register(OLED_Display_t *display, OLED_Bus_t *bus, uint8_t priority, uint32_t latency_ms,
+                                     u8x8_msg_cb cad_cb, u8x8_msg_cb byte_cb)
+{
+    static const osMutexAttr_t lock_attributes = {
+        .name = "OLED_I2C",
+        .attr_bits = osMutexRecursive | osMutexPrioInherit,
+        .cb_mem = &i2c_bus_lock_cb,
+        .cb_size = sizeof(i2c_bus_lock_cb)
+    };
+
+    if (oled_display_count >= OLED_MAX_DISPLAYS)
+    {
+        return 0;
+    }
+    if (i2c_bus_lock == NULL)
+    {
+        i2c_bus_lock = RtosObj_MutexNew(&lock_attributes);
+        if (i2c_bus_lock == NULL)
+        {
+            return 0;
+        }
+        OLED_Bus_Init(&i2c_bus);
+        OLED_Bus_Init(&spi_bus);
+    }
+    display->free_slots = NULL;
+    display->slot = &oled_discard;
+    if (bus != NULL)
+    {
+        const osSemaphoreAttr_t slots_attributes = {
+            .name = "OLED_Slots",
+            .cb_mem = &oled_free_slots_cb[oled_display_count],
+            .cb_size = sizeof(oled_free_slots_cb[0])
+        };
+
+        display->free_slots = RtosObj_SemaphoreNew(OLED_I2C_DMA_SLOTS, OLED_I2C_DMA_SLOTS, &slots_attributes);
+        if (display->free_slots == NULL)
+        {
+            return 0;
+        }
+        taskENTER_CRITICAL();
+        OLED_Bus_AddQueue(bus, &display->queue, priority, latency_ms, display);
+        taskEXIT_CRITICAL();
+    }
+#if !OLED_I2C_USE_DMA
+    display->tx_len = 0;
+#endif
+    display->dc = 0;
+    display->offline = 0;
+    display->resend = 0;
+    display->reinit = 0;
+    display->frames = 0;
+    memset(&display->stats, 0, sizeof(display->stats));
+    display->buffer = oled_frame_buffers[oled_display_count];
+    oled_displays[oled_display_count++] = display;
+
+    u8g2_SetupDisplay(&display->u8g2, OLED_Display_Cb, cad_cb, byte_cb, u8x8_stm32_gpio_and_delay);
+    u8g2_SetupBuffer(&display->u8g2, display->buffer, OLED_BUFFER_TILE_ROWS, u8g2_ll_hvline_vertical_top_lsb, U8G2_R0);
+    return 1;
+}
+
+/**
+ * @brief Initializes a display (SH1106 I2C 128x64) and registers it on the shared bus.
+ *
+ * A display that does not acknowledge its address is taken offline before the init sequence, so an
+ * absent panel costs no transfer deadlines.
+ *
+ * @retval OLED_STATUS_OK      Display set up.
+ * @retval OLED_STATUS_OFFLINE Display set up, the panel did not acknowledge its address.
+ * @retval OLED_STATUS_FAILED  OLED_MAX_DISPLAYS displays registered already, or no RTOS objects left.
  */
-void OLED_Init(void)
+OLED_Status_t OLED_Display_Init(OLED_Display_t *display, uint8_t address, uint8_t priority, uint32_t latency_ms)
 {
-    u8g2_Setup_sh1106_i2c_128x64_noname_f(&u8g2, U8G2_R0, u8x8_byte_stm32_i2c, u8x8_stm32_gpio_and_delay);
-    u8g2_SetI2CAddress(&u8g2, 0x3C);
-    u8g2_InitDisplay(&u8g2);
-    u8g2_SetPowerSave(&u8g2, 0);
+#if OLED_I2C_USE_DMA
+    OLED_Bus_t *bus = &i2c_bus;
+#else
+    OLED_Bus_t *bus = NULL;
+#endif
+    uint8_t ready;
+
+    display->transport = OLED_TRANSPORT_I2C;
+    display->address = address;
+    if (!OLED_Display_Register(display, bus, priority, latency_ms, u8x8_cad_ssd13xx_fast_i2c, u8x8_byte_stm32_i2c))
+    {
+        return OLED_STATUS_FAILED;
+    }
+    u8g2_SetI2CAddress(&display->u8g2, address);
+    /* Another display may be sending already */
+    osMutexAcquire(i2c_bus_lock, osWaitForever);
+    ready = (uint8_t)(OLED_I2C_Hold() && HAL_I2C_IsDeviceReady(&hi2c2, (uint16_t)(address << 1), 2, OLED_I2C_TIMEOUT_MS) == HAL_OK);
+    OLED_I2C_Release();
+    osMutexRelease(i2c_bus_lock);
+    if (!ready)
+    {
+        /* Initialized by OLED_Display_Repair() once it answers */
+        OLED_I2C_SetOffline(display);
+        display->reinit = 1;
+        return OLED_STATUS_OFFLINE;
+    }
+    u8g2_InitDisplay(&display->u8g2);
+    u8g2_SetPowerSave(&display->u8g2, 0);
+    return OLED_STATUS_OK;
 }
 
 /**
- * @brief Returns a pointer to the internal u8g2 display object.
+ * @brief Initializes the display on SPI4 (SH1106 4-wire SPI 128x64, DMA transfers).
+ *
+ * SPI4 has a single chip select, so one SPI display can be set up. The panel is reset through
+ * OLED_RES by the init sequence; it has no address to probe, so it is never taken offline.
  *
- * Provides access to the static u8g2 object for direct drawing operations.
+ * @retval OLED_STATUS_OK     Display set up.
+ * @retval OLED_STATUS_FAILED SPI display set up already, OLED_MAX_DISPLAYS displays registered, or no RTOS objects left.
+ */
+OLED_Status_t OLED_Display_InitSpi(OLED_Display_t *display)
+{
+    if (spi_bus.count != 0)
+    {
+        return OLED_STATUS_FAILED;
+    }
+    display->transport = OLED_TRANSPORT_SPI;
+    display->address = 0;
+    if (!OLED_Display_Register(display, &spi_bus, OLED_INSIDE_PRIORITY, OLED_INSIDE_LATENCY_MS, u8x8_cad_001, u8x8_byte_stm32_spi))
+    {
+        return OLED_STATUS_FAILED;
+    }
+    u8g2_InitDisplay(&display->u8g2);
+    u8g2_SetPowerSave(&display->u8g2, 0);
+    return OLED_STATUS_OK;
+}
+
+/**
+ * @brief Returns the u8g2 object of a display for drawing.
+ */
+u8g2_t* OLED_Display_GetU8g2(OLED_Display_t *display)
+{
+    return &display->u8g2;
+}
+
+/**
+ * @brief Blocks until the queued transfers of one display have been sent.
+ *
+ * I2C: waits as long as the bus makes progress (OLED_I2C_AcquireSlot()). SPI: each slot has to
+ * free up within OLED_I2C_TIMEOUT_MS, the display being alone on SPI4.
+ */
+void OLED_Display_WaitTransferComplete(OLED_Display_t *display)
+{
+    if (display->free_slots == NULL)
+    {
+        return;
+    }
+    /* Owning every slot means nothing is queued or in flight; a stuck bus is recovered (which
+       drops the queues) */
+    for (uint8_t i = 0; i < OLED_I2C_DMA_SLOTS; i++)
+    {
+        uint8_t acquired;
+
+        if (display->transport == OLED_TRANSPORT_SPI)
+        {
+            acquired = (uint8_t)(osSemaphoreAcquire(display->free_slots, OLED_I2C_TIMEOUT_MS) == osOK);
+            if (!acquired)
+            {
+                OLED_SPI_Abort(display);
+            }
+        }
+        else
+        {
+            acquired = OLED_I2C_AcquireSlot(display);
+        }
+        if (!acquired)
+        {
+            while (i-- != 0)
+            {
+                osSemaphoreRelease(display->free_slots);
+            }
+            return;
+        }
+    }
+    for (uint8_t i = 0; i < OLED_I2C_DMA_SLOTS; i++)
+    {
+        osSemaphoreRelease(display->free_slots);
+    }
+}
+
+/**
+ * @brief Returns the number of transfers of one display that are queued or in flight (non-blocking).
+ *
+ * @return Pending DMA slots, or 0 for blocking I2C transfers (OLED_I2C_USE_DMA 0; they complete before returning).
+ */
+uint8_t OLED_Display_GetPendingTransfers(OLED_Display_t *display)
+{
+    if (display->free_slots == NULL)
+    {
+        return 0;
+    }
+    return display->queue.count;
+}
+
+/**
+ * @brief Repairs one display after transport faults (task context, outside of rendering).
+ *
+ * Recovers a faulted bus, probes an offline display every OLED_I2C_PROBE_MS (and re-runs the init
+ * sequence once it answers again), and re-sends the frame buffer if a frame reached the panel
+ * incompletely. It does not wait for queued transfers; a fault of a transfer still in flight is
+ * repaired by the next call. In page modes there is no complete frame to re-send, so the caller
+ * has to redraw.
+ *
+ * @retval 1 The last frame was re-sent (full buffer mode) or has to be redrawn (page modes); panel
+ *           state kept outside the frame buffer (e.g. the display start line) must be restored.
+ * @retval 0 Nothing to repair, or the display is still offline.
+ */
+uint8_t OLED_Display_Repair(OLED_Display_t *display)
+{
+    uint8_t ready;
+
+    if (display->transport == OLED_TRANSPORT_I2C && i2c_fault)
+    {
+        OLED_I2C_Recover();
+    }
+    if (display->offline)
+    {
+        if (osKernelGetTickCount() - display->probe_ms < OLED_I2C_PROBE_MS)
+        {
+            return 0;
+        }
+        display->probe_ms = osKernelGetTickCount();
+        /* The probe waits for the transfer in flight; other displays' transfers resume after it */
+        osMutexAcquire(i2c_bus_lock, osWaitForever);
+        ready = (uint8_t)(OLED_I2C_Hold() && HAL_I2C_IsDeviceReady(&hi2c2, (uint16_t)(display->address << 1), 1, OLED_I2C_TIMEOUT_MS) == HAL_OK);
+        OLED_I2C_Release();
+        osMutexRelease(i2c_bus_lock);
+        if (!ready)
+        {
+            return 0;
+        }
+        display->offline = 0;
+        display->reinit = 1;
+    }
+    if (display->reinit)
+    {
+        display->reinit = 0;
+        u8g2_InitDisplay(&display->u8g2);
+        u8g2_SetPowerSave(&display->u8g2, 0);
+        display->resend = 1;
+    }
+    if (!display->resend)
+    {
+        return 0;
+    }
+    display->resend = 0;
+    display->stats.resends++;
+#if OLED_BUFFER_MODE == OLED_BUFFER_MODE_FULL
+    u8g2_SendBuffer(&display->u8g2);
+#endif
+    return 1;
+}
+
+/**
+ * @brief Copies the transport counters of a display.
+ *
+ * @param[out] stats I2C: bus-wide errors, timeouts and recoveries plus the display's own resends,
+ *                   offline and dropped counters. SPI: the display's own counters (SPI4 serves one
+ *                   display). stats->online is 0 while the display is offline.
+ */
+void OLED_Display_GetStats(OLED_Display_t *display, OLED_I2C_Stats_t *stats)
+{
+    taskENTER_CRITICAL();
+    *stats = display->stats;
+    if (display->transport == OLED_TRANSPORT_I2C)
+    {
+        stats->errors = i2c_stats.errors;
+        stats->timeouts = i2c_stats.timeouts;
+        stats->recoveries = i2c_stats.recoveries;
+    }
+    taskEXIT_CRITICAL();
+    stats->online = (uint8_t)!display->offline;
+}
+
+/**
+ * @brief Copies the frame and bus load counters of a display.
+ */
+void OLED_Display_GetLoad(OLED_Display_t *display, OLED_DisplayLoad_t *load)
+{
+    taskENTER_CRITICAL();
+    load->frames = display->frames;
+    if (display->free_slots != NULL)
+    {
+        load->transfers = display->queue.transfers;
+        load->bytes = display->queue.bytes;
+        load->late = display->queue.late;
+    }
+    else
+    {
+        load->transfers = 0;
+        load->bytes = 0;
+        load->late = 0;
+    }
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief Returns the number of display switches on the bus (0 without DMA).
+ */
+uint32_t OLED_GetBusSwitches(void)
+{
+    return i2c_bus.switches;
+}
+
+/**
+ * @brief Initializes the inside OLED display (SH1106 128x64) on the selected transport.
+ *
+ * Sets up the driver's own display object (buffer size selected by OLED_BUFFER_MODE) on I2C2 at
+ * OLED_INSIDE_ADDRESS or on SPI4, with the inside bus priority, initializes the display, and powers
+ * it on.
+ *
+ * @return Status of the inside display (OLED_Display_Init(), OLED_Display_InitSpi()).
+ *
+ * @note This function must be called before any drawing operations.
+ */
+OLED_Status_t OLED_Init(OLED_Transport_t transport)
+{
+    if (transport == OLED_TRANSPORT_SPI)
+    {
+        return OLED_Display_InitSpi(&oled_inside);
+    }
+    return OLED_Display_Init(&oled_inside, OLED_INSIDE_ADDRESS, OLED_INSIDE_PRIORITY, OLED_INSIDE_LATENCY_MS);
+}
+
+/**
+ * @brief Returns the driver's inside display object.
+ */
+OLED_Display_t* OLED_GetInsideDisplay(void)
+{
+    return &oled_inside;
+}
+
+/**
+ * @brief Returns a pointer to the u8g2 object of the inside display.
  *
  * @return Pointer to the internal u8g2 object.
  */
 u8g2_t* OLED_GetDisplay(void)
 {
-    return &u8g2;
+    return &oled_inside.u8g2;
+}
+
+/**
+ * @brief Blocks until the queued transfers of all displays have been sent; see OLED_Display_WaitTransferComplete().
+ */
+void OLED_WaitTransferComplete(void)
+{
+    for (uint8_t i = 0; i < oled_display_count; i++)
+    {
+        OLED_Display_WaitTransferComplete(oled_displays[i]);
+    }
+}
+
+/**
+ * @brief Returns the number of inside display transfers that are queued or in flight (non-blocking).
+ *
+ * @return Pending DMA slots, or 0 when OLED_I2C_USE_DMA is 0 (transfers complete before returning).
+ */
+uint8_t OLED_GetPendingTransfers(void)
+{
+    return OLED_Display_GetPendingTransfers(&oled_inside);
+}
+
+/**
+ * @brief Repairs the inside panel after transport faults; see OLED_Display_Repair().
+ */
+uint8_t OLED_RepairDisplay(void)
+{
+    return OLED_Display_Repair(&oled_inside);
+}
+
+/**
+ * @brief Copies the transport health counters of the inside display.
+ *
+ * @param[out] stats Counters since startup; stats->online is 0 while the display is offline.
+ */
+void OLED_GetI2CStats(OLED_I2C_Stats_t *stats)
+{
+    OLED_Display_GetStats(&oled_inside, stats);
 }
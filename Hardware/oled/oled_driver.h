@@ -5,42 +5,367 @@
  * @date 2025-08-01
  * @brief OLED display driver interface for STM32 using the u8g2 graphics library.
  *
- * This header provides the interface for controlling a SH1106-based 128x64 OLED display
+ * This header provides the interface for controlling SH1106-based 128x64 OLED displays
  * on the NUCLEO-F429ZI board. It includes initialization, display object access, and
  * STM32-specific callback functions for I2C and timing integration with the u8g2 library.
+ *
+ * The driver is instance-based: every OLED_Display_t carries its own u8g2 object, frame buffer,
+ * transfer queue and fault state, so several displays (e.g. the inside panel at 0x3C and the outside
+ * panel at 0x3D) share I2C2. Their DMA transfers are interleaved by the bus scheduler (oled_bus.h)
+ * by priority and deadline. OLED_Init()/OLED_GetDisplay() and the other functions without a display
+ * argument operate on the driver's own inside display.
+ *
+ * A display can also be wired for 4-wire SPI (SPI4 with DMA, CS/DC/RES on GPIO, see
+ * OLED_Display_InitSpi()); the u8g2 drawing code is the same for both transports.
  */
 
 #ifndef OLED_DRIVER_H
 #define OLED_DRIVER_H
 
 #include "u8g2.h"
+#include "oled_bus.h"
+#include "cmsis_os2.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * @name Frame buffer modes
+ * @brief Values for OLED_BUFFER_MODE.
+ *
+ * | Mode                      | u8g2 buffer | Render/send per frame                    |
+ * |---------------------------|-------------|------------------------------------------|
+ * | OLED_BUFFER_MODE_FULL     | 1024 bytes  | render all 8 pages, then send 8 pages    |
+ * | OLED_BUFFER_MODE_2PAGE    |  256 bytes  | 4 passes of (render 2 pages, send them)  |
+ * | OLED_BUFFER_MODE_1PAGE    |  128 bytes  | 8 passes of (render 1 page, send it)     |
+ *
+ * One page is 140 bytes on the bus (128 data bytes in 24-byte chunks plus address, control and
+ * positioning bytes), i.e. an estimated ~3.2 ms at 400 kHz, ~25 ms for the full frame in every mode
+ * (computed from the byte counts and the bus clock, not measured; the task prints the measured time
+ * of one full frame at startup). With OLED_I2C_USE_DMA the transfer of page n runs while page n+1
+ * is rendered, so a page mode frame takes roughly max(render, send) instead of render + send; the
+ * DMA queue adds OLED_I2C_DMA_SLOTS * 34 bytes of RAM. In page modes the drawing code is executed once per pass
+ * (u8g2_FirstPage()/u8g2_NextPage() picture loop), so it must be repeatable from retained state.
+ * @{
+ */
+#define OLED_BUFFER_MODE_FULL        0
+#define OLED_BUFFER_MODE_2PAGE       2
+#define OLED_BUFFER_MODE_1PAGE       1
+/** @} */
+
+/**
+ * @def OLED_BUFFER_MODE
+ * @brief Frame buffer mode used by OLED_Init() (see the table above).
+ */
+#ifndef OLED_BUFFER_MODE
+#define OLED_BUFFER_MODE             OLED_BUFFER_MODE_FULL
+#endif
+
+/**
+ * @def OLED_I2C_USE_DMA
+ * @brief Set to 1 to queue I2C transfers and send them with DMA (I2C2_TX, DMA1 Stream 7).
+ *
+ * The u8x8 byte callback returns as soon as a transfer is queued, so rendering overlaps with the
+ * bus transfer. Set to 0 for blocking HAL_I2C_Master_Transmit() calls.
+ */
+#ifndef OLED_I2C_USE_DMA
+#define OLED_I2C_USE_DMA             1
+#endif
+
+/**
+ * @def OLED_I2C_DMA_SLOTS
+ * @brief Number of queued transfers per display (one transfer is at most 32 bytes).
+ *
+ * Ten slots hold one complete display page on I2C (positioning commands and six data chunks), or
+ * two pages on SPI (one command and four data chunks each).
+ */
+#define OLED_I2C_DMA_SLOTS           OLED_BUS_QUEUE_SLOTS
+
+/**
+ * @def OLED_MAX_DISPLAYS
+ * @brief Number of displays the driver can serve on I2C2.
+ */
+#define OLED_MAX_DISPLAYS            OLED_BUS_MAX_QUEUES
+
+/**
+ * @def OLED_BUFFER_TILE_ROWS
+ * @brief Tile rows (8 pixel rows each) of the frame buffer of one display.
+ */
+#if OLED_BUFFER_MODE == OLED_BUFFER_MODE_FULL
+#define OLED_BUFFER_TILE_ROWS        8
+#else
+#define OLED_BUFFER_TILE_ROWS        OLED_BUFFER_MODE
+#endif
+
+/**
+ * @name Display addresses and bus scheduling
+ * @brief 7-bit I2C addresses, bus priorities and transfer latency targets of the two panels.
+ *
+ * The inside panel (operator side) is served first; the outside panel (visitor side) gets the bus
+ * between inside pages, and once one of its transfers is older than its latency target it is served
+ * ahead of the inside panel, so it slows down under contention but is never starved.
+ * @{
+ */
+#define OLED_INSIDE_ADDRESS          0x3C
+#define OLED_INSIDE_PRIORITY         1
+#define OLED_INSIDE_LATENCY_MS       30
+#define OLED_OUTSIDE_ADDRESS         0x3D
+#define OLED_OUTSIDE_PRIORITY        0
+#define OLED_OUTSIDE_LATENCY_MS      100
+/** @} */
+
+/**
+ * @def OLED_I2C_TIMEOUT_MS
+ * @brief Deadline of one I2C transfer (milliseconds).
+ *
+ * A 32-byte transfer takes 0.8 ms at 400 kHz. A transfer that misses the deadline is treated as a
+ * stuck bus: the bus is recovered (9 SCL clocks, I2C2 re-init) and the frame re-sent. Waits for a
+ * free DMA slot are not limited by it; they last as long as the transfers queued ahead (another
+ * display's frame included) while the bus keeps completing them.
+ */
+#define OLED_I2C_TIMEOUT_MS          10
+
+/**
+ * @def OLED_I2C_PROBE_MS
+ * @brief Probe period of a display that stopped answering (milliseconds); see OLED_RepairDisplay().
+ */
+#define OLED_I2C_PROBE_MS            1000
+
+/**
+ * @brief SPI4 clock of the SPI transport: 0 = 84 MHz / 32 = 2.625 MHz (default), 1 = 84 MHz / 16 = 5.25 MHz.
+ *
+ * The SH1106 datasheet specifies a 250 ns minimum SPI clock period (4 MHz), so 5.25 MHz is out of
+ * spec; many modules accept it, which roughly halves the frame time (~3.3 ms to ~1.7 ms). Applied
+ * in MX_SPI4_Init().
+ */
+#ifndef OLED_SPI_OVERCLOCK
+#define OLED_SPI_OVERCLOCK           0
+#endif
+
+/**
+ * @brief Transport of a display.
+ *
+ * | Transport          | Bus                          | Full frame on the wire | Frame time  |
+ * |--------------------|------------------------------|------------------------|-------------|
+ * | OLED_TRANSPORT_I2C | I2C2 400 kHz, DMA1 Stream 7  | 1120 bytes + ACKs      | ~29 ms      |
+ * | OLED_TRANSPORT_SPI | SPI4 2.625 MHz, DMA2 Stream 1| 1056 bytes, DC on GPIO | ~3.3 ms     |
+ *
+ * Frame times are estimates: bus times computed with Tools/oled_host/transport_bench.c, not
+ * measured on the target (the OLED task prints the measured time of one full frame at startup).
+ * SPI4 stays within the SH1106's 4 MHz maximum unless OLED_SPI_OVERCLOCK is set (5.25 MHz, ~1.7 ms).
+ */
+typedef enum {
+    OLED_TRANSPORT_I2C = 0,         /**< I2C2 (PF0/PF1), address selectable */
+    OLED_TRANSPORT_SPI              /**< SPI4 (PE2 SCK, PE6 MOSI), OLED_CS/OLED_DC/OLED_RES on PE4/PE5/PE3 */
+} OLED_Transport_t;
+
+/**
+ * @brief Result of setting up a display.
+ */
+typedef enum {
+    OLED_STATUS_FAILED = 0,         /**< Not set up: OLED_MAX_DISPLAYS registered already, or no RTOS objects left */
+    OLED_STATUS_OK,                 /**< Set up, panel initialized and powered on */
+    OLED_STATUS_OFFLINE             /**< Set up, but the panel did not answer; initialized by OLED_Display_Repair() once it does */
+} OLED_Status_t;
+
+/**
+ * @brief I2C transport health counters (since startup).
+ */
+typedef struct {
+    uint32_t errors;        /**< Failed transfers (NAK, bus error, arbitration lost, could not start) */
+    uint32_t timeouts;      /**< Transfers that did not complete within OLED_I2C_TIMEOUT_MS (stuck bus) */
+    uint32_t recoveries;    /**< Bus recoveries (9 SCL clocks, I2C2 re-init) */
+    uint32_t resends;       /**< Frames re-sent (or redrawn) after a fault */
+    uint32_t offline;       /**< Times the display stopped answering after a recovery */
+    uint32_t dropped;       /**< Transfers dropped (display offline or queue dropped after an error) */
+    uint32_t overflows;     /**< Bytes discarded because an I2C transfer exceeded 32 bytes (cad callback) */
+    uint8_t online;         /**< 1 while the display answers */
+} OLED_I2C_Stats_t;
+
+/**
+ * @brief Bus load of one display (since its initialization).
+ */
+typedef struct {
+    uint32_t frames;        /**< Complete frames sent (u8g2_SendBuffer() or a finished picture loop) */
+    uint32_t transfers;     /**< Transfers completed on the bus (0 without DMA) */
+    uint32_t bytes;         /**< Bytes completed on the bus (0 without DMA) */
+    uint32_t late;          /**< Transfers completed after their latency target (0 without DMA) */
+} OLED_DisplayLoad_t;
+
+/**
+ * @brief One SH1106 display on I2C2 or SPI4.
+ *
+ * Allocated by the caller (static storage) and set up with OLED_Display_Init() or
+ * OLED_Display_InitSpi(). The u8g2 object is the first member: the u8x8 callbacks get the display
+ * back from their u8x8 argument. The object holds the DMA transfer queue and must therefore not be
+ * placed in CCM RAM; its frame buffer, which only the CPU touches, is taken from the driver's CCM
+ * RAM pool when the display is registered.
+ */
+typedef struct {
+    u8g2_t u8g2;                    /**< u8g2 object (must stay the first member) */
+    uint8_t *buffer;                /**< Frame buffer (OLED_BUFFER_MODE, CCM RAM, assigned by the driver) */
+    OLED_Transport_t transport;     /**< I2C or SPI */
+    uint8_t address;                /**< 7-bit I2C address (I2C only) */
+    uint8_t dc;                     /**< Current DC level, 0 = command, 1 = data (SPI only) */
+    OLED_BusQueue_t queue;          /**< Transfer queue (I2C with DMA, SPI) */
+    osSemaphoreId_t free_slots;     /**< Free slots of the queue */
+    OLED_BusSlot_t *slot;           /**< Slot of the transfer being assembled */
+#if !OLED_I2C_USE_DMA
+    uint8_t tx[32];                 /**< I2C transfer being assembled (blocking mode) */
+    uint8_t tx_len;                 /**< Number of valid bytes in tx */
+#endif
+    uint8_t offline;                /**< 1 while the display does not answer (transfers dropped) */
+    uint8_t resend;                 /**< 1 if a frame reached the panel incompletely */
+    uint8_t reinit;                 /**< 1 if the display came back and needs its init sequence */
+    uint32_t probe_ms;              /**< Time of the last probe while offline */
+    volatile uint32_t frames;       /**< Complete frames sent */
+    OLED_I2C_Stats_t stats;         /**< Display counters (resends, offline, dropped) */
+} OLED_Display_t;
+
+
+
+/**
+ * @brief Initializes a display (SH1106 I2C 128x64) and registers it on the shared bus.
+ *
+ * Sets up the display's u8g2 object with its own frame buffer, initializes the panel and powers it
+ * on. A panel that does not answer is taken offline and probed by OLED_Display_Repair().
+ *
+ * @param[out] display    Display object (static storage, must stay valid).
+ * @param[in]  address    7-bit I2C address (OLED_INSIDE_ADDRESS, OLED_OUTSIDE_ADDRESS).
+ * @param[in]  priority   Bus priority; higher is served first while no latency target is missed.
+ * @param[in]  latency_ms Latency target of one transfer of this display.
+ * @retval OLED_STATUS_OK      Display set up.
+ * @retval OLED_STATUS_OFFLINE Display set up, the panel did not acknowledge its address.
+ * @retval OLED_STATUS_FAILED  OLED_MAX_DISPLAYS displays registered already, or no RTOS objects left.
+ */
+OLED_Status_t OLED_Display_Init(OLED_Display_t *display, uint8_t address, uint8_t priority, uint32_t latency_ms);
+
 
 /**
- * @brief Initializes the OLED display (SH1106 I2C 128x64).
+ * @brief Initializes the display wired to SPI4 (SH1106 4-wire SPI 128x64).
  *
- * Sets up the internal u8g2 object, configures the I2C address, initializes the display,
- * and powers it on. This function must be called before any drawing operations.
+ * Pulses OLED_RES, initializes the panel and powers it on. Every u8x8 transfer is split into DC
+ * runs of at most 32 bytes that are queued and sent with DMA, chained from the transfer-complete
+ * interrupt; CS stays low while the queue is busy. SPI has no acknowledge, so an absent panel is
+ * not detected and the display is never taken offline.
+ *
+ * @param[out] display Display object (static storage, must stay valid).
+ * @retval OLED_STATUS_OK     Display set up.
+ * @retval OLED_STATUS_FAILED An SPI display is set up already, OLED_MAX_DISPLAYS displays are registered, or no RTOS objects left.
+ */
+OLED_Status_t OLED_Display_InitSpi(OLED_Display_t *display);
+
+
+/**
+ * @brief Returns the u8g2 object of a display for drawing.
+ */
+u8g2_t* OLED_Display_GetU8g2(OLED_Display_t *display);
+
+
+/**
+ * @brief Blocks until the queued transfers of one display have been sent (a stuck bus is recovered).
+ */
+void OLED_Display_WaitTransferComplete(OLED_Display_t *display);
+
+
+/**
+ * @brief Returns the number of transfers of one display that are queued or in flight (non-blocking).
+ */
+uint8_t OLED_Display_GetPendingTransfers(OLED_Display_t *display);
+
+
+/**
+ * @brief Repairs one display after transport faults; see OLED_RepairDisplay().
+ */
+uint8_t OLED_Display_Repair(OLED_Display_t *display);
+
+
+/**
+ * @brief Copies the transport counters of a display (bus errors, timeouts and recoveries are shared).
+ */
+void OLED_Display_GetStats(OLED_Display_t *display, OLED_I2C_Stats_t *stats);
+
+
+/**
+ * @brief Copies the frame and bus load counters of a display.
+ */
+void OLED_Display_GetLoad(OLED_Display_t *display, OLED_DisplayLoad_t *load);
+
+
+/**
+ * @brief Returns the number of display switches on the bus (transfers that changed the address).
+ */
+uint32_t OLED_GetBusSwitches(void);
+
+
+/**
+ * @brief Initializes the inside OLED display (SH1106 128x64).
+ *
+ * Sets up the driver's own display object on the selected transport (I2C at OLED_INSIDE_ADDRESS,
+ * or SPI4), initializes the display, and powers it on. This function must be called before any
+ * drawing operations.
+ *
+ * @param[in] transport OLED_TRANSPORT_I2C or OLED_TRANSPORT_SPI.
+ * @return Status of the inside display (see OLED_Display_Init()); the display can be drawn
+ *         to unless it is OLED_STATUS_FAILED.
  *
  * @note Call once during system startup before using any display functions.
  */
-void OLED_Init(void);
+OLED_Status_t OLED_Init(OLED_Transport_t transport);
 
 
 /**
- * @brief Returns a pointer to the internal u8g2 display object.
+ * @brief Returns the driver's inside display object (set up by OLED_Init()).
+ */
+OLED_Display_t* OLED_GetInsideDisplay(void);
+
+
+/**
+ * @brief Returns a pointer to the u8g2 object of the inside display.
  *
- * Provides access to the static u8g2 object for direct drawing operations.
+ * Provides access to the inside display's u8g2 object for direct drawing operations.
  *
  * @return Pointer to the internal u8g2 object.
  */
 u8g2_t* OLED_GetDisplay(void);
 
 
+/**
+ * @brief Blocks until the queued transfers of all displays have been sent (a stuck bus is recovered).
+ *
+ * Only needed when the caller must know that the panel is up to date (e.g. before power save or
+ * a delay). Returns immediately when OLED_I2C_USE_DMA is 0.
+ */
+void OLED_WaitTransferComplete(void);
+
+
+/**
+ * @brief Returns the number of inside display transfers that are queued or in flight (non-blocking).
+ *
+ * Lets periodic renderers skip a frame instead of blocking on a full transfer queue.
+ *
+ * @return Pending DMA slots, or 0 when OLED_I2C_USE_DMA is 0.
+ */
+uint8_t OLED_GetPendingTransfers(void);
+
+
+/**
+ * @brief Repairs the inside panel after transport faults (call after rendering, from the display task).
+ *
+ * Re-sends the last frame after a bus recovery, probes a display that stopped answering and
+ * re-initializes it when it is back. Returns 1 when the frame was re-sent (full buffer mode) or
+ * must be redrawn by the caller (page modes).
+ */
+uint8_t OLED_RepairDisplay(void);
+
+
+/**
+ * @brief Copies the I2C transport health counters of the inside display.
+ */
+void OLED_GetI2CStats(OLED_I2C_Stats_t *stats);
+
+
 /**
  * @brief STM32 I2C transfer callback for u8g2/u8x8.
  *
@@ -57,6 +382,19 @@ u8g2_t* OLED_GetDisplay(void);
 uint8_t u8x8_byte_stm32_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
 
 
+/**
+ * @brief STM32 SPI transfer callback for u8g2/u8x8 (SPI4 with DMA, CS and DC on GPIO).
+ *
+ * @param[in] u8x8    Pointer to u8x8 structure (first member of an OLED_Display_t).
+ * @param[in] msg     Message type (U8X8_MSG_*).
+ * @param[in] arg_int Integer argument (depends on message).
+ * @param[in] arg_ptr Pointer argument (depends on message).
+ * @retval 1 Operation successful or handled.
+ * @retval 0 Operation not handled or failed.
+ */
+uint8_t u8x8_byte_stm32_spi(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
+
+
 /**
  * @brief STM32-specific delay and GPIO callback for u8g2/u8x8.
  *
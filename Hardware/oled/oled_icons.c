@@ -0,0 +1,19 @@
+/**
+ * @file oled_icons.c
+ * @author Ted Wang
+ * @brief Native OLED images generated by Tools/oled_img/png2oled.py from lock_closed.png lock_open.png.
+ */
+
+#include "oled_icons.h"
+
+static const uint8_t oled_img_lock_closed_data[32] = {
+    0x00, 0x00, 0xC0, 0xFC, 0xC6, 0xC3, 0xC1, 0xC1, 0xC1, 0xC1, 0xC3, 0xC6, 0xFC, 0xC0, 0x00, 0x00,
+    0x00, 0x00, 0x7F, 0x7F, 0x7F, 0x7F, 0x79, 0x70, 0x60, 0x79, 0x7F, 0x7F, 0x7F, 0x7F, 0x00, 0x00,
+};
+const OLED_Image_t oled_img_lock_closed = {16, 16, oled_img_lock_closed_data};
+
+static const uint8_t oled_img_lock_open_data[32] = {
+    0x00, 0x00, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xFC, 0xC6, 0xC3, 0xC1, 0xC1, 0xC1, 0xC1, 0x03, 0x0E,
+    0x00, 0x00, 0x7F, 0x7F, 0x7F, 0x7F, 0x79, 0x70, 0x60, 0x79, 0x7F, 0x7F, 0x7F, 0x7F, 0x00, 0x00,
+};
+const OLED_Image_t oled_img_lock_open = {16, 16, oled_img_lock_open_data};
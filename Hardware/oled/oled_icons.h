@@ -0,0 +1,26 @@
+
+/**
+ * @file oled_icons.h
+ * @author Ted Wang
+ * @brief Native OLED images generated by Tools/oled_img/png2oled.py from lock_closed.png lock_open.png.
+ *
+ * Do not edit; regenerate from the PNG sources instead.
+ */
+
+#ifndef OLED_ICONS_H
+#define OLED_ICONS_H
+
+#include "oled_blit.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern const OLED_Image_t oled_img_lock_closed;    /**< 16x16 */
+extern const OLED_Image_t oled_img_lock_open;    /**< 16x16 */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // OLED_ICONS_H
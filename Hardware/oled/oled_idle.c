@@ -0,0 +1,178 @@
+/**
+ * @file oled_idle.c
+ * @author Ted Wang
+ * @date 2026-10-17
+ * @brief Display idle manager: contrast ramp, power save, instant wake and pixel shift.
+ *
+ * This file provides:
+ *   - The ACTIVE -> DIMMING -> DIM -> SLEEP state walk, timed from the last activity
+ *   - Wake from power save after the new frame has been sent, with latency counters
+ *   - The pixel shift orbit for static regions
+ */
+
+#include "oled_idle.h"
+#include <string.h>
+
+/**
+ * @brief Pixel shift orbit: a 3x3 square walked clockwise, one pixel per move.
+ */
+static const uint8_t oled_idle_orbit[OLED_IDLE_SHIFT_POSITIONS][2] = {
+    {0, 0}, {1, 0}, {2, 0}, {2, 1}, {2, 2}, {1, 2}, {0, 2}, {0, 1}
+};
+
+/**
+ * @brief Sends a contrast level if it differs from the one sent last.
+ */
+static void OLED_Idle_SetContrast(OLED_Idle_t *idle, uint8_t contrast)
+{
+    if (contrast != idle->contrast)
+    {
+        u8g2_SetContrast(idle->u8g2, contrast);
+        idle->contrast = contrast;
+        idle->stats.contrast_writes++;
+    }
+}
+
+/**
+ * @brief Initializes the manager in the ACTIVE state and sends the full contrast.
+ */
+void OLED_Idle_Init(OLED_Idle_t *idle, u8g2_t *u8g2, const OLED_IdleConfig_t *config, uint32_t now_ms)
+{
+    idle->u8g2 = u8g2;
+    idle->config = *config;
+    idle->state = OLED_IDLE_ACTIVE;
+    idle->activity_ms = now_ms;
+    idle->shift_ms = now_ms;
+    idle->wake_ms = now_ms;
+    idle->shift = 0;
+    idle->waking = 0;
+    idle->redraw = 0;
+    memset(&idle->stats, 0, sizeof(idle->stats));
+    u8g2_SetContrast(u8g2, config->contrast_full);
+    idle->contrast = config->contrast_full;
+}
+
+/**
+ * @brief Records an activity; returns 1 if the panel is asleep and needs a frame before it is switched on.
+ */
+uint8_t OLED_Idle_Activity(OLED_Idle_t *idle, uint32_t now_ms)
+{
+    idle->activity_ms = now_ms;
+    if (idle->state == OLED_IDLE_SLEEP)
+    {
+        /* The panel stays dark until the new frame is in its RAM */
+        idle->waking = 1;
+        idle->wake_ms = now_ms;
+    }
+    idle->state = OLED_IDLE_ACTIVE;
+    OLED_Idle_SetContrast(idle, idle->config.contrast_full);
+    return idle->waking;
+}
+
+/**
+ * @brief Switches a woken panel on once its first frame has been sent and records the wake latency.
+ */
+void OLED_Idle_FrameSent(OLED_Idle_t *idle, uint32_t now_ms)
+{
+    uint32_t latency;
+
+    if (!idle->waking)
+    {
+        return;
+    }
+    u8g2_SetPowerSave(idle->u8g2, 0);
+    idle->waking = 0;
+    latency = now_ms - idle->wake_ms;
+    idle->stats.wakes++;
+    idle->stats.wake_last_ms = latency;
+    if (latency > idle->stats.wake_max_ms)
+    {
+        idle->stats.wake_max_ms = latency;
+    }
+    if (latency > idle->config.wake_bound_ms)
+    {
+        idle->stats.wake_late++;
+    }
+}
+
+/**
+ * @brief Advances contrast, power save and pixel shift; returns the delay until the next step.
+ */
+uint32_t OLED_Idle_Step(OLED_Idle_t *idle, uint32_t now_ms)
+{
+    const OLED_IdleConfig_t *config = &idle->config;
+    uint32_t elapsed = now_ms - idle->activity_ms;
+    uint32_t wait;
+
+    if (idle->state == OLED_IDLE_SLEEP)
+    {
+        return OLED_IDLE_FOREVER;
+    }
+    if (config->sleep_after_ms != 0 && elapsed >= config->sleep_after_ms && !idle->waking)
+    {
+        u8g2_SetPowerSave(idle->u8g2, 1);
+        idle->state = OLED_IDLE_SLEEP;
+        idle->stats.sleeps++;
+        return OLED_IDLE_FOREVER;
+    }
+
+    if (elapsed < config->dim_after_ms)
+    {
+        idle->state = OLED_IDLE_ACTIVE;
+        OLED_Idle_SetContrast(idle, config->contrast_full);
+        wait = config->dim_after_ms - elapsed;
+    }
+    else if (elapsed - config->dim_after_ms < config->ramp_ms)
+    {
+        /* Step k of the ramp covers [k, k + 1) * ramp_ms / OLED_IDLE_RAMP_STEPS and ends at level k + 1 */
+        uint32_t into = elapsed - config->dim_after_ms;
+        uint32_t k = into * OLED_IDLE_RAMP_STEPS / config->ramp_ms;
+        int32_t span = (int32_t)config->contrast_full - (int32_t)config->contrast_dim;
+
+        idle->state = OLED_IDLE_DIMMING;
+        OLED_Idle_SetContrast(idle, (uint8_t)(config->contrast_full - span * (int32_t)(k + 1) / OLED_IDLE_RAMP_STEPS));
+        wait = ((k + 1) * config->ramp_ms + OLED_IDLE_RAMP_STEPS - 1) / OLED_IDLE_RAMP_STEPS - into;
+    }
+    else
+    {
+        idle->state = OLED_IDLE_DIM;
+        OLED_Idle_SetContrast(idle, config->contrast_dim);
+        wait = (config->sleep_after_ms != 0) ? config->sleep_after_ms - elapsed : OLED_IDLE_FOREVER;
+    }
+
+    if (config->shift_period_ms != 0)
+    {
+        uint32_t since = now_ms - idle->shift_ms;
+
+        if (since >= config->shift_period_ms)
+        {
+            idle->shift = (uint8_t)((idle->shift + 1) % OLED_IDLE_SHIFT_POSITIONS);
+            idle->shift_ms = now_ms;
+            idle->redraw = 1;
+            idle->stats.shifts++;
+            since = 0;
+        }
+        if (config->shift_period_ms - since < wait)
+        {
+            wait = config->shift_period_ms - since;
+        }
+    }
+    return (wait == 0) ? 1 : wait;
+}
+
+/**
+ * @brief Returns 1 while the panel is dark and not being woken.
+ */
+uint8_t OLED_Idle_IsAsleep(const OLED_Idle_t *idle)
+{
+    return (uint8_t)(idle->state == OLED_IDLE_SLEEP);
+}
+
+/**
+ * @brief Returns the current pixel shift.
+ */
+void OLED_Idle_GetShift(const OLED_Idle_t *idle, uint8_t *dx, uint8_t *dy)
+{
+    *dx = oled_idle_orbit[idle->shift][0];
+    *dy = oled_idle_orbit[idle->shift][1];
+}
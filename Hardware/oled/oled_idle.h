@@ -0,0 +1,157 @@
+/**
+ * @file oled_idle.h
+ * @author Ted Wang
+ * @date 2026-10-17
+ * @brief Display idle manager: contrast ramp, power save, instant wake and pixel shift.
+ *
+ * An OLED pixel wears with its on-time and brightness, so a door panel that shows the same header
+ * at full contrast around the clock burns it in. The idle manager walks a display through
+ *   ACTIVE  - full contrast, for dim_after_ms after the last activity;
+ *   DIMMING - contrast ramps down linearly to contrast_dim over ramp_ms (one command per step);
+ *   DIM     - low contrast until sleep_after_ms after the last activity;
+ *   SLEEP   - u8g2_SetPowerSave(1): the panel is dark, its RAM keeps the last frame.
+ * OLED_Idle_Activity() (a card event) restores full contrast at once. From SLEEP the caller draws
+ * and sends the current frame while the panel is still dark, and OLED_Idle_FrameSent() switches it
+ * on, so the first frame after waking is the new content and never the one from before sleeping.
+ * The time from the activity to OLED_Idle_FrameSent() is the wake latency; wakes that exceed
+ * wake_bound_ms are counted.
+ *
+ * While the panel is lit the whole layout orbits by a few pixels every shift_period_ms (8 positions
+ * on a 3x3 square), which spreads the wear of static regions over neighbouring pixels. The shift is
+ * applied by the caller's drawing code (OLED_Idle_GetShift()) when redraw is set.
+ *
+ * The manager has no RTOS or HAL dependency: the caller passes the time and blocks for the delay
+ * returned by OLED_Idle_Step(). It is also built by the host benchmark (Tools/oled_host).
+ */
+
+#ifndef OLED_IDLE_H
+#define OLED_IDLE_H
+
+#include "u8g2.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @def OLED_IDLE_FOREVER
+ * @brief Return value of OLED_Idle_Step() when nothing is scheduled (wait for the next activity).
+ */
+#define OLED_IDLE_FOREVER           0xFFFFFFFFUL
+
+/**
+ * @def OLED_IDLE_RAMP_STEPS
+ * @brief Contrast commands sent during the ramp from full to dim contrast.
+ */
+#define OLED_IDLE_RAMP_STEPS        16
+
+/**
+ * @def OLED_IDLE_SHIFT_POSITIONS
+ * @brief Positions of the pixel shift orbit.
+ */
+#define OLED_IDLE_SHIFT_POSITIONS   8
+
+/**
+ * @brief Idle states of a display.
+ */
+typedef enum {
+    OLED_IDLE_ACTIVE = 0,           /**< Full contrast */
+    OLED_IDLE_DIMMING,              /**< Contrast ramping down */
+    OLED_IDLE_DIM,                  /**< Low contrast */
+    OLED_IDLE_SLEEP                 /**< Power save (panel dark) */
+} OLED_IdleState_t;
+
+/**
+ * @brief Idle timing and contrast levels (all times in milliseconds since the last activity).
+ */
+typedef struct {
+    uint32_t dim_after_ms;          /**< Start of the contrast ramp */
+    uint32_t ramp_ms;               /**< Duration of the ramp */
+    uint32_t sleep_after_ms;        /**< Power save (0 = never sleep) */
+    uint32_t shift_period_ms;       /**< Pixel shift period (0 = no shift) */
+    uint32_t wake_bound_ms;         /**< Wake latency bound (counted, see OLED_Idle_Stats_t) */
+    uint8_t contrast_full;          /**< Contrast while active */
+    uint8_t contrast_dim;           /**< Contrast at the end of the ramp */
+} OLED_IdleConfig_t;
+
+/**
+ * @brief Idle counters (since OLED_Idle_Init()).
+ */
+typedef struct {
+    uint32_t sleeps;                /**< Times the panel entered power save */
+    uint32_t wakes;                 /**< Wakes from power save */
+    uint32_t wake_last_ms;          /**< Latency of the last wake */
+    uint32_t wake_max_ms;           /**< Worst wake latency */
+    uint32_t wake_late;             /**< Wakes slower than wake_bound_ms */
+    uint32_t contrast_writes;       /**< Contrast commands sent */
+    uint32_t shifts;                /**< Pixel shift moves */
+} OLED_IdleStats_t;
+
+/**
+ * @brief Idle manager of one display.
+ */
+typedef struct {
+    u8g2_t *u8g2;                   /**< Display */
+    OLED_IdleConfig_t config;       /**< Timing and contrast levels */
+    OLED_IdleState_t state;         /**< Current state */
+    uint32_t activity_ms;           /**< Time of the last activity */
+    uint32_t shift_ms;              /**< Time of the last pixel shift move */
+    uint32_t wake_ms;               /**< Time of the activity that woke the panel */
+    uint8_t contrast;               /**< Contrast sent last */
+    uint8_t shift;                  /**< Position on the shift orbit */
+    uint8_t waking;                 /**< 1 = woken, panel still dark until OLED_Idle_FrameSent() */
+    uint8_t redraw;                 /**< 1 = the pixel shift moved; redraw and clear the flag */
+    OLED_IdleStats_t stats;         /**< Counters */
+} OLED_Idle_t;
+
+
+/**
+ * @brief Initializes the manager in the ACTIVE state and sends the full contrast.
+ *
+ * @param[in] config Timing and contrast levels (copied).
+ * @param[in] now_ms Current time; counts as activity.
+ */
+void OLED_Idle_Init(OLED_Idle_t *idle, u8g2_t *u8g2, const OLED_IdleConfig_t *config, uint32_t now_ms);
+
+
+/**
+ * @brief Records an activity (card event): full contrast at once, idle timers restart.
+ *
+ * @return 1 if the panel is asleep: draw and send the current frame, then call OLED_Idle_FrameSent().
+ */
+uint8_t OLED_Idle_Activity(OLED_Idle_t *idle, uint32_t now_ms);
+
+
+/**
+ * @brief Tells the manager that a frame has been sent; switches a woken panel on.
+ *
+ * Call after every frame. Following a wake, call it once the frame has left the bus so the measured
+ * latency covers the whole frame.
+ */
+void OLED_Idle_FrameSent(OLED_Idle_t *idle, uint32_t now_ms);
+
+
+/**
+ * @brief Advances the contrast ramp, power save and pixel shift to now_ms.
+ *
+ * @return Milliseconds until the next step is due, or OLED_IDLE_FOREVER while asleep.
+ */
+uint32_t OLED_Idle_Step(OLED_Idle_t *idle, uint32_t now_ms);
+
+
+/**
+ * @brief Returns 1 while the panel is dark (nothing to draw until the next activity).
+ */
+uint8_t OLED_Idle_IsAsleep(const OLED_Idle_t *idle);
+
+
+/**
+ * @brief Returns the current pixel shift (0..2 pixels right and down).
+ */
+void OLED_Idle_GetShift(const OLED_Idle_t *idle, uint8_t *dx, uint8_t *dy);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // OLED_IDLE_H
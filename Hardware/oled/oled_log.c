@@ -0,0 +1,229 @@
+/**
+ * @file oled_log.c
+ * @author Ted Wang
+ * @date 2026-10-17
+ * @brief Hardware-scrolled u8log terminal for the SH1106 OLED display.
+ *
+ * This file provides:
+ *   - A u8log redraw callback that only marks the written lines and counts the scroll steps
+ *   - A shadow copy of the characters on the panel, one text line per display page
+ *   - A flush that scrolls with the display start line command and renders/sends only the tiles
+ *     of the character cells that differ from the shadow copy
+ *
+ * Rendering uses the regular u8g2 framebuffer, clipped to the tiles being updated, and
+ * u8g2_UpdateDisplayArea() to send them.
+ */
+
+#include "oled_log.h"
+#include "oled_region.h"
+#include <string.h>
+
+/**
+ * @brief Renders the cells of one log line that cover a run of changed cells and sends their tiles.
+ *
+ * @param[in,out] oled_log Log terminal state.
+ * @param[in]     row      Visible line index (0 = top of the panel).
+ * @param[in]     c0       First changed cell.
+ * @param[in]     c1       Last changed cell.
+ * @return Number of tiles sent.
+ */
+static uint16_t OLED_Log_DrawCells(OLED_Log_t *oled_log, uint8_t row, uint8_t c0, uint8_t c1)
+{
+    u8g2_t *u8g2 = oled_log->u8g2;
+    uint8_t cols = oled_log->log.width;
+    uint8_t cw = oled_log->cell_width;
+    uint8_t page = (uint8_t)((oled_log->top_page + row) % OLED_LOG_ROWS);
+    u8g2_uint_t y0 = (u8g2_uint_t)page * 8;
+    uint8_t tx0 = (uint8_t)((c0 * cw) / 8);
+    uint8_t tx1 = (uint8_t)(((c1 + 1) * cw + 7) / 8);
+    uint8_t ca;
+    uint8_t cb;
+    const uint8_t *saved_font = u8g2->font;
+    u8g2_font_calc_vref_fnptr saved_vref = u8g2->font_calc_vref;
+
+    if (tx1 > u8g2_GetBufferTileWidth(u8g2))
+    {
+        tx1 = u8g2_GetBufferTileWidth(u8g2);
+    }
+    /* Whole tiles are sent, so every cell that overlaps them is rendered */
+    ca = (uint8_t)((tx0 * 8) / cw);
+    cb = (uint8_t)((tx1 * 8 + cw - 1) / cw);
+    if (cb > cols)
+    {
+        cb = cols;
+    }
+
+    u8g2_SetClipWindow(u8g2, (u8g2_uint_t)(tx0 * 8), y0, (u8g2_uint_t)(tx1 * 8), y0 + 8);
+    OLED_Region_Clear(u8g2, (int16_t)(tx0 * 8), (int16_t)y0, (int16_t)((tx1 - tx0) * 8), 8);
+    u8g2_SetFont(u8g2, oled_log->font);
+    u8g2_SetFontPosTop(u8g2);
+    for (uint8_t c = ca; c < cb; c++)
+    {
+        uint8_t ch = oled_log->screen[row * cols + c];
+        if (ch != ' ')
+        {
+            u8g2_DrawGlyph(u8g2, (u8g2_uint_t)(c * cw), y0, ch);
+        }
+    }
+    u8g2_SetMaxClipWindow(u8g2);
+    u8g2_SetFont(u8g2, saved_font);
+    u8g2->font_calc_vref = saved_vref;
+
+    u8g2_UpdateDisplayArea(u8g2, tx0, page, (uint8_t)(tx1 - tx0), 1);
+    oled_log->pages_sent++;
+    oled_log->tiles_sent += (uint32_t)(tx1 - tx0);
+    oled_log->cells_drawn += (uint32_t)(cb - ca);
+
+    memcpy(&oled_log->shadow[row * cols + ca], &oled_log->screen[row * cols + ca], (size_t)(cb - ca));
+    return (uint16_t)(tx1 - tx0);
+}
+
+/**
+ * @brief u8log redraw callback (aux_data points to the owning OLED_Log_t).
+ *
+ * Only records the change: the written line (or all lines) is marked and the scroll steps counted
+ * by u8log since the last callback are added to the pending scroll.
+ */
+static void OLED_Log_Redraw(u8log_t *u8log)
+{
+    OLED_Log_t *oled_log = (OLED_Log_t *)u8log->aux_data;
+    uint16_t k = (uint16_t)(u8log->scroll_cnt - oled_log->scroll_seen);
+
+    if (k != 0)
+    {
+        oled_log->scroll_seen = u8log->scroll_cnt;
+        k = (uint16_t)(k + oled_log->pending_scroll);
+        oled_log->pending_scroll = (uint8_t)((k > OLED_LOG_ROWS) ? OLED_LOG_ROWS : k);
+    }
+    if (u8log->is_redraw_all)
+    {
+        oled_log->dirty_rows = (uint8_t)((1u << u8log->height) - 1u);
+    }
+    else if (u8log->is_redraw_line && u8log->redraw_line < u8log->height)
+    {
+        oled_log->dirty_rows |= (uint8_t)(1u << u8log->redraw_line);
+    }
+}
+
+/**
+ * @brief Brings the panel up to date with everything written since the last flush.
+ *
+ * @param[in,out] oled_log Log terminal state.
+ * @return Number of tiles sent (0 if the panel was already up to date).
+ */
+uint16_t OLED_Log_Flush(OLED_Log_t *oled_log)
+{
+    uint8_t rows = oled_log->log.height;
+    uint8_t cols = oled_log->log.width;
+    uint8_t k = oled_log->pending_scroll;
+    uint16_t tiles = 0;
+
+    if (k != 0)
+    {
+        oled_log->pending_scroll = 0;
+        if (k < rows)
+        {
+            memmove(oled_log->shadow, &oled_log->shadow[k * cols], (size_t)(rows - k) * cols);
+            /* 0 never appears in the u8log buffer, so the exposed lines are always redrawn */
+            memset(&oled_log->shadow[(rows - k) * cols], 0, (size_t)k * cols);
+            oled_log->top_page = (uint8_t)((oled_log->top_page + k) % OLED_LOG_ROWS);
+            u8x8_SetDisplayStartLine(u8g2_GetU8x8(oled_log->u8g2), (uint8_t)(oled_log->top_page * 8));
+            oled_log->scrolls += k;
+        }
+        else
+        {
+            /* Everything scrolled out: redraw all lines in place */
+            memset(oled_log->shadow, 0, (size_t)rows * cols);
+        }
+    }
+
+    for (uint8_t row = 0; row < rows; row++)
+    {
+        const uint8_t *shadow = &oled_log->shadow[row * cols];
+        const uint8_t *screen = &oled_log->screen[row * cols];
+        uint8_t c0 = 0;
+        uint8_t c1 = cols;
+
+        if ((oled_log->dirty_rows & (1u << row)) == 0)
+        {
+            continue;
+        }
+        while (c0 < cols && shadow[c0] == screen[c0])
+        {
+            c0++;
+        }
+        if (c0 == cols)
+        {
+            continue;
+        }
+        while (shadow[c1 - 1] == screen[c1 - 1])
+        {
+            c1--;
+        }
+        tiles = (uint16_t)(tiles + OLED_Log_DrawCells(oled_log, row, c0, (uint8_t)(c1 - 1)));
+    }
+    oled_log->dirty_rows = 0;
+    return tiles;
+}
+
+/**
+ * @brief Initializes the log terminal and clears the display.
+ *
+ * @param[out] oled_log Log terminal state to initialize.
+ * @param[in]  u8g2     Display object (full buffer mode, SH1106/SSD13xx controller).
+ * @param[in]  font     Font for the log text; its height must fit into one 8-pixel page.
+ */
+void OLED_Log_Init(OLED_Log_t *oled_log, u8g2_t *u8g2, const uint8_t *font)
+{
+    const uint8_t *saved_font = u8g2->font;
+    uint8_t cols;
+
+    memset(oled_log, 0, sizeof(*oled_log));
+    oled_log->u8g2 = u8g2;
+    oled_log->font = font;
+
+    u8g2_SetFont(u8g2, font);
+    oled_log->cell_width = (uint8_t)u8g2_GetMaxCharWidth(u8g2);
+    cols = (uint8_t)(u8g2_GetDisplayWidth(u8g2) / oled_log->cell_width);
+    if (saved_font != NULL)
+    {
+        u8g2_SetFont(u8g2, saved_font);
+    }
+    if (cols > OLED_LOG_MAX_COLS)
+    {
+        cols = OLED_LOG_MAX_COLS;
+    }
+
+    u8log_Init(&oled_log->log, cols, OLED_LOG_ROWS, oled_log->screen);
+    u8log_SetCallback(&oled_log->log, OLED_Log_Redraw, oled_log);
+    /* Every character reports its line; the callback only marks it */
+    u8log_SetRedrawMode(&oled_log->log, 1);
+    memset(oled_log->shadow, ' ', sizeof(oled_log->shadow));
+
+    u8x8_SetDisplayStartLine(u8g2_GetU8x8(u8g2), 0);
+    u8g2_ClearBuffer(u8g2);
+    u8g2_SendBuffer(u8g2);
+    oled_log->pages_sent += u8g2_GetBufferTileHeight(u8g2);
+}
+
+/**
+ * @brief Writes a string to the log; the display is updated by the next OLED_Log_Flush().
+ *
+ * @param[in,out] oled_log Log terminal state.
+ * @param[in]     str      Null-terminated string (u8log control codes are supported).
+ */
+void OLED_Log_WriteString(OLED_Log_t *oled_log, const char *str)
+{
+    u8log_WriteString(&oled_log->log, str);
+}
+
+/**
+ * @brief Returns the display to the un-scrolled state for regular full-screen drawing.
+ *
+ * @param[in,out] oled_log Log terminal state.
+ */
+void OLED_Log_Release(OLED_Log_t *oled_log)
+{
+    oled_log->top_page = 0;
+    u8x8_SetDisplayStartLine(u8g2_GetU8x8(oled_log->u8g2), 0);
+}
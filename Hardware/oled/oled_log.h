@@ -0,0 +1,112 @@
+
+/**
+ * @file oled_log.h
+ * @author Ted Wang
+ * @date 2026-10-17
+ * @brief Hardware-scrolled u8log terminal for the SH1106 OLED display.
+ *
+ * The stock u8log/u8g2 backend scrolls by moving the whole character buffer and redrawing the whole
+ * screen, so every new log line re-renders and re-sends the full 1 KB framebuffer; with
+ * u8log_SetRedrawMode(1) it also re-renders the whole line for every character. This backend keeps
+ * one text line per display page and scrolls with the controller's display start line command
+ * (0x40..0x7F) instead.
+ *
+ * Writing only records what changed: the u8log callback marks the touched lines and counts the
+ * scroll steps. OLED_Log_Flush(), called once per frame tick, applies the accumulated scroll with a
+ * single start line command, compares each marked line with a shadow copy of the characters on the
+ * panel and renders and sends only the tiles covering the changed character cells. Text is laid
+ * out on a fixed cell grid (the widest glyph of the font), so a live console that appends a few
+ * characters per tick sends a tile or two per tick, however many characters were written.
+ *
+ * While the log is active it owns the display, and the u8g2 framebuffer mirrors the controller RAM
+ * (rotated by the start line) rather than the visible screen. Call OLED_Log_Release() before
+ * returning the display to regular full-screen drawing.
+ */
+
+#ifndef OLED_LOG_H
+#define OLED_LOG_H
+
+#include "u8g2.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @def OLED_LOG_ROWS
+ * @brief Number of text lines (one per 8-pixel display page).
+ */
+#define OLED_LOG_ROWS        8
+
+/**
+ * @def OLED_LOG_MAX_COLS
+ * @brief Maximum number of characters per line.
+ */
+#define OLED_LOG_MAX_COLS    32
+
+/**
+ * @brief Hardware-scrolled log terminal state.
+ */
+typedef struct {
+    u8log_t log;                                            /**< u8log terminal (character buffer, cursor) */
+    u8g2_t *u8g2;                                           /**< Display the log is drawn on */
+    const uint8_t *font;                                    /**< Font used for the log (max. 8 pixel high) */
+    uint8_t top_page;                                       /**< RAM page currently shown at the top of the panel */
+    uint8_t cell_width;                                     /**< Width of a character cell in pixels */
+    uint8_t dirty_rows;                                     /**< Lines written since the last flush (bit per line) */
+    uint8_t pending_scroll;                                 /**< Scroll steps since the last flush (max. OLED_LOG_ROWS) */
+    uint16_t scroll_seen;                                   /**< u8log scroll counter at the last callback */
+    uint8_t screen[OLED_LOG_ROWS * OLED_LOG_MAX_COLS];      /**< u8log character buffer */
+    uint8_t shadow[OLED_LOG_ROWS * OLED_LOG_MAX_COLS];      /**< Characters currently on the panel, per line */
+    uint32_t pages_sent;                                    /**< Number of page transfers issued (profiling) */
+    uint32_t tiles_sent;                                    /**< Number of 8x8 tiles sent (profiling) */
+    uint32_t cells_drawn;                                   /**< Number of character cells rendered (profiling) */
+    uint32_t scrolls;                                       /**< Number of hardware scroll steps (profiling) */
+} OLED_Log_t;
+
+
+/**
+ * @brief Initializes the log terminal and clears the display.
+ *
+ * @param[out] oled_log Log terminal state to initialize.
+ * @param[in]  u8g2     Display object (full buffer mode, SH1106/SSD13xx controller).
+ * @param[in]  font     Font for the log text; its height must fit into one 8-pixel page.
+ */
+void OLED_Log_Init(OLED_Log_t *oled_log, u8g2_t *u8g2, const uint8_t *font);
+
+
+/**
+ * @brief Writes a string to the log; the display is updated by the next OLED_Log_Flush().
+ *
+ * @param[in,out] oled_log Log terminal state.
+ * @param[in]     str      Null-terminated string (u8log control codes are supported).
+ */
+void OLED_Log_WriteString(OLED_Log_t *oled_log, const char *str);
+
+
+/**
+ * @brief Brings the panel up to date with everything written since the last flush.
+ *
+ * Scrolls once by the accumulated number of lines, then renders and sends the tiles of the changed
+ * character cells of each written line. Call it once per frame tick (or after a batch of writes).
+ *
+ * @param[in,out] oled_log Log terminal state.
+ * @return Number of tiles sent (0 if the panel was already up to date).
+ */
+uint16_t OLED_Log_Flush(OLED_Log_t *oled_log);
+
+
+/**
+ * @brief Returns the display to the un-scrolled state for regular full-screen drawing.
+ *
+ * Resets the display start line to 0. The caller is expected to redraw and send a full frame.
+ *
+ * @param[in,out] oled_log Log terminal state.
+ */
+void OLED_Log_Release(OLED_Log_t *oled_log);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // OLED_LOG_H
@@ -0,0 +1,260 @@
+/**
+ * @file oled_mirror.c
+ * @author Ted Wang
+ * @date 2026-10-17
+ * @brief Binary screen mirroring of the u8g2 framebuffer over UART (DMA).
+ *
+ * This file provides:
+ *   - A streaming PackBits encoder that writes directly into the UART transmit buffer
+ *   - Keyframe and XOR-delta frame encoding against a reference copy of the last sent frame
+ *   - Non-blocking DMA transmission with skip-on-busy back-pressure
+ *
+ * The state is not thread-safe; it is meant to be used from the OLED display task only.
+ */
+
+#include "oled_mirror.h"
+#include "ccmram.h"
+#include "uart_log.h"
+#include <string.h>
+
+/**
+ * @brief Stream frame header and trailer sizes.
+ */
+#define OLED_MIRROR_SYNC0           0xA5
+#define OLED_MIRROR_SYNC1           0x5A
+#define OLED_MIRROR_HEADER_BYTES    5
+#define OLED_MIRROR_TRAILER_BYTES   2
+
+/**
+ * @brief Transmit buffer size: header, seq/size, tile bitmap, worst-case PackBits output, trailer.
+ */
+#define OLED_MIRROR_TX_BYTES        (OLED_MIRROR_HEADER_BYTES + 3 + 16 + OLED_MIRROR_MAX_BYTES + OLED_MIRROR_MAX_BYTES / 64 + OLED_MIRROR_TRAILER_BYTES)
+
+/**
+ * @brief Streaming PackBits encoder state.
+ *
+ * Control byte n: 0..127 = n+1 literal bytes follow; 129..255 = next byte repeated 257-n times.
+ */
+typedef struct {
+    uint8_t *out;           /**< Output position */
+    uint8_t *lit_ctrl;      /**< Control byte of the open literal run, or NULL */
+    uint8_t run_byte;       /**< Byte of the pending run */
+    uint8_t run_len;        /**< Length of the pending run (0 = none) */
+} OLED_MirrorRLE_t;
+
+/**
+ * @brief Mirror state (file scope only). The reference frame is CPU-only (CCM RAM); the transmit
+ *        buffer is read by the UART DMA and stays in SRAM.
+ */
+static UART_HandleTypeDef *mirror_uart;
+static uint8_t mirror_ref[OLED_MIRROR_MAX_BYTES] CCM_RAM;
+static uint8_t mirror_tx[OLED_MIRROR_TX_BYTES];
+static uint8_t mirror_seq;
+static uint8_t mirror_need_key = 1;
+static uint8_t mirror_since_key;
+static OLED_MirrorStats_t mirror_stats;
+
+/**
+ * @brief Appends bytes to the open literal run, opening a new one when needed.
+ */
+static void OLED_Mirror_RLE_Literal(OLED_MirrorRLE_t *rle, uint8_t b, uint8_t count)
+{
+    while (count-- > 0)
+    {
+        if (rle->lit_ctrl == NULL || *rle->lit_ctrl == 127)
+        {
+            rle->lit_ctrl = rle->out++;
+            *rle->lit_ctrl = 0xFF;      /* becomes 0 with the first byte */
+        }
+        (*rle->lit_ctrl)++;
+        *rle->out++ = b;
+    }
+}
+
+/**
+ * @brief Emits the pending run (as a repeat if it is long enough, otherwise as literals).
+ */
+static void OLED_Mirror_RLE_Flush(OLED_MirrorRLE_t *rle)
+{
+    if (rle->run_len >= 3)
+    {
+        rle->lit_ctrl = NULL;
+        *rle->out++ = (uint8_t)(257 - rle->run_len);
+        *rle->out++ = rle->run_byte;
+    }
+    else
+    {
+        OLED_Mirror_RLE_Literal(rle, rle->run_byte, rle->run_len);
+    }
+    rle->run_len = 0;
+}
+
+/**
+ * @brief Feeds bytes into the PackBits encoder.
+ */
+static void OLED_Mirror_RLE_Put(OLED_MirrorRLE_t *rle, const uint8_t *data, uint16_t len)
+{
+    for (uint16_t i = 0; i < len; i++)
+    {
+        if (rle->run_len != 0 && data[i] == rle->run_byte && rle->run_len < 128)
+        {
+            rle->run_len++;
+            continue;
+        }
+        if (rle->run_len != 0)
+        {
+            OLED_Mirror_RLE_Flush(rle);
+        }
+        rle->run_byte = data[i];
+        rle->run_len = 1;
+    }
+}
+
+/**
+ * @brief Writes the frame header and checksum around the payload and starts the DMA transfer.
+ *
+ * @param[in] type    Frame type ('K' or 'D').
+ * @param[in] end     End of the payload in mirror_tx.
+ */
+static void OLED_Mirror_Send(uint8_t type, const uint8_t *end)
+{
+    uint16_t len = (uint16_t)(end - &mirror_tx[OLED_MIRROR_HEADER_BYTES]);
+    uint16_t total = (uint16_t)(OLED_MIRROR_HEADER_BYTES + len + OLED_MIRROR_TRAILER_BYTES);
+    uint16_t sum1 = 0;
+    uint16_t sum2 = 0;
+
+    mirror_tx[0] = OLED_MIRROR_SYNC0;
+    mirror_tx[1] = OLED_MIRROR_SYNC1;
+    mirror_tx[2] = type;
+    mirror_tx[3] = (uint8_t)(len & 0xFF);
+    mirror_tx[4] = (uint8_t)(len >> 8);
+    for (uint16_t i = 2; i < OLED_MIRROR_HEADER_BYTES + len; i++)
+    {
+        sum1 = (uint16_t)((sum1 + mirror_tx[i]) % 255);
+        sum2 = (uint16_t)((sum2 + sum1) % 255);
+    }
+    mirror_tx[OLED_MIRROR_HEADER_BYTES + len] = (uint8_t)sum1;
+    mirror_tx[OLED_MIRROR_HEADER_BYTES + len + 1] = (uint8_t)sum2;
+
+    if (UartLog_TransmitDma(mirror_tx, total) == HAL_OK)
+    {
+        mirror_stats.bytes_sent += total;
+    }
+    else
+    {
+        /* The receiver will see a sequence gap; resynchronize with a keyframe */
+        mirror_need_key = 1;
+    }
+    mirror_seq++;
+}
+
+/**
+ * @brief Initializes the mirror; the next update sends a keyframe.
+ *
+ * @param[in] huart UART of uart_log.h (huart3), with a DMA TX channel linked.
+ */
+void OLED_Mirror_Init(UART_HandleTypeDef *huart)
+{
+    mirror_uart = huart;
+    mirror_seq = 0;
+    mirror_need_key = 1;
+    mirror_since_key = 0;
+    memset(&mirror_stats, 0, sizeof(mirror_stats));
+}
+
+/**
+ * @brief Sends the changes of the u8g2 framebuffer since the last transmitted frame.
+ *
+ * Tiles are compared as two 32-bit words each; only changed tiles are XORed, encoded and copied into
+ * the reference frame.
+ *
+ * @param[in] u8g2 Display object with a full frame buffer.
+ */
+void OLED_Mirror_Update(u8g2_t *u8g2)
+{
+    const uint8_t *buf = u8g2_GetBufferPtr(u8g2);
+    uint8_t tiles_w = u8g2_GetBufferTileWidth(u8g2);
+    uint8_t tiles_h = u8g2_GetBufferTileHeight(u8g2);
+    uint16_t size = (uint16_t)tiles_w * tiles_h * 8;
+    OLED_MirrorRLE_t rle = {NULL, NULL, 0, 0};
+    uint8_t *p = &mirror_tx[OLED_MIRROR_HEADER_BYTES];
+
+    if (mirror_uart == NULL || size > OLED_MIRROR_MAX_BYTES)
+    {
+        return;
+    }
+    if (mirror_uart->gState != HAL_UART_STATE_READY)
+    {
+        mirror_stats.skipped++;
+        return;
+    }
+
+    *p++ = mirror_seq;
+    *p++ = tiles_w;
+    *p++ = tiles_h;
+
+    if (mirror_need_key || mirror_since_key >= OLED_MIRROR_KEYFRAME_INTERVAL)
+    {
+        rle.out = p;
+        OLED_Mirror_RLE_Put(&rle, buf, size);
+        OLED_Mirror_RLE_Flush(&rle);
+        memcpy(mirror_ref, buf, size);
+        mirror_need_key = 0;
+        mirror_since_key = 0;
+        mirror_stats.keyframes++;
+        OLED_Mirror_Send('K', rle.out);
+        return;
+    }
+
+    uint8_t *bitmap = p;
+    uint16_t tiles = (uint16_t)tiles_w * tiles_h;
+    uint16_t changed = 0;
+
+    memset(bitmap, 0, (size_t)(tiles + 7) / 8);
+    rle.out = bitmap + (tiles + 7) / 8;
+    for (uint16_t t = 0; t < tiles; t++)
+    {
+        uint32_t cur[2];
+        uint32_t ref[2];
+        memcpy(cur, &buf[t * 8], 8);
+        memcpy(ref, &mirror_ref[t * 8], 8);
+        if (cur[0] == ref[0] && cur[1] == ref[1])
+        {
+            continue;
+        }
+        ref[0] ^= cur[0];
+        ref[1] ^= cur[1];
+        OLED_Mirror_RLE_Put(&rle, (const uint8_t *)ref, 8);
+        memcpy(&mirror_ref[t * 8], cur, 8);
+        bitmap[t >> 3] |= (uint8_t)(1u << (t & 7));
+        changed++;
+    }
+    if (changed == 0)
+    {
+        mirror_stats.unchanged++;
+        return;
+    }
+    OLED_Mirror_RLE_Flush(&rle);
+    mirror_since_key++;
+    mirror_stats.deltas++;
+    mirror_stats.tiles_sent += changed;
+    OLED_Mirror_Send('D', rle.out);
+}
+
+/**
+ * @brief Forces the next update to be a keyframe.
+ */
+void OLED_Mirror_RequestKeyframe(void)
+{
+    mirror_need_key = 1;
+}
+
+/**
+ * @brief Returns the mirror statistics.
+ *
+ * @param[out] stats Destination for the counters.
+ */
+void OLED_Mirror_GetStats(OLED_MirrorStats_t *stats)
+{
+    *stats = mirror_stats;
+}
@@ -0,0 +1,104 @@
+
+/**
+ * @file oled_mirror.h
+ * @author Ted Wang
+ * @date 2026-10-17
+ * @brief Binary screen mirroring of the u8g2 framebuffer over UART (DMA).
+ *
+ * u8x8_capture.c / u8g2_WriteBufferPBM() produce uncompressed ASCII images through a per-string
+ * callback, which is far too slow for remote monitoring. This module sends a compact binary stream
+ * instead: a keyframe (the whole framebuffer) followed by delta frames that contain only the tiles
+ * (8x8 pixel blocks) changed since the last transmitted frame, XORed with their previous content and
+ * PackBits run-length encoded. The frame is transmitted with DMA, so the display task only pays for
+ * the compare and the encoding of the changed tiles.
+ *
+ * Stream format (all multi-byte values little endian):
+ * @code
+ *   0xA5 0x5A  type  len_lo len_hi  payload[len]  sum1 sum2
+ *
+ *   type 'K' (keyframe): seq  tiles_w  tiles_h  packbits(framebuffer)
+ *   type 'D' (delta):    seq  tiles_w  tiles_h  bitmap[(tiles_w*tiles_h+7)/8]  packbits(xor tiles)
+ * @endcode
+ * The framebuffer uses the u8g2 tile layout (8 vertical pixels per byte, tile rows of
+ * tiles_w*8 bytes). The bitmap has one bit per tile in row-major order (LSB first); the XOR data
+ * holds 8 bytes per set bit. seq increments with every transmitted frame; a receiver that sees a gap
+ * must wait for the next keyframe (sent every OLED_MIRROR_KEYFRAME_INTERVAL frames). sum1/sum2 are a
+ * Fletcher-16 checksum over type, length and payload. Tools/oled_mirror/oled_mirror.py decodes and
+ * displays the stream.
+ *
+ * Frames share UART3 with the text output and the trace stream through uart_log.h. If the UART is
+ * still busy with the previous frame, the update is skipped and the changes are carried into the
+ * next delta (the reference copy only advances when a frame is sent).
+ */
+
+#ifndef OLED_MIRROR_H
+#define OLED_MIRROR_H
+
+#include "u8g2.h"
+#include "main.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @def OLED_MIRROR_KEYFRAME_INTERVAL
+ * @brief A keyframe is sent after this many delta frames (resynchronizes late or lossy receivers).
+ */
+#define OLED_MIRROR_KEYFRAME_INTERVAL    32
+
+/**
+ * @def OLED_MIRROR_MAX_BYTES
+ * @brief Framebuffer size supported by the mirror (128x64 monochrome).
+ */
+#define OLED_MIRROR_MAX_BYTES            1024
+
+/**
+ * @brief Mirror statistics (for profiling).
+ */
+typedef struct {
+    uint32_t keyframes;         /**< Keyframes transmitted */
+    uint32_t deltas;            /**< Delta frames transmitted */
+    uint32_t unchanged;         /**< Updates without any changed tile (nothing sent) */
+    uint32_t skipped;           /**< Updates skipped because the UART was busy */
+    uint32_t tiles_sent;        /**< Changed tiles transmitted in delta frames */
+    uint32_t bytes_sent;        /**< Total stream bytes transmitted */
+} OLED_MirrorStats_t;
+
+
+/**
+ * @brief Initializes the mirror; the next update sends a keyframe.
+ *
+ * @param[in] huart UART of uart_log.h (huart3), with a DMA TX channel linked.
+ */
+void OLED_Mirror_Init(UART_HandleTypeDef *huart);
+
+
+/**
+ * @brief Sends the changes of the u8g2 framebuffer since the last transmitted frame.
+ *
+ * Call after the frame has been rendered (full buffer mode only).
+ *
+ * @param[in] u8g2 Display object with a full frame buffer.
+ */
+void OLED_Mirror_Update(u8g2_t *u8g2);
+
+
+/**
+ * @brief Forces the next update to be a keyframe.
+ */
+void OLED_Mirror_RequestKeyframe(void);
+
+
+/**
+ * @brief Returns the mirror statistics.
+ *
+ * @param[out] stats Destination for the counters.
+ */
+void OLED_Mirror_GetStats(OLED_MirrorStats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // OLED_MIRROR_H
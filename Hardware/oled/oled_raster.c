@@ -0,0 +1,609 @@
+/**
+ * @file oled_raster.c
+ * @author Ted Wang
+ * @date 2026-10-17
+ * @brief Span-based line, circle, disc and polygon rasterizers for the u8g2 tile buffer.
+ *
+ * This file provides:
+ *   - Run writers: a horizontal run is one bit mask over consecutive bytes of a band, a vertical run
+ *     one byte mask per band; both clipped against the u8g2 user window
+ *   - A band filler for filled shapes that writes the columns shared by all rows of a band once
+ *   - Bresenham lines split into runs, midpoint circles/discs from a per-row half-width table, and
+ *     an even-odd scanline polygon fill with exact integer edge sampling
+ *
+ * The line and circle algorithms replicate u8g2_line.c and u8g2_circle.c step by step, so the
+ * resulting pixels are identical; only the way they reach the buffer differs.
+ */
+
+#include "oled_raster.h"
+#include <string.h>
+
+/**
+ * @brief Replicates a byte into the four lanes of a 32-bit word.
+ */
+#define OLED_RASTER_LANES(b)    ((uint32_t)(uint8_t)(b) * 0x01010101UL)
+
+/**
+ * @brief Visible window (current page intersected with the clip window) and draw color.
+ */
+typedef struct {
+    int16_t x0;         /**< First visible column */
+    int16_t x1;         /**< Last visible column + 1 */
+    int16_t y0;         /**< First visible row */
+    int16_t y1;         /**< Last visible row + 1 */
+    uint8_t color;      /**< u8g2 draw color (0 = clear, 1 = set, 2 = XOR) */
+} OLED_RasterClip_t;
+
+/**
+ * @brief Reads the visible window; returns 0 if nothing can be drawn.
+ */
+static uint8_t OLED_Raster_GetClip(u8g2_t *u8g2, OLED_RasterClip_t *clip)
+{
+#ifdef U8G2_WITH_CLIP_WINDOW_SUPPORT
+    if (u8g2->is_page_clip_window_intersection == 0)
+    {
+        return 0;
+    }
+#endif
+    clip->x0 = (int16_t)u8g2->user_x0;
+    clip->x1 = (int16_t)u8g2->user_x1;
+    clip->y0 = (int16_t)u8g2->user_y0;
+    clip->y1 = (int16_t)u8g2->user_y1;
+    clip->color = u8g2->draw_color;
+    return (uint8_t)(clip->x0 < clip->x1 && clip->y0 < clip->y1);
+}
+
+/**
+ * @brief Returns the buffer bytes of a band (8 pixel rows) of the current page.
+ */
+static uint8_t *OLED_Raster_BandPtr(u8g2_t *u8g2, int16_t band)
+{
+    return u8g2->tile_buf_ptr + (uint16_t)(band - u8g2->tile_curr_row) * u8g2->pixel_buf_width;
+}
+
+/**
+ * @brief Applies the same bit mask to n consecutive bytes (four per 32-bit word).
+ */
+static void OLED_Raster_Apply(uint8_t *dst, uint16_t n, uint8_t mask, uint8_t color)
+{
+    uint32_t mask32 = OLED_RASTER_LANES(mask);
+    uint16_t i = 0;
+
+    for (; i + 4 <= n; i += 4)
+    {
+        uint32_t d;
+        memcpy(&d, &dst[i], 4);
+        if (color == 1)
+        {
+            d |= mask32;
+        }
+        else if (color == 0)
+        {
+            d &= ~mask32;
+        }
+        else
+        {
+            d ^= mask32;
+        }
+        memcpy(&dst[i], &d, 4);
+    }
+    for (; i < n; i++)
+    {
+        if (color == 1)
+        {
+            dst[i] |= mask;
+        }
+        else if (color == 0)
+        {
+            dst[i] &= (uint8_t)~mask;
+        }
+        else
+        {
+            dst[i] ^= mask;
+        }
+    }
+}
+
+/**
+ * @brief Draws the horizontal run xa..xb (inclusive, xa <= xb) on row y.
+ */
+static void OLED_Raster_HRun(u8g2_t *u8g2, const OLED_RasterClip_t *clip, int16_t xa, int16_t xb, int16_t y)
+{
+    if (y < clip->y0 || y >= clip->y1)
+    {
+        return;
+    }
+    if (xa < clip->x0)
+    {
+        xa = clip->x0;
+    }
+    if (xb >= clip->x1)
+    {
+        xb = (int16_t)(clip->x1 - 1);
+    }
+    if (xa > xb)
+    {
+        return;
+    }
+    OLED_Raster_Apply(OLED_Raster_BandPtr(u8g2, (int16_t)(y >> 3)) + xa, (uint16_t)(xb - xa + 1),
+                      (uint8_t)(1u << (y & 7)), clip->color);
+}
+
+/**
+ * @brief Draws the vertical run ya..yb (inclusive, ya <= yb) in column x, one byte per band.
+ */
+static void OLED_Raster_VRun(u8g2_t *u8g2, const OLED_RasterClip_t *clip, int16_t x, int16_t ya, int16_t yb)
+{
+    if (x < clip->x0 || x >= clip->x1)
+    {
+        return;
+    }
+    if (ya < clip->y0)
+    {
+        ya = clip->y0;
+    }
+    if (yb >= clip->y1)
+    {
+        yb = (int16_t)(clip->y1 - 1);
+    }
+    while (ya <= yb)
+    {
+        int16_t band = (int16_t)(ya >> 3);
+        int16_t last = (int16_t)(band * 8 + 7);
+        uint8_t mask = (uint8_t)(0xFF << (ya & 7));
+
+        if (last > yb)
+        {
+            mask &= (uint8_t)(0xFF >> (last - yb));
+            last = yb;
+        }
+        OLED_Raster_Apply(OLED_Raster_BandPtr(u8g2, band) + x, 1, mask, clip->color);
+        ya = (int16_t)(last + 1);
+    }
+}
+
+/**
+ * @brief Fills one span per row of a band; columns covered by every row are written once.
+ *
+ * @param[in]     band Band index (rows band*8 .. band*8+7).
+ * @param[in,out] xl   First column per row (clipped in place); xl > xr means an empty row.
+ * @param[in,out] xr   Last column per row (inclusive).
+ */
+static void OLED_Raster_FillBand(u8g2_t *u8g2, const OLED_RasterClip_t *clip, int16_t band, int16_t *xl, int16_t *xr)
+{
+    uint8_t *dst = OLED_Raster_BandPtr(u8g2, band);
+    int16_t il = INT16_MIN;
+    int16_t ir = INT16_MAX;
+    uint8_t rows = 0;
+
+    for (uint8_t r = 0; r < 8; r++)
+    {
+        int16_t y = (int16_t)(band * 8 + r);
+        if (y < clip->y0 || y >= clip->y1)
+        {
+            continue;
+        }
+        if (xl[r] < clip->x0)
+        {
+            xl[r] = clip->x0;
+        }
+        if (xr[r] >= clip->x1)
+        {
+            xr[r] = (int16_t)(clip->x1 - 1);
+        }
+        if (xl[r] > xr[r])
+        {
+            continue;
+        }
+        rows |= (uint8_t)(1u << r);
+        il = (xl[r] > il) ? xl[r] : il;
+        ir = (xr[r] < ir) ? xr[r] : ir;
+    }
+    if (rows == 0)
+    {
+        return;
+    }
+
+    if (il <= ir)
+    {
+        OLED_Raster_Apply(dst + il, (uint16_t)(ir - il + 1), rows, clip->color);
+    }
+    for (uint8_t r = 0; r < 8; r++)
+    {
+        uint8_t bit = (uint8_t)(1u << r);
+        if ((rows & bit) == 0)
+        {
+            continue;
+        }
+        if (il > ir)
+        {
+            OLED_Raster_Apply(dst + xl[r], (uint16_t)(xr[r] - xl[r] + 1), bit, clip->color);
+            continue;
+        }
+        if (xl[r] < il)
+        {
+            OLED_Raster_Apply(dst + xl[r], (uint16_t)(il - xl[r]), bit, clip->color);
+        }
+        if (xr[r] > ir)
+        {
+            OLED_Raster_Apply(dst + ir + 1, (uint16_t)(xr[r] - ir), bit, clip->color);
+        }
+    }
+}
+
+/**
+ * @brief Draws a line (same pixels as u8g2_DrawLine()); end points may be off screen.
+ *
+ * Bresenham along the major axis as in u8g2_line.c; the pixels between two minor-axis steps form a
+ * run that is written at once.
+ */
+void OLED_Raster_Line(u8g2_t *u8g2, int16_t x0, int16_t y0, int16_t x1, int16_t y1)
+{
+    OLED_RasterClip_t clip;
+    int16_t dx = (int16_t)((x0 > x1) ? x0 - x1 : x1 - x0);
+    int16_t dy = (int16_t)((y0 > y1) ? y0 - y1 : y1 - y0);
+    uint8_t swapxy = 0;
+    int16_t tmp;
+    int16_t err;
+    int16_t step;
+    int16_t start;
+
+    if (OLED_Raster_GetClip(u8g2, &clip) == 0)
+    {
+        return;
+    }
+    if (dy > dx)
+    {
+        swapxy = 1;
+        tmp = dx; dx = dy; dy = tmp;
+        tmp = x0; x0 = y0; y0 = tmp;
+        tmp = x1; x1 = y1; y1 = tmp;
+    }
+    if (x0 > x1)
+    {
+        tmp = x0; x0 = x1; x1 = tmp;
+        tmp = y0; y0 = y1; y1 = tmp;
+    }
+    err = (int16_t)(dx >> 1);
+    step = (y1 > y0) ? 1 : -1;
+
+    /* (x0, y0) now walks along the major axis; a run ends where y0 steps */
+    start = x0;
+    for (int16_t x = x0; x <= x1; x++)
+    {
+        err = (int16_t)(err - dy);
+        if (err < 0 || x == x1)
+        {
+            if (swapxy == 0)
+            {
+                OLED_Raster_HRun(u8g2, &clip, start, x, y0);
+            }
+            else
+            {
+                OLED_Raster_VRun(u8g2, &clip, y0, start, x);
+            }
+            start = (int16_t)(x + 1);
+        }
+        if (err < 0)
+        {
+            y0 = (int16_t)(y0 + step);
+            err = (int16_t)(err + dx);
+        }
+    }
+}
+
+/**
+ * @brief Computes the half width of the u8g2 midpoint disc for each row offset 0..rad.
+ *
+ * Runs the midpoint iteration of u8g2_circle.c; each step (x, y) covers the offsets (x, 0..y) and
+ * (y, 0..x), so the half width of row dy is the largest column of any point at or below dy.
+ *
+ * @param[out] hw Half widths, hw[rad + 1] = -1 (rad + 2 entries).
+ */
+static void OLED_Raster_HalfWidths(uint8_t rad, int8_t *hw)
+{
+    int16_t f = (int16_t)(1 - rad);
+    int16_t ddF_x = 1;
+    int16_t ddF_y = (int16_t)(-2 * rad);
+    int16_t x = 0;
+    int16_t y = rad;
+
+    memset(hw, 0xFF, (size_t)rad + 2);
+    for (;;)
+    {
+        if (hw[y] < x)
+        {
+            hw[y] = (int8_t)x;
+        }
+        if (hw[x] < y)
+        {
+            hw[x] = (int8_t)y;
+        }
+        if (x >= y)
+        {
+            break;
+        }
+        if (f >= 0)
+        {
+            y--;
+            ddF_y += 2;
+            f = (int16_t)(f + ddF_y);
+        }
+        x++;
+        ddF_x += 2;
+        f = (int16_t)(f + ddF_x);
+    }
+    for (int16_t dy = (int16_t)(rad - 1); dy >= 0; dy--)
+    {
+        if (hw[dy] < hw[dy + 1])
+        {
+            hw[dy] = hw[dy + 1];
+        }
+    }
+}
+
+/**
+ * @brief Draws a circle outline (same pixels as u8g2_DrawCircle()).
+ *
+ * The outline of row dy runs from just outside the next row's half width to its own half width.
+ * Shared axis pixels of adjacent quadrants are drawn once.
+ */
+void OLED_Raster_Circle(u8g2_t *u8g2, int16_t x0, int16_t y0, uint8_t rad, uint8_t option)
+{
+    OLED_RasterClip_t clip;
+    int8_t hw[OLED_RASTER_MAX_RADIUS + 2];
+    uint8_t ur = (uint8_t)(option & U8G2_DRAW_UPPER_RIGHT);
+    uint8_t ul = (uint8_t)(option & U8G2_DRAW_UPPER_LEFT);
+    uint8_t lr = (uint8_t)(option & U8G2_DRAW_LOWER_RIGHT);
+    uint8_t ll = (uint8_t)(option & U8G2_DRAW_LOWER_LEFT);
+
+    if (rad > OLED_RASTER_MAX_RADIUS)
+    {
+        u8g2_DrawCircle(u8g2, (u8g2_uint_t)x0, (u8g2_uint_t)y0, rad, option);
+        return;
+    }
+    if (OLED_Raster_GetClip(u8g2, &clip) == 0 || y0 + rad < clip.y0 || y0 - rad >= clip.y1 ||
+        x0 + rad < clip.x0 || x0 - rad >= clip.x1)
+    {
+        return;
+    }
+    if (rad == 0)
+    {
+        /* The center belongs to every quadrant */
+        if ((option & U8G2_DRAW_ALL) != 0)
+        {
+            OLED_Raster_HRun(u8g2, &clip, x0, x0, y0);
+        }
+        return;
+    }
+    OLED_Raster_HalfWidths(rad, hw);
+
+    for (int16_t dy = 0; dy <= rad; dy++)
+    {
+        int16_t b = hw[dy];
+        int16_t a = (int16_t)(hw[dy + 1] + 1);
+        if (a > b)
+        {
+            a = b;
+        }
+        /* Right quadrants include column 0, left ones only if the right one is off; likewise rows */
+        if (ur)
+        {
+            OLED_Raster_HRun(u8g2, &clip, (int16_t)(x0 + a), (int16_t)(x0 + b), (int16_t)(y0 - dy));
+        }
+        if (ul)
+        {
+            int16_t la = (ur && a == 0) ? 1 : a;
+            if (la <= b)
+            {
+                OLED_Raster_HRun(u8g2, &clip, (int16_t)(x0 - b), (int16_t)(x0 - la), (int16_t)(y0 - dy));
+            }
+        }
+        if (lr && !(dy == 0 && ur))
+        {
+            OLED_Raster_HRun(u8g2, &clip, (int16_t)(x0 + a), (int16_t)(x0 + b), (int16_t)(y0 + dy));
+        }
+        if (ll && !(dy == 0 && ul))
+        {
+            int16_t la = (lr && a == 0) ? 1 : a;
+            if (la <= b)
+            {
+                OLED_Raster_HRun(u8g2, &clip, (int16_t)(x0 - b), (int16_t)(x0 - la), (int16_t)(y0 + dy));
+            }
+        }
+    }
+}
+
+/**
+ * @brief Draws a filled circle (same pixels as u8g2_DrawDisc()), one band at a time.
+ */
+void OLED_Raster_Disc(u8g2_t *u8g2, int16_t x0, int16_t y0, uint8_t rad, uint8_t option)
+{
+    OLED_RasterClip_t clip;
+    int8_t hw[OLED_RASTER_MAX_RADIUS + 2];
+    int16_t top;
+    int16_t bottom;
+
+    if (rad > OLED_RASTER_MAX_RADIUS)
+    {
+        u8g2_DrawDisc(u8g2, (u8g2_uint_t)x0, (u8g2_uint_t)y0, rad, option);
+        return;
+    }
+    if (OLED_Raster_GetClip(u8g2, &clip) == 0)
+    {
+        return;
+    }
+    top = (int16_t)(y0 - rad);
+    bottom = (int16_t)(y0 + rad);
+    if (top < clip.y0)
+    {
+        top = clip.y0;
+    }
+    if (bottom >= clip.y1)
+    {
+        bottom = (int16_t)(clip.y1 - 1);
+    }
+    if (top > bottom || x0 + rad < clip.x0 || x0 - rad >= clip.x1)
+    {
+        return;
+    }
+    OLED_Raster_HalfWidths(rad, hw);
+
+    for (int16_t band = (int16_t)(top >> 3); band <= (int16_t)(bottom >> 3); band++)
+    {
+        int16_t xl[8];
+        int16_t xr[8];
+
+        for (uint8_t r = 0; r < 8; r++)
+        {
+            int16_t dy = (int16_t)(band * 8 + r - y0);
+            uint8_t left;
+            uint8_t right;
+
+            xl[r] = 1;
+            xr[r] = 0;
+            if (dy < -rad || dy > rad)
+            {
+                continue;
+            }
+            left = (uint8_t)(((dy <= 0) && (option & U8G2_DRAW_UPPER_LEFT)) || ((dy >= 0) && (option & U8G2_DRAW_LOWER_LEFT)));
+            right = (uint8_t)(((dy <= 0) && (option & U8G2_DRAW_UPPER_RIGHT)) || ((dy >= 0) && (option & U8G2_DRAW_LOWER_RIGHT)));
+            if (!left && !right)
+            {
+                continue;
+            }
+            xl[r] = left ? (int16_t)(x0 - hw[(dy < 0) ? -dy : dy]) : x0;
+            xr[r] = right ? (int16_t)(x0 + hw[(dy < 0) ? -dy : dy]) : x0;
+        }
+        OLED_Raster_FillBand(u8g2, &clip, band, xl, xr);
+    }
+}
+
+/**
+ * @brief Floor division for a positive divisor.
+ */
+static int32_t OLED_Raster_FloorDiv(int32_t num, int32_t den)
+{
+    int32_t q = num / den;
+    return (num % den != 0 && num < 0) ? q - 1 : q;
+}
+
+/**
+ * @brief Computes the sorted span boundaries of one polygon scanline.
+ *
+ * An edge crosses row y if the row center y + 0.5 lies in [y_top, y_bottom). The boundary is the
+ * first pixel whose center is at or right of the crossing: ceil(X - 0.5), computed exactly.
+ *
+ * @return Number of boundaries (even); pixels cut[2i] .. cut[2i+1]-1 are inside.
+ */
+static uint8_t OLED_Raster_Scanline(const OLED_Point_t *points, uint8_t count, int16_t y, int16_t *cut)
+{
+    uint8_t n = 0;
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        OLED_Point_t a = points[i];
+        OLED_Point_t b = points[(i + 1 == count) ? 0 : i + 1];
+        if (a.y == b.y)
+        {
+            continue;
+        }
+        if (a.y > b.y)
+        {
+            OLED_Point_t t = a;
+            a = b;
+            b = t;
+        }
+        if (y < a.y || y >= b.y)
+        {
+            continue;
+        }
+        /* X - 0.5 = a.x + (2N - D) / 2D with N = (2(y - a.y) + 1)(b.x - a.x), D = 2(b.y - a.y) */
+        int32_t d = 2 * (int32_t)(b.y - a.y);
+        int32_t num = 2 * (2 * (int32_t)(y - a.y) + 1) * (b.x - a.x) - d;
+        int16_t c = (int16_t)(a.x + OLED_Raster_FloorDiv(num + 2 * d - 1, 2 * d));
+
+        uint8_t j = n++;
+        while (j > 0 && cut[j - 1] > c)
+        {
+            cut[j] = cut[j - 1];
+            j--;
+        }
+        cut[j] = c;
+    }
+    return n;
+}
+
+/**
+ * @brief Fills a polygon (even-odd rule, a pixel is set if its center is inside).
+ *
+ * Rows with a single span (every row of a convex polygon) are collected per band and written
+ * with OLED_Raster_FillBand(); rows with several spans are written run by run.
+ */
+void OLED_Raster_FillPolygon(u8g2_t *u8g2, const OLED_Point_t *points, uint8_t count)
+{
+    OLED_RasterClip_t clip;
+    int16_t cut[OLED_RASTER_MAX_POLYGON_POINTS];
+    int16_t top;
+    int16_t bottom;
+
+    if (count < 3 || count > OLED_RASTER_MAX_POLYGON_POINTS || OLED_Raster_GetClip(u8g2, &clip) == 0)
+    {
+        return;
+    }
+    top = points[0].y;
+    bottom = points[0].y;
+    for (uint8_t i = 1; i < count; i++)
+    {
+        top = (points[i].y < top) ? points[i].y : top;
+        bottom = (points[i].y > bottom) ? points[i].y : bottom;
+    }
+    /* Rows whose center lies inside [top, bottom) */
+    bottom = (int16_t)(bottom - 1);
+    if (top < clip.y0)
+    {
+        top = clip.y0;
+    }
+    if (bottom >= clip.y1)
+    {
+        bottom = (int16_t)(clip.y1 - 1);
+    }
+    if (top > bottom)
+    {
+        return;
+    }
+
+    for (int16_t band = (int16_t)(top >> 3); band <= (int16_t)(bottom >> 3); band++)
+    {
+        int16_t xl[8];
+        int16_t xr[8];
+
+        for (uint8_t r = 0; r < 8; r++)
+        {
+            int16_t y = (int16_t)(band * 8 + r);
+            uint8_t n;
+
+            xl[r] = 1;
+            xr[r] = 0;
+            if (y < top || y > bottom)
+            {
+                continue;
+            }
+            n = OLED_Raster_Scanline(points, count, y, cut);
+            if (n == 2)
+            {
+                xl[r] = cut[0];
+                xr[r] = (int16_t)(cut[1] - 1);
+                continue;
+            }
+            for (uint8_t i = 0; i + 1 < n; i += 2)
+            {
+                if (cut[i] < cut[i + 1])
+                {
+                    OLED_Raster_HRun(u8g2, &clip, cut[i], (int16_t)(cut[i + 1] - 1), y);
+                }
+            }
+        }
+        OLED_Raster_FillBand(u8g2, &clip, band, xl, xr);
+    }
+}
@@ -0,0 +1,90 @@
+
+/**
+ * @file oled_raster.h
+ * @author Ted Wang
+ * @date 2026-10-17
+ * @brief Span-based line, circle, disc and polygon rasterizers for the u8g2 tile buffer.
+ *
+ * u8g2_DrawLine() plots every pixel through u8g2_DrawPixel(), u8g2_DrawCircle() does the same for
+ * eight octant points per step, and u8g2_DrawDisc() issues two vertical lines per step, each going
+ * through the clip and hvline callback chain. These functions produce the same pixels (line, circle
+ * and disc are pixel-exact with u8g2 for draw color 1) but collect them into runs first:
+ *   - horizontal runs are written with one bit mask over consecutive buffer bytes (four per 32-bit
+ *     word), vertical runs with one byte mask per 8 pixel band;
+ *   - filled shapes are rasterized band by band, so the columns covered by all rows of a band are
+ *     written once with the combined mask.
+ *
+ * The polygon fill is a scanline fill with the even-odd rule and pixel-center sampling, so it also
+ * handles concave polygons (u8g2_DrawPolygon() is meant for convex ones).
+ *
+ * The rasterizers write the u8g2 tile buffer directly, so they assume U8G2_R0 and a vertical-byte
+ * display (SH1106/SSD1306). They clip against the display, the current page (page modes) and the
+ * u8g2 clip window, and honor the draw color (0 = clear, 1 = set, 2 = XOR; every pixel is touched
+ * once, so XOR shapes have no holes where octants or scanlines meet).
+ */
+
+#ifndef OLED_RASTER_H
+#define OLED_RASTER_H
+
+#include "u8g2.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @def OLED_RASTER_MAX_RADIUS
+ * @brief Largest circle/disc radius handled by the span rasterizer (larger ones use u8g2).
+ */
+#define OLED_RASTER_MAX_RADIUS          63
+
+/**
+ * @def OLED_RASTER_MAX_POLYGON_POINTS
+ * @brief Maximum number of polygon vertices.
+ */
+#define OLED_RASTER_MAX_POLYGON_POINTS  16
+
+/**
+ * @brief Polygon vertex.
+ */
+typedef struct {
+    int16_t x;      /**< Column */
+    int16_t y;      /**< Row */
+} OLED_Point_t;
+
+
+/**
+ * @brief Draws a line (same pixels as u8g2_DrawLine()); end points may be off screen.
+ */
+void OLED_Raster_Line(u8g2_t *u8g2, int16_t x0, int16_t y0, int16_t x1, int16_t y1);
+
+
+/**
+ * @brief Draws a circle outline (same pixels as u8g2_DrawCircle()).
+ *
+ * @param[in] option U8G2_DRAW_UPPER_RIGHT / _UPPER_LEFT / _LOWER_LEFT / _LOWER_RIGHT or U8G2_DRAW_ALL.
+ */
+void OLED_Raster_Circle(u8g2_t *u8g2, int16_t x0, int16_t y0, uint8_t rad, uint8_t option);
+
+
+/**
+ * @brief Draws a filled circle (same pixels as u8g2_DrawDisc()).
+ *
+ * @param[in] option U8G2_DRAW_UPPER_RIGHT / _UPPER_LEFT / _LOWER_LEFT / _LOWER_RIGHT or U8G2_DRAW_ALL.
+ */
+void OLED_Raster_Disc(u8g2_t *u8g2, int16_t x0, int16_t y0, uint8_t rad, uint8_t option);
+
+
+/**
+ * @brief Fills a polygon (even-odd rule, a pixel is set if its center is inside).
+ *
+ * @param[in] points Vertices (the polygon is closed automatically).
+ * @param[in] count  Number of vertices (3..OLED_RASTER_MAX_POLYGON_POINTS).
+ */
+void OLED_Raster_FillPolygon(u8g2_t *u8g2, const OLED_Point_t *points, uint8_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // OLED_RASTER_H
@@ -0,0 +1,69 @@
+/**
+ * @file oled_region.h
+ * @author Ted Wang
+ * @date 2026-10-17
+ * @brief Rectangle operations on the vertical byte frame buffer: fill, clear, invert, copy and scroll.
+ *
+ * u8g2_DrawBox() reaches the buffer through the hvline callback chain one column byte at a time,
+ * and XOR highlighting (u8g2_SetDrawColor(u8g2, 2)) takes the same path. These functions work on
+ * the u8g2 tile buffer directly: a rectangle covers one run of columns in each 8 pixel band, the
+ * rows of a band are selected with a page mask, and each run is processed four columns per 32-bit
+ * word. Copy and scroll move a rectangle by any pixel offset, combining two source bands per
+ * destination byte, and handle overlapping source and destination.
+ *
+ * Like OLED_Blit(), the functions take the u8g2 object, assume U8G2_R0 and a vertical byte display
+ * (SH1106/SSD1306), clip against the display, the current page (page modes) and the u8g2 clip
+ * window, and ignore the draw color. Copy and scroll read the source from the current buffer, so in
+ * page modes only the part of the source inside the current page is moved.
+ */
+
+#ifndef OLED_REGION_H
+#define OLED_REGION_H
+
+#include "u8g2.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * @brief Sets all pixels of a rectangle (u8g2_DrawBox() with draw color 1).
+ */
+void OLED_Region_Fill(u8g2_t *u8g2, int16_t x, int16_t y, int16_t w, int16_t h);
+
+
+/**
+ * @brief Clears all pixels of a rectangle (u8g2_DrawBox() with draw color 0).
+ */
+void OLED_Region_Clear(u8g2_t *u8g2, int16_t x, int16_t y, int16_t w, int16_t h);
+
+
+/**
+ * @brief Inverts all pixels of a rectangle (u8g2_DrawBox() with draw color 2), e.g. to highlight a row.
+ */
+void OLED_Region_Invert(u8g2_t *u8g2, int16_t x, int16_t y, int16_t w, int16_t h);
+
+
+/**
+ * @brief Copies a rectangle to another position of the buffer; source and destination may overlap.
+ *
+ * @param[in] x, y, w, h Source rectangle.
+ * @param[in] dst_x      Left edge of the destination.
+ * @param[in] dst_y      Top edge of the destination.
+ */
+void OLED_Region_Copy(u8g2_t *u8g2, int16_t x, int16_t y, int16_t w, int16_t h, int16_t dst_x, int16_t dst_y);
+
+
+/**
+ * @brief Scrolls the content of a rectangle by (dx, dy) pixels; the uncovered part is cleared.
+ *
+ * Content moved outside the rectangle is dropped, e.g. dy = -8 moves a text console up by one line.
+ */
+void OLED_Region_Scroll(u8g2_t *u8g2, int16_t x, int16_t y, int16_t w, int16_t h, int16_t dx, int16_t dy);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // OLED_REGION_H
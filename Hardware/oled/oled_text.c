@@ -0,0 +1,308 @@
+/**
+ * @file oled_text.c
+ * @author Ted Wang
+ * @date 2026-10-17
+ * @brief Cached string metrics and aligned text drawing for the u8g2 OLED display.
+ *
+ * This file provides:
+ *   - A small round-robin cache of string widths keyed by (font pointer, FNV-1a hash, length)
+ *   - A width query compatible with u8g2_GetStrWidth() (balanced width calculation)
+ *   - A combined measure-and-draw call that looks up each glyph only once per frame
+ *
+ * The cache is shared by the render tasks of both panels (see OLED_OUTSIDE_DISPLAY_ENABLE): its
+ * lookups and stores run with the scheduler suspended on the target. Measuring and drawing use
+ * only the caller's u8g2 object and run unlocked.
+ */
+
+#include "oled_text.h"
+#include "ccmram.h"
+#include <string.h>
+#if defined(USE_HAL_DRIVER)
+#include "FreeRTOS.h"
+#include "task.h"
+#endif
+
+/**
+ * @name Cache lock (scheduler suspension on the target; nothing in single-threaded host builds)
+ * @{
+ */
+#if defined(USE_HAL_DRIVER)
+#define OLED_TEXT_LOCK()        vTaskSuspendAll()
+#define OLED_TEXT_UNLOCK()      (void)xTaskResumeAll()
+#else
+#define OLED_TEXT_LOCK()
+#define OLED_TEXT_UNLOCK()
+#endif
+/** @} */
+
+/**
+ * @brief One memoized string width.
+ */
+typedef struct {
+    const uint8_t *font;    /**< Font the width was measured with (NULL = empty slot) */
+    uint32_t hash;          /**< FNV-1a hash of the string */
+    uint16_t length;        /**< String length, checked together with the hash */
+    u8g2_uint_t width;      /**< Measured pixel width */
+} OLED_TextCacheEntry_t;
+
+/**
+ * @brief Horizontal metrics decoded from a glyph header.
+ */
+typedef struct {
+    int8_t width;           /**< Glyph bitmap width */
+    int8_t x_offset;        /**< Glyph x offset */
+    int8_t delta_x;         /**< Advance to the next glyph */
+} OLED_GlyphMetrics_t;
+
+/**
+ * @brief Metrics cache table (CCM RAM) and round-robin replacement index (file scope only).
+ */
+static OLED_TextCacheEntry_t text_cache[OLED_TEXT_CACHE_ENTRIES] CCM_RAM;
+static uint8_t text_cache_next;
+static OLED_TextCacheStats_t text_cache_stats;
+
+/**
+ * @brief Computes the FNV-1a hash and length of a u8g2 ASCII string ('\\0' or '\\n' terminated).
+ */
+static uint32_t OLED_Text_Hash(const char *str, uint16_t *length)
+{
+    uint32_t hash = 2166136261u;
+    uint16_t len = 0;
+
+    while (str[len] != '\0' && str[len] != '\n')
+    {
+        hash ^= (uint8_t)str[len];
+        hash *= 16777619u;
+        len++;
+    }
+    *length = len;
+    return hash;
+}
+
+/**
+ * @brief Decodes the horizontal metrics of a glyph without touching u8g2->font_decode.
+ */
+static void OLED_Text_DecodeMetrics(const u8g2_t *u8g2, const uint8_t *glyph_data, OLED_GlyphMetrics_t *m)
+{
+    u8g2_font_decode_t decode;
+
+    decode.decode_ptr = glyph_data;
+    decode.decode_bit_pos = 0;
+    m->width = u8g2_font_decode_get_unsigned_bits(&decode, u8g2->font_info.bits_per_char_width);
+    u8g2_font_decode_get_unsigned_bits(&decode, u8g2->font_info.bits_per_char_height);
+    m->x_offset = u8g2_font_decode_get_signed_bits(&decode, u8g2->font_info.bits_per_char_x);
+    u8g2_font_decode_get_signed_bits(&decode, u8g2->font_info.bits_per_char_y);
+    m->delta_x = u8g2_font_decode_get_signed_bits(&decode, u8g2->font_info.bits_per_delta_x);
+}
+
+/**
+ * @brief Measures a string, optionally recording the glyph data pointers for a later draw.
+ *
+ * Follows the balanced width calculation of u8g2_string_width(): sum of advances, with the last
+ * advance replaced by the real bitmap width plus x offset, plus a positive initial x offset.
+ *
+ * @param[in]  u8g2   Pointer to the u8g2 object.
+ * @param[in]  str    String to measure.
+ * @param[out] glyphs Destination for up to OLED_TEXT_MAX_GLYPHS glyph pointers, or NULL.
+ * @return Width of the string in pixels.
+ */
+static u8g2_uint_t OLED_Text_Measure(u8g2_t *u8g2, const char *str, const uint8_t **glyphs)
+{
+    OLED_GlyphMetrics_t m;
+    OLED_GlyphMetrics_t last = {0, 0, 0};
+    int8_t initial_x_offset = -64;
+    u8g2_uint_t w = 0;
+    uint16_t i;
+
+    for (i = 0; str[i] != '\0' && str[i] != '\n'; i++)
+    {
+        const uint8_t *glyph_data = u8g2_font_get_glyph_data(u8g2, (uint8_t)str[i]);
+        if (glyphs != NULL && i < OLED_TEXT_MAX_GLYPHS)
+        {
+            glyphs[i] = glyph_data;
+        }
+        if (glyph_data == NULL)
+        {
+            continue;
+        }
+        OLED_Text_DecodeMetrics(u8g2, glyph_data, &m);
+        if (initial_x_offset == -64)
+        {
+            initial_x_offset = m.x_offset;
+        }
+        w += m.delta_x;
+        last = m;
+    }
+
+    if (last.width != 0)
+    {
+        w -= last.delta_x;
+        w += last.width;
+        w += last.x_offset;
+        if (initial_x_offset > 0)
+        {
+            w += initial_x_offset;
+        }
+    }
+    return w;
+}
+
+/**
+ * @brief Looks up a string in the metrics cache and counts the hit or miss.
+ * @return 1 with the cached width in *width, 0 on a miss.
+ */
+static uint8_t OLED_Text_CacheFind(const uint8_t *font, uint32_t hash, uint16_t length, u8g2_uint_t *width)
+{
+    uint8_t found = 0;
+
+    OLED_TEXT_LOCK();
+    for (uint8_t i = 0; i < OLED_TEXT_CACHE_ENTRIES; i++)
+    {
+        const OLED_TextCacheEntry_t *e = &text_cache[i];
+        if (e->font == font && e->hash == hash && e->length == length)
+        {
+            *width = e->width;
+            found = 1;
+            break;
+        }
+    }
+    if (found)
+    {
+        text_cache_stats.hits++;
+    }
+    else
+    {
+        text_cache_stats.misses++;
+    }
+    OLED_TEXT_UNLOCK();
+    return found;
+}
+
+/**
+ * @brief Stores a measured width, replacing the oldest entry.
+ */
+static void OLED_Text_CacheStore(const uint8_t *font, uint32_t hash, uint16_t length, u8g2_uint_t width)
+{
+    OLED_TextCacheEntry_t *e;
+
+    OLED_TEXT_LOCK();
+    e = &text_cache[text_cache_next];
+    e->font = font;
+    e->hash = hash;
+    e->length = length;
+    e->width = width;
+    text_cache_next = (uint8_t)((text_cache_next + 1) % OLED_TEXT_CACHE_ENTRIES);
+    OLED_TEXT_UNLOCK();
+}
+
+/**
+ * @brief Returns the pixel width of an ASCII string in the current font (cached).
+ *
+ * @param[in] u8g2 Pointer to the u8g2 object (font must be set).
+ * @param[in] str  Null-terminated ASCII string.
+ * @return Width of the string in pixels.
+ */
+u8g2_uint_t OLED_Text_GetWidth(u8g2_t *u8g2, const char *str)
+{
+    uint16_t length;
+    uint32_t hash = OLED_Text_Hash(str, &length);
+    u8g2_uint_t width;
+
+    if (OLED_Text_CacheFind(u8g2->font, hash, length, &width))
+    {
+        return width;
+    }
+
+    width = OLED_Text_Measure(u8g2, str, NULL);
+    OLED_Text_CacheStore(u8g2->font, hash, length, width);
+    return width;
+}
+
+/**
+ * @brief Measures and draws an ASCII string aligned inside a horizontal box.
+ *
+ * @param[in] u8g2  Pointer to the u8g2 object (font must be set).
+ * @param[in] x     Left edge of the layout box.
+ * @param[in] y     Baseline (or reference position set by u8g2_SetFontPos*) of the text.
+ * @param[in] w     Width of the layout box in pixels.
+ * @param[in] str   Null-terminated ASCII string.
+ * @param[in] align Alignment of the string inside the box.
+ * @return Advance width of the drawn string in pixels.
+ *
+ * @note Only the default font direction (0) uses the single-lookup path; other directions fall
+ *       back to u8g2_DrawStr() with a cached width.
+ */
+u8g2_uint_t OLED_Text_DrawAligned(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, const char *str, OLED_TextAlign_t align)
+{
+    const uint8_t *glyphs[OLED_TEXT_MAX_GLYPHS];
+    uint8_t have_glyphs = 0;
+    u8g2_uint_t text_width;
+    u8g2_uint_t sum = 0;
+    uint16_t length;
+    uint32_t hash = OLED_Text_Hash(str, &length);
+
+    if (!OLED_Text_CacheFind(u8g2->font, hash, length, &text_width))
+    {
+        text_width = OLED_Text_Measure(u8g2, str, glyphs);
+        OLED_Text_CacheStore(u8g2->font, hash, length, text_width);
+        have_glyphs = 1;
+    }
+
+    if (align != OLED_TEXT_ALIGN_LEFT && text_width < w)
+    {
+        x += (align == OLED_TEXT_ALIGN_CENTER) ? (u8g2_uint_t)((w - text_width) / 2) : (u8g2_uint_t)(w - text_width);
+    }
+
+#ifdef U8G2_WITH_FONT_ROTATION
+    if (u8g2->font_decode.dir != 0)
+    {
+        return u8g2_DrawStr(u8g2, x, y, str);
+    }
+#endif
+
+    y += u8g2->font_calc_vref(u8g2);
+    for (uint16_t i = 0; i < length; i++)
+    {
+        const uint8_t *glyph_data;
+        if (have_glyphs && i < OLED_TEXT_MAX_GLYPHS)
+        {
+            glyph_data = glyphs[i];
+        }
+        else
+        {
+            glyph_data = u8g2_font_get_glyph_data(u8g2, (uint8_t)str[i]);
+        }
+        if (glyph_data != NULL)
+        {
+            u8g2->font_decode.target_x = x;
+            u8g2->font_decode.target_y = y;
+            u8g2_uint_t delta = u8g2_font_decode_glyph(u8g2, glyph_data);
+            x += delta;
+            sum += delta;
+        }
+    }
+    return sum;
+}
+
+/**
+ * @brief Drops all cached string widths.
+ */
+void OLED_Text_ClearCache(void)
+{
+    OLED_TEXT_LOCK();
+    memset(text_cache, 0, sizeof(text_cache));
+    text_cache_next = 0;
+    OLED_TEXT_UNLOCK();
+}
+
+/**
+ * @brief Returns the metrics cache hit/miss counters.
+ *
+ * @param[out] stats Destination for the counters.
+ */
+void OLED_Text_GetCacheStats(OLED_TextCacheStats_t *stats)
+{
+    OLED_TEXT_LOCK();
+    *stats = text_cache_stats;
+    OLED_TEXT_UNLOCK();
+}
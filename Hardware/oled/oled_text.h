@@ -0,0 +1,103 @@
+
+/**
+ * @file oled_text.h
+ * @author Ted Wang
+ * @date 2026-10-17
+ * @brief Cached string metrics and aligned text drawing for the u8g2 OLED display.
+ *
+ * Centering or right-aligning a string with plain u8g2 costs two full glyph lookups per character:
+ * one in u8g2_GetStrWidth() and one again in u8g2_DrawStr(). This module keeps a small memoized
+ * table of string widths keyed by (font, string hash) and provides a combined measure-and-draw call
+ * that reuses the glyph pointers found during measurement, so layout code pays for the glyph lookup
+ * at most once per string per frame.
+ */
+
+#ifndef OLED_TEXT_H
+#define OLED_TEXT_H
+
+#include "u8g2.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @def OLED_TEXT_CACHE_ENTRIES
+ * @brief Number of (font, string) width entries kept in the metrics cache.
+ */
+#define OLED_TEXT_CACHE_ENTRIES      8
+
+/**
+ * @def OLED_TEXT_MAX_GLYPHS
+ * @brief Maximum string length handled by the single-lookup draw path.
+ *
+ * Longer strings are still drawn correctly, but fall back to the regular u8g2 lookup for the tail.
+ */
+#define OLED_TEXT_MAX_GLYPHS         32
+
+/**
+ * @brief Horizontal alignment of a string inside a layout box.
+ */
+typedef enum {
+    OLED_TEXT_ALIGN_LEFT = 0,   /**< Text starts at the left edge of the box */
+    OLED_TEXT_ALIGN_CENTER,     /**< Text is centered inside the box */
+    OLED_TEXT_ALIGN_RIGHT       /**< Text ends at the right edge of the box */
+} OLED_TextAlign_t;
+
+/**
+ * @brief Metrics cache statistics (for profiling).
+ */
+typedef struct {
+    uint32_t hits;      /**< Width requests served from the cache */
+    uint32_t misses;    /**< Width requests that required a glyph walk */
+} OLED_TextCacheStats_t;
+
+
+/**
+ * @brief Returns the pixel width of an ASCII string in the current font.
+ *
+ * Same result as u8g2_GetStrWidth(), but served from the metrics cache when the (font, string)
+ * pair has been measured before.
+ *
+ * @param[in] u8g2 Pointer to the u8g2 object (font must be set).
+ * @param[in] str  Null-terminated ASCII string.
+ * @return Width of the string in pixels.
+ */
+u8g2_uint_t OLED_Text_GetWidth(u8g2_t *u8g2, const char *str);
+
+
+/**
+ * @brief Measures and draws an ASCII string aligned inside a horizontal box.
+ *
+ * The glyph data of each character is looked up once; on a cache miss the pointers found while
+ * measuring are reused for drawing, on a cache hit the width comes from the cache.
+ *
+ * @param[in] u8g2  Pointer to the u8g2 object (font must be set).
+ * @param[in] x     Left edge of the layout box.
+ * @param[in] y     Baseline (or reference position set by u8g2_SetFontPos*) of the text.
+ * @param[in] w     Width of the layout box in pixels.
+ * @param[in] str   Null-terminated ASCII string.
+ * @param[in] align Alignment of the string inside the box.
+ * @return Advance width of the drawn string in pixels.
+ */
+u8g2_uint_t OLED_Text_DrawAligned(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, const char *str, OLED_TextAlign_t align);
+
+
+/**
+ * @brief Drops all cached string widths (e.g. after replacing a font in flash).
+ */
+void OLED_Text_ClearCache(void);
+
+
+/**
+ * @brief Returns the metrics cache hit/miss counters.
+ *
+ * @param[out] stats Destination for the counters.
+ */
+void OLED_Text_GetCacheStats(OLED_TextCacheStats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // OLED_TEXT_H
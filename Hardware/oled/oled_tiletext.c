@@ -0,0 +1,188 @@
+/**
+ * @file oled_tiletext.c
+ * @author Ted Wang
+ * @date 2026-10-17
+ * @brief Hybrid rendering: u8x8 tile text rows next to the u8g2 framebuffer.
+ *
+ * This file provides:
+ *   - Field formatting (padding and alignment) into a row of character cells
+ *   - A cell compare against the known display content, sending runs of changed cells as tiles
+ *   - A framebuffer send that skips the rows owned by tile text
+ *
+ * The state is not thread-safe; it is meant to be used from the OLED display task only.
+ */
+
+#include "oled_tiletext.h"
+#include <string.h>
+
+/**
+ * @brief Copies the glyph tiles of a run of cells into the framebuffer (keeps it an image of the display).
+ */
+static void OLED_TileText_CopyToBuffer(OLED_TileText_t *tt, uint8_t col, uint8_t row, uint8_t count, const uint8_t *tiles)
+{
+    uint8_t *buf = u8g2_GetBufferPtr(tt->u8g2);
+    uint16_t tw = u8g2_GetBufferTileWidth(tt->u8g2);
+
+    memcpy(&buf[((uint16_t)row * tw + col) * 8], tiles, (size_t)count * 8);
+}
+
+/**
+ * @brief Initializes the tile text state; all cells are unknown until printed.
+ *
+ * @param[out] tt       State to initialize.
+ * @param[in]  u8g2     Display object (full buffer mode, at most 16x8 tiles).
+ * @param[in]  font     u8x8 font with 8x8 glyphs.
+ * @param[in]  row_mask Tile rows owned by tile text (bit n = row n).
+ */
+void OLED_TileText_Init(OLED_TileText_t *tt, u8g2_t *u8g2, const uint8_t *font, uint8_t row_mask)
+{
+    tt->u8g2 = u8g2;
+    tt->font = font;
+    tt->row_mask = row_mask;
+    tt->tiles_sent = 0;
+    OLED_TileText_Invalidate(tt);
+}
+
+/**
+ * @brief Forgets the display content; the next print of each cell sends it.
+ */
+void OLED_TileText_Invalidate(OLED_TileText_t *tt)
+{
+    memset(tt->cells, 0, sizeof(tt->cells));
+}
+
+/**
+ * @brief Prints text into a field of a tile text row, padded with spaces; sends only changed cells.
+ *
+ * The field is formatted into a line of cells first, then compared with the known display content.
+ * Each run of changed cells is converted to glyph tiles and sent with a single u8x8_DrawTile() call,
+ * so a one-character change costs one tile (8 data bytes) plus the page/column address commands.
+ *
+ * @param[in,out] tt    Tile text state.
+ * @param[in]     col   First tile column of the field.
+ * @param[in]     row   Tile row (must be owned by tile text).
+ * @param[in]     width Field width in characters (clipped to the display).
+ * @param[in]     text  ASCII text; truncated to the field width.
+ * @param[in]     align Alignment inside the field.
+ * @return Number of character tiles sent.
+ */
+uint8_t OLED_TileText_Print(OLED_TileText_t *tt, uint8_t col, uint8_t row, uint8_t width, const char *text,
+                            OLED_TextAlign_t align)
+{
+    u8x8_t *u8x8 = u8g2_GetU8x8(tt->u8g2);
+    uint8_t cols = u8g2_GetBufferTileWidth(tt->u8g2);
+    char line[OLED_TILETEXT_MAX_COLS];
+    uint8_t tiles[OLED_TILETEXT_MAX_COLS * 8];
+    uint8_t sent = 0;
+    size_t len = strlen(text);
+    uint8_t pad;
+
+    if (row >= OLED_TILETEXT_MAX_ROWS || (tt->row_mask & (1u << row)) == 0 || col >= cols)
+    {
+        return 0;
+    }
+    if (cols > OLED_TILETEXT_MAX_COLS)
+    {
+        cols = OLED_TILETEXT_MAX_COLS;
+    }
+    if (width > cols - col)
+    {
+        width = (uint8_t)(cols - col);
+    }
+    if (len > width)
+    {
+        len = width;
+    }
+
+    pad = 0;
+    if (align == OLED_TEXT_ALIGN_CENTER)
+    {
+        pad = (uint8_t)((width - len) / 2);
+    }
+    else if (align == OLED_TEXT_ALIGN_RIGHT)
+    {
+        pad = (uint8_t)(width - len);
+    }
+    memset(line, ' ', width);
+    memcpy(&line[pad], text, len);
+
+    u8x8_SetFont(u8x8, tt->font);
+    for (uint8_t i = 0; i < width; )
+    {
+        char *cell = &tt->cells[row][col + i];
+        uint8_t run = 0;
+
+        while (i + run < width && cell[run] != line[i + run])
+        {
+            u8x8_get_glyph_data(u8x8, (uint8_t)line[i + run], &tiles[run * 8], 0);
+            cell[run] = line[i + run];
+            run++;
+        }
+        if (run == 0)
+        {
+            i++;
+            continue;
+        }
+        OLED_TileText_CopyToBuffer(tt, (uint8_t)(col + i), row, run, tiles);
+        u8x8_DrawTile(u8x8, (uint8_t)(col + i), row, run, tiles);
+        sent = (uint8_t)(sent + run);
+        i = (uint8_t)(i + run);
+    }
+    tt->tiles_sent += sent;
+    return sent;
+}
+
+/**
+ * @brief Sends the framebuffer rows owned by u8g2 (replaces u8g2_SendBuffer()).
+ *
+ * The tile text rows of the framebuffer are refreshed from the known cells first, so drawing
+ * (or u8g2_ClearBuffer()) there has no effect; they are not sent. Adjacent u8g2 rows are sent
+ * with one u8g2_UpdateDisplayArea() call.
+ */
+void OLED_TileText_SendBuffer(OLED_TileText_t *tt)
+{
+    u8x8_t *u8x8 = u8g2_GetU8x8(tt->u8g2);
+    uint8_t cols = u8g2_GetBufferTileWidth(tt->u8g2);
+    uint8_t rows = u8g2_GetBufferTileHeight(tt->u8g2);
+    uint8_t first = 0xFF;
+    uint8_t tile[8];
+
+    if (cols > OLED_TILETEXT_MAX_COLS)
+    {
+        cols = OLED_TILETEXT_MAX_COLS;
+    }
+    if (rows > OLED_TILETEXT_MAX_ROWS)
+    {
+        rows = OLED_TILETEXT_MAX_ROWS;
+    }
+
+    u8x8_SetFont(u8x8, tt->font);
+    for (uint8_t row = 0; row <= rows; row++)
+    {
+        if (row < rows && (tt->row_mask & (1u << row)) == 0)
+        {
+            if (first == 0xFF)
+            {
+                first = row;
+            }
+            continue;
+        }
+        if (first != 0xFF)
+        {
+            u8g2_UpdateDisplayArea(tt->u8g2, 0, first, cols, (uint8_t)(row - first));
+            first = 0xFF;
+        }
+        if (row == rows)
+        {
+            break;
+        }
+        for (uint8_t c = 0; c < cols; c++)
+        {
+            if (tt->cells[row][c] != 0)
+            {
+                u8x8_get_glyph_data(u8x8, (uint8_t)tt->cells[row][c], tile, 0);
+                OLED_TileText_CopyToBuffer(tt, c, row, 1, tile);
+            }
+        }
+    }
+}
@@ -0,0 +1,106 @@
+
+/**
+ * @file oled_tiletext.h
+ * @author Ted Wang
+ * @date 2026-10-17
+ * @brief Hybrid rendering: u8x8 tile text rows next to the u8g2 framebuffer.
+ *
+ * Status fields such as "Success" are monospace text. An 8x8 u8x8 font glyph is exactly one
+ * display tile, so such text can be written straight into display RAM without drawing into the
+ * framebuffer and without decoding a u8g2 (RLE) font. This module gives the ownership of selected
+ * tile rows (8 pixel bands) to tile text; the remaining rows belong to the u8g2 framebuffer.
+ *
+ * OLED_TileText_Print() keeps the characters currently on the display and sends only the changed
+ * cells, one u8x8_DrawTile() call per run of adjacent changed cells (8 data bytes per character).
+ *
+ * Coordination with the framebuffer:
+ *   - Use OLED_TileText_SendBuffer() instead of u8g2_SendBuffer(); it sends only the rows owned by
+ *     u8g2, so a framebuffer update never overwrites the tile text.
+ *   - The glyph tiles are also copied into the framebuffer rows owned by tile text, so the
+ *     framebuffer stays an exact image of the display (OLED_Mirror_Update(), PBM capture).
+ *     OLED_TileText_SendBuffer() restores them after u8g2_ClearBuffer().
+ *   - After u8g2_ClearDisplay() or u8g2_SendBuffer(), call OLED_TileText_Invalidate() so the next
+ *     print rewrites every cell.
+ *
+ * Only 8x8 (1x1 tile) u8x8 fonts are supported, e.g. u8x8_font_chroma48medium8_r. The module needs
+ * the u8g2 full frame buffer (OLED_BUFFER_MODE_FULL).
+ */
+
+#ifndef OLED_TILETEXT_H
+#define OLED_TILETEXT_H
+
+#include "u8g2.h"
+#include "oled_text.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @def OLED_TILETEXT_MAX_ROWS
+ * @brief Maximum number of tile rows of the display (64 pixels).
+ */
+#define OLED_TILETEXT_MAX_ROWS      8
+
+/**
+ * @def OLED_TILETEXT_MAX_COLS
+ * @brief Maximum number of tile columns of the display (128 pixels).
+ */
+#define OLED_TILETEXT_MAX_COLS      16
+
+/**
+ * @brief Tile text state: row ownership and the characters on the display.
+ */
+typedef struct {
+    u8g2_t *u8g2;                                                   /**< Display object (full buffer mode) */
+    const uint8_t *font;                                            /**< u8x8 8x8 font */
+    uint8_t row_mask;                                               /**< Bit n set = tile row n is owned by tile text */
+    char cells[OLED_TILETEXT_MAX_ROWS][OLED_TILETEXT_MAX_COLS];     /**< Characters on the display, 0 = unknown */
+    uint32_t tiles_sent;                                            /**< Character tiles sent (profiling) */
+} OLED_TileText_t;
+
+
+/**
+ * @brief Initializes the tile text state; all cells are unknown until printed.
+ *
+ * @param[out] tt       State to initialize.
+ * @param[in]  u8g2     Display object (full buffer mode, at most 16x8 tiles).
+ * @param[in]  font     u8x8 font with 8x8 glyphs.
+ * @param[in]  row_mask Tile rows owned by tile text (bit n = row n).
+ */
+void OLED_TileText_Init(OLED_TileText_t *tt, u8g2_t *u8g2, const uint8_t *font, uint8_t row_mask);
+
+
+/**
+ * @brief Forgets the display content; the next print of each cell sends it.
+ */
+void OLED_TileText_Invalidate(OLED_TileText_t *tt);
+
+
+/**
+ * @brief Prints text into a field of a tile text row, padded with spaces; sends only changed cells.
+ *
+ * @param[in,out] tt    Tile text state.
+ * @param[in]     col   First tile column of the field.
+ * @param[in]     row   Tile row (must be owned by tile text).
+ * @param[in]     width Field width in characters (clipped to the display).
+ * @param[in]     text  ASCII text; truncated to the field width.
+ * @param[in]     align Alignment inside the field.
+ * @return Number of character tiles sent.
+ */
+uint8_t OLED_TileText_Print(OLED_TileText_t *tt, uint8_t col, uint8_t row, uint8_t width, const char *text,
+                            OLED_TextAlign_t align);
+
+
+/**
+ * @brief Sends the framebuffer rows owned by u8g2 (replaces u8g2_SendBuffer()).
+ *
+ * The tile text rows of the framebuffer are refreshed from the known cells first; they are not sent.
+ */
+void OLED_TileText_SendBuffer(OLED_TileText_t *tt);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // OLED_TILETEXT_H
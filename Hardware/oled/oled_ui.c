@@ -0,0 +1,445 @@
+/**
+ * @file oled_ui.c
+ * @author Ted Wang
+ * @date 2026-10-17
+ * @brief Retained-mode widgets (label, icon, progress bar, list) with tile damage tracking.
+ *
+ * This file provides:
+ *   - Widget setters that damage only what visibly changes
+ *   - A tile damage map per screen (one 16-bit mask per tile row)
+ *   - A compositor that merges damaged tiles into rectangles, redraws each rectangle clipped to it,
+ *     and sends only those tiles
+ *
+ * Not thread-safe; screens and widgets are meant to be used from the OLED display task only.
+ */
+
+#include "oled_ui.h"
+#include "oled_region.h"
+#include <string.h>
+
+/**
+ * @brief Appends a widget to the screen's drawing list and damages its box.
+ */
+static void OLED_Ui_AddWidget(OLED_UiScreen_t *screen, OLED_UiWidget_t *widget, OLED_UiType_t type,
+                              u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h)
+{
+    widget->type = type;
+    widget->screen = screen;
+    widget->next = NULL;
+    widget->x = x;
+    widget->y = y;
+    widget->w = w;
+    widget->h = h;
+    widget->visible = 1;
+
+    if (screen->last == NULL)
+    {
+        screen->first = widget;
+    }
+    else
+    {
+        screen->last->next = widget;
+    }
+    screen->last = widget;
+    OLED_Ui_Invalidate(screen, x, y, w, h);
+}
+
+/**
+ * @brief Damages the whole box of a widget.
+ */
+static void OLED_Ui_InvalidateWidget(const OLED_UiWidget_t *widget)
+{
+    OLED_Ui_Invalidate(widget->screen, widget->x, widget->y, widget->w, widget->h);
+}
+
+/**
+ * @brief Draws one widget (the clip window limits the output to the region being composed).
+ */
+static void OLED_Ui_DrawWidget(u8g2_t *u8g2, const OLED_UiWidget_t *widget)
+{
+    switch (widget->type)
+    {
+        case OLED_UI_LABEL:
+        {
+            const OLED_UiLabel_t *label = (const OLED_UiLabel_t *)widget;
+            u8g2_SetFont(u8g2, label->font);
+            u8g2_SetFontPosTop(u8g2);
+            OLED_Text_DrawAligned(u8g2, widget->x, widget->y, widget->w, label->text, label->align);
+            break;
+        }
+        case OLED_UI_ICON:
+        {
+            const OLED_UiIcon_t *icon = (const OLED_UiIcon_t *)widget;
+            if (icon->image != NULL)
+            {
+                OLED_Blit(u8g2, (int16_t)widget->x, (int16_t)widget->y, icon->image, OLED_BLIT_OR);
+            }
+            break;
+        }
+        case OLED_UI_PROGRESS:
+        {
+            const OLED_UiProgress_t *bar = (const OLED_UiProgress_t *)widget;
+            u8g2_DrawFrame(u8g2, widget->x, widget->y, widget->w, widget->h);
+            if (bar->fill != 0 && widget->h > 2)
+            {
+                u8g2_DrawBox(u8g2, widget->x + 1, widget->y + 1, bar->fill, widget->h - 2);
+            }
+            break;
+        }
+        case OLED_UI_LIST:
+        {
+            const OLED_UiList_t *list = (const OLED_UiList_t *)widget;
+            uint8_t rows = (uint8_t)(widget->h / list->row_height);
+            u8g2_SetFont(u8g2, list->font);
+            u8g2_SetFontPosTop(u8g2);
+            for (uint8_t i = 0; i < rows && (uint16_t)list->top + i < list->count; i++)
+            {
+                uint8_t item = (uint8_t)(list->top + i);
+                u8g2_uint_t row_y = (u8g2_uint_t)(widget->y + i * list->row_height);
+                if (item == list->selected)
+                {
+                    u8g2_DrawBox(u8g2, widget->x, row_y, widget->w, list->row_height);
+                    u8g2_SetFontMode(u8g2, 1);
+                    u8g2_SetDrawColor(u8g2, 0);
+                    u8g2_DrawStr(u8g2, widget->x + 2, row_y + 1, list->items[item]);
+                    u8g2_SetDrawColor(u8g2, 1);
+                    u8g2_SetFontMode(u8g2, 0);
+                }
+                else
+                {
+                    u8g2_DrawStr(u8g2, widget->x + 2, row_y + 1, list->items[item]);
+                }
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief Initializes an empty screen; the first render redraws the whole display.
+ *
+ * @param[out] screen Screen to initialize.
+ * @param[in]  u8g2   Display object (full buffer mode, at most 16x8 tiles).
+ */
+void OLED_Ui_InitScreen(OLED_UiScreen_t *screen, u8g2_t *u8g2)
+{
+    memset(screen, 0, sizeof(*screen));
+    screen->u8g2 = u8g2;
+    OLED_Ui_InvalidateAll(screen);
+}
+
+/**
+ * @brief Marks a rectangle as damaged.
+ */
+void OLED_Ui_Invalidate(OLED_UiScreen_t *screen, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h)
+{
+    uint8_t tiles_w = u8g2_GetBufferTileWidth(screen->u8g2);
+    uint8_t tiles_h = u8g2_GetBufferTileHeight(screen->u8g2);
+    uint16_t tx0, tx1, ty0, ty1;
+    uint16_t mask;
+
+    if (w == 0 || h == 0)
+    {
+        return;
+    }
+    tx0 = x / 8;
+    ty0 = y / 8;
+    tx1 = (uint16_t)((x + w - 1) / 8);
+    ty1 = (uint16_t)((y + h - 1) / 8);
+    if (tx0 >= tiles_w || ty0 >= tiles_h)
+    {
+        return;
+    }
+    if (tx1 >= tiles_w)
+    {
+        tx1 = (uint16_t)(tiles_w - 1);
+    }
+    if (ty1 >= tiles_h)
+    {
+        ty1 = (uint16_t)(tiles_h - 1);
+    }
+    mask = (uint16_t)(((1u << (tx1 + 1)) - 1u) & ~((1u << tx0) - 1u));
+    for (uint16_t ty = ty0; ty <= ty1; ty++)
+    {
+        screen->damage[ty] |= mask;
+    }
+}
+
+/**
+ * @brief Marks the whole screen as damaged.
+ */
+void OLED_Ui_InvalidateAll(OLED_UiScreen_t *screen)
+{
+    OLED_Ui_Invalidate(screen, 0, 0, u8g2_GetDisplayWidth(screen->u8g2), u8g2_GetDisplayHeight(screen->u8g2));
+}
+
+/**
+ * @brief Redraws and sends all damaged tiles, then clears the damage map.
+ *
+ * Each run of damaged tiles in a tile row is extended downwards over the rows where the same run is
+ * damaged, so a widget spanning several rows is composed once per rectangle, not once per row.
+ *
+ * @param[in,out] screen Screen to render.
+ * @return Number of tiles sent (0 if nothing changed).
+ */
+uint16_t OLED_Ui_Render(OLED_UiScreen_t *screen)
+{
+    u8g2_t *u8g2 = screen->u8g2;
+    uint8_t tiles_h = u8g2_GetBufferTileHeight(u8g2);
+    const uint8_t *saved_font = u8g2->font;
+    u8g2_font_calc_vref_fnptr saved_vref = u8g2->font_calc_vref;
+    uint16_t sent = 0;
+
+    for (uint8_t ty = 0; ty < tiles_h; ty++)
+    {
+        while (screen->damage[ty] != 0)
+        {
+            uint16_t bits = screen->damage[ty];
+            uint8_t tx0 = 0;
+            uint8_t tx1;
+            uint8_t ty1 = ty;
+            uint16_t mask;
+
+            while ((bits & (1u << tx0)) == 0)
+            {
+                tx0++;
+            }
+            tx1 = tx0;
+            while (tx1 + 1 < 16 && (bits & (1u << (tx1 + 1))) != 0)
+            {
+                tx1++;
+            }
+            mask = (uint16_t)(((1u << (tx1 + 1)) - 1u) & ~((1u << tx0) - 1u));
+            while (ty1 + 1 < tiles_h && (screen->damage[ty1 + 1] & mask) == mask)
+            {
+                ty1++;
+            }
+            for (uint8_t r = ty; r <= ty1; r++)
+            {
+                screen->damage[r] &= (uint16_t)~mask;
+            }
+
+            u8g2_uint_t x0 = (u8g2_uint_t)(tx0 * 8);
+            u8g2_uint_t y0 = (u8g2_uint_t)(ty * 8);
+            u8g2_uint_t x1 = (u8g2_uint_t)((tx1 + 1) * 8);
+            u8g2_uint_t y1 = (u8g2_uint_t)((ty1 + 1) * 8);
+
+            u8g2_SetClipWindow(u8g2, x0, y0, x1, y1);
+            OLED_Region_Clear(u8g2, (int16_t)x0, (int16_t)y0, (int16_t)(x1 - x0), (int16_t)(y1 - y0));
+            for (const OLED_UiWidget_t *w = screen->first; w != NULL; w = w->next)
+            {
+                if (w->visible && w->x < x1 && w->x + w->w > x0 && w->y < y1 && w->y + w->h > y0)
+                {
+                    OLED_Ui_DrawWidget(u8g2, w);
+                }
+            }
+            u8g2_UpdateDisplayArea(u8g2, tx0, ty, (uint8_t)(tx1 - tx0 + 1), (uint8_t)(ty1 - ty + 1));
+            sent = (uint16_t)(sent + (tx1 - tx0 + 1) * (ty1 - ty + 1));
+        }
+    }
+
+    if (sent != 0)
+    {
+        u8g2_SetMaxClipWindow(u8g2);
+        if (saved_font != NULL)
+        {
+            u8g2_SetFont(u8g2, saved_font);
+        }
+        u8g2->font_calc_vref = saved_vref;
+        screen->frames++;
+        screen->tiles_sent += sent;
+    }
+    return sent;
+}
+
+/**
+ * @brief Shows or hides a widget.
+ */
+void OLED_Ui_SetVisible(OLED_UiWidget_t *widget, uint8_t visible)
+{
+    visible = visible ? 1 : 0;
+    if (widget->visible != visible)
+    {
+        widget->visible = visible;
+        OLED_Ui_InvalidateWidget(widget);
+    }
+}
+
+/**
+ * @brief Adds a label to a screen.
+ */
+void OLED_UiLabel_Init(OLED_UiLabel_t *label, OLED_UiScreen_t *screen, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w,
+                       const uint8_t *font, OLED_TextAlign_t align)
+{
+    u8g2_t *u8g2 = screen->u8g2;
+    const uint8_t *saved_font = u8g2->font;
+    u8g2_uint_t h;
+
+    u8g2_SetFont(u8g2, font);
+    h = (u8g2_uint_t)(u8g2_GetAscent(u8g2) - u8g2_GetDescent(u8g2));
+    if (saved_font != NULL)
+    {
+        u8g2_SetFont(u8g2, saved_font);
+    }
+
+    label->font = font;
+    label->align = align;
+    label->text[0] = '\0';
+    OLED_Ui_AddWidget(screen, &label->base, OLED_UI_LABEL, x, y, w, h);
+}
+
+/**
+ * @brief Sets the label text; damages the label if it changed.
+ */
+void OLED_UiLabel_SetText(OLED_UiLabel_t *label, const char *text)
+{
+    uint8_t n = 0;
+
+    while (n < OLED_UI_LABEL_MAX_CHARS && text[n] != '\0')
+    {
+        n++;
+    }
+    if (strncmp(label->text, text, n) == 0 && label->text[n] == '\0')
+    {
+        return;
+    }
+    memcpy(label->text, text, n);
+    label->text[n] = '\0';
+    OLED_Ui_InvalidateWidget(&label->base);
+}
+
+/**
+ * @brief Adds an icon to a screen; the icon size is the size of the initial image.
+ */
+void OLED_UiIcon_Init(OLED_UiIcon_t *icon, OLED_UiScreen_t *screen, u8g2_uint_t x, u8g2_uint_t y, const OLED_Image_t *image)
+{
+    icon->image = image;
+    OLED_Ui_AddWidget(screen, &icon->base, OLED_UI_ICON, x, y, image->width, image->height);
+}
+
+/**
+ * @brief Sets the icon image; damages the icon if it changed.
+ */
+void OLED_UiIcon_SetImage(OLED_UiIcon_t *icon, const OLED_Image_t *image)
+{
+    if (icon->image != image)
+    {
+        icon->image = image;
+        OLED_Ui_InvalidateWidget(&icon->base);
+    }
+}
+
+/**
+ * @brief Adds a progress bar to a screen.
+ */
+void OLED_UiProgress_Init(OLED_UiProgress_t *bar, OLED_UiScreen_t *screen, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h,
+                          uint16_t max)
+{
+    bar->value = 0;
+    bar->max = (max != 0) ? max : 1;
+    bar->fill = 0;
+    OLED_Ui_AddWidget(screen, &bar->base, OLED_UI_PROGRESS, x, y, w, h);
+}
+
+/**
+ * @brief Sets the progress value; damages only the columns between the old and the new fill level.
+ */
+void OLED_UiProgress_SetValue(OLED_UiProgress_t *bar, uint16_t value)
+{
+    u8g2_uint_t inner = (bar->base.w > 2) ? (u8g2_uint_t)(bar->base.w - 2) : 0;
+    u8g2_uint_t fill;
+
+    if (value > bar->max)
+    {
+        value = bar->max;
+    }
+    bar->value = value;
+    fill = (u8g2_uint_t)(((uint32_t)inner * value) / bar->max);
+    if (fill == bar->fill)
+    {
+        return;
+    }
+    if (fill > bar->fill)
+    {
+        OLED_Ui_Invalidate(bar->base.screen, bar->base.x + 1 + bar->fill, bar->base.y, fill - bar->fill, bar->base.h);
+    }
+    else
+    {
+        OLED_Ui_Invalidate(bar->base.screen, bar->base.x + 1 + fill, bar->base.y, bar->fill - fill, bar->base.h);
+    }
+    bar->fill = fill;
+}
+
+/**
+ * @brief Adds a list to a screen.
+ */
+void OLED_UiList_Init(OLED_UiList_t *list, OLED_UiScreen_t *screen, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h,
+                      const uint8_t *font, uint8_t row_height)
+{
+    list->font = font;
+    list->items = NULL;
+    list->count = 0;
+    list->top = 0;
+    list->selected = 0xFF;
+    list->row_height = (row_height != 0) ? row_height : 8;
+    OLED_Ui_AddWidget(screen, &list->base, OLED_UI_LIST, x, y, w, h);
+}
+
+/**
+ * @brief Sets the list items; damages the whole list.
+ */
+void OLED_UiList_SetItems(OLED_UiList_t *list, const char *const *items, uint8_t count)
+{
+    list->items = items;
+    list->count = count;
+    if (list->top >= count)
+    {
+        list->top = 0;
+    }
+    OLED_Ui_InvalidateWidget(&list->base);
+}
+
+/**
+ * @brief Damages the row of one item (after its string changed in place).
+ */
+void OLED_UiList_InvalidateItem(OLED_UiList_t *list, uint8_t index)
+{
+    uint8_t rows = (uint8_t)(list->base.h / list->row_height);
+
+    if (index >= list->top && index < list->top + rows)
+    {
+        OLED_Ui_Invalidate(list->base.screen, list->base.x, (u8g2_uint_t)(list->base.y + (index - list->top) * list->row_height),
+                           list->base.w, list->row_height);
+    }
+}
+
+/**
+ * @brief Highlights an item (0xFF = none) and scrolls it into view; damages the affected rows.
+ */
+void OLED_UiList_SetSelected(OLED_UiList_t *list, uint8_t index)
+{
+    uint8_t rows = (uint8_t)(list->base.h / list->row_height);
+    uint8_t old = list->selected;
+
+    if (index == old)
+    {
+        return;
+    }
+    list->selected = index;
+    if (index != 0xFF && rows != 0 && (index < list->top || index >= list->top + rows))
+    {
+        list->top = (index < list->top) ? index : (uint8_t)(index - rows + 1);
+        OLED_Ui_InvalidateWidget(&list->base);
+        return;
+    }
+    if (old != 0xFF)
+    {
+        OLED_UiList_InvalidateItem(list, old);
+    }
+    if (index != 0xFF)
+    {
+        OLED_UiList_InvalidateItem(list, index);
+    }
+}
@@ -0,0 +1,223 @@
+
+/**
+ * @file oled_ui.h
+ * @author Ted Wang
+ * @date 2026-10-17
+ * @brief Retained-mode widgets (label, icon, progress bar, list) with tile damage tracking.
+ *
+ * Widgets keep their own state and are drawn by the screen compositor, not by the application.
+ * A property setter compares the new value with the current one and, only if the visible result
+ * changes, marks the widget's bounding box as damaged in the screen's tile map (one bit per 8x8
+ * tile). OLED_Ui_Render() then redraws each damaged run of tiles with the u8g2 clip window set to
+ * that run, and sends exactly those tiles with u8g2_UpdateDisplayArea(). A frame without changes
+ * costs nothing; a clock that ticks once per second costs its own tiles only.
+ *
+ * Widgets are drawn in the order they were added, so later widgets are on top. The compositor needs
+ * the u8g2 full frame buffer (OLED_BUFFER_MODE_FULL).
+ */
+
+#ifndef OLED_UI_H
+#define OLED_UI_H
+
+#include "u8g2.h"
+#include "oled_text.h"
+#include "oled_blit.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @def OLED_UI_LABEL_MAX_CHARS
+ * @brief Maximum label text length (characters, without terminator).
+ */
+#define OLED_UI_LABEL_MAX_CHARS      24
+
+/**
+ * @def OLED_UI_MAX_TILE_ROWS
+ * @brief Maximum number of tile rows of the display (64 pixels).
+ */
+#define OLED_UI_MAX_TILE_ROWS        8
+
+/**
+ * @brief Widget types.
+ */
+typedef enum {
+    OLED_UI_LABEL = 0,          /**< Single line of text */
+    OLED_UI_ICON,               /**< Native image (oled_blit.h) */
+    OLED_UI_PROGRESS,           /**< Horizontal progress bar */
+    OLED_UI_LIST                /**< Vertical list of text rows with an optional selection */
+} OLED_UiType_t;
+
+struct OLED_UiScreen_s;
+
+/**
+ * @brief Common widget header (first member of every widget).
+ */
+typedef struct OLED_UiWidget_s {
+    OLED_UiType_t type;                 /**< Widget type */
+    struct OLED_UiScreen_s *screen;     /**< Screen the widget belongs to */
+    struct OLED_UiWidget_s *next;       /**< Next widget in drawing order */
+    u8g2_uint_t x;                      /**< Left edge */
+    u8g2_uint_t y;                      /**< Top edge */
+    u8g2_uint_t w;                      /**< Width */
+    u8g2_uint_t h;                      /**< Height */
+    uint8_t visible;                    /**< 0 = hidden */
+} OLED_UiWidget_t;
+
+/**
+ * @brief Label widget: one line of text, aligned inside its box.
+ */
+typedef struct {
+    OLED_UiWidget_t base;                       /**< Widget header */
+    const uint8_t *font;                        /**< u8g2 font */
+    OLED_TextAlign_t align;                     /**< Alignment inside the box */
+    char text[OLED_UI_LABEL_MAX_CHARS + 1];     /**< Current text */
+} OLED_UiLabel_t;
+
+/**
+ * @brief Icon widget: native image drawn with OLED_Blit() (OR mode).
+ */
+typedef struct {
+    OLED_UiWidget_t base;           /**< Widget header (w/h = image size) */
+    const OLED_Image_t *image;      /**< Current image, NULL = empty */
+} OLED_UiIcon_t;
+
+/**
+ * @brief Progress bar widget: frame with a filled part proportional to value/max.
+ */
+typedef struct {
+    OLED_UiWidget_t base;           /**< Widget header */
+    uint16_t value;                 /**< Current value */
+    uint16_t max;                   /**< Value for a full bar */
+    u8g2_uint_t fill;               /**< Filled width in pixels (derived from value) */
+} OLED_UiProgress_t;
+
+/**
+ * @brief List widget: up to h / row_height visible rows, optionally one row highlighted.
+ */
+typedef struct {
+    OLED_UiWidget_t base;           /**< Widget header */
+    const uint8_t *font;            /**< u8g2 font */
+    const char *const *items;       /**< Item strings (owned by the caller) */
+    uint8_t count;                  /**< Number of items */
+    uint8_t top;                    /**< First visible item */
+    uint8_t selected;               /**< Highlighted item, 0xFF = none */
+    uint8_t row_height;             /**< Row height in pixels */
+} OLED_UiList_t;
+
+/**
+ * @brief Screen: widget list and tile damage map.
+ */
+typedef struct OLED_UiScreen_s {
+    u8g2_t *u8g2;                               /**< Display object (full buffer mode) */
+    OLED_UiWidget_t *first;                     /**< First widget in drawing order */
+    OLED_UiWidget_t *last;                      /**< Last widget in drawing order */
+    uint16_t damage[OLED_UI_MAX_TILE_ROWS];     /**< One bit per damaged tile (bit = tile column) */
+    uint32_t frames;                            /**< OLED_Ui_Render() calls that sent tiles (profiling) */
+    uint32_t tiles_sent;                        /**< Tiles sent (profiling) */
+} OLED_UiScreen_t;
+
+
+/**
+ * @brief Initializes an empty screen; the first render redraws the whole display.
+ *
+ * @param[out] screen Screen to initialize.
+ * @param[in]  u8g2   Display object (full buffer mode, at most 16x8 tiles).
+ */
+void OLED_Ui_InitScreen(OLED_UiScreen_t *screen, u8g2_t *u8g2);
+
+
+/**
+ * @brief Marks a rectangle as damaged (e.g. after drawing outside of the widget system).
+ */
+void OLED_Ui_Invalidate(OLED_UiScreen_t *screen, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h);
+
+
+/**
+ * @brief Marks the whole screen as damaged.
+ */
+void OLED_Ui_InvalidateAll(OLED_UiScreen_t *screen);
+
+
+/**
+ * @brief Redraws and sends all damaged tiles, then clears the damage map.
+ *
+ * @param[in,out] screen Screen to render.
+ * @return Number of tiles sent (0 if nothing changed).
+ */
+uint16_t OLED_Ui_Render(OLED_UiScreen_t *screen);
+
+
+/**
+ * @brief Shows or hides a widget.
+ */
+void OLED_Ui_SetVisible(OLED_UiWidget_t *widget, uint8_t visible);
+
+
+/**
+ * @brief Adds a label to a screen.
+ *
+ * The label height is the font's maximum character height; the text is drawn with its top at y.
+ */
+void OLED_UiLabel_Init(OLED_UiLabel_t *label, OLED_UiScreen_t *screen, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w,
+                       const uint8_t *font, OLED_TextAlign_t align);
+
+/**
+ * @brief Sets the label text (truncated to OLED_UI_LABEL_MAX_CHARS); damages the label if it changed.
+ */
+void OLED_UiLabel_SetText(OLED_UiLabel_t *label, const char *text);
+
+
+/**
+ * @brief Adds an icon to a screen; the icon size is the size of the initial image.
+ */
+void OLED_UiIcon_Init(OLED_UiIcon_t *icon, OLED_UiScreen_t *screen, u8g2_uint_t x, u8g2_uint_t y, const OLED_Image_t *image);
+
+/**
+ * @brief Sets the icon image (same size as the initial one); damages the icon if it changed.
+ */
+void OLED_UiIcon_SetImage(OLED_UiIcon_t *icon, const OLED_Image_t *image);
+
+
+/**
+ * @brief Adds a progress bar to a screen.
+ */
+void OLED_UiProgress_Init(OLED_UiProgress_t *bar, OLED_UiScreen_t *screen, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h,
+                          uint16_t max);
+
+/**
+ * @brief Sets the progress value (clamped to max); damages only the changed part of the bar.
+ */
+void OLED_UiProgress_SetValue(OLED_UiProgress_t *bar, uint16_t value);
+
+
+/**
+ * @brief Adds a list to a screen.
+ */
+void OLED_UiList_Init(OLED_UiList_t *list, OLED_UiScreen_t *screen, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h,
+                      const uint8_t *font, uint8_t row_height);
+
+/**
+ * @brief Sets the list items; damages the whole list.
+ *
+ * The strings are not copied. After changing their content in place, call this again (or
+ * OLED_UiList_InvalidateItem()) so the list is redrawn.
+ */
+void OLED_UiList_SetItems(OLED_UiList_t *list, const char *const *items, uint8_t count);
+
+/**
+ * @brief Damages the row of one item (after its string changed in place).
+ */
+void OLED_UiList_InvalidateItem(OLED_UiList_t *list, uint8_t index);
+
+/**
+ * @brief Highlights an item (0xFF = none) and scrolls it into view; damages the affected rows.
+ */
+void OLED_UiList_SetSelected(OLED_UiList_t *list, uint8_t index);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // OLED_UI_H
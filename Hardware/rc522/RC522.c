@@ -14,6 +14,7 @@
  */
 
 #include "RC522.h"
+#include "timing.h"
 #include <stdint.h>
 
 /**
@@ -144,22 +145,35 @@ void AntennaOff(void)
 /**
  * @brief Resets the MFRC522 module.
  *
- * Writes the reset command to the CommandReg register.
+ * Writes the reset command to the CommandReg register, then polls the PowerDown bit (set during
+ * the reset phase) with 1 ms task sleeps, at most MFRC522_RESET_TIMEOUT_MS.
  */
 void MFRC522_Reset(void)
 {
+    uint8_t waited = 0;
+
     Write_MFRC522(CommandReg, PCD_RESETPHASE);
+    while ((Read_MFRC522(CommandReg) & MFRC522_POWERDOWN) && waited < MFRC522_RESET_TIMEOUT_MS)
+    {
+        Timing_DelayMs(1);
+        waited++;
+    }
 }
 
 /**
  * @brief Initializes the MFRC522 module for operation.
  *
- * Sets CS and RST pins, resets the module, configures timer and modulation registers, and enables the antenna.
+ * Pulses RST low (hard reset, at least 100 ns) and waits for the oscillator, soft-resets the module,
+ * configures timer and modulation registers, and enables the antenna. The waits sleep the calling
+ * task once the scheduler runs (timing.h).
  */
 void MFRC522_Init(void)
 {
 	HAL_GPIO_WritePin(MFRC522_CS_PORT,MFRC522_CS_PIN,GPIO_PIN_SET);
+	HAL_GPIO_WritePin(MFRC522_RST_PORT,MFRC522_RST_PIN,GPIO_PIN_RESET);
+	Timing_DelayUs(1);
 	HAL_GPIO_WritePin(MFRC522_RST_PORT,MFRC522_RST_PIN,GPIO_PIN_SET);
+	Timing_DelayMs(MFRC522_STARTUP_MS);
 	MFRC522_Reset();
 	 	
 	//Timer: TPrescaler*TreloadVal/6.78MHz = 24ms
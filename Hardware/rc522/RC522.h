@@ -25,6 +25,17 @@ extern SPI_HandleTypeDef hspi2;
 //Maximum length of the array
 #define MAX_LEN 16
 
+// Reset timing (timing.h): the task sleeps while the oscillator starts.
+// Releasing NRSTPD (RST) restarts the 27.12 MHz crystal oscillator; per the MFRC522 datasheet
+// (hard power-down, reset) the chip is ready only once the oscillator has started, and that
+// start-up time depends on the crystal rather than being a fixed figure. The old code wrote the configuration right after
+// releasing RST, which a still-starting oscillator can lose. 50 ms bounds the start-up of common
+// module crystals with margin; it lengthens the reader startup from ~0.04 ms to ~52 ms of wall time
+// but adds no CPU time, since the task sleeps (Tools/oled_host/startup_bench.c, a model).
+#define MFRC522_STARTUP_MS          50      // after releasing RST (crystal start-up, generous)
+#define MFRC522_RESET_TIMEOUT_MS    10      // upper bound for the soft reset phase
+#define MFRC522_POWERDOWN           0x10    // CommandReg PowerDown bit, set until the reset phase ends
+
 #define HSPI_INSTANCE				&hspi2
 #define MFRC522_CS_PORT				GPIOB
 #define MFRC522_CS_PIN				GPIO_PIN_8
@@ -137,6 +148,11 @@ extern SPI_HandleTypeDef hspi2;
  */
 void MFRC522_Init(void);
 
+/**
+ * @brief Soft-resets the MFRC522 and waits until its reset phase has ended.
+ */
+void MFRC522_Reset(void);
+
 /**
  * @brief Requests card presence and reads the card type.
  * @param reqMode Request mode (PICC_REQIDL or PICC_REQALL).
@@ -226,6 +226,22 @@ typedef void (*u8g2_draw_ll_hvline_cb)(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t
 
 typedef uint8_t (*u8g2_get_kerning_cb)(u8g2_t *u8g2, uint16_t e1, uint16_t e2);
 
+#ifdef U8G2_WITH_UNICODE
+/*
+  Sorted index of the unicode glyphs (encoding > 255) of one font, generated by
+  Tools/oled_font/fontsubset.py. With an index the glyph lookup is a binary search
+  instead of the walk through the unicode lookup table and the glyphs of a block.
+*/
+struct _u8g2_font_index_t
+{
+  const uint8_t *font;			/* font the index was generated for */
+  const uint16_t *encoding;		/* unicode encodings, ascending */
+  const uint32_t *offset;		/* start of each glyph, in bytes from the start of the font */
+  uint16_t count;			/* number of entries */
+};
+typedef struct _u8g2_font_index_t u8g2_font_index_t;
+#endif
+
 
 /* from ucglib... */
 struct _u8g2_font_info_t
@@ -363,6 +379,9 @@ struct u8g2_struct
   u8g2_font_calc_vref_fnptr font_calc_vref;
   u8g2_font_decode_t font_decode;		/* new font decode structure */
   u8g2_font_info_t font_info;			/* new font info structure */
+#ifdef U8G2_WITH_UNICODE
+  const u8g2_font_index_t *font_index;	/* used while font == font_index->font, can be NULL */
+#endif
 
 #ifdef U8G2_WITH_CLIP_WINDOW_SUPPORT
   /* 1 of there is an intersection between user_?? and clip_?? box */
@@ -1784,6 +1803,12 @@ uint8_t u8g2_GetKerningByTable(u8g2_t *u8g2, const uint16_t *kt, uint16_t e1, ui
 u8g2_uint_t u8g2_add_vector_y(u8g2_uint_t dy, int8_t x, int8_t y, uint8_t dir) U8G2_NOINLINE;
 u8g2_uint_t u8g2_add_vector_x(u8g2_uint_t dx, int8_t x, int8_t y, uint8_t dir) U8G2_NOINLINE;
 
+/* glyph lookup and decode primitives, used by the OLED text metrics cache (oled_text.c) */
+const uint8_t *u8g2_font_get_glyph_data(u8g2_t *u8g2, uint16_t encoding);
+int8_t u8g2_font_decode_glyph(u8g2_t *u8g2, const uint8_t *glyph_data);
+uint8_t u8g2_font_decode_get_unsigned_bits(u8g2_font_decode_t *f, uint8_t cnt);
+int8_t u8g2_font_decode_get_signed_bits(u8g2_font_decode_t *f, uint8_t cnt);
+
 
 size_t u8g2_GetFontSize(const uint8_t *font_arg);
 
@@ -1792,6 +1817,9 @@ size_t u8g2_GetFontSize(const uint8_t *font_arg);
 #define U8G2_FONT_HEIGHT_MODE_ALL 2
 
 void u8g2_SetFont(u8g2_t *u8g2, const uint8_t  *font);
+#ifdef U8G2_WITH_UNICODE
+void u8g2_SetFontIndex(u8g2_t *u8g2, const u8g2_font_index_t *font_index);
+#endif
 void u8g2_SetFontMode(u8g2_t *u8g2, uint8_t is_transparent);
 
 uint8_t u8g2_IsGlyph(u8g2_t *u8g2, uint16_t requested_encoding);
@@ -36,28 +36,30 @@
 //  return buf;
 //  #endif
 //}
-//uint8_t *u8g2_m_16_8_1(uint8_t *page_cnt)
-//{
-//  #ifdef U8G2_USE_DYNAMIC_ALLOC
-//  *page_cnt = 1;
-//  return 0;
-//  #else
-//  static uint8_t buf[128];
-//  *page_cnt = 1;
-//  return buf;
-//  #endif
-//}
-//uint8_t *u8g2_m_16_8_2(uint8_t *page_cnt)
-//{
-//  #ifdef U8G2_USE_DYNAMIC_ALLOC
-//  *page_cnt = 2;
-//  return 0;
-//  #else
-//  static uint8_t buf[256];
-//  *page_cnt = 2;
-//  return buf;
-//  #endif
-//}
+#ifndef USE_HAL_DRIVER /* page buffer variants: host tools only (Tools/oled_host/vdisplay.c) */
+uint8_t *u8g2_m_16_8_1(uint8_t *page_cnt)
+{
+  #ifdef U8G2_USE_DYNAMIC_ALLOC
+  *page_cnt = 1;
+  return 0;
+  #else
+  static uint8_t buf[128];
+  *page_cnt = 1;
+  return buf;
+  #endif
+}
+uint8_t *u8g2_m_16_8_2(uint8_t *page_cnt)
+{
+  #ifdef U8G2_USE_DYNAMIC_ALLOC
+  *page_cnt = 2;
+  return 0;
+  #else
+  static uint8_t buf[256];
+  *page_cnt = 2;
+  return buf;
+  #endif
+}
+#endif
 uint8_t *u8g2_m_16_8_f(uint8_t *page_cnt)
 {
   #ifdef U8G2_USE_DYNAMIC_ALLOC
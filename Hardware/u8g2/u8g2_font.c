@@ -771,6 +771,35 @@ int8_t u8g2_font_2x_decode_glyph(u8g2_t *u8g2, const uint8_t *glyph_data)
   return d*2;
 }
 
+#ifdef U8G2_WITH_UNICODE
+/*
+  Description:
+    Binary search of a unicode glyph in the sorted font index.
+  Return:
+    Address of the glyph data or NULL, if the encoding is not in the index.
+*/
+static const uint8_t *u8g2_font_index_lookup(const u8g2_font_index_t *index, uint16_t encoding)
+{
+  uint16_t lo = 0;
+  uint16_t hi = index->count;
+  uint16_t mid;
+  uint16_t e;
+  
+  while ( lo < hi )
+  {
+    mid = (uint16_t)((lo + hi) >> 1);
+    e = index->encoding[mid];
+    if ( e == encoding )
+      return index->font + index->offset[mid] + 3;	/* skip encoding and glyph size */
+    if ( e < encoding )
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return NULL;
+}
+#endif
+
 /*
   Description:
     Find the starting point of the glyph data.
@@ -813,6 +842,9 @@ const uint8_t *u8g2_font_get_glyph_data(u8g2_t *u8g2, uint16_t encoding)
     uint16_t e;
     const uint8_t *unicode_lookup_table;
     
+    if ( u8g2->font_index != NULL && u8g2->font_index->font == u8g2->font )
+      return u8g2_font_index_lookup(u8g2->font_index, encoding);
+    
 // removed, there is now the new index table
 //#ifdef  __unix__
 //    if ( u8g2->last_font_data != NULL && encoding >= u8g2->last_unicode )
@@ -1291,6 +1323,18 @@ void u8g2_SetFont(u8g2_t *u8g2, const uint8_t  *font)
   }
 }
 
+#ifdef U8G2_WITH_UNICODE
+/*
+  Registers the sorted glyph index of a font (see u8g2_font_index_t).
+  The index is used whenever its font is the current font, so it may be set
+  once and survives switching to other fonts and back. NULL removes it.
+*/
+void u8g2_SetFontIndex(u8g2_t *u8g2, const u8g2_font_index_t *font_index)
+{
+  u8g2->font_index = font_index;
+}
+#endif
+
 /*===============================================*/
 
 static uint8_t u8g2_is_all_valid(u8g2_t *u8g2, const char *str) U8G2_NOINLINE;
@@ -71,6 +71,9 @@ void u8g2_SetClipWindow(u8g2_t *u8g2, u8g2_uint_t clip_x0, u8g2_uint_t clip_y0,
 void u8g2_SetupBuffer(u8g2_t *u8g2, uint8_t *buf, uint8_t tile_buf_height, u8g2_draw_ll_hvline_cb ll_hvline_cb, const u8g2_cb_t *u8g2_cb)
 {
   u8g2->font = NULL;
+#ifdef U8G2_WITH_UNICODE
+  u8g2->font_index = NULL;
+#endif
   //u8g2->kerning = NULL;
   //u8g2->get_kerning_cb = u8g2_GetNullKerning;
   
@@ -84,6 +84,7 @@ static void u8log_scroll_up(u8log_t *u8log)
     cnt--;
   } while(cnt > 0);
   
+  u8log->scroll_cnt++;
   if ( u8log->is_redraw_line_for_each_char )
     u8log->is_redraw_all = 1;
   else
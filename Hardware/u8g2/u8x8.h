@@ -356,6 +356,7 @@ struct u8x8_struct
 					/* i2c_address is the address for writing data to the display */
 					/* usually, the lowest bit must be zero for a valid address */
   uint8_t i2c_started;	/* for i2c interface */
+  uint8_t display_start_line;	/* ssd13xx/sh1106 RAM row shown at the top of the panel, used for hardware scrolling */
   //uint8_t device_address;	/* OBSOLETE???? - this is the device address, replacement for U8X8_MSG_CAD_SET_DEVICE */
   uint8_t utf8_state;		/* number of chars which are still to scan */
   uint8_t gpio_result;	/* return value from the gpio call (only for MENU keys at the moment) */ 
@@ -427,6 +428,7 @@ struct u8log_struct
   uint8_t is_redraw_line;
   uint8_t is_redraw_all;
   uint8_t is_redraw_all_required_for_next_nl; /* in nl mode, redraw all instead of current line */
+  uint16_t scroll_cnt;		/* incremented by each scroll up, lets a redraw callback follow the scrolling */
 };
 
 
@@ -584,6 +586,8 @@ void u8x8_ClearDisplay(u8x8_t *u8x8);	// this does not work for u8g2 in some cas
 void u8x8_FillDisplay(u8x8_t *u8x8);
 void u8x8_RefreshDisplay(u8x8_t *u8x8);	// make RAM content visible on the display (Dec 16: SSD1606 only)
 void u8x8_ClearLine(u8x8_t *u8x8, uint8_t line);
+/* ssd13xx/sh1106 only: select the RAM row (0..63) shown at the top of the panel (command 0x40..0x7f) */
+void u8x8_SetDisplayStartLine(u8x8_t *u8x8, uint8_t line);
 
 
 
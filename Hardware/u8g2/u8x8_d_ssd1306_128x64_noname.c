@@ -300,7 +300,7 @@ static uint8_t u8x8_d_ssd1306_sh1106_generic(u8x8_t *u8x8, uint8_t msg, uint8_t
       x *= 8;
       x += u8x8->x_offset;
     
-      u8x8_cad_SendCmd(u8x8, 0x040 );	/* set line offset to 0 */
+      u8x8_cad_SendCmd(u8x8, 0x040 | (u8x8->display_start_line & 0x03f) );	/* keep the line offset, see u8x8_SetDisplayStartLine() */
     
       u8x8_cad_SendCmd(u8x8, 0x010 | (x>>4) );
       u8x8_cad_SendArg(u8x8, 0x000 | ((x&15)));					/* probably wrong, should be SendCmd */
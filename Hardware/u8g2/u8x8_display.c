@@ -200,4 +200,16 @@ void u8x8_ClearLine(u8x8_t *u8x8, uint8_t line)
     tile.tile_ptr = (uint8_t *)buf;		/* tile_ptr should be const, but isn't */
     u8x8->display_cb(u8x8, U8X8_MSG_DISPLAY_DRAW_TILE, u8x8->display_info->tile_width, (void *)&tile);
   }  
-}
\ No newline at end of file
+}
+/*
+  ssd13xx/sh1106 only: select the RAM row shown at the top of the panel.
+  The value is also kept in u8x8->display_start_line, because the
+  DRAW_TILE message of these controllers re-sends the start line.
+*/
+void u8x8_SetDisplayStartLine(u8x8_t *u8x8, uint8_t line)
+{
+  u8x8->display_start_line = line & 0x03f;
+  u8x8_cad_StartTransfer(u8x8);
+  u8x8_cad_SendCmd(u8x8, 0x040 | u8x8->display_start_line );
+  u8x8_cad_EndTransfer(u8x8);
+}
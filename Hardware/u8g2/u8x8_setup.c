@@ -104,6 +104,7 @@ void u8x8_SetupDefaults(u8x8_t *u8x8)
     u8x8->utf8_state = 0;		/* also reset by u8x8_utf8_init */
     u8x8->bus_clock = 0;		/* issue 769 */
     u8x8->i2c_address = 255;
+    u8x8->display_start_line = 0;
     u8x8->debounce_default_pin_state = 255;	/* assume all low active buttons */
   
 #ifdef U8X8_USE_PINS 
@@ -0,0 +1,146 @@
+#!/usr/bin/env python3
+"""
+@file memmap_report.py
+@author Ted Wang
+@date 2026-10-17
+@brief Memory map report for the Keil (armlink) build: region use, CCM RAM contents, DMA placement.
+
+Reads the linker map (MDK-ARM/NUCLEO-F429ZI_OLED_RC522_RTOS/NUCLEO-F429ZI_OLED_RC522_RTOS.map,
+written with "Memory Map" and "Symbols" enabled in Options for Target -> Listing) and prints
+  - every execution region of MDK-ARM/stm32f429zi_ccm.sct with its size, limit and RW/ZI split,
+  - the data objects placed in CCM RAM (RW_IRAM2), largest first,
+  - the largest data objects left in SRAM (RW_IRAM1),
+  - where the buffers read or written by DMA ended up. The DMA controllers cannot access CCM RAM
+    (0x10000000..0x1000FFFF), so a DMA buffer there is reported as an error.
+
+The exit code is 1 if a DMA buffer lies in CCM RAM or a region is over its limit.
+
+Only the Python standard library is used.
+
+Example:
+    python3 memmap_report.py ../../MDK-ARM/NUCLEO-F429ZI_OLED_RC522_RTOS/NUCLEO-F429ZI_OLED_RC522_RTOS.map
+    python3 memmap_report.py --top 30 --dma my_uart_rx <map>
+"""
+
+import argparse
+import re
+import sys
+
+CCM_BASE = 0x10000000
+CCM_SIZE = 0x10000
+SRAM_BASE = 0x20000000
+SRAM_SIZE = 0x30000
+
+# Objects handed to HAL_*_DMA(): the OLED displays (bus slots), the slot used for dropped
+# transfers, the mirror and the trace transmit buffers
+DEFAULT_DMA = ["oled_inside", "outside_display", "oled_discard", "mirror_tx", "trace_tx"]
+
+REGION_RE = re.compile(r"^\s*Execution Region (\S+) \(Exec base: (0x[0-9a-fA-F]+),.*?Size: (0x[0-9a-fA-F]+), "
+                       r"Max: (0x[0-9a-fA-F]+)")
+SECTION_RE = re.compile(r"^\s*(0x[0-9a-fA-F]+)\s+(?:0x[0-9a-fA-F]+|-)\s+(0x[0-9a-fA-F]+)\s+(Data|Zero|Code)\s+(RO|RW)\s")
+SYMBOL_RE = re.compile(r"^\s*(\S+)\s+(0x[0-9a-fA-F]+)\s+(?:\S+\s+)?Data\s+(\d+)\s+(\S+?)\((\S+)\)\s*$")
+
+
+def memory_name(address):
+    if CCM_BASE <= address < CCM_BASE + CCM_SIZE:
+        return "CCM"
+    if SRAM_BASE <= address < SRAM_BASE + SRAM_SIZE:
+        return "SRAM"
+    if 0x08000000 <= address < 0x08200000:
+        return "Flash"
+    return "?"
+
+
+def parse_map(path):
+    """Returns (regions, symbols): regions as dicts, data symbols as (name, address, size, object, section)."""
+    regions = []
+    symbols = []
+    current = None
+    with open(path, encoding="latin-1") as f:
+        for line in f:
+            m = REGION_RE.match(line)
+            if m:
+                current = {"name": m.group(1), "base": int(m.group(2), 16), "size": int(m.group(3), 16),
+                           "max": int(m.group(4), 16), "rw": 0, "zi": 0}
+                regions.append(current)
+                continue
+            if line.startswith("====="):
+                current = None
+                continue
+            if current is not None:
+                m = SECTION_RE.match(line)
+                if m and m.group(4) == "RW":
+                    current["zi" if m.group(3) == "Zero" else "rw"] += int(m.group(2), 16)
+                continue
+            m = SYMBOL_RE.match(line)
+            if m and int(m.group(3)) > 0:
+                symbols.append((m.group(1), int(m.group(2), 16), int(m.group(3)), m.group(4), m.group(5)))
+    return regions, symbols
+
+
+def print_objects(title, objects, top):
+    print("\n%s" % title)
+    if not objects:
+        print("    (none)")
+        return
+    for name, address, size, obj, section in objects[:top]:
+        print("  %7u  0x%08x  %-32s %s" % (size, address, name, obj))
+    if len(objects) > top:
+        rest = objects[top:]
+        print("  %7u  (%u more)" % (sum(o[2] for o in rest), len(rest)))
+
+
+def main():
+    ap = argparse.ArgumentParser(description="armlink memory map report (regions, CCM RAM, DMA buffers)")
+    ap.add_argument("map", help="linker map file (.map)")
+    ap.add_argument("--top", type=int, default=15, help="number of SRAM objects to list (default 15)")
+    ap.add_argument("--dma", action="append", default=[], metavar="SYMBOL",
+                    help="additional DMA buffer that must stay in SRAM (repeatable)")
+    args = ap.parse_args()
+
+    regions, symbols = parse_map(args.map)
+    if not regions:
+        sys.exit("%s: no execution regions found (is the memory map enabled in the listing options?)" % args.map)
+    errors = 0
+
+    print("%-10s %-6s %-10s %8s %8s %6s %8s %8s" % ("region", "memory", "base", "used", "max", "use %", "RW", "ZI"))
+    for r in regions:
+        use = 100.0 * r["size"] / r["max"] if r["max"] else 0.0
+        print("%-10s %-6s 0x%08x %8u %8u %5.1f%% %8u %8u" % (r["name"], memory_name(r["base"]), r["base"], r["size"],
+                                                             r["max"], use, r["rw"], r["zi"]))
+        if r["size"] > r["max"]:
+            errors += 1
+
+    # Symbol tables list a section symbol and a data symbol at the same address; keep the data ones
+    seen = set()
+    data = []
+    for s in sorted(symbols, key=lambda s: -s[2]):
+        if (s[0], s[1]) not in seen:
+            seen.add((s[0], s[1]))
+            data.append(s)
+    ccm = [s for s in data if memory_name(s[1]) == "CCM"]
+    sram = [s for s in data if memory_name(s[1]) == "SRAM"]
+    print_objects("CCM RAM: %u bytes in %u objects" % (sum(s[2] for s in ccm), len(ccm)), ccm, len(ccm))
+    print_objects("SRAM: largest of %u objects" % len(sram), sram, args.top)
+
+    print("\nDMA buffers")
+    by_name = {}
+    for s in data:
+        by_name.setdefault(s[0], s)
+    for name in DEFAULT_DMA + args.dma:
+        s = by_name.get(name)
+        if s is None:
+            print("  %-32s not in the image" % name)
+            continue
+        memory = memory_name(s[1])
+        state = "ok" if memory == "SRAM" else "ERROR: not reachable by DMA"
+        if memory != "SRAM":
+            errors += 1
+        print("  %-32s 0x%08x %-5s %s" % (name, s[1], memory, state))
+
+    print("\n%s" % ("ok" if errors == 0 else "%u error(s)" % errors))
+    return 1 if errors else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
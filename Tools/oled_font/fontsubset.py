@@ -0,0 +1,263 @@
+#!/usr/bin/env python3
+"""
+@file fontsubset.py
+@author Ted Wang
+@date 2026-10-17
+@brief Subsets a u8g2 font to the characters of a name list and generates its sorted glyph index.
+
+u8g2 finds a unicode glyph by scanning the unicode lookup table of the font and then walking the
+glyphs of the block it lands in one by one (about 100 glyphs per block in the CJK fonts). This
+tool reads a font from Hardware/u8g2/u8g2_fonts.c and writes a .c/.h pair with
+  - the font reduced to the codepoints used by the name list (plus --text and, with --ascii, the
+    printable ASCII range), in the regular u8g2 font format, and
+  - a u8g2_font_index_t (Hardware/u8g2/u8g2.h): the unicode encodings in ascending order with the
+    offset of each glyph, so u8g2_font_get_glyph_data() does a binary search.
+With --index-only the font is not copied; only the index of the unmodified u8g2 font is written.
+
+The name list is UTF-8 text; every character of it is kept (line breaks are ignored). The tool
+prints the flash used by the full font, the subset and the index, and lists characters that the
+font does not have.
+
+Only the Python standard library is used.
+
+Example (writes oled_font_names.c and oled_font_names.h, the fixture of
+Tools/oled_host/font_bench.c; a firmware build adds its output to the Keil project):
+    python3 fontsubset.py --font u8g2_font_wqy12_t_gb2312 --names names.txt --ascii \\
+        -o oled_font_names
+"""
+
+import argparse
+import os
+import re
+import sys
+
+HEADER_SIZE = 23            # U8G2_FONT_DATA_STRUCT_SIZE
+BLOCK_GLYPHS = 100          # glyphs per unicode lookup table entry, as in the u8g2 fonts
+DEFAULT_SOURCE = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "..", "Hardware", "u8g2", "u8g2_fonts.c")
+ESCAPES = {'n': 10, 't': 9, 'r': 13, '"': 34, '\\': 92, "'": 39, '?': 63}
+
+
+def parse_c_string(text):
+    """Decodes the concatenated C string literals of a u8g2 font into bytes."""
+    data = bytearray()
+    for literal in re.findall(r'"((?:[^"\\]|\\.)*)"', text):
+        i = 0
+        while i < len(literal):
+            if literal[i] != '\\':
+                data.append(ord(literal[i]))
+                i += 1
+                continue
+            j = i + 1
+            k = j
+            while k < len(literal) and k < j + 3 and literal[k] in "01234567":
+                k += 1
+            if k > j:
+                data.append(int(literal[j:k], 8))
+                i = k
+            else:
+                data.append(ESCAPES.get(literal[j], ord(literal[j])))
+                i = j + 1
+    data.append(0)      # terminator of the string, part of the font
+    return bytes(data)
+
+
+def read_font(path, name):
+    """Returns the bytes of the named font in a u8g2_fonts.c style source."""
+    with open(path, encoding="latin-1") as f:
+        source = f.read()
+    m = re.search(r'const uint8_t %s\[(\d+)\][^=]*=((?:\s*"(?:[^"\\]|\\.)*")+)\s*;' % re.escape(name), source)
+    if m is None:
+        sys.exit("%s: font %s not found" % (path, name))
+    data = parse_c_string(m.group(2))
+    if len(data) != int(m.group(1)):
+        sys.exit("%s: font %s decodes to %u bytes, declared %s" % (path, name, len(data), m.group(1)))
+    return data
+
+
+def word(data, pos):
+    return (data[pos] << 8) | data[pos + 1]
+
+
+def split_glyphs(font):
+    """Splits a font into its header and a dict encoding -> (offset, glyph bytes incl. encoding and size)."""
+    glyphs = {}
+    pos = HEADER_SIZE
+    while font[pos + 1] != 0:
+        size = font[pos + 1]
+        glyphs[font[pos]] = (pos, font[pos:pos + size])
+        pos += size
+    table = HEADER_SIZE + word(font, 21)
+    if table != pos + 2:
+        sys.exit("unexpected font layout: unicode section at %u, 8 bit glyphs end at %u" % (table, pos + 2))
+    while word(font, table + 2) != 0xFFFF:
+        table += 4
+    pos = table + 4
+    while word(font, pos) != 0:
+        size = font[pos + 2]
+        glyphs[word(font, pos)] = (pos, font[pos:pos + size])
+        pos += size
+    return font[:HEADER_SIZE], glyphs
+
+
+def build_font(header, glyphs, keep):
+    """Rebuilds a u8g2 font from the kept encodings; returns the bytes and the unicode glyph offsets."""
+    low = sorted(e for e in keep if e <= 255)
+    high = sorted(e for e in keep if e > 255)
+    body = bytearray()
+    upper_a = lower_a = None
+    for e in low:
+        if upper_a is None and e >= ord('A'):
+            upper_a = len(body)
+        if lower_a is None and e >= ord('a'):
+            lower_a = len(body)
+        body += glyphs[e][1]
+    end = len(body)
+    body += b"\0\0"
+    unicode_start = len(body)
+
+    # Lookup table: one entry per block (distance to the block start, last encoding in the block);
+    # the last entry is marked 0xFFFF so the scan in u8g2_font_get_glyph_data() always stops
+    blocks = [high[i:i + BLOCK_GLYPHS] for i in range(0, len(high), BLOCK_GLYPHS)] or [[]]
+    table = bytearray()
+    glyph_data = bytearray()
+    offsets = {}
+    previous = 0
+    table_size = 4 * len(blocks)
+    for n, block in enumerate(blocks):
+        start = table_size + len(glyph_data)
+        last = 0xFFFF if n == len(blocks) - 1 else block[-1]
+        table += bytes([(start - previous) >> 8, (start - previous) & 0xFF, last >> 8, last & 0xFF])
+        previous = start
+        for e in block:
+            offsets[e] = HEADER_SIZE + unicode_start + table_size + len(glyph_data)
+            glyph_data += glyphs[e][1]
+    body += table + glyph_data + b"\0\0"
+
+    out = bytearray(header)
+    out[0] = (len(low) + len(high)) & 0xFF
+    for pos, value in ((17, end if upper_a is None else upper_a), (19, end if lower_a is None else lower_a),
+                       (21, unicode_start)):
+        if value > 0xFFFF:
+            sys.exit("8 bit glyphs exceed 64 KB")
+        out[pos] = value >> 8
+        out[pos + 1] = value & 0xFF
+    return bytes(out + body), offsets
+
+
+def c_string(data):
+    """Formats bytes as u8g2 style C string literal lines (the final NUL is implicit)."""
+    lines = []
+    line = ""
+    escaped = False
+    for b in data[:-1]:
+        c = chr(b)
+        if c in '"\\?' or b < 32 or b > 126 or (escaped and c in "01234567"):
+            piece = "\\%o" % b
+            escaped = True
+        else:
+            piece = c
+            escaped = False
+        if len(line) + len(piece) > 92:
+            lines.append('  "%s"' % line)
+            line = ""
+        line += piece
+    lines.append('  "%s"' % line)
+    return lines
+
+
+def main():
+    ap = argparse.ArgumentParser(description="u8g2 font subsetter and glyph index generator")
+    ap.add_argument("--font", required=True, help="u8g2 font name, e.g. u8g2_font_wqy12_t_gb2312")
+    ap.add_argument("--names", help="UTF-8 name list; all of its characters are kept")
+    ap.add_argument("--text", default="", help="additional characters to keep")
+    ap.add_argument("--ascii", action="store_true", help="also keep the printable ASCII characters 32..126")
+    ap.add_argument("--index-only", action="store_true", help="write only the index of the unmodified font")
+    ap.add_argument("--name", help="C name of the generated font (default: output file name)")
+    ap.add_argument("--source", default=DEFAULT_SOURCE, help="font source (default: Hardware/u8g2/u8g2_fonts.c)")
+    ap.add_argument("-o", "--output", required=True, help="output path without extension (.c and .h are written)")
+    args = ap.parse_args()
+
+    module = os.path.basename(args.output)
+    guard = re.sub(r"[^0-9A-Za-z]", "_", module).upper() + "_H"
+    font = read_font(args.source, args.font)
+    header, glyphs = split_glyphs(font)
+
+    if args.index_only:
+        name = args.font
+        data = font
+        kept = len(glyphs)
+        offsets = {e: pos for e, (pos, _) in glyphs.items() if e > 255}
+        what = "Sorted glyph index of %s." % args.font
+    else:
+        text = args.text
+        if args.names:
+            with open(args.names, encoding="utf-8") as f:
+                text += f.read()
+        wanted = {ord(c) for c in text if c not in "\r\n"}
+        if args.ascii:
+            wanted |= set(range(32, 127))
+        missing = sorted(e for e in wanted if e not in glyphs)
+        if any(e > 0xFFFF for e in missing):
+            sys.exit("codepoints above U+FFFF are not supported by u8g2")
+        for e in missing:
+            print("warning: %s has no glyph for U+%04X %s" % (args.font, e, chr(e)), file=sys.stderr)
+        name = args.name or module
+        kept = len(wanted) - len(missing)
+        data, offsets = build_font(header, glyphs, wanted - set(missing))
+        what = "%s reduced to the characters of %s, with its sorted glyph index." \
+            % (args.font, os.path.basename(args.names) if args.names else "the given text")
+
+    encodings = sorted(offsets)
+    index_bytes = 6 * len(encodings)
+    inputs = "--font %s" % args.font + (" --names %s" % os.path.basename(args.names) if args.names else "") + \
+        (" --ascii" if args.ascii else "") + (" --index-only" if args.index_only else "")
+
+    header_lines = ["/**", " * @file %s.h" % module, " * @author Ted Wang",
+                    " * @brief %s" % what, " *", " * Generated by Tools/oled_font/fontsubset.py %s" % inputs,
+                    " * Select with u8g2_SetFont() and u8g2_SetFontIndex(); do not edit, regenerate instead.",
+                    " */", "", "#ifndef %s" % guard, "#define %s" % guard, "", '#include "u8g2.h"', "",
+                    "#ifdef __cplusplus", 'extern "C" {', "#endif", ""]
+    if not args.index_only:
+        header_lines.append('extern const uint8_t %s[%u] U8G2_FONT_SECTION("%s");    /**< %u glyphs */'
+                            % (name, len(data), name, kept))
+    header_lines.append("extern const u8g2_font_index_t %s_index;    /**< %u unicode glyphs */" % (name, len(encodings)))
+    header_lines += ["", "#ifdef __cplusplus", "}", "#endif", "", "#endif // %s" % guard, ""]
+
+    source = ["/**", " * @file %s.c" % module, " * @author Ted Wang",
+              " * @brief %s" % what,
+              " */", "", '#include "%s.h"' % module, ""]
+    if not args.index_only:
+        source.append('const uint8_t %s[%u] U8G2_FONT_SECTION("%s") = ' % (name, len(data), name))
+        source += c_string(data)
+        source[-1] += ";"
+        source.append("")
+    if encodings:
+        source.append("static const uint16_t %s_index_encoding[%u] = {" % (name, len(encodings)))
+        for i in range(0, len(encodings), 12):
+            source.append("    " + " ".join("0x%04X," % e for e in encodings[i:i + 12]))
+        source.append("};")
+        source.append("static const uint32_t %s_index_offset[%u] = {" % (name, len(encodings)))
+        for i in range(0, len(encodings), 10):
+            source.append("    " + " ".join("%u," % offsets[e] for e in encodings[i:i + 10]))
+        source.append("};")
+        source.append("const u8g2_font_index_t %s_index = {%s, %s_index_encoding, %s_index_offset, %u};"
+                      % (name, name, name, name, len(encodings)))
+    else:
+        source.append("const u8g2_font_index_t %s_index = {%s, NULL, NULL, 0};" % (name, name))
+    source.append("")
+
+    with open(args.output + ".h", "w", newline="\n") as f:
+        f.write("\n".join(header_lines))
+    with open(args.output + ".c", "w", newline="\n") as f:
+        f.write("\n".join(source))
+
+    print("%s: %u bytes, %u glyphs" % (args.font, len(font), len(glyphs)))
+    if not args.index_only:
+        print("%s: %u bytes, %u glyphs (%u bytes = %.1f%% saved)"
+              % (name, len(data), kept, len(font) - len(data), 100.0 * (len(font) - len(data)) / len(font)))
+    print("%s_index: %u entries, %u bytes" % (name, len(encodings), index_bytes))
+    print("written to %s.c/.h" % args.output)
+
+
+if __name__ == "__main__":
+    main()
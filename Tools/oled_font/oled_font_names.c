@@ -0,0 +1,134 @@
+/**
+ * @file oled_font_names.c
+ * @author Ted Wang
+ * @brief u8g2_font_wqy12_t_gb2312 reduced to the characters of names.txt, with its sorted glyph index.
+ */
+
+#include "oled_font_names.h"
+
+const uint8_t oled_font_names[3450] U8G2_FONT_SECTION("oled_font_names") = 
+  "\265\0\2\2\4\4\5\5\5\15\15\0\376\10\376\12\377\1v\3\60\4i \5\0\60Z!\7\221\22Z\316\0\42\7\64"
+  "\361Z\242\31#\15\226\20\336bk\254\330k\254\330\2$\16\245\360Y\363\252T\326H'U\355\10%\20\226"
+  "\360\331b\352\322)\243\14SL]:\1&\15\205\20Zs\212)W3\305\250\2'\6\61\362V\6(\13\263\361YSL"
+  "\261;\346\0)\13\263\361Yr\314\261+\246\10*\13u\20Z\253\352P\253\31\1+\16w\20\342\63\3168\217"
+  "\221\63\3168\3,\7\62\362Y\224\2-\7\25\220Z\206\0.\6!\22V\4/\13\304\360\331\233\271\314e\256"
+  "\1\60\12\205\20\332V\366\235\26\0\61\17\205\20Z6\312(\243\214\62\312(\16\1\62\14\205\20\332V"
+  "\316(\243\334\36\2\63\17\205\20ZF\206\31\245\15\63\312h(\0\64\16\206\20\336u\212]9\215\215"
+  "\62L\0\65\17\205\20ZF\312(\243\221aF\31\15\5\66\15\205\20\332VF\31\215\224\355\264\0\67\17"
+  "\205\20Z\206F\31\345\214rF\31E\08\14\205\20\332V\326ie;-\09\14\205\20\332V\266\323\310H\247"
+  "\5:\7a\20J\244\0;\11\202\362YF\306J\1<\15\225\20\332Q\356\206\31f\230a\0=\10\65pZ\206\206C>"
+  "\15\225\20Z2\314\60\303\14s7\2\77\16\225\20\332V\326\31E\235\351\214\42\0@\22\247\360aw\225"
+  "\244NR\251JU2\251\234'\0A\20\207\20\342\63\316\60eT\227Ce\250a\0B\20\206\20^\206\312H\243"
+  "\261\62\322H\243\261\0C\21\206\20\336F\312H\303\14\63\314\60\243\64\22\0D\21\207\20b\206\314"
+  "\250\206\32j\250\241FiH\0E\16\205\20Zn\224\321\330(\243\214\206\0F\17\205\20Zn\224\321H\31e"
+  "\224QF\0G\17\206\20\336F\312H\303\14\363F\32\245!H\20\206\20^2\322H\243\61\64\322H#\215\2I"
+  "\10\203\20RV\354\65J\10\243\320Q\373s\1K\14\205\20Z\262L\245\326)V9L\17\205\20Z2\312(\243"
+  "\214\62\312(\243!M\20\207\20b\364\310\253R\225\214\62j\250a\0N\17\206\20^2\332*\312\244\67"
+  "\322H\243\0O\17\207\20bw\225\241\206\32j\230r\236\0P\16\205\20ZF\312\366P\31e\224\21\0Q\20"
+  "\227\360aw\225\241\206\32j\230r\336T\2R\17\206\20^F\314)\247\234Fl\247\214\2S\16\205\20\332"
+  "\206F\31n\230QFC\1T\17\207\20b\216\234q\306\31g\234q\306\31U\21\206\20^2\322H#\215\64\322H"
+  "\243\64\22\0V\20\207\20b2\324\60\345\230\253\214j\230q\6W\20\211\20jr\326YW\235\251\231\332"
+  "\65\312\21X\16\206\20^2\322\250\314:\266\62\322(Y\20\207\20b2L\271\312\60\343\214\63\3168\3Z"
+  "\21\207\20b\216\14\63\314\60\303\14\63\314x\214\0[\11\263\362YF\354\317\1\134\21\245\360Y2"
+  "\312\60\243\14\63\312\60\243\14\63\12]\11\263\361Yf\177\216\0^\10\65\320Zs\252\3_\7\25\360Y"
+  "\206\0`\7\62\361VR\14a\13e\20\332VNC\353\64\2b\14\205\20Z2\312h\244\354\36\12c\11d\20\326Fn"
+  "\243\1d\14\205\20\332QFihw\32\1e\14e\20\332V\36#\243\14G\0f\11\203\20\322\346\210\235\0g\14"
+  "\205\320\331\206v\247\221QZ\0h\13\205\20Z2\312h\244\354\35i\7\201\20J\322\30j\10\242\320\315"
+  "r\352\65k\16\205\20Z2\312(\246R\247X\345\0l\7\201\20J\16\1m\15g\20b\226\212QF\31e\224\5n\11e"
+  "\20ZF\312\336\1o\11e\20\332Vv\247\5p\14\205\320YF\312\356\241\62\312\10q\14\205\320\331\206v"
+  "\247\221QF\1r\10c\20RF\354\4s\14e\20\332VN\32\246\234\26\0t\11\203\20Rb\34\261-u\11e\20Z\262"
+  "w\32\1v\14e\20Z\262Ne\312\31E\0w\15g\20bb\224QU\252;\346\4x\12e\20Zr\252\253Z\7y\16\205\320Y"
+  "\262Ne\312\31\345\214\62\0z\12e\20Z\206F\271=\4{\12\243\360QS\254rl\7|\7\261\362U\36\2}\13"
+  "\243\360Qr\254SlE\0~\7&p\336\244\5\0\0\0\4\377\377\60K\30\252\361q3+\3078\343\254c\35\223"
+  "\314\31\346\214b\312(g\4\60O\17\265\362\361\63\314\335\60\303\14\63\314(0U\24\267\362q3\225"
+  "\363\32\231\3128\216\244\321\246\64\265\0\60r\32\252\361\361q\306\61\217\234QF\31e$3L5\314"
+  "\31f\224\63\336\10\60\211\25\267\362q3\245\63\3148\343\64\222F\32f\234\221\334\0\60\212\26"
+  "\267\362qrU\246\230t\322)\243\32e\230q\206\31f\0\60\242\26\232\360q2\32jd\224a\215\67\225"
+  "\351Lf:\223\231\0\60\255\27\272\360\361Q\246\63\235\346\320t&\307\221\62\235Y\231\316t\6\60"
+  "\261\31\272\361\361\62+\323y\304\221q\15sF\31\345\214\62\235\311Lf\2\60\351\27\251\361\361"
+  "\342F\32f4\322\310\231\314T&3\225\261\206\32\2\60\363\24\231\361\361\64\235Q&3\225\311Le*G"
+  "\15\65\1N-\27\271\361\361Q&3\32G\316:\353<\16]\243Lf2#\0N=\33\273\360q\36\232=\322\210Ul\305"
+  "\250\222\212I%Y\305Vl\305J%\5O\37\36\273\360\361k\134\303\64F\314(#9T\215\62Lc\304\214b\215b"
+  "\215\222\314(\3OP\36\273\360\361c\246b\306i\214Xc\231a\212C\247\230a\212\31\352\14\63\312\60"
+  "\215\21OU\34\273\360\361\63k\14\231qT#u\246\234b\312i\244\234b\312\31\327\270\206\12Os\37"
+  "\273\360\361k\234\206\316(\303\214\62Rc\250\214\62\314(\3038tF\31f\224a\32#Q\233\32\272\361q"
+  "\36\232\314(\343\61\64\312d\15\307\3208\243qd\230\351\214\0Q\254\32\273\360\361\63kh\250\63"
+  "\212)\323\231Tz\306\215\63\245\231\231\231\21\0Q\257\34\273\360q\362\320\31\67\63L1\243X\243"
+  "8\206&S\32\253&S&3\251\0R\30\35\273\360q3\225\63\36C\325\260\212\255\254SF9\345\24S\314UF"
+  "\225&\23\0SZ\33\273\360\361\62\212\325\30*\243\214\216Y\305r\314*\306q\244\230\2339C\11T4\34"
+  "\273\360q\307\310(\303\214\62\314h\214\314=\206\306\31\216C\243\232\312y\303\1Th\32\273\360q"
+  "\307\231\313\64T\314\34583\25\323P1\345T\16U\223\232\24U\20\37\273\360\361aff8\216\224Q\214"
+  "\343H\31\305j\214\230Q\206i\214\230\62Lq\214\4V\11\34\273\360\361a\206\343\320\60\343qg\230"
+  "\321\30\31\346<\16\231\312VLQ\215\4V\375\30\272\361q\36\232Tc\351\214tFj,\235\242\216i\274"
+  "\311q\10Z\34\36\273\360\361\322H+\246j\254J\245\225TK\245\241\222\352\63\265T\265\312\24\253"
+  "\30\1Zw\36\273\360\361\62\314(\216C\345T\16U\223)\215\241j\230\344\320\32\345\230\312\214\63"
+  "\0[Y\33\273\360qF\316\270\206\31eX\325\252\65S\254b+\266Q\206\31\345\271\1[\207\32\273\360"
+  "\361a\306\343H\231\224c\223\231\225\34182\316\254L\246Lg\10[\213\33\273\360\361a\306\343H"
+  "\231\324(g\234\34184\332T\33\66u\326\60C\0\134\17\33\273\360\361afeV\246b\215b\216\271\314"
+  "\31i\224Q\206\231L\231\316\4\134q\26\271\361\361Q&3\312Yg\235u\326Yg\235\307\241\251\0\134"
+  "\360\35\273\360qs\306y\254\64SS\246f\252\306PeNc(\15\63\65F\246\62\0^\372\34\273\360\361qF"
+  "\307.\253q\350\230\323Xu\206j\214\230\63L1\243<F\0_ \31\273\360qf.sY\336\31e\30\307!S\206U"
+  "\206]Q\326\31\5_:\33\273\360q\346\320\61\227Cm\224\363\30:\306\221bk\354\214b\215\306\34\61_"
+  "m\36\273\360\361\63\36Cf\224Q\36*f:\16\231\253\214\206F1e\224\223\214#j\0_\220\35\273\360q3"
+  "\312(\243\262\312U\206I\16U\243\14\323\30\61\243\14\253:\305\266\6_\327\31\273\360\361afe8"
+  "\16\15\63+\343q\343Lv\305\324\215\222\36\22`\246\32\273\360q\353VF\231Lj\250J\247\62\227CW"
+  "\31\345T\266b\312\3eO\36\273\360\361\62\314h\250\234\361Hc\244\230\272\306P1u\246\256\61R"
+  "\246\332H\345\0f\16\32\273\360\361\3618\263\254e\34g\226\265\214\343\314\31f\224QNQ\303\4fS"
+  "\33\273\360\361qF#\2169R\254\343Pj\304L\305\361L\261U\303*\353\1fh\36\273\360q\307\310(\303"
+  "\214\306\310(\303<\216\224Yi\214\230Y\343He\212Q.\0f\371\35\273\360\361Q\314\343P\261\212"
+  "\343l\305qg\230\321\30\31e\230\321\30\31e\30\1f\376\30\271\361q\353q\310\270Z\343\310\254\61"
+  "b\206q\214\230a\34#\1g(\31\273\360\361afeV\206\343\320\60\323\233j\303\246\316\32\346\214\63"
+  "\4g,\31\273\360\361afe8\16\215\66\325\306\251\206\355V\34\62\303\314\312\20g1\32\273\360qk*f"
+  "j\14\231\63+\303qh\264\251\66l\352\254a\206\0gN\31\273\360\361a\206\343\320\251\206M\235\365"
+  "\320t\246\63\34\207\206\231\326\20gh\34\273\360q\343\320\31\306!3\314\31\256\261TK\345\224T"
+  "\254b\212\355\262T\0gp\30\273\360\361afe8\16\235j\330ne\224Qf\247\330S\307\2g\227\36\273\360"
+  "q3\312\60\243<\16\231QF;#\225f\212\251g\33e\230Q\206\31e\0h\201\33\273\360\361\322\230)\247"
+  "\34S\322\251\265\312TF\235j8\16\235j\330\324Yh\205\32\273\360qk*\216C\223q\310\325Tc\250\230"
+  ":S\35\307\314\270F\22k#\35\273\360\361Q\15g\206\31\15\65v\352\231rFuFe\312)\246X\345\24\65"
+  "\14m\13\35\273\360\361rW\314c\244\14\63\256a\34:\243\254aFq\214\224aF\31f\0mi\34\273\360\361"
+  "r\312\260\312\31\15\231d\306\65Lc\304L\352!s\231\313<\24\0m\233\37\273\360\361\62\3128\215"
+  "\241a\206i\214\214b\306i\214X'=VL\261\312)f\34\1q6\33\273\360qs\306UF\2629\206\222\31\246\66"
+  "\254\62\2129\326P\225U\216\5s\213\31\273\360\361\306\215\63+\263\62+Scd*\263\62+\263\62\34"
+  "\207\0t3\36\273\360\361a9R\314(\215\21\233#\305\214\322\322*\251\30U\251b\324\61S1\2u0\23"
+  "\251\361q\369\353\254\3638t\326Y\347qh*x\312\33\273\360q\36\32ezl\244QTcs\15\65T\206y\250"
+  "\241bk\304\21\177W\30\272\361q\36\262\224\3458t\246\307\316(\247\230)Mi\270)\0\200\341\36"
+  "\273\360\361\343\320\61\217\241\313\241cN#\345\24\323P1\345\64RNQ\243\214\362\0\202\263\33"
+  "\272\361\361c\36G\216\231\314h\349\323c\243\214\62\312(g\230\64\222\0\205\344\32\273\360\361"
+  "\353q\350\324\32\61\3058\236\31\305\361\352Tj\246$\323L\2\214\42\36\273\360qrF1\215\230Q\254"
+  "\324\30\252l\15\25SL2\215\30UY\305:*\5\215u\35\273\360\361\63+\226C\325(\2438F\312\60\243"
+  "\234V\231r\212\263\212\32g4\6\215\205\35\273\360\361\323\320(\2478T\215bRc\223q\304\64b\25"
+  "\313#E\215\63\32\3\217\334\34\273\360\361\362\320\231\225\331\343\310)\243\234\62\312\251l"
+  "\305\224\221\252\251<F\0\220\321\33\273\360\361r\246\312\221\206\212\271\312(\313\261j\224c"
+  "\25\273T\235\3328\3\220\355\32\273\360\361\63\65\16\225SLC\325\244\36\252\206\355!\207\2169o"
+  "\235\1\224\303\35\273\360\361\62\314(C=RL\31\225cg\224\311\241\206\314\270j#\235a\206\21\226"
+  "H\35\273\360qF\314(\216+f\250SNi\14\231\313\224\344H}F\231J\15\63\2\226\352\31\273\360\361"
+  "\306\215\63\34o\224\221\225Tf\217\233\225\307\320\2548.\0\227Y\35\273\360q3\312c\355*\217\64"
+  "rF\3258T\254\242J#&\231Q\254Q\262\1\227\351\33\273\360q3\312\343\220\31\345q\244\34\363\2209"
+  "\217g\33\305\61\223\314(\3\230\226\35\273\360qb\34C\303:\215#\345\214ZC\246\62\247\64\206*e"
+  "\252TLM\35\232l\32\273\360\361\306\320\254\14\63\312\60g\230Q\206\343fe\32683+\223\12\232"
+  "\330\34\273\360\361a\206\343\320\234C\343\32\215\63S1\15\25SN1\15\25\63V\0\236\304\34\273"
+  "\360\361k4n\224\36384\314\324\30\31\305\32\215\221Q\254\321\30YC\5\237\231\34\273\360\361Q"
+  "\314T\3168\343qhT\223)f\24S\206Q\303\134eS\216\0\0";
+
+static const uint16_t oled_font_names_index_encoding[86] = {
+    0x304B, 0x304F, 0x3055, 0x3072, 0x3089, 0x308A, 0x30A2, 0x30AD, 0x30B1, 0x30E9, 0x30F3, 0x4E2D,
+    0x4E3D, 0x4F1F, 0x4F50, 0x4F55, 0x4F73, 0x519B, 0x51AC, 0x51AF, 0x5218, 0x535A, 0x5434, 0x5468,
+    0x5510, 0x5609, 0x56FD, 0x5A1C, 0x5A77, 0x5B59, 0x5B87, 0x5B8B, 0x5C0F, 0x5C71, 0x5CF0, 0x5EFA,
+    0x5F20, 0x5F3A, 0x5F6D, 0x5F90, 0x5FD7, 0x60A6, 0x654F, 0x660E, 0x6653, 0x6668, 0x66F9, 0x66FE,
+    0x6728, 0x672C, 0x6731, 0x674E, 0x6768, 0x6770, 0x6797, 0x6881, 0x6885, 0x6B23, 0x6D0B, 0x6D69,
+    0x6D9B, 0x7136, 0x738B, 0x7433, 0x7530, 0x78CA, 0x7F57, 0x80E1, 0x82B3, 0x85E4, 0x8C22, 0x8D75,
+    0x8D85, 0x8FDC, 0x90D1, 0x90ED, 0x94C3, 0x9648, 0x96EA, 0x9759, 0x97E9, 0x9896, 0x9A6C, 0x9AD8,
+    0x9EC4, 0x9F99,
+};
+static const uint32_t oled_font_names_index_offset[86] = {
+    1156, 1180, 1195, 1215, 1241, 1262, 1284, 1306, 1329, 1354,
+    1377, 1397, 1420, 1447, 1477, 1507, 1535, 1566, 1592, 1618,
+    1646, 1675, 1702, 1730, 1756, 1787, 1815, 1839, 1869, 1899,
+    1926, 1952, 1979, 2006, 2028, 2057, 2085, 2110, 2137, 2167,
+    2196, 2221, 2247, 2277, 2303, 2330, 2360, 2389, 2413, 2438,
+    2463, 2489, 2514, 2542, 2566, 2596, 2623, 2649, 2678, 2707,
+    2735, 2766, 2793, 2818, 2848, 2867, 2894, 2918, 2948, 2975,
+    3001, 3031, 3060, 3089, 3117, 3144, 3170, 3199, 3228, 3253,
+    3282, 3309, 3338, 3364, 3392, 3420,
+};
+const u8g2_font_index_t oled_font_names_index = {oled_font_names, oled_font_names_index_encoding, oled_font_names_index_offset, 86};
@@ -0,0 +1,26 @@
+/**
+ * @file oled_font_names.h
+ * @author Ted Wang
+ * @brief u8g2_font_wqy12_t_gb2312 reduced to the characters of names.txt, with its sorted glyph index.
+ *
+ * Generated by Tools/oled_font/fontsubset.py --font u8g2_font_wqy12_t_gb2312 --names names.txt --ascii
+ * Select with u8g2_SetFont() and u8g2_SetFontIndex(); do not edit, regenerate instead.
+ */
+
+#ifndef OLED_FONT_NAMES_H
+#define OLED_FONT_NAMES_H
+
+#include "u8g2.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern const uint8_t oled_font_names[3450] U8G2_FONT_SECTION("oled_font_names");    /**< 181 glyphs */
+extern const u8g2_font_index_t oled_font_names_index;    /**< 86 unicode glyphs */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // OLED_FONT_NAMES_H
@@ -0,0 +1,106 @@
+/**
+ * @file bench_util.h
+ * @author Ted Wang
+ * @date 2026-10-17
+ * @brief Timing and check reporting shared by the host benchmarks in Tools/oled_host (Linux).
+ *
+ * Header only, so every tool still builds with a single gcc line. The tools check the firmware
+ * code against a reference first and then time it; the check output has the same form in all of
+ * them:
+ * @code
+ *   check line      5012 shapes, 0 failed          (one line per group, bench_check_group())
+ *   failed: fixed: expected "-1.5", got "-1.05"    (one line per mismatch, bench_check_fail())
+ *   check: ok (20000 random shapes)                (summary, bench_check_summary())
+ * @endcode
+ * and the exit code of a tool is 1 if any check fails. Times are best of several runs on the host
+ * CPU, only meaningful relative to each other.
+ */
+
+#ifndef BENCH_UTIL_H
+#define BENCH_UTIL_H
+
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Start value of a best-of-runs minimum. */
+#define BENCH_NO_TIME       1e30
+
+/**
+ * @brief Monotonic time in nanoseconds.
+ */
+static inline uint64_t bench_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Nanoseconds per operation since t0 (from bench_now_ns()) for count operations.
+ */
+static inline double bench_ns_per(uint64_t t0, uint32_t count)
+{
+    return (double)(bench_now_ns() - t0) / count;
+}
+
+/**
+ * @brief Keeps the best (smallest) time of several runs: best = bench_min(best, ns).
+ */
+static inline double bench_min(double best, double ns)
+{
+    return (ns < best) ? ns : best;
+}
+
+/**
+ * @brief Prints the result of one check group.
+ * @return 1 if the group has failures.
+ */
+static inline int bench_check_group(const char *name, unsigned count, const char *unit, unsigned failed)
+{
+    printf("check %-8s %5u %s, %u failed\n", name, count, unit, failed);
+    return failed != 0;
+}
+
+/**
+ * @brief Prints one failed check (printf format, no line break).
+ * @return 1, to be added to the failure count.
+ */
+static inline int bench_check_fail(const char *fmt, ...)
+{
+    va_list args;
+
+    printf("failed: ");
+    va_start(args, fmt);
+    vprintf(fmt, args);
+    va_end(args);
+    printf("\n");
+    return 1;
+}
+
+/**
+ * @brief Prints the check summary, "ok" or "FAILED" with what was checked (printf format).
+ * @return The exit code of the tool: 1 if failures is not zero.
+ */
+static inline int bench_check_summary(int failures, const char *fmt, ...)
+{
+    va_list args;
+
+    printf("check: %s (", (failures == 0) ? "ok" : "FAILED");
+    va_start(args, fmt);
+    vprintf(fmt, args);
+    va_end(args);
+    printf(")\n");
+    return failures != 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BENCH_UTIL_H
@@ -0,0 +1,262 @@
+/**
+ * @file bus_bench.c
+ * @author Ted Wang
+ * @date 2026-10-17
+ * @brief Host simulation of two SH1106 panels sharing one 400 kHz I2C bus (Hardware/oled/oled_bus.c).
+ *
+ * The transfers of one full frame are captured from u8g2 (u8g2_SendBuffer() of a SH1106 128x64 with
+ * the u8x8 fast I2C command sequence). Each display is then driven by a simulated task that renders
+ * for a fixed time and commits its transfers into a OLED_BUS_QUEUE_SLOTS deep queue, blocking while
+ * the queue is full and ending the frame after its last transfer, like u8x8_byte_stm32_i2c() with
+ * OLED_I2C_USE_DMA. The bus sends one transfer at a time in the order chosen by OLED_Bus_Next(); a
+ * transfer of n bytes takes (n + 1 address byte) * 9 bit times plus a fixed DMA/interrupt overhead.
+ *
+ * Reported per display and scenario: frames per second, average and worst frame latency (render
+ * start to the completion of the frame's last transfer), transfers that missed their latency target,
+ * and the number of display switches on the bus.
+ *
+ * Build (from the repository root):
+ * @code
+ *   gcc -O2 -IHardware/u8g2 -IHardware/oled \
+ *       Tools/oled_host/bus_bench.c Hardware/oled/oled_bus.c Hardware/u8g2/u8*.c -o bus_bench
+ * @endcode
+ * Usage: bus_bench [-r render_us] [-k bus_khz] [-t seconds]
+ */
+
+#include "u8g2.h"
+#include "oled_bus.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define BENCH_MAX_TRANSFERS     128
+#define BENCH_DISPLAYS          2
+#define BENCH_OVERHEAD_US       15
+
+/**
+ * @brief Captured transfers of one full frame.
+ */
+typedef struct {
+    uint8_t len[BENCH_MAX_TRANSFERS];
+    uint16_t count;
+    uint32_t bytes;
+} bench_frame_t;
+
+/**
+ * @brief Simulated display task.
+ */
+typedef struct {
+    const char *name;
+    uint8_t priority;
+    uint32_t latency_ms;
+    uint32_t period_us;             /* 0 = render the next frame as soon as the last one is queued */
+    OLED_BusQueue_t queue;          /* set up by bench_run() */
+    uint32_t render_until;          /* end of the current render, 0 = not rendering */
+    uint32_t next_start;            /* earliest start of the next render */
+    uint16_t next_transfer;         /* next transfer of the frame to commit */
+    uint8_t sending;                /* 1 while committing the frame's transfers */
+    uint32_t frame_start[4];        /* render start of frames not completed yet */
+    uint32_t started;
+    uint32_t completed;
+    uint64_t latency_sum;
+    uint32_t latency_max;
+} bench_display_t;
+
+static u8g2_t bench_u8g2;
+static uint8_t bench_buffer[1024];
+static bench_frame_t bench_frame;
+
+static uint8_t bench_capture_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+    switch (msg)
+    {
+        case U8X8_MSG_BYTE_SEND:
+            bench_frame.len[bench_frame.count] = (uint8_t)(bench_frame.len[bench_frame.count] + arg_int);
+            bench_frame.bytes += arg_int;
+            break;
+        case U8X8_MSG_BYTE_START_TRANSFER:
+            bench_frame.len[bench_frame.count] = 0;
+            break;
+        case U8X8_MSG_BYTE_END_TRANSFER:
+            if (bench_frame.count < BENCH_MAX_TRANSFERS - 1)
+            {
+                bench_frame.count++;
+            }
+            break;
+        default:
+            break;
+    }
+    return 1;
+}
+
+static uint8_t bench_gpio_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+    return 1;
+}
+
+/**
+ * @brief Captures the transfer sizes of one u8g2_SendBuffer() (the same for every frame content).
+ */
+static void bench_capture_frame(void)
+{
+    u8g2_SetupDisplay(&bench_u8g2, u8x8_d_sh1106_128x64_noname, u8x8_cad_ssd13xx_fast_i2c, bench_capture_cb, bench_gpio_cb);
+    u8g2_SetupBuffer(&bench_u8g2, bench_buffer, 8, u8g2_ll_hvline_vertical_top_lsb, U8G2_R0);
+    u8g2_InitDisplay(&bench_u8g2);
+    u8g2_ClearBuffer(&bench_u8g2);
+    u8g2_SetFont(&bench_u8g2, u8g2_font_ncenB08_tr);
+    u8g2_DrawStr(&bench_u8g2, 0, 12, "Access granted");
+    memset(&bench_frame, 0, sizeof(bench_frame));
+    u8g2_SendBuffer(&bench_u8g2);
+}
+
+static uint32_t bench_transfer_us(uint8_t len, uint32_t khz)
+{
+    return (uint32_t)((len + 1u) * 9u * 1000u / khz) + BENCH_OVERHEAD_US;
+}
+
+/**
+ * @brief Runs one scenario for duration_us with one or two displays.
+ */
+static void bench_run(const char *title, bench_display_t *displays, uint8_t count,
+                      uint32_t render_us, uint32_t khz, uint32_t duration_us)
+{
+    OLED_Bus_t bus;
+    uint32_t busy_until = 0;
+    uint32_t bus_busy_us = 0;
+
+    OLED_Bus_Init(&bus);
+    for (uint8_t i = 0; i < count; i++)
+    {
+        bench_display_t *d = &displays[i];
+        OLED_Bus_AddQueue(&bus, &d->queue, d->priority, d->latency_ms, d);
+        d->render_until = 0;
+        d->next_start = 0;
+        d->sending = 0;
+        d->started = 0;
+        d->completed = 0;
+        d->latency_sum = 0;
+        d->latency_max = 0;
+    }
+
+    for (uint32_t t = 0; t < duration_us; t++)
+    {
+        if (bus.active != NULL && t >= busy_until)
+        {
+            bench_display_t *d = (bench_display_t *)OLED_Bus_Complete(&bus, t / 1000u)->context;
+            if (d->queue.transfers % bench_frame.count == 0)
+            {
+                uint32_t latency = t - d->frame_start[d->completed % 4];
+                d->latency_sum += latency;
+                if (latency > d->latency_max)
+                {
+                    d->latency_max = latency;
+                }
+                d->completed++;
+            }
+        }
+        for (uint8_t i = 0; i < count; i++)
+        {
+            bench_display_t *d = &displays[i];
+
+            if (!d->sending && d->render_until == 0 && t >= d->next_start && d->started - d->completed < 2)
+            {
+                d->frame_start[d->started % 4] = t;
+                d->started++;
+                d->render_until = t + render_us;
+                d->next_start = t + d->period_us;
+            }
+            if (d->render_until != 0 && t >= d->render_until)
+            {
+                d->render_until = 0;
+                d->sending = 1;
+                d->next_transfer = 0;
+            }
+            while (d->sending && d->queue.count < OLED_BUS_QUEUE_SLOTS)
+            {
+                OLED_BusSlot_t *slot = OLED_Bus_Reserve(&d->queue);
+                slot->len = bench_frame.len[d->next_transfer];
+                OLED_Bus_Commit(&bus, &d->queue, t / 1000u);
+                if (++d->next_transfer == bench_frame.count)
+                {
+                    OLED_Bus_EndFrame(&d->queue);
+                    d->sending = 0;
+                }
+            }
+        }
+        if (bus.active == NULL)
+        {
+            OLED_BusSlot_t *slot = OLED_Bus_Next(&bus, t / 1000u);
+            if (slot != NULL)
+            {
+                uint32_t us = bench_transfer_us(slot->len, khz);
+                busy_until = t + us;
+                bus_busy_us += us;
+            }
+        }
+    }
+
+    printf("\n%s\n", title);
+    printf("  %-8s %4s %7s %8s %10s %10s %10s\n", "display", "prio", "target", "fps", "avg ms", "max ms", "late");
+    for (uint8_t i = 0; i < count; i++)
+    {
+        bench_display_t *d = &displays[i];
+        printf("  %-8s %4u %5lums %8.1f %10.1f %10.1f %6lu/%lu\n", d->name, d->priority,
+               (unsigned long)d->latency_ms, d->completed * 1e6 / duration_us,
+               d->completed ? d->latency_sum / 1000.0 / d->completed : 0.0, d->latency_max / 1000.0,
+               (unsigned long)d->queue.late, (unsigned long)d->queue.transfers);
+    }
+    printf("  bus busy %.0f%%, display switches %lu\n", 100.0 * bus_busy_us / duration_us, (unsigned long)bus.switches);
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t render_us = 3000;
+    uint32_t khz = 400;
+    uint32_t seconds = 10;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "r:k:t:")) != -1)
+    {
+        switch (opt)
+        {
+            case 'r': render_us = (uint32_t)atoi(optarg); break;
+            case 'k': khz = (uint32_t)atoi(optarg); break;
+            case 't': seconds = (uint32_t)atoi(optarg); break;
+            default:
+                fprintf(stderr, "usage: %s [-r render_us] [-k bus_khz] [-t seconds]\n", argv[0]);
+                return 2;
+        }
+    }
+    bench_capture_frame();
+    printf("full frame: %u transfers, %lu bytes, %.1f ms on a %lu kHz bus; render %lu us\n",
+           bench_frame.count, (unsigned long)bench_frame.bytes,
+           bench_frame.count * BENCH_OVERHEAD_US / 1000.0 + (bench_frame.bytes + bench_frame.count) * 9.0 / khz,
+           (unsigned long)khz, (unsigned long)render_us);
+
+    {
+        bench_display_t d[1] = {{.name = "inside", .priority = 1, .latency_ms = 30, .period_us = 0}};
+        bench_run("inside alone, flat out", d, 1, render_us, khz, seconds * 1000000u);
+    }
+    {
+        bench_display_t d[2] = {{.name = "inside", .priority = 1, .latency_ms = 30, .period_us = 0},
+                                {.name = "outside", .priority = 1, .latency_ms = 30, .period_us = 0}};
+        bench_run("both flat out, equal priority and target", d, 2, render_us, khz, seconds * 1000000u);
+    }
+    {
+        bench_display_t d[2] = {{.name = "inside", .priority = 1, .latency_ms = 30, .period_us = 0},
+                                {.name = "outside", .priority = 0, .latency_ms = 100, .period_us = 0}};
+        bench_run("both flat out, inside first (driver defaults)", d, 2, render_us, khz, seconds * 1000000u);
+    }
+    {
+        bench_display_t d[2] = {{.name = "inside", .priority = 1, .latency_ms = 30, .period_us = 0},
+                                {.name = "outside", .priority = 0, .latency_ms = 100, .period_us = 200000}};
+        bench_run("inside flat out, outside at 5 frames/s", d, 2, render_us, khz, seconds * 1000000u);
+    }
+    {
+        bench_display_t d[2] = {{.name = "inside", .priority = 1, .latency_ms = 30, .period_us = 100000},
+                                {.name = "outside", .priority = 0, .latency_ms = 100, .period_us = 200000}};
+        bench_run("status page rates: inside 10 frames/s, outside 5 frames/s", d, 2, render_us, khz, seconds * 1000000u);
+    }
+    return 0;
+}
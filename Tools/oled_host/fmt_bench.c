@@ -0,0 +1,329 @@
+/**
+ * @file fmt_bench.c
+ * @author Ted Wang
+ * @date 2026-10-17
+ * @brief Host check and benchmark of the formatting module (Core/Src/fmt.c) against snprintf().
+ *
+ * Check: random values through every spec used by the firmware (%u, %02u, %02X, %04X, %08X, %d with
+ * and without width, fixed point, hex byte strings, truncation at every buffer size) must produce
+ * exactly the snprintf() output.
+ *
+ * Benchmark: the strings the tasks format on their hot paths, in ns per call:
+ *   - uid:    "Tag/Card: %02X%02X%02X%02X" (status screen, every reading)
+ *   - clock:  "%02lu:%02lu:%02lu" (dashboard uptime, every tick)
+ *   - debug:  "MFRC522_Anticoll status: %d, UID: %02X%02X%02X%02X, UID_len: %d\r\n" (RC522 task)
+ *   - report: "OLED fps in %lu.%lu out %lu.%lu, ..." (bus report)
+ *
+ * Stack: each formatter runs once on a thread whose stack is filled with a pattern; the bytes of
+ * the pattern that were overwritten give the peak stack use of the call. The host C library is not
+ * the one linked on the target (ARM C library / microlib), but both printf engines walk a format
+ * string and varargs with a conversion buffer, so the ratio is indicative; the fmt.c figures
+ * carry over directly (compare with gcc -fstack-usage on the target build).
+ *
+ * Build (from the repository root):
+ * @code
+ *   gcc -O2 -ICore/Inc Tools/oled_host/fmt_bench.c Core/Src/fmt.c -lpthread -o fmt_bench
+ * @endcode
+ */
+
+#include "bench_util.h"
+#include "fmt.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_CHECKS        200000
+#define BENCH_CALLS         200000
+#define BENCH_RUNS          5
+#define BENCH_STACK_BYTES   (64 * 1024)
+#define BENCH_STACK_FILL    0xA5
+
+static const uint8_t bench_uid[4] = {0xDE, 0xAD, 0x0B, 0x7F};
+static volatile uint32_t bench_sink;
+static char bench_out[96];
+
+/* ---- hot path strings, snprintf and fmt versions ---- */
+
+static void uid_printf(void)
+{
+    snprintf(bench_out, sizeof(bench_out), "Tag/Card: %02X%02X%02X%02X", bench_uid[0], bench_uid[1], bench_uid[2], bench_uid[3]);
+}
+
+static void uid_fmt(void)
+{
+    Fmt_t f;
+    Fmt_Init(&f, bench_out, sizeof(bench_out));
+    Fmt_Str(&f, "Tag/Card: ");
+    Fmt_HexBytes(&f, bench_uid, 4);
+}
+
+static void clock_printf(void)
+{
+    uint32_t s = 45296 + bench_sink;
+    snprintf(bench_out, sizeof(bench_out), "%02lu:%02lu:%02lu", (unsigned long)((s / 3600u) % 100u), (unsigned long)((s / 60u) % 60u), (unsigned long)(s % 60u));
+}
+
+static void clock_fmt(void)
+{
+    uint32_t s = 45296 + bench_sink;
+    Fmt_t f;
+    Fmt_Init(&f, bench_out, sizeof(bench_out));
+    Fmt_Uint(&f, (s / 3600u) % 100u, FMT_D2);
+    Fmt_Char(&f, ':');
+    Fmt_Uint(&f, (s / 60u) % 60u, FMT_D2);
+    Fmt_Char(&f, ':');
+    Fmt_Uint(&f, s % 60u, FMT_D2);
+}
+
+static void debug_printf(void)
+{
+    snprintf(bench_out, sizeof(bench_out), "MFRC522_Anticoll status: %d, UID: %02X%02X%02X%02X, UID_len: %d\r\n",
+             (int)bench_sink, bench_uid[0], bench_uid[1], bench_uid[2], bench_uid[3], 4);
+}
+
+static void debug_fmt(void)
+{
+    Fmt_t f;
+    Fmt_Init(&f, bench_out, sizeof(bench_out));
+    Fmt_Str(&f, "MFRC522_Anticoll status: ");
+    Fmt_Int(&f, (int32_t)bench_sink, FMT_D);
+    Fmt_Str(&f, ", UID: ");
+    Fmt_HexBytes(&f, bench_uid, 4);
+    Fmt_Str(&f, ", UID_len: ");
+    Fmt_Int(&f, 4, FMT_D);
+    Fmt_Str(&f, "\r\n");
+}
+
+static void report_printf(void)
+{
+    uint32_t in10 = 284 + bench_sink;
+    uint32_t out10 = 78;
+    snprintf(bench_out, sizeof(bench_out), "OLED fps in %lu.%lu out %lu.%lu, late %lu/%lu, switches %lu\r\n",
+             (unsigned long)(in10 / 10), (unsigned long)(in10 % 10), (unsigned long)(out10 / 10), (unsigned long)(out10 % 10),
+             (unsigned long)3, (unsigned long)0, (unsigned long)123456);
+}
+
+static void report_fmt(void)
+{
+    uint32_t in10 = 284 + bench_sink;
+    uint32_t out10 = 78;
+    Fmt_t f;
+    Fmt_Init(&f, bench_out, sizeof(bench_out));
+    Fmt_Str(&f, "OLED fps in ");
+    Fmt_Fixed(&f, (int32_t)in10, 1);
+    Fmt_Str(&f, " out ");
+    Fmt_Fixed(&f, (int32_t)out10, 1);
+    Fmt_Str(&f, ", late ");
+    Fmt_Uint(&f, 3, FMT_D);
+    Fmt_Char(&f, '/');
+    Fmt_Uint(&f, 0, FMT_D);
+    Fmt_Str(&f, ", switches ");
+    Fmt_Uint(&f, 123456, FMT_D);
+    Fmt_Str(&f, "\r\n");
+}
+
+typedef struct {
+    const char *name;
+    void (*printf_fn)(void);
+    void (*fmt_fn)(void);
+} bench_case_t;
+
+static const bench_case_t bench_cases[] = {
+    {"uid", uid_printf, uid_fmt},
+    {"clock", clock_printf, clock_fmt},
+    {"debug", debug_printf, debug_fmt},
+    {"report", report_printf, report_fmt},
+};
+
+/* ---- checks ---- */
+
+static uint32_t bench_rand_state = 12345;
+
+static uint32_t bench_rand(void)
+{
+    bench_rand_state = bench_rand_state * 1103515245u + 12345u;
+    return (bench_rand_state >> 1) ^ (bench_rand_state << 17);
+}
+
+static uint32_t bench_value(void)
+{
+    /* Mix of small, medium and full range values */
+    switch (bench_rand() % 4)
+    {
+        case 0: return bench_rand() % 10;
+        case 1: return bench_rand() % 1000;
+        case 2: return bench_rand() % 100000;
+        default: return bench_rand();
+    }
+}
+
+static int bench_compare(const char *what, const char *expected, const Fmt_t *f)
+{
+    size_t expected_len = strlen(expected);
+
+    if (strcmp(expected, f->buf) != 0 || f->len != expected_len)
+    {
+        return bench_check_fail("%s: expected \"%s\", got \"%s\" (len %u)", what, expected, f->buf, f->len);
+    }
+    return 0;
+}
+
+static int bench_check(void)
+{
+    static const struct { uint16_t spec; const char *fmt; } uspecs[] = {
+        {FMT_D, "%lu"}, {FMT_D2, "%02lu"}, {FMT_X2, "%02lX"}, {FMT_X4, "%04lX"}, {FMT_X8, "%08lX"},
+        {FMT_HEX, "%lX"}, {FMT_WIDTH(6), "%6lu"}, {FMT_ZERO | FMT_WIDTH(12), "%012lu"}, {FMT_HEX | FMT_WIDTH(5), "%5lX"},
+    };
+    static const struct { uint16_t spec; const char *fmt; } ispecs[] = {
+        {FMT_D, "%ld"}, {FMT_WIDTH(6), "%6ld"}, {FMT_ZERO | FMT_WIDTH(6), "%06ld"},
+    };
+    char expected[64];
+    char out[64];
+    Fmt_t f;
+    int failures = 0;
+
+    for (int i = 0; i < BENCH_CHECKS && failures < 10; i++)
+    {
+        uint32_t v = bench_value();
+        int32_t sv = (int32_t)((bench_rand() & 1) ? v : (uint32_t)0 - v);
+        uint8_t decimals = (uint8_t)(bench_rand() % 4);
+        uint8_t bytes[8];
+        size_t size;
+
+        for (size_t k = 0; k < sizeof(uspecs) / sizeof(uspecs[0]); k++)
+        {
+            snprintf(expected, sizeof(expected), uspecs[k].fmt, (unsigned long)v);
+            Fmt_Init(&f, out, sizeof(out));
+            Fmt_Uint(&f, v, uspecs[k].spec);
+            failures += bench_compare(uspecs[k].fmt, expected, &f);
+        }
+        for (size_t k = 0; k < sizeof(ispecs) / sizeof(ispecs[0]); k++)
+        {
+            snprintf(expected, sizeof(expected), ispecs[k].fmt, (long)sv);
+            Fmt_Init(&f, out, sizeof(out));
+            Fmt_Int(&f, sv, ispecs[k].spec);
+            failures += bench_compare(ispecs[k].fmt, expected, &f);
+        }
+        {
+            uint32_t scale = (decimals == 0) ? 1 : (decimals == 1) ? 10 : (decimals == 2) ? 100 : 1000;
+            uint32_t mag = (sv < 0) ? (uint32_t)0 - (uint32_t)sv : (uint32_t)sv;
+            if (decimals == 0)
+            {
+                snprintf(expected, sizeof(expected), "%s%lu", sv < 0 ? "-" : "", (unsigned long)mag);
+            }
+            else
+            {
+                snprintf(expected, sizeof(expected), "%s%lu.%0*lu", sv < 0 ? "-" : "", (unsigned long)(mag / scale), decimals, (unsigned long)(mag % scale));
+            }
+            Fmt_Init(&f, out, sizeof(out));
+            Fmt_Fixed(&f, sv, decimals);
+            failures += bench_compare("fixed", expected, &f);
+        }
+        for (size_t k = 0; k < sizeof(bytes); k++)
+        {
+            bytes[k] = (uint8_t)bench_rand();
+        }
+        snprintf(expected, sizeof(expected), "%02X%02X%02X%02X%02X%02X%02X%02X",
+                 bytes[0], bytes[1], bytes[2], bytes[3], bytes[4], bytes[5], bytes[6], bytes[7]);
+        Fmt_Init(&f, out, sizeof(out));
+        Fmt_HexBytes(&f, bytes, 8);
+        failures += bench_compare("hexbytes", expected, &f);
+
+        /* Truncation: every buffer size cuts the same prefix as snprintf */
+        size = 1 + bench_rand() % 24;
+        snprintf(expected, size, "id %lu: %02X%02X ok", (unsigned long)v, bytes[0], bytes[1]);
+        Fmt_Init(&f, out, size);
+        Fmt_Str(&f, "id ");
+        Fmt_Uint(&f, v, FMT_D);
+        Fmt_Str(&f, ": ");
+        Fmt_HexBytes(&f, bytes, 2);
+        Fmt_Str(&f, " ok");
+        failures += bench_compare("truncated", expected, &f);
+        {
+            char full[64];
+            int n = snprintf(full, sizeof(full), "id %lu: %02X%02X ok", (unsigned long)v, bytes[0], bytes[1]);
+            if (f.truncated != (uint8_t)((size_t)n >= size))
+            {
+                failures += bench_check_fail("truncated flag: size %zu, length %d, flag %u", size, n, f.truncated);
+            }
+        }
+    }
+    return bench_check_summary(failures, "%d random values through every spec", BENCH_CHECKS);
+}
+
+/* ---- timing and stack ---- */
+
+static double bench_ns(void (*fn)(void))
+{
+    double best = BENCH_NO_TIME;
+
+    for (int run = 0; run < BENCH_RUNS; run++)
+    {
+        uint64_t t0 = bench_now_ns();
+        for (int i = 0; i < BENCH_CALLS; i++)
+        {
+            bench_sink = (uint32_t)i & 7u;
+            fn();
+        }
+        best = bench_min(best, bench_ns_per(t0, BENCH_CALLS));
+    }
+    return best;
+}
+
+static void bench_nothing(void)
+{
+}
+
+static void *bench_thread(void *arg)
+{
+    ((void (*)(void))arg)();
+    return NULL;
+}
+
+/**
+ * @brief Peak stack use of fn in bytes, measured on a freshly painted thread stack.
+ */
+static size_t bench_stack(void (*fn)(void))
+{
+    static unsigned char stack[BENCH_STACK_BYTES] __attribute__((aligned(64)));
+    size_t base;
+    size_t used;
+    pthread_attr_t attr;
+    pthread_t thread;
+
+    /* Baseline: the thread start-up alone */
+    memset(stack, BENCH_STACK_FILL, sizeof(stack));
+    pthread_attr_init(&attr);
+    pthread_attr_setstack(&attr, stack, sizeof(stack));
+    pthread_create(&thread, &attr, bench_thread, (void *)bench_nothing);
+    pthread_join(thread, NULL);
+    for (base = 0; base < sizeof(stack) && stack[base] == BENCH_STACK_FILL; base++)
+    {
+    }
+
+    memset(stack, BENCH_STACK_FILL, sizeof(stack));
+    pthread_create(&thread, &attr, bench_thread, (void *)fn);
+    pthread_join(thread, NULL);
+    pthread_attr_destroy(&attr);
+    for (used = 0; used < sizeof(stack) && stack[used] == BENCH_STACK_FILL; used++)
+    {
+    }
+    return (base > used) ? base - used : 0;
+}
+
+int main(void)
+{
+    int fail = bench_check();
+
+    printf("\n%-8s %12s %12s %8s %14s %14s\n", "string", "snprintf ns", "fmt ns", "speedup", "snprintf stack", "fmt stack");
+    for (size_t i = 0; i < sizeof(bench_cases) / sizeof(bench_cases[0]); i++)
+    {
+        const bench_case_t *c = &bench_cases[i];
+        double p = bench_ns(c->printf_fn);
+        double q = bench_ns(c->fmt_fn);
+
+        printf("%-8s %12.1f %12.1f %7.1fx %12zu B %12zu B\n", c->name, p, q, p / q, bench_stack(c->printf_fn), bench_stack(c->fmt_fn));
+    }
+    return fail;
+}
@@ -0,0 +1,268 @@
+/**
+ * @file font_bench.c
+ * @author Ted Wang
+ * @date 2026-10-17
+ * @brief Host check and benchmark of the sorted glyph index (u8g2_font_index_t) and the name font subset.
+ *
+ * Check:
+ *   - every glyph of u8g2_font_wqy12_t_gb2312 is found through an index of the full font at the
+ *     same address as by the u8g2 table walk, and missing encodings return NULL both ways;
+ *   - every character of the name list has the same glyph bytes in the subset (the fixture
+ *     Tools/oled_font/oled_font_names.c, not linked into the firmware) as in the full font, with
+ *     and without the subset index;
+ *   - every name renders to the same pixels with the subset and index as with the full font.
+ * The full font index is built here by walking the font, which is what
+ * Tools/oled_font/fontsubset.py --index-only writes out.
+ *
+ * Benchmark:
+ *   - lookup: u8g2_font_get_glyph_data() per character of the name list, in ns
+ *   - draw:   u8g2_DrawUTF8() of one name into the frame buffer, in ns
+ * for the full font and the subset, each with the u8g2 table walk and with the index. The flash
+ * used by the full font, the subset and the index is printed as well.
+ *
+ * Build (from the repository root):
+ * @code
+ *   gcc -O2 -ITools/oled_host -ITools/oled_font -IHardware/u8g2 -IHardware/oled \
+ *       Tools/oled_host/font_bench.c Tools/oled_host/vdisplay.c Tools/oled_font/oled_font_names.c \
+ *       Hardware/u8g2/u8*.c -o font_bench
+ * @endcode
+ * Usage: font_bench [name list] (default Tools/oled_font/names.txt).
+ */
+
+#include "bench_util.h"
+#include "vdisplay.h"
+#include "oled_font_names.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_MAX_NAMES     256
+#define BENCH_MAX_CHARS     4096
+#define BENCH_LOOKUPS       200000
+#define BENCH_DRAWS         20000
+#define BENCH_RUNS          5
+
+static char bench_names[BENCH_MAX_NAMES][64];
+static int bench_name_count;
+static uint16_t bench_chars[BENCH_MAX_CHARS];
+static int bench_char_count;
+
+static uint16_t full_encoding[8192];
+static uint32_t full_offset[8192];
+static u8g2_font_index_t full_index;
+
+/**
+ * @brief Reads the name list (one UTF-8 name per line) and decodes its characters.
+ */
+static int bench_read_names(const char *path)
+{
+    FILE *f = fopen(path, "r");
+    char line[64];
+
+    if (f == NULL)
+    {
+        perror(path);
+        return -1;
+    }
+    while (fgets(line, sizeof(line), f) != NULL && bench_name_count < BENCH_MAX_NAMES)
+    {
+        const uint8_t *s = (const uint8_t *)line;
+
+        line[strcspn(line, "\r\n")] = '\0';
+        if (line[0] == '\0')
+        {
+            continue;
+        }
+        strcpy(bench_names[bench_name_count++], line);
+        while (*s != '\0' && bench_char_count < BENCH_MAX_CHARS)
+        {
+            uint16_t e;
+
+            if (*s < 0x80)
+            {
+                e = *s++;
+            }
+            else if ((*s & 0xE0) == 0xC0)
+            {
+                e = (uint16_t)(((s[0] & 0x1F) << 6) | (s[1] & 0x3F));
+                s += 2;
+            }
+            else
+            {
+                e = (uint16_t)(((s[0] & 0x0F) << 12) | ((s[1] & 0x3F) << 6) | (s[2] & 0x3F));
+                s += 3;
+            }
+            bench_chars[bench_char_count++] = e;
+        }
+    }
+    fclose(f);
+    return 0;
+}
+
+static uint16_t bench_word(const uint8_t *p)
+{
+    return (uint16_t)((p[0] << 8) | p[1]);
+}
+
+/**
+ * @brief Builds the index of a u8g2 font by walking its unicode glyphs.
+ */
+static void bench_build_index(const uint8_t *font, u8g2_font_index_t *index, uint16_t *encoding, uint32_t *offset)
+{
+    const uint8_t *p = font + 23 + bench_word(font + 21);
+    uint16_t n = 0;
+
+    while (bench_word(p + 2) != 0xFFFF)
+    {
+        p += 4;
+    }
+    p += 4;
+    while (bench_word(p) != 0)
+    {
+        encoding[n] = bench_word(p);
+        offset[n] = (uint32_t)(p - font);
+        n++;
+        p += p[2];
+    }
+    index->font = font;
+    index->encoding = encoding;
+    index->offset = offset;
+    index->count = n;
+}
+
+/**
+ * @brief Looks up a glyph with or without an index.
+ */
+static const uint8_t *bench_lookup(u8g2_t *u8g2, const uint8_t *font, const u8g2_font_index_t *index, uint16_t e)
+{
+    u8g2_SetFont(u8g2, font);
+    u8g2_SetFontIndex(u8g2, index);
+    return u8g2_font_get_glyph_data(u8g2, e);
+}
+
+static int bench_check(u8g2_t *u8g2)
+{
+    static uint8_t ref[128 * 64];
+    static uint8_t sub[128 * 64];
+    int fail = 0;
+
+    /* Full font: index against the table walk for every encoding */
+    for (uint32_t e = 256; e < 0xFFFF; e++)
+    {
+        if (bench_lookup(u8g2, u8g2_font_wqy12_t_gb2312, &full_index, (uint16_t)e)
+            != bench_lookup(u8g2, u8g2_font_wqy12_t_gb2312, NULL, (uint16_t)e))
+        {
+            fail |= bench_check_fail("full font: U+%04X differs", (unsigned)e);
+        }
+    }
+
+    /* Subset: same glyph bytes as the full font */
+    for (int i = 0; i < bench_char_count; i++)
+    {
+        uint16_t e = bench_chars[i];
+        const uint8_t *a = bench_lookup(u8g2, u8g2_font_wqy12_t_gb2312, NULL, e);
+        const uint8_t *b = bench_lookup(u8g2, oled_font_names, &oled_font_names_index, e);
+        const uint8_t *c = bench_lookup(u8g2, oled_font_names, NULL, e);
+
+        if (a == NULL && b == NULL && c == NULL)
+        {
+            continue;
+        }
+        if (a == NULL || b == NULL || b != c || a[-1] != b[-1] || memcmp(a, b, a[-1] - ((e > 255) ? 3 : 2)) != 0)
+        {
+            fail |= bench_check_fail("subset: U+%04X differs", e);
+        }
+    }
+
+    /* Rendering */
+    for (int i = 0; i < bench_name_count; i++)
+    {
+        u8g2_ClearBuffer(u8g2);
+        u8g2_SetFont(u8g2, u8g2_font_wqy12_t_gb2312);
+        u8g2_SetFontIndex(u8g2, NULL);
+        u8g2_DrawUTF8(u8g2, 0, 20, bench_names[i]);
+        u8g2_SendBuffer(u8g2);
+        vdisplay_snapshot(ref);
+        u8g2_ClearBuffer(u8g2);
+        u8g2_SetFont(u8g2, oled_font_names);
+        u8g2_SetFontIndex(u8g2, &oled_font_names_index);
+        u8g2_DrawUTF8(u8g2, 0, 20, bench_names[i]);
+        u8g2_SendBuffer(u8g2);
+        vdisplay_snapshot(sub);
+        if (memcmp(ref, sub, sizeof(ref)) != 0)
+        {
+            fail |= bench_check_fail("render: \"%s\" differs", bench_names[i]);
+        }
+    }
+    return bench_check_summary(fail, "%d names, %d characters, %u glyphs of the full font",
+                               bench_name_count, bench_char_count, (unsigned)full_index.count);
+}
+
+static double bench_lookup_ns(u8g2_t *u8g2, const uint8_t *font, const u8g2_font_index_t *index)
+{
+    double best = BENCH_NO_TIME;
+    volatile uintptr_t sink = 0;
+
+    u8g2_SetFont(u8g2, font);
+    u8g2_SetFontIndex(u8g2, index);
+    for (int run = 0; run < BENCH_RUNS; run++)
+    {
+        uint64_t t0 = bench_now_ns();
+        for (int i = 0; i < BENCH_LOOKUPS; i++)
+        {
+            sink += (uintptr_t)u8g2_font_get_glyph_data(u8g2, bench_chars[i % bench_char_count]);
+        }
+        best = bench_min(best, bench_ns_per(t0, BENCH_LOOKUPS));
+    }
+    (void)sink;
+    return best;
+}
+
+static double bench_draw_ns(u8g2_t *u8g2, const uint8_t *font, const u8g2_font_index_t *index)
+{
+    double best = BENCH_NO_TIME;
+
+    u8g2_SetFont(u8g2, font);
+    u8g2_SetFontIndex(u8g2, index);
+    for (int run = 0; run < BENCH_RUNS; run++)
+    {
+        uint64_t t0 = bench_now_ns();
+        for (int i = 0; i < BENCH_DRAWS; i++)
+        {
+            u8g2_DrawUTF8(u8g2, 0, 20, bench_names[i % bench_name_count]);
+        }
+        best = bench_min(best, bench_ns_per(t0, BENCH_DRAWS));
+    }
+    return best;
+}
+
+int main(int argc, char **argv)
+{
+    static const char *cases[] = {"full font", "full + index", "subset", "subset + index"};
+    const uint8_t *fonts[] = {u8g2_font_wqy12_t_gb2312, u8g2_font_wqy12_t_gb2312, oled_font_names, oled_font_names};
+    const u8g2_font_index_t *indexes[] = {NULL, &full_index, NULL, &oled_font_names_index};
+    double lookup[4];
+    double draw[4];
+    u8g2_t u8g2;
+    int fail;
+
+    if (bench_read_names((argc > 1) ? argv[1] : "Tools/oled_font/names.txt") != 0 || bench_char_count == 0)
+    {
+        return 1;
+    }
+    vdisplay_setup(&u8g2, 'd');
+    bench_build_index(u8g2_font_wqy12_t_gb2312, &full_index, full_encoding, full_offset);
+    fail = bench_check(&u8g2);
+
+    printf("\n%-16s %10s %10s %10s %10s\n", "font", "flash B", "index B", "lookup ns", "draw ns");
+    for (int i = 0; i < 4; i++)
+    {
+        lookup[i] = bench_lookup_ns(&u8g2, fonts[i], indexes[i]);
+        draw[i] = bench_draw_ns(&u8g2, fonts[i], indexes[i]);
+        printf("%-16s %10lu %10lu %10.1f %10.0f\n", cases[i], (unsigned long)u8g2_GetFontSize(fonts[i]),
+               (unsigned long)((indexes[i] != NULL) ? indexes[i]->count * 6u : 0u), lookup[i], draw[i]);
+    }
+    printf("\nlookup speedup: full font %.1fx with index, %.1fx subset + index\n", lookup[0] / lookup[1], lookup[0] / lookup[3]);
+    printf("draw speedup:   full font %.1fx with index, %.1fx subset + index\n", draw[0] / draw[1], draw[0] / draw[3]);
+    return fail;
+}
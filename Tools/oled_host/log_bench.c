@@ -0,0 +1,242 @@
+/**
+ * @file log_bench.c
+ * @author Ted Wang
+ * @date 2026-10-17
+ * @brief Host check and benchmark of the batched, dirty-cell u8log terminal (Hardware/oled/oled_log.c).
+ *
+ * Each workload writes some text per frame tick and then flushes once:
+ *   - typing:   one character per tick, a line break every 24 characters (live console)
+ *   - lines:    one access log line per tick ("XX XX XX XX granted")
+ *   - burst:    three log lines per tick (several queued readings drained in one batch)
+ *   - progress: "\rcopy NN%" per tick, a new line every 100 ticks (in-place status line)
+ *   - random:   0..40 random characters, line breaks, '\r' and occasional '\f' per tick
+ *
+ * Check: after every flush the visible image of the virtual SH1106 (start line applied) must equal
+ * a full render of the u8log character buffer on the same cell grid.
+ *
+ * Benchmark, per tick: I2C payload bytes (with the bus time at 400 kHz), tiles sent and host time
+ * for
+ *   - oled_log:    OLED_Log_WriteString() per write and OLED_Log_Flush() per tick
+ *   - full redraw: u8log without callback, full buffer render and u8g2_SendBuffer() per tick
+ *   - stock:       u8log_u8g2_cb() in redraw mode 0 (full redraw per completed line)
+ *   - stock live:  u8log_u8g2_cb() in redraw mode 1 (full redraw per character)
+ *
+ * Build (from the repository root):
+ * @code
+ *   gcc -O2 -ITools/oled_host -IHardware/u8g2 -IHardware/oled \
+ *       Tools/oled_host/log_bench.c Tools/oled_host/vdisplay.c Hardware/oled/oled_log.c \
+ *       Hardware/oled/oled_region.c Hardware/u8g2/u8*.c -o log_bench
+ * @endcode
+ */
+
+#include "bench_util.h"
+#include "vdisplay.h"
+#include "oled_log.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_TICKS         2000
+#define BENCH_FONT          u8g2_font_5x7_tf
+
+enum { WL_TYPING, WL_LINES, WL_BURST, WL_PROGRESS, WL_RANDOM, WL_COUNT };
+enum { BK_LOG, BK_FULL, BK_STOCK, BK_STOCK_LIVE, BK_COUNT };
+
+static const char *const workload_names[WL_COUNT] = {"typing", "lines", "burst", "progress", "random"};
+static const char *const backend_names[BK_COUNT] = {"oled_log", "full redraw", "stock", "stock live"};
+
+static u8g2_t ref_u8g2;
+static uint8_t ref_buf[VDISPLAY_WIDTH * VDISPLAY_HEIGHT / 8];
+
+/**
+ * @brief Text written by a workload in one tick.
+ */
+static void bench_tick_text(int workload, int tick, char *out)
+{
+    static const char alphabet[] = "ABCDEFabcdef0123456789 -:%";
+    int n;
+
+    switch (workload)
+    {
+    case WL_TYPING:
+        out[0] = ((tick % 24) == 23) ? '\n' : alphabet[tick % (sizeof(alphabet) - 1)];
+        out[1] = '\0';
+        break;
+    case WL_LINES:
+        sprintf(out, "%02X %02X %02X %02X granted\n", tick & 0xFF, (tick * 7) & 0xFF, (tick * 13) & 0xFF, 0x5A);
+        break;
+    case WL_BURST:
+        for (n = 0; n < 3; n++)
+        {
+            int id = tick * 3 + n;
+            out += sprintf(out, "%02X %02X %02X %02X granted\n", id & 0xFF, (id * 7) & 0xFF, (id * 13) & 0xFF, 0x5A);
+        }
+        break;
+    case WL_PROGRESS:
+        sprintf(out, "\rcopy %d%%%s", tick % 100, ((tick % 100) == 99) ? "\n" : "");
+        break;
+    default:
+        n = rand() % 41;
+        for (int i = 0; i < n; i++)
+        {
+            int r = rand() % 100;
+            *out++ = (r < 8) ? '\n' : (r < 10) ? '\r' : alphabet[rand() % (sizeof(alphabet) - 1)];
+        }
+        if (rand() % 50 == 0)
+        {
+            *out++ = '\f';
+        }
+        *out = '\0';
+        break;
+    }
+}
+
+/**
+ * @brief Renders the u8log character buffer on the cell grid and compares it with the panel.
+ */
+static int bench_check_screen(const OLED_Log_t *oled_log, int workload, int tick)
+{
+    static uint8_t panel[VDISPLAY_WIDTH * VDISPLAY_HEIGHT];
+    uint8_t cols = oled_log->log.width;
+
+    u8g2_ClearBuffer(&ref_u8g2);
+    for (int row = 0; row < oled_log->log.height; row++)
+    {
+        for (int c = 0; c < cols; c++)
+        {
+            uint8_t ch = oled_log->screen[row * cols + c];
+            if (ch != ' ')
+            {
+                u8g2_DrawGlyph(&ref_u8g2, (u8g2_uint_t)(c * oled_log->cell_width), (u8g2_uint_t)(row * 8), ch);
+            }
+        }
+    }
+    vdisplay_snapshot(panel);
+    for (int y = 0; y < VDISPLAY_HEIGHT; y++)
+    {
+        for (int x = 0; x < VDISPLAY_WIDTH; x++)
+        {
+            int ref = (ref_buf[(y >> 3) * VDISPLAY_WIDTH + x] >> (y & 7)) & 1;
+            if (ref != panel[y * VDISPLAY_WIDTH + x])
+            {
+                return bench_check_fail("%s: tick %d differs at (%d, %d)", workload_names[workload], tick, x, y);
+            }
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Full render of a u8log buffer on the cell grid into the display buffer (full redraw backend).
+ */
+static void bench_draw_grid(u8g2_t *u8g2, const u8log_t *u8log, uint8_t cell_width)
+{
+    u8g2_ClearBuffer(u8g2);
+    for (int row = 0; row < u8log->height; row++)
+    {
+        for (int c = 0; c < u8log->width; c++)
+        {
+            uint8_t ch = u8log->screen_buffer[row * u8log->width + c];
+            if (ch != ' ')
+            {
+                u8g2_DrawGlyph(u8g2, (u8g2_uint_t)(c * cell_width), (u8g2_uint_t)(row * 8), ch);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Runs one workload on one backend.
+ *
+ * @param[out] bytes, tiles, ns Totals over all ticks.
+ * @return Number of failed checks (only checked for BK_LOG when check is set).
+ */
+static int bench_run(int backend, int workload, int check, uint64_t *bytes, uint64_t *tiles, uint64_t *ns)
+{
+    static OLED_Log_t oled_log;
+    static char text[256];
+    u8g2_t u8g2;
+    u8log_t *u8log = &oled_log.log;
+    int fail = 0;
+    uint64_t t = 0;
+
+    srand(1);
+    vdisplay_setup(&u8g2, 'f');
+    OLED_Log_Init(&oled_log, &u8g2, BENCH_FONT);
+    if (backend != BK_LOG)
+    {
+        /* Same character grid, stock redraw */
+        u8g2_SetFont(&u8g2, BENCH_FONT);
+        if (backend == BK_FULL)
+        {
+            u8g2_SetFontPosTop(&u8g2);
+        }
+        u8log_SetCallback(u8log, (backend == BK_FULL) ? NULL : u8log_u8g2_cb, &u8g2);
+        u8log_SetRedrawMode(u8log, (backend == BK_STOCK_LIVE) ? 1 : 0);
+        u8log_SetLineHeightOffset(u8log, (int8_t)(8 - (u8g2_GetAscent(&u8g2) - u8g2_GetDescent(&u8g2))));
+    }
+    vdisplay.bytes = 0;
+    vdisplay.tiles = 0;
+    oled_log.tiles_sent = 0;
+
+    for (int tick = 0; tick < BENCH_TICKS; tick++)
+    {
+        uint64_t t0;
+
+        bench_tick_text(workload, tick, text);
+        t0 = bench_now_ns();
+        if (backend == BK_LOG)
+        {
+            OLED_Log_WriteString(&oled_log, text);
+            OLED_Log_Flush(&oled_log);
+        }
+        else
+        {
+            u8log_WriteString(u8log, text);
+            if (backend == BK_FULL)
+            {
+                bench_draw_grid(&u8g2, u8log, oled_log.cell_width);
+                u8g2_SendBuffer(&u8g2);
+            }
+        }
+        t += bench_now_ns() - t0;
+        if (check && backend == BK_LOG)
+        {
+            fail += bench_check_screen(&oled_log, workload, tick);
+        }
+    }
+    *bytes = vdisplay.bytes;
+    *tiles = (backend == BK_LOG) ? oled_log.tiles_sent : 0;
+    *ns = t;
+    return fail;
+}
+
+int main(void)
+{
+    uint64_t bytes, tiles, ns;
+    int fail = 0;
+
+    u8g2_SetupDisplay(&ref_u8g2, u8x8_d_ssd1306_128x64_noname, u8x8_cad_001, u8x8_byte_empty, u8x8_dummy_cb);
+    u8g2_SetupBuffer(&ref_u8g2, ref_buf, 8, u8g2_ll_hvline_vertical_top_lsb, U8G2_R0);
+    u8g2_SetFont(&ref_u8g2, BENCH_FONT);
+    u8g2_SetFontPosTop(&ref_u8g2);
+
+    for (int w = 0; w < WL_COUNT; w++)
+    {
+        fail += bench_run(BK_LOG, w, 1, &bytes, &tiles, &ns);
+    }
+    fail = bench_check_summary(fail, "%d workloads x %d ticks", WL_COUNT, BENCH_TICKS);
+
+    printf("\n%-10s %-12s %10s %10s %10s %10s\n", "workload", "backend", "bytes/tick", "I2C ms", "tiles/tick", "host us");
+    for (int w = 0; w < WL_COUNT; w++)
+    {
+        for (int b = 0; b < BK_COUNT; b++)
+        {
+            bench_run(b, w, 0, &bytes, &tiles, &ns);
+            printf("%-10s %-12s %10.1f %10.2f %10.2f %10.2f\n", workload_names[w], backend_names[b],
+                   (double)bytes / BENCH_TICKS, (double)bytes * 9.0 / 400.0 / BENCH_TICKS,
+                   (double)tiles / BENCH_TICKS, (double)ns / 1000.0 / BENCH_TICKS);
+        }
+    }
+    return fail;
+}
@@ -0,0 +1,411 @@
+/**
+ * @file oled_bench.c
+ * @author Ted Wang
+ * @date 2026-10-17
+ * @brief Host render benchmark and golden-image regression check for the OLED screens.
+ *
+ * Replays recorded RC522_Data_t sequences through the same screen code as OLED_Display_Task
+ * (oled_status_screen.c, or oled_dashboard.c with -S dashboard) on the virtual display
+ * (vdisplay.c) and reports, per sequence:
+ *   - ns/frame for OLED_StatusScreen_Render() (best of --repeat runs per frame), for
+ *     OLED_StatusScreen_RenderTiles() (-S tiles, hybrid tile text renderer, one run per frame), or
+ *     for OLED_Dashboard_Update() + OLED_Dashboard_Render() at each OLED_DASHBOARD_TICK_MS tick, or
+ *     for OLED_StatusScreen_RenderAnimated() and every OLED_Anim_Step() that sends (-S anim; the
+ *     steps are replayed at the delays the animator asks for, as OLED_Animated_Status_Loop() does)
+ *   - bytes and I2C transfers per frame (SH1106 protocol modes)
+ *   - pixel-exact differences against golden PBM images
+ *
+ * Build (from the repository root):
+ * @code
+ *   gcc -O2 -ITools/oled_host -IHardware/u8g2 -IHardware/oled -ICore/Inc \
+ *       -IMiddlewares/Third_Party/FreeRTOS/Source/CMSIS_RTOS_V2 \
+ *       Tools/oled_host/oled_bench.c Tools/oled_host/vdisplay.c Core/Src/oled_status_screen.c \
+ *       Core/Src/oled_dashboard.c Core/Src/fmt.c Hardware/oled/oled_ui.c Hardware/oled/oled_text.c \
+ *       Hardware/oled/oled_tiletext.c Hardware/oled/oled_blit.c Hardware/oled/oled_icons.c \
+ *       Hardware/oled/oled_anim.c Hardware/oled/oled_raster.c Hardware/oled/oled_region.c \
+ *       Hardware/u8g2/u8*.c -o oled_bench
+ * @endcode
+ *
+ * Usage:
+ * @code
+ *   ./oled_bench [-S status|tiles|dashboard|anim] [-m f|1|2|d] [-r repeat] [-g golden_dir] [-u] [-o dump_dir] sequence.txt...
+ * @endcode
+ * Sequence files hold one RC522 reading per line: "1 <uid bytes in hex>" for a detected card,
+ * "0" for no card; '#' starts a comment. Readings are RC522_TASK_PERIOD_MS apart; the dashboard is
+ * rendered at every tick in between and compared against its golden image right after each
+ * reading. The animated page is compared against the frame shown just before the next reading. The
+ * dashboard, tile text and animated renderers need a full buffer mode (f or d). With -u the golden
+ * images are (re)written instead of compared. The exit code is 1 if any frame differs from its golden image.
+ *
+ * Timings are host CPU timings and only meaningful relative to each other (regressions, modes).
+ */
+
+#include "bench_util.h"
+#include "vdisplay.h"
+#include "oled_status_screen.h"
+#include "oled_dashboard.h"
+#include "oled_rtos_task.h"
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#define BENCH_MAX_FRAMES    1024
+
+/** @brief Period of the recorded RC522 readings (RC522_Task delay). */
+#define RC522_TASK_PERIOD_MS    2000
+
+/**
+ * @brief Per-sequence results.
+ */
+typedef struct {
+    unsigned frames;
+    double ns_sum;
+    double ns_max;
+    unsigned long bytes;
+    unsigned long transfers;
+    unsigned golden_compared;
+    unsigned golden_failed;
+    unsigned long pixels_differ;
+} bench_result_t;
+
+/**
+ * @brief Reads a recorded RC522 sequence.
+ * @return Number of readings, or -1 if the file cannot be read.
+ */
+static int bench_load_sequence(const char *path, RC522_Data_t *seq, int max)
+{
+    char line[128];
+    int n = 0;
+    FILE *f = fopen(path, "r");
+
+    if (f == NULL)
+    {
+        return -1;
+    }
+    while (n < max && fgets(line, sizeof(line), f) != NULL)
+    {
+        char *p = strchr(line, '#');
+        unsigned status;
+        int used;
+
+        if (p != NULL)
+        {
+            *p = '\0';
+        }
+        if (sscanf(line, " %u%n", &status, &used) != 1)
+        {
+            continue;
+        }
+        memset(&seq[n], 0, sizeof(seq[n]));
+        seq[n].status = (uint8_t)status;
+        p = line + used;
+        while (seq[n].uid_length < sizeof(seq[n].uid))
+        {
+            unsigned b;
+            if (sscanf(p, " %2x%n", &b, &used) != 1)
+            {
+                break;
+            }
+            seq[n].uid[seq[n].uid_length++] = (uint8_t)b;
+            p += used;
+        }
+        n++;
+    }
+    fclose(f);
+    return n;
+}
+
+/**
+ * @brief Returns the file name of a path without directory and extension.
+ */
+static void bench_base_name(const char *path, char *name, size_t size)
+{
+    const char *s = strrchr(path, '/');
+    char *dot;
+
+    snprintf(name, size, "%s", s != NULL ? s + 1 : path);
+    dot = strrchr(name, '.');
+    if (dot != NULL)
+    {
+        *dot = '\0';
+    }
+}
+
+static int bench_mkdir(const char *path)
+{
+    return (mkdir(path, 0777) == 0 || errno == EEXIST) ? 0 : -1;
+}
+
+int main(int argc, char **argv)
+{
+    static RC522_Data_t seq[BENCH_MAX_FRAMES];
+    uint8_t pixels[VDISPLAY_WIDTH * VDISPLAY_HEIGHT];
+    uint8_t golden[VDISPLAY_WIDTH * VDISPLAY_HEIGHT];
+    const char *golden_dir = NULL;
+    const char *dump_dir = NULL;
+    int update = 0;
+    int repeat = 50;
+    char mode = 'f';
+    char screen_sel = 's';
+    int failed = 0;
+    int argi;
+    u8g2_t u8g2;
+
+    for (argi = 1; argi < argc && argv[argi][0] == '-'; argi++)
+    {
+        if (strcmp(argv[argi], "-m") == 0 && argi + 1 < argc)
+            mode = argv[++argi][0];
+        else if (strcmp(argv[argi], "-S") == 0 && argi + 1 < argc)
+            screen_sel = argv[++argi][0];
+        else if (strcmp(argv[argi], "-r") == 0 && argi + 1 < argc)
+            repeat = atoi(argv[++argi]);
+        else if (strcmp(argv[argi], "-g") == 0 && argi + 1 < argc)
+            golden_dir = argv[++argi];
+        else if (strcmp(argv[argi], "-o") == 0 && argi + 1 < argc)
+            dump_dir = argv[++argi];
+        else if (strcmp(argv[argi], "-u") == 0)
+            update = 1;
+        else
+        {
+            fprintf(stderr, "usage: %s [-S status|tiles|dashboard|anim] [-m f|1|2|d] [-r repeat] [-g golden_dir] [-u] [-o dump_dir] sequence.txt...\n", argv[0]);
+            return 2;
+        }
+    }
+    if (argi >= argc || repeat < 1)
+    {
+        fprintf(stderr, "no sequence given\n");
+        return 2;
+    }
+    if (screen_sel != 's' && screen_sel != 't' && screen_sel != 'd' && screen_sel != 'a')
+    {
+        fprintf(stderr, "unknown screen '%c'\n", screen_sel);
+        return 2;
+    }
+    if (screen_sel != 's' && mode != 'f' && mode != 'd')
+    {
+        fprintf(stderr, "this screen needs a full buffer mode (f or d)\n");
+        return 2;
+    }
+
+    printf("%-16s %6s %10s %10s %10s %8s %s\n", "sequence", "frames", "ns/frame", "ns max", "bytes/fr", "xfer/fr", "golden");
+    for (; argi < argc; argi++)
+    {
+        char name[64];
+        char path[512];
+        bench_result_t r;
+        OLED_StatusScreen_t screen;
+        static OLED_Dashboard_t dash;
+        static OLED_TileText_t tiles;
+        static OLED_StatusAnim_t anim;
+        uint32_t now_ms = 0;
+        int n = bench_load_sequence(argv[argi], seq, BENCH_MAX_FRAMES);
+
+        if (n < 0)
+        {
+            fprintf(stderr, "%s: cannot read\n", argv[argi]);
+            return 2;
+        }
+        if (vdisplay_setup(&u8g2, mode) != 0)
+        {
+            fprintf(stderr, "unknown mode '%c'\n", mode);
+            return 2;
+        }
+        u8g2_ClearDisplay(&u8g2);
+        OLED_StatusScreen_Init(&screen);
+        bench_base_name(argv[argi], name, sizeof(name));
+        if (screen_sel == 'd')
+        {
+            strncat(name, "_dash", sizeof(name) - strlen(name) - 1);
+            OLED_Dashboard_Init(&dash, &u8g2);
+        }
+        else if (screen_sel == 't')
+        {
+            strncat(name, "_tiles", sizeof(name) - strlen(name) - 1);
+            OLED_StatusScreen_InitTiles(&u8g2, &tiles);
+        }
+        else if (screen_sel == 'a')
+        {
+            strncat(name, "_anim", sizeof(name) - strlen(name) - 1);
+            OLED_StatusScreen_InitAnim(&anim, &u8g2, NULL);
+        }
+        memset(&r, 0, sizeof(r));
+
+        for (int i = 0; i < n; i++)
+        {
+            uint64_t best = UINT64_MAX;
+            uint32_t bytes0;
+            uint32_t transfers0;
+
+            if (screen_sel == 'd')
+            {
+                /* One reading, then the ticks until the next one; the golden image is the frame
+                   rendered for the reading itself (tick 0) */
+                uint8_t reading_pixels[sizeof(pixels)];
+                for (uint32_t tick = 0; tick < RC522_TASK_PERIOD_MS; tick += OLED_DASHBOARD_TICK_MS)
+                {
+                    uint32_t b0 = vdisplay.bytes;
+                    uint32_t x0 = vdisplay.transfers;
+                    uint64_t t0 = bench_now_ns();
+                    OLED_Dashboard_Update(&dash, (tick == 0) ? &seq[i] : NULL, now_ms);
+                    OLED_Dashboard_Render(&dash);
+                    double t = (double)(bench_now_ns() - t0);
+                    r.frames++;
+                    r.ns_sum += t;
+                    if (t > r.ns_max)
+                    {
+                        r.ns_max = t;
+                    }
+                    r.bytes += vdisplay.bytes - b0;
+                    r.transfers += vdisplay.transfers - x0;
+                    if (tick == 0)
+                    {
+                        vdisplay_snapshot(reading_pixels);
+                    }
+                    now_ms += OLED_DASHBOARD_TICK_MS;
+                }
+                memcpy(pixels, reading_pixels, sizeof(pixels));
+            }
+            else if (screen_sel == 'a')
+            {
+                /* The reading, then the animation steps until the next one (an idle animator
+                   returns OLED_ANIM_IDLE and nothing is sent until then) */
+                uint32_t next_reading = now_ms + RC522_TASK_PERIOD_MS;
+                uint32_t wait;
+                for (int step = 0; now_ms < next_reading; step++)
+                {
+                    uint32_t b0 = vdisplay.bytes;
+                    uint32_t x0 = vdisplay.transfers;
+                    uint64_t t0 = bench_now_ns();
+                    if (step == 0)
+                    {
+                        OLED_StatusScreen_Update(&screen, &seq[i]);
+                        OLED_StatusScreen_RenderAnimated(&anim, &screen, now_ms);
+                    }
+                    wait = OLED_Anim_Step(&anim.animator, now_ms);
+                    double t = (double)(bench_now_ns() - t0);
+                    if (vdisplay.bytes != b0)
+                    {
+                        r.frames++;
+                        r.ns_sum += t;
+                        if (t > r.ns_max)
+                        {
+                            r.ns_max = t;
+                        }
+                        r.bytes += vdisplay.bytes - b0;
+                        r.transfers += vdisplay.transfers - x0;
+                    }
+                    now_ms = (wait == OLED_ANIM_IDLE || next_reading - now_ms < wait) ? next_reading : now_ms + wait;
+                }
+                vdisplay_snapshot(pixels);
+            }
+            else if (screen_sel == 't')
+            {
+                uint64_t t0;
+                double t;
+                bytes0 = vdisplay.bytes;
+                transfers0 = vdisplay.transfers;
+                t0 = bench_now_ns();
+                OLED_StatusScreen_Update(&screen, &seq[i]);
+                OLED_StatusScreen_RenderTiles(&tiles, &screen);
+                t = (double)(bench_now_ns() - t0);
+                r.frames++;
+                r.ns_sum += t;
+                if (t > r.ns_max)
+                {
+                    r.ns_max = t;
+                }
+                r.bytes += vdisplay.bytes - bytes0;
+                r.transfers += vdisplay.transfers - transfers0;
+                vdisplay_snapshot(pixels);
+            }
+            else
+            {
+                OLED_StatusScreen_Update(&screen, &seq[i]);
+                for (int k = 0; k < repeat; k++)
+                {
+                    uint64_t t0;
+                    uint64_t t;
+                    bytes0 = vdisplay.bytes;
+                    transfers0 = vdisplay.transfers;
+                    t0 = bench_now_ns();
+                    OLED_StatusScreen_Render(&u8g2, &screen);
+                    t = bench_now_ns() - t0;
+                    if (t < best)
+                    {
+                        best = t;
+                    }
+                }
+                r.frames++;
+                r.ns_sum += (double)best;
+                if ((double)best > r.ns_max)
+                {
+                    r.ns_max = (double)best;
+                }
+                r.bytes += vdisplay.bytes - bytes0;
+                r.transfers += vdisplay.transfers - transfers0;
+                vdisplay_snapshot(pixels);
+            }
+
+            if (dump_dir != NULL)
+            {
+                bench_mkdir(dump_dir);
+                snprintf(path, sizeof(path), "%s/%s_%03d.pbm", dump_dir, name, i);
+                vdisplay_write_pbm(path, pixels);
+                snprintf(path, sizeof(path), "%s/%s_%03d.png", dump_dir, name, i);
+                vdisplay_write_png(path, pixels);
+            }
+            if (golden_dir != NULL)
+            {
+                snprintf(path, sizeof(path), "%s/%s_%03d.pbm", golden_dir, name, i);
+                if (update)
+                {
+                    bench_mkdir(golden_dir);
+                    if (vdisplay_write_pbm(path, pixels) != 0)
+                    {
+                        fprintf(stderr, "%s: cannot write\n", path);
+                        return 2;
+                    }
+                    continue;
+                }
+                r.golden_compared++;
+                if (vdisplay_read_pbm(path, golden) != 0)
+                {
+                    fprintf(stderr, "%s: missing golden image\n", path);
+                    r.golden_failed++;
+                    continue;
+                }
+                unsigned long diff = 0;
+                for (size_t p = 0; p < sizeof(pixels); p++)
+                {
+                    diff += pixels[p] != golden[p];
+                }
+                if (diff != 0)
+                {
+                    fprintf(stderr, "%s: %lu pixels differ\n", path, diff);
+                    r.golden_failed++;
+                    r.pixels_differ += diff;
+                }
+            }
+        }
+
+        if (r.golden_failed != 0)
+        {
+            failed = 1;
+        }
+        if (r.frames == 0)
+        {
+            continue;
+        }
+        if (golden_dir == NULL)
+            snprintf(path, sizeof(path), "-");
+        else if (update)
+            snprintf(path, sizeof(path), "updated");
+        else
+            snprintf(path, sizeof(path), "%u/%u ok (%lu px)", r.golden_compared - r.golden_failed, r.golden_compared, r.pixels_differ);
+        printf("%-16s %6u %10.0f %10.0f %10.1f %8.1f %s\n", name, r.frames, r.ns_sum / r.frames, r.ns_max,
+               (double)r.bytes / r.frames, (double)r.transfers / r.frames, path);
+    }
+    return failed;
+}
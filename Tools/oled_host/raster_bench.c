@@ -0,0 +1,358 @@
+/**
+ * @file raster_bench.c
+ * @author Ted Wang
+ * @date 2026-10-17
+ * @brief Host check and benchmark of the span rasterizers (Hardware/oled/oled_raster.c) against u8g2.
+ *
+ * Check: random lines, circles and discs (all quadrant options, partly off screen, with clip
+ * windows) must produce exactly the pixels of u8g2_DrawLine() / u8g2_DrawCircle() / u8g2_DrawDisc();
+ * random polygons (also concave) must match a per-pixel even-odd test at the pixel centers; XOR
+ * drawing must equal set drawing on an empty buffer (no pixel touched twice); page mode must equal
+ * full buffer mode.
+ *
+ * Benchmark: typical animation frames drawn into the frame buffer (no transfer), in ns per frame,
+ * with the u8g2 primitives and with the span rasterizers:
+ *   - spinner:  12 rotating spokes (lines) and a circle outline
+ *   - progress: rounded bar outline (quarter circles and lines) with a filled part (quarter discs
+ *               and a polygon)
+ *   - disc:     a radius 24 disc
+ *   - star:     a concave 10 point star (u8g2_DrawPolygon() only handles convex polygons and can
+ *               divide by zero on this one, so the u8g2 side draws it as 10 triangles around the center)
+ *
+ * Build (from the repository root):
+ * @code
+ *   gcc -O2 -ITools/oled_host -IHardware/u8g2 -IHardware/oled \
+ *       Tools/oled_host/raster_bench.c Tools/oled_host/vdisplay.c Hardware/oled/oled_raster.c \
+ *       Hardware/u8g2/u8*.c -lm -o raster_bench
+ * @endcode
+ */
+
+#include "bench_util.h"
+#include "vdisplay.h"
+#include "oled_raster.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_CHECKS        20000
+#define BENCH_FRAMES        2000
+#define BENCH_RUNS          5
+
+static int bench_rand(int lo, int hi)
+{
+    return lo + rand() % (hi - lo + 1);
+}
+
+/**
+ * @brief Even-odd point-in-polygon test at the center of pixel (x, y).
+ */
+static int bench_inside(const OLED_Point_t *p, int n, int x, int y)
+{
+    double px = x + 0.5;
+    double py = y + 0.5;
+    int inside = 0;
+
+    for (int i = 0, j = n - 1; i < n; j = i++)
+    {
+        if ((p[i].y <= py) != (p[j].y <= py))
+        {
+            double cx = p[i].x + (py - p[i].y) * (p[j].x - p[i].x) / (double)(p[j].y - p[i].y);
+            if (px >= cx)
+            {
+                inside = !inside;
+            }
+        }
+    }
+    return inside;
+}
+
+/**
+ * @brief Random shape and clip window for one check.
+ */
+typedef struct {
+    int kind;                   /* 0 line, 1 circle, 2 disc, 3 polygon */
+    int x0, y0, x1, y1, rad, option;
+    OLED_Point_t pts[OLED_RASTER_MAX_POLYGON_POINTS];
+    int n;
+    int clip;
+    int cx0, cy0, cx1, cy1;
+} bench_shape_t;
+
+static void bench_random_shape(bench_shape_t *s)
+{
+    static const int options[] = {U8G2_DRAW_ALL, U8G2_DRAW_UPPER_RIGHT, U8G2_DRAW_UPPER_LEFT, U8G2_DRAW_LOWER_LEFT,
+                                  U8G2_DRAW_LOWER_RIGHT, U8G2_DRAW_UPPER_RIGHT | U8G2_DRAW_LOWER_LEFT,
+                                  U8G2_DRAW_UPPER_LEFT | U8G2_DRAW_UPPER_RIGHT};
+
+    s->kind = rand() % 4;
+    /* u8g2 uses 8-bit coordinates: keep its shapes inside 0..255 so both see the same input */
+    s->x0 = bench_rand(0, 127);
+    s->y0 = bench_rand(0, 63);
+    s->x1 = bench_rand(0, 127);
+    s->y1 = bench_rand(0, 63);
+    s->rad = bench_rand(0, 40);
+    if (s->kind != 0)
+    {
+        s->x0 = bench_rand(s->rad, 127 + 40);
+        s->y0 = bench_rand(s->rad, 63 + 30);
+    }
+    s->option = options[rand() % 7];
+    s->n = bench_rand(3, OLED_RASTER_MAX_POLYGON_POINTS);
+    for (int i = 0; i < s->n; i++)
+    {
+        s->pts[i].x = (int16_t)bench_rand(-20, 150);
+        s->pts[i].y = (int16_t)bench_rand(-20, 85);
+    }
+    s->clip = rand() % 3 == 0;
+    s->cx0 = bench_rand(0, 100);
+    s->cy0 = bench_rand(0, 50);
+    s->cx1 = bench_rand(s->cx0 + 1, 128);
+    s->cy1 = bench_rand(s->cy0 + 1, 64);
+}
+
+static void bench_draw_shape(u8g2_t *u8g2, const bench_shape_t *s, int span)
+{
+    if (s->clip)
+    {
+        u8g2_SetClipWindow(u8g2, s->cx0, s->cy0, s->cx1, s->cy1);
+    }
+    switch (s->kind)
+    {
+        case 0:
+            if (span)
+                OLED_Raster_Line(u8g2, s->x0, s->y0, s->x1, s->y1);
+            else
+                u8g2_DrawLine(u8g2, s->x0, s->y0, s->x1, s->y1);
+            break;
+        case 1:
+            if (span)
+                OLED_Raster_Circle(u8g2, s->x0, s->y0, s->rad, s->option);
+            else
+                u8g2_DrawCircle(u8g2, s->x0, s->y0, s->rad, s->option);
+            break;
+        case 2:
+            if (span)
+                OLED_Raster_Disc(u8g2, s->x0, s->y0, s->rad, s->option);
+            else
+                u8g2_DrawDisc(u8g2, s->x0, s->y0, s->rad, s->option);
+            break;
+        default:
+            OLED_Raster_FillPolygon(u8g2, s->pts, (uint8_t)s->n);
+            break;
+    }
+    u8g2_SetMaxClipWindow(u8g2);
+}
+
+/**
+ * @brief Renders a shape into the frame buffer (full buffer) and returns it as pixels.
+ */
+static void bench_render(const bench_shape_t *s, int span, uint8_t color, char mode, uint8_t *pixels)
+{
+    u8g2_t u8g2;
+
+    vdisplay_setup(&u8g2, mode);
+    u8g2_SetDrawColor(&u8g2, color);
+    u8g2_FirstPage(&u8g2);
+    do
+    {
+        bench_draw_shape(&u8g2, s, span);
+    } while (u8g2_NextPage(&u8g2));
+    vdisplay_snapshot(pixels);
+}
+
+static int bench_check(void)
+{
+    static const char *names[] = {"line", "circle", "disc", "polygon"};
+    unsigned failed[4] = {0, 0, 0, 0};
+    unsigned count[4] = {0, 0, 0, 0};
+    uint8_t ref[VDISPLAY_WIDTH * VDISPLAY_HEIGHT];
+    uint8_t out[VDISPLAY_WIDTH * VDISPLAY_HEIGHT];
+    uint8_t alt[VDISPLAY_WIDTH * VDISPLAY_HEIGHT];
+    int fail = 0;
+
+    srand(1);
+    for (int i = 0; i < BENCH_CHECKS; i++)
+    {
+        bench_shape_t s;
+        bench_random_shape(&s);
+        count[s.kind]++;
+
+        bench_render(&s, 1, 1, 'f', out);
+        if (s.kind < 3)
+        {
+            bench_render(&s, 0, 1, 'f', ref);
+        }
+        else
+        {
+            for (int y = 0; y < VDISPLAY_HEIGHT; y++)
+            {
+                for (int x = 0; x < VDISPLAY_WIDTH; x++)
+                {
+                    int visible = !s.clip || (x >= s.cx0 && x < s.cx1 && y >= s.cy0 && y < s.cy1);
+                    ref[y * VDISPLAY_WIDTH + x] = (uint8_t)(visible && bench_inside(s.pts, s.n, x, y));
+                }
+            }
+        }
+        if (memcmp(out, ref, sizeof(out)) != 0)
+        {
+            failed[s.kind]++;
+            continue;
+        }
+        bench_render(&s, 1, 2, 'f', alt);
+        if (memcmp(out, alt, sizeof(out)) != 0)
+        {
+            failed[s.kind]++;
+            continue;
+        }
+        bench_render(&s, 1, 1, '1', alt);
+        if (memcmp(out, alt, sizeof(out)) != 0)
+        {
+            failed[s.kind]++;
+        }
+    }
+    for (int k = 0; k < 4; k++)
+    {
+        fail |= bench_check_group(names[k], count[k], "shapes", failed[k]);
+    }
+    return bench_check_summary(fail, "%d random shapes", BENCH_CHECKS);
+}
+
+/**
+ * @brief One animation frame of a benchmark scene.
+ */
+static void bench_scene(u8g2_t *u8g2, int scene, int frame, int span)
+{
+    switch (scene)
+    {
+        case 0:     /* spinner */
+            for (int i = 0; i < 12; i++)
+            {
+                double a = (i + frame) * (2.0 * M_PI / 12.0);
+                int16_t x0 = (int16_t)lround(64 + 8 * cos(a));
+                int16_t y0 = (int16_t)lround(32 + 8 * sin(a));
+                int16_t x1 = (int16_t)lround(64 + 20 * cos(a));
+                int16_t y1 = (int16_t)lround(32 + 20 * sin(a));
+                if (span)
+                    OLED_Raster_Line(u8g2, x0, y0, x1, y1);
+                else
+                    u8g2_DrawLine(u8g2, x0, y0, x1, y1);
+            }
+            if (span)
+                OLED_Raster_Circle(u8g2, 64, 32, 24, U8G2_DRAW_ALL);
+            else
+                u8g2_DrawCircle(u8g2, 64, 32, 24, U8G2_DRAW_ALL);
+            break;
+
+        case 1:     /* progress bar, rounded ends of radius 6 */
+        {
+            int16_t fill = (int16_t)(8 + frame % 104);
+            if (span)
+            {
+                OLED_Point_t box[4] = {{10, 27}, {fill, 27}, {fill, 38}, {10, 38}};
+                OLED_Raster_Circle(u8g2, 10, 32, 6, U8G2_DRAW_UPPER_LEFT | U8G2_DRAW_LOWER_LEFT);
+                OLED_Raster_Circle(u8g2, 117, 32, 6, U8G2_DRAW_UPPER_RIGHT | U8G2_DRAW_LOWER_RIGHT);
+                OLED_Raster_Line(u8g2, 10, 26, 117, 26);
+                OLED_Raster_Line(u8g2, 10, 38, 117, 38);
+                OLED_Raster_Disc(u8g2, 10, 32, 4, U8G2_DRAW_UPPER_LEFT | U8G2_DRAW_LOWER_LEFT);
+                OLED_Raster_FillPolygon(u8g2, box, 4);
+                OLED_Raster_Disc(u8g2, fill, 32, 4, U8G2_DRAW_UPPER_RIGHT | U8G2_DRAW_LOWER_RIGHT);
+            }
+            else
+            {
+                u8g2_DrawCircle(u8g2, 10, 32, 6, U8G2_DRAW_UPPER_LEFT | U8G2_DRAW_LOWER_LEFT);
+                u8g2_DrawCircle(u8g2, 117, 32, 6, U8G2_DRAW_UPPER_RIGHT | U8G2_DRAW_LOWER_RIGHT);
+                u8g2_DrawLine(u8g2, 10, 26, 117, 26);
+                u8g2_DrawLine(u8g2, 10, 38, 117, 38);
+                u8g2_DrawDisc(u8g2, 10, 32, 4, U8G2_DRAW_UPPER_LEFT | U8G2_DRAW_LOWER_LEFT);
+                u8g2_ClearPolygonXY();
+                u8g2_AddPolygonXY(u8g2, 10, 27);
+                u8g2_AddPolygonXY(u8g2, fill, 27);
+                u8g2_AddPolygonXY(u8g2, fill, 38);
+                u8g2_AddPolygonXY(u8g2, 10, 38);
+                u8g2_DrawPolygon(u8g2);
+                u8g2_DrawDisc(u8g2, (u8g2_uint_t)fill, 32, 4, U8G2_DRAW_UPPER_RIGHT | U8G2_DRAW_LOWER_RIGHT);
+            }
+            break;
+        }
+
+        case 2:     /* disc */
+            if (span)
+                OLED_Raster_Disc(u8g2, (int16_t)(40 + frame % 48), 32, 24, U8G2_DRAW_ALL);
+            else
+                u8g2_DrawDisc(u8g2, (u8g2_uint_t)(40 + frame % 48), 32, 24, U8G2_DRAW_ALL);
+            break;
+
+        default:    /* star */
+        {
+            OLED_Point_t star[10];
+            for (int i = 0; i < 10; i++)
+            {
+                double a = i * (M_PI / 5.0) + frame * 0.05;
+                double r = (i & 1) ? 12.0 : 30.0;
+                star[i].x = (int16_t)lround(64 + r * cos(a));
+                star[i].y = (int16_t)lround(32 + r * sin(a));
+            }
+            if (span)
+            {
+                OLED_Raster_FillPolygon(u8g2, star, 10);
+            }
+            else
+            {
+                for (int i = 0; i < 10; i++)
+                {
+                    const OLED_Point_t *b = &star[(i + 1) % 10];
+                    u8g2_DrawTriangle(u8g2, 64, 32, star[i].x, star[i].y, b->x, b->y);
+                }
+            }
+            break;
+        }
+    }
+}
+
+static double bench_scene_ns(int scene, int span)
+{
+    u8g2_t u8g2;
+    double best = BENCH_NO_TIME;
+
+    vdisplay_setup(&u8g2, 'f');
+    for (int run = 0; run < BENCH_RUNS; run++)
+    {
+        uint64_t t0 = bench_now_ns();
+        for (int frame = 0; frame < BENCH_FRAMES; frame++)
+        {
+            u8g2_ClearBuffer(&u8g2);
+            bench_scene(&u8g2, scene, frame, span);
+        }
+        best = bench_min(best, bench_ns_per(t0, BENCH_FRAMES));
+    }
+    return best;
+}
+
+int main(void)
+{
+    static const char *scenes[] = {"spinner", "progress", "disc", "star"};
+    int fail = bench_check();
+    double clear_ns;
+
+    /* u8g2_ClearBuffer() is part of every frame; report it separately */
+    {
+        u8g2_t u8g2;
+        vdisplay_setup(&u8g2, 'f');
+        uint64_t t0 = bench_now_ns();
+        for (int frame = 0; frame < BENCH_FRAMES; frame++)
+        {
+            u8g2_ClearBuffer(&u8g2);
+        }
+        clear_ns = bench_ns_per(t0, BENCH_FRAMES);
+    }
+
+    printf("\n%-10s %12s %12s %8s   (ns/frame, including %.0f ns u8g2_ClearBuffer)\n", "scene", "u8g2", "span", "speedup", clear_ns);
+    for (int scene = 0; scene < 4; scene++)
+    {
+        double ref = bench_scene_ns(scene, 0);
+        double span = bench_scene_ns(scene, 1);
+        printf("%-10s %12.0f %12.0f %7.1fx\n", scenes[scene], ref, span, ref / span);
+    }
+    return fail;
+}
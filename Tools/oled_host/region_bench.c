@@ -0,0 +1,372 @@
+/**
+ * @file region_bench.c
+ * @author Ted Wang
+ * @date 2026-10-17
+ * @brief Host check and benchmark of the frame buffer region operations (Hardware/oled/oled_region.c).
+ *
+ * Check: on random buffer contents, random rectangles (partly off screen, with and without clip
+ * window) must give exactly the pixels of a per-pixel reference for fill, clear, invert, copy
+ * (overlapping in every direction) and scroll; fill, clear and invert must equal u8g2_DrawBox()
+ * with draw color 1, 0 and 2; page modes must equal full buffer mode.
+ *
+ * Benchmark: typical operations on a full 128x64 buffer, in ns per operation:
+ *   - banner:   invert a 128x16 row at y = 20 (not band aligned), u8g2_DrawBox() with color 2
+ *   - clear:    clear a 100x40 area at (10, 12), u8g2_DrawBox() with color 0
+ *   - fill:     fill the same area, u8g2_DrawBox() with color 1
+ *   - scroll8:  scroll the whole screen up by 8 pixels (one text line); reference: per-pixel copy
+ *   - scroll1:  scroll the whole screen up by 1 pixel; reference: per-pixel copy
+ *
+ * Build (from the repository root):
+ * @code
+ *   gcc -O2 -ITools/oled_host -IHardware/u8g2 -IHardware/oled \
+ *       Tools/oled_host/region_bench.c Tools/oled_host/vdisplay.c Hardware/oled/oled_region.c \
+ *       Hardware/u8g2/u8*.c -o region_bench
+ * @endcode
+ */
+
+#include "bench_util.h"
+#include "vdisplay.h"
+#include "oled_region.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_CHECKS        20000
+#define BENCH_OPS           20000
+#define BENCH_RUNS          5
+#define BENCH_BUF_SIZE      (VDISPLAY_WIDTH * VDISPLAY_HEIGHT / 8)
+
+enum { OP_FILL, OP_CLEAR, OP_INVERT, OP_COPY, OP_SCROLL, OP_COUNT };
+
+static int bench_rand(int lo, int hi)
+{
+    return lo + rand() % (hi - lo + 1);
+}
+
+static int bench_get(const uint8_t *buf, int x, int y)
+{
+    return (buf[(y >> 3) * VDISPLAY_WIDTH + x] >> (y & 7)) & 1;
+}
+
+static void bench_set(uint8_t *buf, int x, int y, int v)
+{
+    uint8_t bit = (uint8_t)(1u << (y & 7));
+
+    if (v)
+        buf[(y >> 3) * VDISPLAY_WIDTH + x] |= bit;
+    else
+        buf[(y >> 3) * VDISPLAY_WIDTH + x] &= (uint8_t)~bit;
+}
+
+/**
+ * @brief Random operation with its rectangle, offset and clip window.
+ */
+typedef struct {
+    int op;
+    int x, y, w, h;
+    int dx, dy;                 /* copy destination offset / scroll offset */
+    int clip;
+    int cx0, cy0, cx1, cy1;
+} bench_op_t;
+
+static void bench_random_op(bench_op_t *o)
+{
+    o->op = rand() % OP_COUNT;
+    o->x = bench_rand(-20, 140);
+    o->y = bench_rand(-20, 75);
+    o->w = bench_rand(0, 100);
+    o->h = bench_rand(0, 70);
+    o->dx = bench_rand(-40, 40);
+    o->dy = bench_rand(-40, 40);
+    if (rand() % 4 == 0)
+    {
+        o->dx = 0;
+    }
+    if (rand() % 4 == 0)
+    {
+        o->dy = (rand() % 2) ? 8 * bench_rand(-4, 4) : 0;
+    }
+    o->clip = rand() % 3 == 0;
+    o->cx0 = bench_rand(0, 100);
+    o->cy0 = bench_rand(0, 50);
+    o->cx1 = bench_rand(o->cx0 + 1, 128);
+    o->cy1 = bench_rand(o->cy0 + 1, 64);
+}
+
+static int bench_visible(const bench_op_t *o, int x, int y)
+{
+    if (x < 0 || y < 0 || x >= VDISPLAY_WIDTH || y >= VDISPLAY_HEIGHT)
+        return 0;
+    return !o->clip || (x >= o->cx0 && x < o->cx1 && y >= o->cy0 && y < o->cy1);
+}
+
+static int bench_in_rect(const bench_op_t *o, int x, int y)
+{
+    return x >= o->x && x < o->x + o->w && y >= o->y && y < o->y + o->h;
+}
+
+/**
+ * @brief Per-pixel reference of an operation on a full buffer.
+ */
+static void bench_reference(const bench_op_t *o, const uint8_t *in, uint8_t *out)
+{
+    memcpy(out, in, BENCH_BUF_SIZE);
+    for (int y = 0; y < VDISPLAY_HEIGHT; y++)
+    {
+        for (int x = 0; x < VDISPLAY_WIDTH; x++)
+        {
+            int sx = x - o->dx;
+            int sy = y - o->dy;
+
+            if (!bench_visible(o, x, y))
+                continue;
+            switch (o->op)
+            {
+                case OP_FILL:
+                    if (bench_in_rect(o, x, y))
+                        bench_set(out, x, y, 1);
+                    break;
+                case OP_CLEAR:
+                    if (bench_in_rect(o, x, y))
+                        bench_set(out, x, y, 0);
+                    break;
+                case OP_INVERT:
+                    if (bench_in_rect(o, x, y))
+                        bench_set(out, x, y, !bench_get(in, x, y));
+                    break;
+                case OP_COPY:
+                    /* Destination rectangle is the source moved by (dx, dy) */
+                    if ((o->dx != 0 || o->dy != 0) && bench_in_rect(o, sx, sy) && bench_visible(o, sx, sy))
+                        bench_set(out, x, y, bench_get(in, sx, sy));
+                    break;
+                default:
+                    if (!bench_in_rect(o, x, y))
+                        break;
+                    if (!bench_in_rect(o, sx, sy))
+                        bench_set(out, x, y, 0);
+                    else if (bench_visible(o, sx, sy))
+                        bench_set(out, x, y, bench_get(in, sx, sy));
+                    break;
+            }
+        }
+    }
+}
+
+static void bench_apply(u8g2_t *u8g2, const bench_op_t *o)
+{
+    if (o->clip)
+    {
+        u8g2_SetClipWindow(u8g2, o->cx0, o->cy0, o->cx1, o->cy1);
+    }
+    switch (o->op)
+    {
+        case OP_FILL:
+            OLED_Region_Fill(u8g2, o->x, o->y, o->w, o->h);
+            break;
+        case OP_CLEAR:
+            OLED_Region_Clear(u8g2, o->x, o->y, o->w, o->h);
+            break;
+        case OP_INVERT:
+            OLED_Region_Invert(u8g2, o->x, o->y, o->w, o->h);
+            break;
+        case OP_COPY:
+            OLED_Region_Copy(u8g2, o->x, o->y, o->w, o->h, o->x + o->dx, o->y + o->dy);
+            break;
+        default:
+            OLED_Region_Scroll(u8g2, o->x, o->y, o->w, o->h, o->dx, o->dy);
+            break;
+    }
+    u8g2_SetMaxClipWindow(u8g2);
+}
+
+/**
+ * @brief Draws some content, then the operation, in the given buffer mode; returns the pixels.
+ */
+static void bench_render(const bench_op_t *o, char mode, int u8g2_box, uint8_t *pixels)
+{
+    u8g2_t u8g2;
+
+    vdisplay_setup(&u8g2, mode);
+    u8g2_FirstPage(&u8g2);
+    do
+    {
+        u8g2_SetFont(&u8g2, u8g2_font_6x10_tf);
+        u8g2_DrawStr(&u8g2, 0, 10, "Region ops 0123456789");
+        u8g2_DrawStr(&u8g2, 3, 33, "ABCDEFGHIJKLMNOPQRSTU");
+        u8g2_DrawBox(&u8g2, 20, 40, 70, 20);
+        u8g2_DrawFrame(&u8g2, 5, 13, 118, 50);
+        if (u8g2_box)
+        {
+            if (o->clip)
+                u8g2_SetClipWindow(&u8g2, o->cx0, o->cy0, o->cx1, o->cy1);
+            u8g2_SetDrawColor(&u8g2, (o->op == OP_FILL) ? 1 : (o->op == OP_CLEAR) ? 0 : 2);
+            u8g2_DrawBox(&u8g2, o->x, o->y, o->w, o->h);
+            u8g2_SetDrawColor(&u8g2, 1);
+            u8g2_SetMaxClipWindow(&u8g2);
+        }
+        else
+        {
+            bench_apply(&u8g2, o);
+        }
+    } while (u8g2_NextPage(&u8g2));
+    vdisplay_snapshot(pixels);
+}
+
+static int bench_check(void)
+{
+    static const char *names[] = {"fill", "clear", "invert", "copy", "scroll"};
+    unsigned failed[OP_COUNT] = {0};
+    unsigned count[OP_COUNT] = {0};
+    uint8_t in[BENCH_BUF_SIZE];
+    uint8_t ref[BENCH_BUF_SIZE];
+    uint8_t full[VDISPLAY_WIDTH * VDISPLAY_HEIGHT];
+    uint8_t alt[VDISPLAY_WIDTH * VDISPLAY_HEIGHT];
+    u8g2_t u8g2;
+    int fail = 0;
+
+    srand(1);
+    vdisplay_setup(&u8g2, 'f');
+    for (int i = 0; i < BENCH_CHECKS; i++)
+    {
+        bench_op_t o;
+        uint8_t *buf = u8g2_GetBufferPtr(&u8g2);
+
+        bench_random_op(&o);
+        count[o.op]++;
+        for (int k = 0; k < BENCH_BUF_SIZE; k++)
+        {
+            in[k] = (uint8_t)rand();
+        }
+        memcpy(buf, in, BENCH_BUF_SIZE);
+        bench_apply(&u8g2, &o);
+        bench_reference(&o, in, ref);
+        if (memcmp(buf, ref, BENCH_BUF_SIZE) != 0)
+        {
+            failed[o.op]++;
+            continue;
+        }
+
+        /* Page modes (copy and scroll only move rows inside a page there, so they are not compared) */
+        if (o.op <= OP_INVERT)
+        {
+            bench_render(&o, 'f', 0, full);
+            bench_render(&o, '1', 0, alt);
+            if (memcmp(full, alt, sizeof(full)) != 0)
+            {
+                failed[o.op]++;
+                continue;
+            }
+            bench_render(&o, '2', 0, alt);
+            if (memcmp(full, alt, sizeof(full)) != 0)
+            {
+                failed[o.op]++;
+                continue;
+            }
+            /* u8g2 takes 8-bit unsigned coordinates */
+            if (o.x >= 0 && o.y >= 0)
+            {
+                bench_render(&o, 'f', 1, alt);
+                if (memcmp(full, alt, sizeof(full)) != 0)
+                {
+                    failed[o.op]++;
+                }
+            }
+        }
+    }
+    for (int k = 0; k < OP_COUNT; k++)
+    {
+        fail |= bench_check_group(names[k], count[k], "operations", failed[k]);
+    }
+    return bench_check_summary(fail, "%d random operations", BENCH_CHECKS);
+}
+
+/**
+ * @brief Per-pixel scroll of the whole screen, the reference for scroll8/scroll1.
+ */
+static void bench_pixel_scroll(uint8_t *buf, int dy)
+{
+    for (int y = 0; y < VDISPLAY_HEIGHT; y++)
+    {
+        for (int x = 0; x < VDISPLAY_WIDTH; x++)
+        {
+            bench_set(buf, x, y, (y + dy < VDISPLAY_HEIGHT) ? bench_get(buf, x, y + dy) : 0);
+        }
+    }
+}
+
+/**
+ * @brief One operation of a benchmark case.
+ */
+static void bench_case(u8g2_t *u8g2, int c, int region)
+{
+    switch (c)
+    {
+        case 0:
+            if (region)
+            {
+                OLED_Region_Invert(u8g2, 0, 20, 128, 16);
+            }
+            else
+            {
+                u8g2_SetDrawColor(u8g2, 2);
+                u8g2_DrawBox(u8g2, 0, 20, 128, 16);
+                u8g2_SetDrawColor(u8g2, 1);
+            }
+            break;
+        case 1:
+        case 2:
+            if (region)
+            {
+                if (c == 1)
+                    OLED_Region_Clear(u8g2, 10, 12, 100, 40);
+                else
+                    OLED_Region_Fill(u8g2, 10, 12, 100, 40);
+            }
+            else
+            {
+                u8g2_SetDrawColor(u8g2, (c == 1) ? 0 : 1);
+                u8g2_DrawBox(u8g2, 10, 12, 100, 40);
+                u8g2_SetDrawColor(u8g2, 1);
+            }
+            break;
+        default:
+            if (region)
+                OLED_Region_Scroll(u8g2, 0, 0, 128, 64, 0, (c == 3) ? -8 : -1);
+            else
+                bench_pixel_scroll(u8g2_GetBufferPtr(u8g2), (c == 3) ? 8 : 1);
+            break;
+    }
+}
+
+static double bench_case_ns(int c, int region)
+{
+    u8g2_t u8g2;
+    double best = BENCH_NO_TIME;
+
+    vdisplay_setup(&u8g2, 'f');
+    for (int run = 0; run < BENCH_RUNS; run++)
+    {
+        uint64_t t0 = bench_now_ns();
+        for (int i = 0; i < BENCH_OPS; i++)
+        {
+            bench_case(&u8g2, c, region);
+        }
+        best = bench_min(best, bench_ns_per(t0, BENCH_OPS));
+    }
+    return best;
+}
+
+int main(void)
+{
+    static const char *cases[] = {"banner", "clear", "fill", "scroll8", "scroll1"};
+    int fail = bench_check();
+
+    printf("\n%-10s %12s %12s %8s   (ns/operation)\n", "case", "reference", "region", "speedup");
+    for (int c = 0; c < 5; c++)
+    {
+        double ref = bench_case_ns(c, 0);
+        double region = bench_case_ns(c, 1);
+        printf("%-10s %12.0f %12.0f %7.1fx\n", cases[c], ref, region, ref / region);
+    }
+    return fail;
+}
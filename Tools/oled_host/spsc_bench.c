@@ -0,0 +1,466 @@
+/**
+ * @file spsc_bench.c
+ * @author Ted Wang
+ * @date 2026-10-17
+ * @brief Host check and benchmark of the SPSC ring buffer (Core/Inc/spsc_ring.h) against a locked queue.
+ *
+ * Check:
+ *   - model: random bulk pushes, pops and peek/skip on rings of several capacities and element
+ *     sizes (also across the 2^32 index wrap) must match a plain reference FIFO;
+ *   - threads: a producer and a consumer thread move a numbered stream through a small ring with
+ *     random batch sizes; the consumer must see every number exactly once and in order.
+ *
+ * Benchmark, 16-byte elements:
+ *   - pair:  one push and one pop on the same thread (the cost per element a task or an interrupt
+ *            pays on the single-core target), in ns;
+ *   - flow:  elements per second from a producer thread to a consumer thread, one element per
+ *            call and in batches of 16.
+ * The baseline is a bounded queue as osMessageQueue implements it: by-value copy, a lock around
+ * every put and get and blocking on full/empty (pthread mutex and condition variables here,
+ * critical sections and task lists on FreeRTOS).
+ *
+ * Build (from the repository root):
+ * @code
+ *   gcc -O2 -ICore/Inc Tools/oled_host/spsc_bench.c -lpthread -o spsc_bench
+ * @endcode
+ */
+
+#include "bench_util.h"
+#include "spsc_ring.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_MODEL_OPS         200000
+#define BENCH_THREAD_ITEMS      5000000u
+#define BENCH_PAIRS             5000000u
+#define BENCH_FLOW_ITEMS        5000000u
+#define BENCH_CAPACITY          256u
+#define BENCH_RUNS              3
+
+/**
+ * @brief Benchmark element (the size of a small log or trace message).
+ */
+typedef struct {
+    uint32_t seq;
+    uint32_t a;
+    uint32_t b;
+    uint32_t c;
+} bench_item_t;
+
+static uint32_t bench_rand_state = 12345;
+
+static uint32_t bench_rand(void)
+{
+    bench_rand_state = bench_rand_state * 1103515245u + 12345u;
+    return bench_rand_state >> 8;
+}
+
+/* ---- locked queue (osMessageQueue model) ---- */
+
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t not_full;
+    pthread_cond_t not_empty;
+    uint32_t head;
+    uint32_t count;
+    uint32_t capacity;
+    uint32_t elem_size;
+    uint8_t *buf;
+} lockq_t;
+
+static void lockq_init(lockq_t *q, void *buf, uint32_t capacity, uint32_t elem_size)
+{
+    pthread_mutex_init(&q->lock, NULL);
+    pthread_cond_init(&q->not_full, NULL);
+    pthread_cond_init(&q->not_empty, NULL);
+    q->head = 0;
+    q->count = 0;
+    q->capacity = capacity;
+    q->elem_size = elem_size;
+    q->buf = buf;
+}
+
+static void lockq_put(lockq_t *q, const void *item)
+{
+    pthread_mutex_lock(&q->lock);
+    while (q->count == q->capacity)
+    {
+        pthread_cond_wait(&q->not_full, &q->lock);
+    }
+    memcpy(q->buf + ((q->head + q->count) % q->capacity) * q->elem_size, item, q->elem_size);
+    q->count++;
+    pthread_cond_signal(&q->not_empty);
+    pthread_mutex_unlock(&q->lock);
+}
+
+static void lockq_get(lockq_t *q, void *item)
+{
+    pthread_mutex_lock(&q->lock);
+    while (q->count == 0)
+    {
+        pthread_cond_wait(&q->not_empty, &q->lock);
+    }
+    memcpy(item, q->buf + q->head * q->elem_size, q->elem_size);
+    q->head = (q->head + 1) % q->capacity;
+    q->count--;
+    pthread_cond_signal(&q->not_full);
+    pthread_mutex_unlock(&q->lock);
+}
+
+/* ---- checks ---- */
+
+/**
+ * @brief Random operations against a reference FIFO. Returns the number of failures.
+ */
+static int bench_check_model(uint32_t capacity, uint32_t elem_size, uint32_t start_index)
+{
+    uint8_t *mem = malloc(capacity * elem_size);
+    uint8_t *ref = malloc((capacity + 32u) * elem_size);
+    uint8_t in[32 * 16];
+    uint8_t out[32 * 16];
+    size_t ref_head = 0;
+    size_t ref_tail = 0;
+    uint8_t next = 0;
+    SpscRing_t ring;
+    int failures = 0;
+
+    SpscRing_Init(&ring, mem, capacity, elem_size);
+    ring.head = ring.tail = start_index;
+    for (int op = 0; op < BENCH_MODEL_OPS && failures == 0; op++)
+    {
+        uint32_t n = bench_rand() % 33u;
+        uint32_t done;
+        uint32_t expect;
+
+        switch (bench_rand() % 3u)
+        {
+        case 0:
+            /* Keep the reference FIFO at the start of its buffer */
+            memmove(ref, ref + ref_tail * elem_size, (ref_head - ref_tail) * elem_size);
+            ref_head -= ref_tail;
+            ref_tail = 0;
+            for (uint32_t i = 0; i < n * elem_size; i++)
+            {
+                in[i] = next++;
+            }
+            expect = capacity - (uint32_t)(ref_head - ref_tail);
+            expect = (n < expect) ? n : expect;
+            done = SpscRing_Push(&ring, in, n);
+            memcpy(ref + ref_head * elem_size, in, done * elem_size);
+            ref_head += done;
+            next = (uint8_t)(next - (n - done) * elem_size);
+            break;
+        case 1:
+            expect = (uint32_t)(ref_head - ref_tail);
+            expect = (n < expect) ? n : expect;
+            done = SpscRing_Pop(&ring, out, n);
+            if (done == expect && memcmp(out, ref + ref_tail * elem_size, done * elem_size) != 0)
+            {
+                failures++;
+            }
+            ref_tail += done;
+            break;
+        default:
+        {
+            uint32_t count;
+            uint32_t contiguous = capacity - (ring.tail & (capacity - 1u));
+            uint8_t *p = SpscRing_Peek(&ring, &count);
+
+            expect = (uint32_t)(ref_head - ref_tail);
+            expect = (contiguous < expect) ? contiguous : expect;
+            done = (n < count) ? n : count;
+            if (count != expect || memcmp(p, ref + ref_tail * elem_size, done * elem_size) != 0)
+            {
+                failures++;
+            }
+            SpscRing_Skip(&ring, done);
+            ref_tail += done;
+            done = count;
+            break;
+        }
+        }
+        if (done != expect || SpscRing_Count(&ring) != ref_head - ref_tail ||
+            SpscRing_Free(&ring) != capacity - (ref_head - ref_tail))
+        {
+            failures++;
+        }
+    }
+    if (failures != 0)
+    {
+        (void)bench_check_fail("model capacity %u, element %u B, start %08X", capacity, elem_size, start_index);
+    }
+    free(mem);
+    free(ref);
+    return failures;
+}
+
+typedef struct {
+    SpscRing_t *ring;
+    uint32_t items;
+    uint32_t batch;         /* 0: random batches */
+    uint32_t errors;
+} bench_flow_t;
+
+static void *bench_producer(void *arg)
+{
+    bench_flow_t *flow = arg;
+    bench_item_t items[32];
+    uint32_t seq = 0;
+    uint32_t rand_state = 777;
+
+    while (seq < flow->items)
+    {
+        uint32_t n = flow->batch;
+        uint32_t done;
+
+        if (n == 0)
+        {
+            rand_state = rand_state * 1103515245u + 12345u;
+            n = 1 + (rand_state >> 8) % 32u;
+        }
+        if (n > flow->items - seq)
+        {
+            n = flow->items - seq;
+        }
+        for (uint32_t i = 0; i < n; i++)
+        {
+            items[i].seq = seq + i;
+            items[i].a = ~(seq + i);
+        }
+        done = SpscRing_Push(flow->ring, items, n);
+        seq += done;
+        if (done == 0)
+        {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+static void *bench_consumer(void *arg)
+{
+    bench_flow_t *flow = arg;
+    bench_item_t items[32];
+    uint32_t seq = 0;
+    uint32_t rand_state = 999;
+
+    while (seq < flow->items)
+    {
+        uint32_t n = flow->batch;
+        uint32_t done;
+
+        if (n == 0)
+        {
+            rand_state = rand_state * 1103515245u + 12345u;
+            n = 1 + (rand_state >> 8) % 32u;
+        }
+        done = SpscRing_Pop(flow->ring, items, n);
+        for (uint32_t i = 0; i < done; i++)
+        {
+            if (items[i].seq != seq + i || items[i].a != ~(seq + i))
+            {
+                flow->errors++;
+            }
+        }
+        seq += done;
+        if (done == 0)
+        {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Runs a producer and a consumer thread through an SPSC ring; returns elements per second.
+ */
+static double bench_spsc_flow(uint32_t items, uint32_t batch, uint32_t capacity, uint32_t *errors)
+{
+    static bench_item_t mem[4096];
+    SpscRing_t ring;
+    bench_flow_t flow = {&ring, items, batch, 0};
+    pthread_t producer;
+    pthread_t consumer;
+    uint64_t t0;
+
+    SpscRing_Init(&ring, mem, capacity, sizeof(bench_item_t));
+    t0 = bench_now_ns();
+    pthread_create(&consumer, NULL, bench_consumer, &flow);
+    pthread_create(&producer, NULL, bench_producer, &flow);
+    pthread_join(producer, NULL);
+    pthread_join(consumer, NULL);
+    *errors += flow.errors;
+    return items * 1e9 / (double)(bench_now_ns() - t0);
+}
+
+static int bench_check(void)
+{
+    static const uint32_t capacities[] = {1, 2, 8, 64};
+    static const uint32_t sizes[] = {1, 3, 8, 16};
+    int failures = 0;
+    unsigned layouts = 0;
+    uint32_t errors = 0;
+    SpscRing_t ring;
+    uint8_t mem[16];
+
+    if (SpscRing_Init(&ring, mem, 12, 1) || SpscRing_Init(&ring, mem, 0, 1) || SpscRing_Init(&ring, mem, 8, 0))
+    {
+        failures += bench_check_fail("init accepts an invalid capacity or element size");
+    }
+    for (size_t c = 0; c < sizeof(capacities) / sizeof(capacities[0]); c++)
+    {
+        for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+        {
+            failures += bench_check_model(capacities[c], sizes[s], 0);
+            failures += bench_check_model(capacities[c], sizes[s], 0xFFFFFF00u);
+            layouts += 2;
+        }
+    }
+    bench_spsc_flow(BENCH_THREAD_ITEMS, 0, 8, &errors);
+    bench_spsc_flow(BENCH_THREAD_ITEMS, 0, 64, &errors);
+    if (errors != 0)
+    {
+        failures += bench_check_fail("threads: %u elements lost, duplicated or out of order", errors);
+    }
+    return bench_check_summary(failures, "model on %u ring layouts, %u elements through two threads",
+                               layouts, 2 * BENCH_THREAD_ITEMS);
+}
+
+/* ---- benchmarks ---- */
+
+typedef struct {
+    lockq_t *q;
+    uint32_t items;
+    uint32_t errors;
+} lockq_flow_t;
+
+static void *lockq_producer(void *arg)
+{
+    lockq_flow_t *flow = arg;
+    bench_item_t item = {0, 0, 0, 0};
+
+    for (uint32_t seq = 0; seq < flow->items; seq++)
+    {
+        item.seq = seq;
+        lockq_put(flow->q, &item);
+    }
+    return NULL;
+}
+
+static void *lockq_consumer(void *arg)
+{
+    lockq_flow_t *flow = arg;
+    bench_item_t item;
+
+    for (uint32_t seq = 0; seq < flow->items; seq++)
+    {
+        lockq_get(flow->q, &item);
+        flow->errors += (item.seq != seq);
+    }
+    return NULL;
+}
+
+static double bench_lockq_flow(uint32_t items, uint32_t *errors)
+{
+    static bench_item_t mem[BENCH_CAPACITY];
+    lockq_t q;
+    lockq_flow_t flow = {&q, items, 0};
+    pthread_t producer;
+    pthread_t consumer;
+    uint64_t t0;
+
+    lockq_init(&q, mem, BENCH_CAPACITY, sizeof(bench_item_t));
+    t0 = bench_now_ns();
+    pthread_create(&consumer, NULL, lockq_consumer, &flow);
+    pthread_create(&producer, NULL, lockq_producer, &flow);
+    pthread_join(producer, NULL);
+    pthread_join(consumer, NULL);
+    *errors += flow.errors;
+    return items * 1e9 / (double)(bench_now_ns() - t0);
+}
+
+/**
+ * @brief ns per push + pop of one element on one thread (best of BENCH_RUNS).
+ */
+static double bench_pair_ns(int locked)
+{
+    static bench_item_t mem[BENCH_CAPACITY];
+    bench_item_t item = {1, 2, 3, 4};
+    bench_item_t out;
+    volatile uint32_t sink = 0;
+    double best = BENCH_NO_TIME;
+
+    for (int run = 0; run < BENCH_RUNS; run++)
+    {
+        SpscRing_t ring;
+        lockq_t q;
+        uint64_t t0;
+
+        SpscRing_Init(&ring, mem, BENCH_CAPACITY, sizeof(bench_item_t));
+        lockq_init(&q, mem, BENCH_CAPACITY, sizeof(bench_item_t));
+        t0 = bench_now_ns();
+        for (uint32_t i = 0; i < BENCH_PAIRS; i++)
+        {
+            item.seq = i;
+            if (locked)
+            {
+                lockq_put(&q, &item);
+                lockq_get(&q, &out);
+            }
+            else
+            {
+                SpscRing_Push(&ring, &item, 1);
+                SpscRing_Pop(&ring, &out, 1);
+            }
+            sink += out.seq;
+        }
+        best = bench_min(best, bench_ns_per(t0, BENCH_PAIRS));
+    }
+    (void)sink;
+    return best;
+}
+
+static double bench_best_flow(int kind, uint32_t *errors)
+{
+    double best = 0;
+
+    for (int run = 0; run < BENCH_RUNS; run++)
+    {
+        double rate = (kind == 0) ? bench_lockq_flow(BENCH_FLOW_ITEMS, errors)
+                                  : bench_spsc_flow(BENCH_FLOW_ITEMS, (kind == 1) ? 1 : 16, BENCH_CAPACITY, errors);
+        best = (rate > best) ? rate : best;
+    }
+    return best;
+}
+
+int main(void)
+{
+    int fail = bench_check();
+    uint32_t errors = 0;
+    double locked_pair;
+    double spsc_pair;
+    double locked_flow;
+    double spsc_flow1;
+    double spsc_flow16;
+
+    locked_pair = bench_pair_ns(1);
+    spsc_pair = bench_pair_ns(0);
+    locked_flow = bench_best_flow(0, &errors);
+    spsc_flow1 = bench_best_flow(1, &errors);
+    spsc_flow16 = bench_best_flow(2, &errors);
+    if (errors != 0)
+    {
+        fail = bench_check_fail("benchmark streams: %u errors", errors);
+    }
+
+    printf("\n%-22s %14s %16s\n", "16-byte elements", "push+pop ns", "thread flow /s");
+    printf("%-22s %14.1f %16.0f\n", "locked queue", locked_pair, locked_flow);
+    printf("%-22s %14.1f %16.0f\n", "spsc ring, 1 per call", spsc_pair, spsc_flow1);
+    printf("%-22s %14s %16.0f\n", "spsc ring, 16 per call", "-", spsc_flow16);
+    printf("\nspeedup: push+pop %.1fx, flow %.1fx (1 per call) / %.1fx (16 per call)\n",
+           locked_pair / spsc_pair, spsc_flow1 / locked_flow, spsc_flow16 / locked_flow);
+    return fail;
+}
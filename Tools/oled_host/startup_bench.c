@@ -0,0 +1,164 @@
+/**
+ * @file startup_bench.c
+ * @author Ted Wang
+ * @date 2026-10-17
+ * @brief Host model of the driver startup delays before and after the RTOS-aware delay service.
+ *
+ * The SH1106 startup of OLED_Display_Init() (u8g2_InitDisplay() and u8g2_SetPowerSave()) and the
+ * first u8g2_ClearDisplay() are run through the real u8x8 code with a gpio_and_delay callback that
+ * records every delay request. Each request is then costed twice:
+ *   - before: U8X8_MSG_DELAY_MILLI n was HAL_Delay(n), U8X8_MSG_DELAY_10MICRO was HAL_Delay(1)
+ *     (both busy-waits of n..n+1 ms; the midpoint is used), U8X8_MSG_DELAY_100NANO a single NOP;
+ *   - after (timing.c): milliseconds are osDelay(n + 1) task sleeps of n..n+1 ms, 10 us and 100 ns
+ *     steps are DWT busy-waits of exactly the requested time.
+ * MFRC522_Init() is costed from its code: register accesses over SPI2 (APB1 42 MHz / 4 = 10.5 MHz, 2 bytes
+ * each plus an assumed HAL overhead per byte), the RST pulse (1 us busy), the MFRC522_STARTUP_MS sleep and
+ * the PowerDown poll of MFRC522_Reset() (assumed to clear at the first 1 ms poll).
+ *
+ * Bus time of the SH1106 commands is the same before and after and is left out. The figures are a
+ * model, not a measurement on the target; the RC522 and OLED tasks print the measured wall and
+ * busy-wait time of their startup on UART3.
+ *
+ * Build (from the repository root):
+ * @code
+ *   gcc -O2 -IHardware/u8g2 Tools/oled_host/startup_bench.c Hardware/u8g2/u8*.c -o startup_bench
+ * @endcode
+ */
+
+#include "u8g2.h"
+#include <stdio.h>
+#include <string.h>
+
+#define BENCH_MAX_DELAYS            64
+#define BENCH_SPI_HAL_US            1.25    /* Assumed HAL_SPI_TransmitReceive() overhead per byte */
+#define BENCH_SPI_BYTE_US           (8.0 / 10.5 + BENCH_SPI_HAL_US)    /* 8 bits at 10.5 MHz (MX_SPI2_Init) plus overhead */
+#define BENCH_MFRC522_ACCESSES      9       /* Register accesses of MFRC522_Init() before: soft reset, 6 setup writes, AntennaOn() read+write */
+#define BENCH_MFRC522_POLL_READS    2       /* CommandReg reads of the PowerDown poll (set, then clear after 1 ms) */
+#define BENCH_MFRC522_STARTUP_MS    50      /* MFRC522_STARTUP_MS (RC522.h) */
+
+/**
+ * @brief One recorded delay request.
+ */
+typedef struct {
+    uint8_t msg;
+    uint8_t arg;
+} bench_delay_t;
+
+static u8g2_t bench_u8g2;
+static bench_delay_t bench_delays[BENCH_MAX_DELAYS];
+static uint32_t bench_delay_count;
+
+static uint8_t bench_byte_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+    (void)u8x8; (void)msg; (void)arg_int; (void)arg_ptr;
+    return 1;
+}
+
+static uint8_t bench_gpio_and_delay_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+    (void)u8x8; (void)arg_ptr;
+    switch (msg)
+    {
+        case U8X8_MSG_DELAY_MILLI:
+        case U8X8_MSG_DELAY_10MICRO:
+        case U8X8_MSG_DELAY_100NANO:
+        case U8X8_MSG_DELAY_NANO:
+            if (bench_delay_count < BENCH_MAX_DELAYS)
+            {
+                bench_delays[bench_delay_count].msg = msg;
+                bench_delays[bench_delay_count].arg = arg_int;
+                bench_delay_count++;
+            }
+            return 1;
+        default:
+            return 1;
+    }
+}
+
+/**
+ * @brief Wall and busy-wait time of a startup phase (microseconds).
+ */
+typedef struct {
+    double wall_us;
+    double busy_us;
+} bench_cost_t;
+
+static void bench_cost_delays(bench_cost_t *before, bench_cost_t *after)
+{
+    memset(before, 0, sizeof(*before));
+    memset(after, 0, sizeof(*after));
+    for (uint32_t i = 0; i < bench_delay_count; i++)
+    {
+        double arg = bench_delays[i].arg;
+        double b = 0.0;
+        double a_busy = 0.0;
+        double a_sleep = 0.0;
+
+        switch (bench_delays[i].msg)
+        {
+            case U8X8_MSG_DELAY_MILLI:
+                b = (arg + 0.5) * 1000.0;
+                a_sleep = (arg + 0.5) * 1000.0;
+                break;
+            case U8X8_MSG_DELAY_10MICRO:
+                b = 1.5 * 1000.0;
+                a_busy = 10.0 * arg;
+                break;
+            case U8X8_MSG_DELAY_100NANO:
+                a_busy = 0.1 * arg;
+                break;
+            default:
+                a_busy = 0.001 * arg;
+                break;
+        }
+        before->wall_us += b;
+        before->busy_us += b;
+        after->wall_us += a_busy + a_sleep;
+        after->busy_us += a_busy;
+    }
+}
+
+static void bench_print(const char *name, const bench_cost_t *before, const bench_cost_t *after)
+{
+    printf("  %-16s %10.3f %10.3f %10.3f %10.3f\n", name,
+           before->wall_us / 1000.0, before->busy_us / 1000.0, after->wall_us / 1000.0, after->busy_us / 1000.0);
+}
+
+int main(void)
+{
+    bench_cost_t oled_before;
+    bench_cost_t oled_after;
+    bench_cost_t rc522_before;
+    bench_cost_t rc522_after;
+    uint32_t counts[4] = {0};
+    double spi_us = BENCH_MFRC522_ACCESSES * 2 * BENCH_SPI_BYTE_US;
+
+    u8g2_Setup_sh1106_i2c_128x64_noname_f(&bench_u8g2, U8G2_R0, bench_byte_cb, bench_gpio_and_delay_cb);
+    u8g2_InitDisplay(&bench_u8g2);
+    u8g2_SetPowerSave(&bench_u8g2, 0);
+    u8g2_ClearDisplay(&bench_u8g2);
+    for (uint32_t i = 0; i < bench_delay_count; i++)
+    {
+        switch (bench_delays[i].msg)
+        {
+            case U8X8_MSG_DELAY_MILLI: counts[0]++; break;
+            case U8X8_MSG_DELAY_10MICRO: counts[1]++; break;
+            case U8X8_MSG_DELAY_100NANO: counts[2]++; break;
+            default: counts[3]++; break;
+        }
+    }
+    bench_cost_delays(&oled_before, &oled_after);
+
+    // Before: register accesses only; after: RST pulse, oscillator sleep, soft reset poll with one 1 ms sleep
+    rc522_before.wall_us = spi_us;
+    rc522_before.busy_us = spi_us;
+    rc522_after.busy_us = spi_us + 1.0 + BENCH_MFRC522_POLL_READS * 2 * BENCH_SPI_BYTE_US;
+    rc522_after.wall_us = rc522_after.busy_us + (BENCH_MFRC522_STARTUP_MS + 0.5) * 1000.0 + 1.5 * 1000.0;
+
+    printf("SH1106 startup delay requests: %u milli, %u 10micro, %u 100nano, %u nano\n",
+           counts[0], counts[1], counts[2], counts[3]);
+    printf("  %-16s %10s %10s %10s %10s\n", "phase (ms)", "wall old", "busy old", "wall new", "busy new");
+    bench_print("OLED_Init", &oled_before, &oled_after);
+    bench_print("MFRC522_Init", &rc522_before, &rc522_after);
+    return 0;
+}
@@ -0,0 +1,208 @@
+/**
+ * @file transport_bench.c
+ * @author Ted Wang
+ * @date 2026-10-17
+ * @brief Host comparison of the OLED transports: full frame bytes and bus time on I2C and SPI.
+ *
+ * One u8g2_SendBuffer() of a SH1106 128x64 is captured twice through the real u8x8 command
+ * sequences: with the fast I2C sequence (u8x8_cad_ssd13xx_fast_i2c, one transfer per 32 byte I2C
+ * write like u8x8_byte_stm32_i2c()) and with the 4-wire SPI sequence (u8x8_cad_001, split into
+ * runs of one DC level of at most 32 bytes like u8x8_byte_stm32_spi()). The bus time of a frame is
+ * then derived for several clocks:
+ *   - I2C: 9 bit times per byte (8 data bits + ACK) plus the address byte, start and stop of every
+ *     transfer, plus a fixed DMA/interrupt overhead per transfer;
+ *   - SPI: 8 bit times per byte, plus a fixed overhead per run (DC/CS GPIO writes, DMA start and
+ *     completion interrupt).
+ * Blocking transfers add the render time to the bus time; DMA transfers overlap the two, so a frame
+ * takes the longer of both.
+ *
+ * Build (from the repository root):
+ * @code
+ *   gcc -O2 -IHardware/u8g2 Tools/oled_host/transport_bench.c Hardware/u8g2/u8*.c -o transport_bench
+ * @endcode
+ * Usage: transport_bench [-r render_us]
+ */
+
+#include "u8g2.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define BENCH_MAX_TRANSFERS     256
+#define BENCH_SLOT_BYTES        32
+#define BENCH_I2C_OVERHEAD_US   15
+#define BENCH_SPI_OVERHEAD_US   3
+
+/**
+ * @brief Captured transfers (I2C writes or SPI runs) of one full frame.
+ */
+typedef struct {
+    uint8_t len[BENCH_MAX_TRANSFERS];
+    uint16_t count;
+    uint32_t bytes;
+    uint8_t dc;                     /* SPI: current DC level */
+    uint8_t open;                   /* 1 while a transfer or run is being assembled */
+} bench_capture_t;
+
+static u8g2_t bench_u8g2;
+static uint8_t bench_buffer[1024];
+static bench_capture_t bench_i2c;
+static bench_capture_t bench_spi;
+
+static void bench_close(bench_capture_t *c)
+{
+    if (c->open && c->len[c->count] > 0 && c->count < BENCH_MAX_TRANSFERS - 1)
+    {
+        c->count++;
+    }
+    c->open = 0;
+}
+
+static void bench_open(bench_capture_t *c)
+{
+    c->len[c->count] = 0;
+    c->open = 1;
+}
+
+static void bench_add(bench_capture_t *c, uint8_t n)
+{
+    while (n-- > 0)
+    {
+        if (c->len[c->count] == BENCH_SLOT_BYTES)
+        {
+            bench_close(c);
+            bench_open(c);
+        }
+        c->len[c->count]++;
+        c->bytes++;
+    }
+}
+
+static uint8_t bench_i2c_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+    switch (msg)
+    {
+        case U8X8_MSG_BYTE_SEND:
+            bench_add(&bench_i2c, arg_int);
+            break;
+        case U8X8_MSG_BYTE_START_TRANSFER:
+            bench_open(&bench_i2c);
+            break;
+        case U8X8_MSG_BYTE_END_TRANSFER:
+            bench_close(&bench_i2c);
+            break;
+        default:
+            break;
+    }
+    return 1;
+}
+
+static uint8_t bench_spi_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+    switch (msg)
+    {
+        case U8X8_MSG_BYTE_SEND:
+            bench_add(&bench_spi, arg_int);
+            break;
+        case U8X8_MSG_BYTE_SET_DC:
+            /* A DC change ends the run, like u8x8_byte_stm32_spi() */
+            if (arg_int != bench_spi.dc && bench_spi.open)
+            {
+                bench_close(&bench_spi);
+                bench_open(&bench_spi);
+            }
+            bench_spi.dc = arg_int;
+            break;
+        case U8X8_MSG_BYTE_START_TRANSFER:
+            bench_open(&bench_spi);
+            break;
+        case U8X8_MSG_BYTE_END_TRANSFER:
+            bench_close(&bench_spi);
+            break;
+        default:
+            break;
+    }
+    return 1;
+}
+
+static uint8_t bench_gpio_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+    return 1;
+}
+
+/**
+ * @brief Captures one u8g2_SendBuffer() through the given command sequence and byte callback.
+ */
+static void bench_capture(bench_capture_t *c, u8x8_msg_cb cad_cb, u8x8_msg_cb byte_cb)
+{
+    u8g2_SetupDisplay(&bench_u8g2, u8x8_d_sh1106_128x64_noname, cad_cb, byte_cb, bench_gpio_cb);
+    u8g2_SetupBuffer(&bench_u8g2, bench_buffer, 8, u8g2_ll_hvline_vertical_top_lsb, U8G2_R0);
+    u8g2_InitDisplay(&bench_u8g2);
+    u8g2_ClearBuffer(&bench_u8g2);
+    u8g2_SetFont(&bench_u8g2, u8g2_font_ncenB08_tr);
+    u8g2_DrawStr(&bench_u8g2, 0, 12, "Access granted");
+    memset(c, 0, sizeof(*c));
+    u8g2_SendBuffer(&bench_u8g2);
+}
+
+/**
+ * @brief Bus time of one frame in microseconds.
+ */
+static double bench_i2c_us(uint32_t khz)
+{
+    /* address byte per transfer, start + stop about one byte time */
+    return (bench_i2c.bytes + 2.0 * bench_i2c.count) * 9.0 * 1000.0 / khz + bench_i2c.count * BENCH_I2C_OVERHEAD_US;
+}
+
+static double bench_spi_us(uint32_t khz)
+{
+    return bench_spi.bytes * 8.0 * 1000.0 / khz + bench_spi.count * BENCH_SPI_OVERHEAD_US;
+}
+
+static void bench_print(const char *name, double bus_us, uint32_t render_us)
+{
+    double blocking_us = bus_us + render_us;
+    double dma_us = bus_us > render_us ? bus_us : render_us;
+
+    printf("  %-22s %9.2f %12.2f %8.1f %12.2f %8.1f\n", name, bus_us / 1000.0,
+           blocking_us / 1000.0, 1e6 / blocking_us, dma_us / 1000.0, 1e6 / dma_us);
+}
+
+int main(int argc, char **argv)
+{
+    static const uint32_t i2c_khz[] = {100, 400};
+    static const uint32_t spi_khz[] = {2625, 5250, 10500};
+    uint32_t render_us = 3000;
+    char name[32];
+    int opt;
+
+    while ((opt = getopt(argc, argv, "r:")) != -1)
+    {
+        switch (opt)
+        {
+            case 'r': render_us = (uint32_t)atoi(optarg); break;
+            default:
+                fprintf(stderr, "usage: %s [-r render_us]\n", argv[0]);
+                return 2;
+        }
+    }
+    bench_capture(&bench_i2c, u8x8_cad_ssd13xx_fast_i2c, bench_i2c_cb);
+    bench_capture(&bench_spi, u8x8_cad_001, bench_spi_cb);
+
+    printf("full frame: I2C %lu bytes in %u transfers, SPI %lu bytes in %u runs; render %lu us\n\n",
+           (unsigned long)bench_i2c.bytes, bench_i2c.count, (unsigned long)bench_spi.bytes, bench_spi.count,
+           (unsigned long)render_us);
+    printf("  %-22s %9s %12s %8s %12s %8s\n", "transport", "bus ms", "blocking ms", "fps", "DMA ms", "fps");
+    for (size_t i = 0; i < sizeof(i2c_khz) / sizeof(i2c_khz[0]); i++)
+    {
+        snprintf(name, sizeof(name), "I2C %lu kHz", (unsigned long)i2c_khz[i]);
+        bench_print(name, bench_i2c_us(i2c_khz[i]), render_us);
+    }
+    for (size_t i = 0; i < sizeof(spi_khz) / sizeof(spi_khz[0]); i++)
+    {
+        snprintf(name, sizeof(name), "SPI %.3g MHz", spi_khz[i] / 1000.0);
+        bench_print(name, bench_spi_us(spi_khz[i]), render_us);
+    }
+    return 0;
+}
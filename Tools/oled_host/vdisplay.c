@@ -0,0 +1,418 @@
+/**
+ * @file vdisplay.c
+ * @author Ted Wang
+ * @date 2026-10-17
+ * @brief Host-side virtual 128x64 OLED display for u8g2/u8x8 (Linux).
+ *
+ * This file provides:
+ *   - An SH1106 I2C protocol emulation behind a u8x8 byte callback
+ *   - A direct u8x8 display callback that writes tiles into the same display RAM
+ *   - Pixel access and PBM/PNG image I/O
+ */
+
+#include "vdisplay.h"
+#include <stdio.h>
+#include <string.h>
+
+vdisplay_t vdisplay;
+
+/**
+ * @brief Number of argument bytes that follow an SH1106/SSD1306 command byte.
+ */
+static int vdisplay_cmd_args(uint8_t cmd)
+{
+    switch (cmd)
+    {
+        case 0x81: case 0xA8: case 0xAD: case 0xD3: case 0xD5:
+        case 0xD9: case 0xDA: case 0xDB: case 0x8D: case 0x20:
+            return 1;
+        case 0x21: case 0x22:
+            return 2;
+        default:
+            return 0;
+    }
+}
+
+/**
+ * @brief Executes one controller command (with its arguments).
+ */
+static void vdisplay_command(const uint8_t *c)
+{
+    if (c[0] <= 0x0F)
+        vdisplay.column = (uint8_t)((vdisplay.column & 0xF0) | c[0]);
+    else if (c[0] <= 0x1F)
+        vdisplay.column = (uint8_t)((vdisplay.column & 0x0F) | ((c[0] & 0x0F) << 4));
+    else if (c[0] >= 0x40 && c[0] <= 0x7F)
+        vdisplay.start_line = c[0] & 0x3F;
+    else if (c[0] >= 0xB0 && c[0] <= 0xB7)
+        vdisplay.page = c[0] & 0x07;
+    else if (c[0] == 0x81)
+        vdisplay.contrast = c[1];
+    else if (c[0] == 0xA6 || c[0] == 0xA7)
+        vdisplay.inverse = c[0] & 1;
+    else if (c[0] == 0xAE || c[0] == 0xAF)
+        vdisplay.power_save = (c[0] & 1) ? 0 : 1;
+}
+
+/**
+ * @brief Writes one data byte at the current page/column (column auto-increments).
+ */
+static void vdisplay_data(uint8_t d)
+{
+    if (vdisplay.column < VDISPLAY_RAM_COLS)
+    {
+        vdisplay.ram[vdisplay.page][vdisplay.column] = d;
+    }
+    vdisplay.column++;
+}
+
+/**
+ * @brief Decodes a complete I2C transfer (control byte(s) followed by commands or data).
+ */
+static void vdisplay_transfer(const uint8_t *p, int n)
+{
+    int i = 0;
+
+    while (i < n)
+    {
+        uint8_t control = p[i++];
+        int continuation = control & 0x80;      /* Co bit: one byte follows, then a new control byte */
+        int is_data = control & 0x40;           /* D/C# bit */
+        int end = continuation ? (i + 1 < n ? i + 1 : n) : n;
+
+        while (i < end)
+        {
+            if (is_data)
+            {
+                vdisplay_data(p[i++]);
+            }
+            else
+            {
+                uint8_t cmd[3] = {p[i], 0, 0};
+                int args = vdisplay_cmd_args(p[i++]);
+                for (int k = 1; k <= args && i < n; k++)
+                {
+                    cmd[k] = p[i++];
+                }
+                vdisplay_command(cmd);
+            }
+        }
+    }
+}
+
+uint8_t vdisplay_byte_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+    (void)u8x8;
+    switch (msg)
+    {
+        case U8X8_MSG_BYTE_SEND:
+            if (vdisplay.xfer_len + arg_int <= sizeof(vdisplay.xfer))
+            {
+                memcpy(&vdisplay.xfer[vdisplay.xfer_len], arg_ptr, arg_int);
+                vdisplay.xfer_len += arg_int;
+            }
+            vdisplay.bytes += arg_int;
+            break;
+        case U8X8_MSG_BYTE_START_TRANSFER:
+            vdisplay.xfer_len = 0;
+            break;
+        case U8X8_MSG_BYTE_END_TRANSFER:
+            vdisplay_transfer(vdisplay.xfer, vdisplay.xfer_len);
+            vdisplay.transfers++;
+            break;
+        case U8X8_MSG_BYTE_INIT:
+        case U8X8_MSG_BYTE_SET_DC:
+            break;
+        default:
+            return 0;
+    }
+    return 1;
+}
+
+uint8_t vdisplay_gpio_and_delay_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+    (void)u8x8;
+    (void)msg;
+    (void)arg_int;
+    (void)arg_ptr;
+    return 1;
+}
+
+static const u8x8_display_info_t vdisplay_display_info =
+{
+  /* chip_enable_level = */ 0,
+  /* chip_disable_level = */ 1,
+  /* post_chip_enable_wait_ns = */ 0,
+  /* pre_chip_disable_wait_ns = */ 0,
+  /* reset_pulse_width_ms = */ 0,
+  /* post_reset_wait_ms = */ 0,
+  /* sda_setup_time_ns = */ 0,
+  /* sck_pulse_width_ns = */ 0,
+  /* sck_clock_hz = */ 0,
+  /* spi_mode = */ 0,
+  /* i2c_bus_clock_100kHz = */ 4,
+  /* data_setup_time_ns = */ 0,
+  /* write_pulse_width_ns = */ 0,
+  /* tile_width = */ 16,
+  /* tile_height = */ 8,
+  /* default_x_offset = */ 0,
+  /* flipmode_x_offset = */ 0,
+  /* pixel_width = */ 128,
+  /* pixel_height = */ 64
+};
+
+uint8_t u8x8_d_vdisplay_128x64(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+    u8x8_tile_t *tile;
+
+    switch (msg)
+    {
+        case U8X8_MSG_DISPLAY_SETUP_MEMORY:
+            u8x8_d_helper_display_setup_memory(u8x8, &vdisplay_display_info);
+            break;
+        case U8X8_MSG_DISPLAY_INIT:
+            break;
+        case U8X8_MSG_DISPLAY_SET_POWER_SAVE:
+            vdisplay.power_save = arg_int;
+            break;
+        case U8X8_MSG_DISPLAY_SET_CONTRAST:
+            vdisplay.contrast = arg_int;
+            break;
+        case U8X8_MSG_DISPLAY_DRAW_TILE:
+            tile = (u8x8_tile_t *)arg_ptr;
+            do
+            {
+                uint8_t col = (uint8_t)(tile->x_pos * 8 + u8x8->x_offset);
+                for (uint8_t t = 0; t < tile->cnt; t++)
+                {
+                    memcpy(&vdisplay.ram[tile->y_pos & 7][col], &tile->tile_ptr[t * 8], 8);
+                    col += 8;
+                }
+                vdisplay.tiles += tile->cnt;
+                arg_int--;
+            } while (arg_int > 0);
+            break;
+        default:
+            return 0;
+    }
+    return 1;
+}
+
+int vdisplay_setup(u8g2_t *u8g2, char mode)
+{
+    uint8_t tile_buf_height;
+    uint8_t *buf;
+
+    vdisplay_reset();
+    switch (mode)
+    {
+        case 'f':
+            u8g2_Setup_sh1106_i2c_128x64_noname_f(u8g2, U8G2_R0, vdisplay_byte_cb, vdisplay_gpio_and_delay_cb);
+            vdisplay.x_offset = 2;
+            break;
+        case '1':
+            u8g2_Setup_sh1106_i2c_128x64_noname_1(u8g2, U8G2_R0, vdisplay_byte_cb, vdisplay_gpio_and_delay_cb);
+            vdisplay.x_offset = 2;
+            break;
+        case '2':
+            u8g2_Setup_sh1106_i2c_128x64_noname_2(u8g2, U8G2_R0, vdisplay_byte_cb, vdisplay_gpio_and_delay_cb);
+            vdisplay.x_offset = 2;
+            break;
+        case 'd':
+            u8g2_SetupDisplay(u8g2, u8x8_d_vdisplay_128x64, u8x8_cad_empty, u8x8_byte_empty, vdisplay_gpio_and_delay_cb);
+            buf = u8g2_m_16_8_f(&tile_buf_height);
+            u8g2_SetupBuffer(u8g2, buf, tile_buf_height, u8g2_ll_hvline_vertical_top_lsb, U8G2_R0);
+            vdisplay.x_offset = 0;
+            break;
+        default:
+            return -1;
+    }
+    u8g2_InitDisplay(u8g2);
+    u8g2_SetPowerSave(u8g2, 0);
+    return 0;
+}
+
+void vdisplay_reset(void)
+{
+    memset(&vdisplay, 0, sizeof(vdisplay));
+    vdisplay.power_save = 1;
+}
+
+int vdisplay_pixel(int x, int y)
+{
+    int row = (y + vdisplay.start_line) & 63;
+    int bit = (vdisplay.ram[row >> 3][x + vdisplay.x_offset] >> (row & 7)) & 1;
+
+    if (vdisplay.power_save)
+    {
+        return 0;
+    }
+    return bit ^ vdisplay.inverse;
+}
+
+void vdisplay_snapshot(uint8_t *pixels)
+{
+    for (int y = 0; y < VDISPLAY_HEIGHT; y++)
+    {
+        for (int x = 0; x < VDISPLAY_WIDTH; x++)
+        {
+            pixels[y * VDISPLAY_WIDTH + x] = (uint8_t)vdisplay_pixel(x, y);
+        }
+    }
+}
+
+int vdisplay_write_pbm(const char *path, const uint8_t *pixels)
+{
+    FILE *f = fopen(path, "wb");
+    if (f == NULL)
+    {
+        return -1;
+    }
+    fprintf(f, "P4\n%d %d\n", VDISPLAY_WIDTH, VDISPLAY_HEIGHT);
+    for (int y = 0; y < VDISPLAY_HEIGHT; y++)
+    {
+        for (int x = 0; x < VDISPLAY_WIDTH; x += 8)
+        {
+            uint8_t b = 0;
+            for (int i = 0; i < 8; i++)
+            {
+                b = (uint8_t)((b << 1) | pixels[y * VDISPLAY_WIDTH + x + i]);
+            }
+            fputc(b, f);
+        }
+    }
+    return fclose(f);
+}
+
+int vdisplay_read_pbm(const char *path, uint8_t *pixels)
+{
+    int w, h;
+    FILE *f = fopen(path, "rb");
+    if (f == NULL)
+    {
+        return -1;
+    }
+    if (fscanf(f, "P4 %d %d", &w, &h) != 2 || w != VDISPLAY_WIDTH || h != VDISPLAY_HEIGHT)
+    {
+        fclose(f);
+        return -1;
+    }
+    fgetc(f);   /* single whitespace after the header */
+    for (int y = 0; y < VDISPLAY_HEIGHT; y++)
+    {
+        for (int x = 0; x < VDISPLAY_WIDTH; x += 8)
+        {
+            int b = fgetc(f);
+            if (b == EOF)
+            {
+                fclose(f);
+                return -1;
+            }
+            for (int i = 0; i < 8; i++)
+            {
+                pixels[y * VDISPLAY_WIDTH + x + i] = (uint8_t)((b >> (7 - i)) & 1);
+            }
+        }
+    }
+    fclose(f);
+    return 0;
+}
+
+/**
+ * @brief CRC-32 (PNG chunks) and Adler-32 (zlib stream) helpers.
+ */
+static uint32_t vdisplay_crc32(uint32_t crc, const uint8_t *p, size_t n)
+{
+    crc = ~crc;
+    while (n--)
+    {
+        crc ^= *p++;
+        for (int k = 0; k < 8; k++)
+        {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+        }
+    }
+    return ~crc;
+}
+
+static void vdisplay_put32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
+
+static void vdisplay_png_chunk(FILE *f, const char *type, const uint8_t *data, uint32_t len)
+{
+    uint8_t hdr[8];
+    uint8_t crc[4];
+    uint32_t c;
+
+    vdisplay_put32(hdr, len);
+    memcpy(&hdr[4], type, 4);
+    c = vdisplay_crc32(0, &hdr[4], 4);
+    c = vdisplay_crc32(c, data, len);
+    vdisplay_put32(crc, c);
+    fwrite(hdr, 1, 8, f);
+    fwrite(data, 1, len, f);
+    fwrite(crc, 1, 4, f);
+}
+
+int vdisplay_write_png(const char *path, const uint8_t *pixels)
+{
+    static const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    enum { ROW = 1 + VDISPLAY_WIDTH / 8, RAW = ROW * VDISPLAY_HEIGHT };
+    uint8_t ihdr[13] = {0};
+    uint8_t raw[RAW];
+    uint8_t idat[2 + 5 + RAW + 4];
+    uint32_t a = 1, b = 0;
+    FILE *f;
+
+    for (int y = 0; y < VDISPLAY_HEIGHT; y++)
+    {
+        raw[y * ROW] = 0;   /* filter type: none */
+        for (int x = 0; x < VDISPLAY_WIDTH; x += 8)
+        {
+            uint8_t v = 0;
+            for (int i = 0; i < 8; i++)
+            {
+                v = (uint8_t)((v << 1) | (pixels[y * VDISPLAY_WIDTH + x + i] ? 1 : 0));
+            }
+            raw[y * ROW + 1 + x / 8] = v;
+        }
+    }
+    for (int i = 0; i < RAW; i++)
+    {
+        a = (a + raw[i]) % 65521u;
+        b = (b + a) % 65521u;
+    }
+
+    /* zlib header, one stored (uncompressed) deflate block, Adler-32 */
+    idat[0] = 0x78;
+    idat[1] = 0x01;
+    idat[2] = 0x01;
+    idat[3] = (uint8_t)(RAW & 0xFF);
+    idat[4] = (uint8_t)(RAW >> 8);
+    idat[5] = (uint8_t)(~RAW & 0xFF);
+    idat[6] = (uint8_t)((~RAW >> 8) & 0xFF);
+    memcpy(&idat[7], raw, RAW);
+    vdisplay_put32(&idat[7 + RAW], (b << 16) | a);
+
+    vdisplay_put32(&ihdr[0], VDISPLAY_WIDTH);
+    vdisplay_put32(&ihdr[4], VDISPLAY_HEIGHT);
+    ihdr[8] = 1;    /* bit depth */
+    ihdr[9] = 0;    /* grayscale */
+
+    f = fopen(path, "wb");
+    if (f == NULL)
+    {
+        return -1;
+    }
+    /* PNG grayscale: 0 = black. The OLED shows lit pixels (1) as white, so keep the values as is */
+    fwrite(signature, 1, sizeof(signature), f);
+    vdisplay_png_chunk(f, "IHDR", ihdr, sizeof(ihdr));
+    vdisplay_png_chunk(f, "IDAT", idat, sizeof(idat));
+    vdisplay_png_chunk(f, "IEND", NULL, 0);
+    return fclose(f);
+}
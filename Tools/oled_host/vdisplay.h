@@ -0,0 +1,92 @@
+
+/**
+ * @file vdisplay.h
+ * @author Ted Wang
+ * @date 2026-10-17
+ * @brief Host-side virtual 128x64 OLED display for u8g2/u8x8 (Linux).
+ *
+ * Two ways to attach u8g2 to an in-memory display:
+ *   - vdisplay_byte_cb: u8x8 byte callback that emulates the SH1106 I2C protocol (command/data
+ *     control bytes, page/column addressing, start line, contrast, power save). It is used together
+ *     with the real u8g2_Setup_sh1106_i2c_128x64_noname_{f,1,2} setups, so the complete driver
+ *     path runs and the byte counter equals the I2C payload on the target.
+ *   - u8x8_d_vdisplay_128x64: u8x8 display callback that copies tiles straight into memory, for
+ *     measuring rendering cost without any transport.
+ *
+ * Frames can be read pixel by pixel, compared against golden images and written as PBM or PNG
+ * (PBM: lit pixels are black, as usual for P4; PNG: lit pixels are white, as on the panel).
+ */
+
+#ifndef VDISPLAY_H
+#define VDISPLAY_H
+
+#include "u8g2.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define VDISPLAY_WIDTH      128
+#define VDISPLAY_HEIGHT     64
+#define VDISPLAY_RAM_COLS   132     /**< SH1106 column RAM (display uses columns 2..129) */
+
+/**
+ * @brief Virtual display state.
+ */
+typedef struct {
+    uint8_t ram[8][VDISPLAY_RAM_COLS];  /**< Controller display RAM (pages x columns) */
+    uint8_t page;                       /**< Current page address */
+    uint8_t column;                     /**< Current column address */
+    uint8_t start_line;                 /**< Display start line */
+    uint8_t contrast;                   /**< Contrast register */
+    uint8_t power_save;                 /**< 1 = display off */
+    uint8_t inverse;                    /**< 1 = inverse display */
+    uint8_t x_offset;                   /**< RAM column of visible pixel 0 (2 for SH1106, 0 for direct) */
+    uint8_t xfer[64];                   /**< Current I2C transfer */
+    uint8_t xfer_len;                   /**< Bytes in the current I2C transfer */
+    uint32_t bytes;                     /**< Bytes sent through the byte callback */
+    uint32_t transfers;                 /**< I2C transfers (START/END pairs) */
+    uint32_t tiles;                     /**< Tiles written through the display callback */
+} vdisplay_t;
+
+/** @brief The virtual display used by the callbacks (one display per process). */
+extern vdisplay_t vdisplay;
+
+uint8_t vdisplay_byte_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
+uint8_t vdisplay_gpio_and_delay_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
+uint8_t u8x8_d_vdisplay_128x64(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
+
+/**
+ * @brief Sets up u8g2 with the virtual display.
+ *
+ * @param u8g2 Display object
+ * @param mode 'f' (full buffer), '1' or '2' (page buffer) with the SH1106 protocol path,
+ *             or 'd' (full buffer, direct display callback without transport)
+ * @return 0 on success, -1 for an unknown mode
+ */
+int vdisplay_setup(u8g2_t *u8g2, char mode);
+
+/** @brief Resets the display RAM, registers and counters. */
+void vdisplay_reset(void);
+
+/** @brief Returns the visible pixel (x, y), taking start line and inverse display into account. */
+int vdisplay_pixel(int x, int y);
+
+/** @brief Stores the visible image as 1 byte per pixel (0/1), VDISPLAY_WIDTH * VDISPLAY_HEIGHT bytes. */
+void vdisplay_snapshot(uint8_t *pixels);
+
+/** @brief Writes a 1 byte per pixel image as binary PBM. Returns 0 on success. */
+int vdisplay_write_pbm(const char *path, const uint8_t *pixels);
+
+/** @brief Writes a 1 byte per pixel image as 1-bit grayscale PNG (uncompressed deflate). Returns 0 on success. */
+int vdisplay_write_png(const char *path, const uint8_t *pixels);
+
+/** @brief Reads a binary PBM written by vdisplay_write_pbm(). Returns 0 on success. */
+int vdisplay_read_pbm(const char *path, uint8_t *pixels);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // VDISPLAY_H
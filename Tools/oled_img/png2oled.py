@@ -0,0 +1,188 @@
+#!/usr/bin/env python3
+"""
+@file png2oled.py
+@author Ted Wang
+@date 2026-10-17
+@brief Converts PNG images into native OLED_Image_t definitions (Hardware/oled/oled_blit.h).
+
+Each image becomes one OLED_Image_t in the SH1106 / u8g2 buffer layout: (height + 7) / 8 bands of
+width bytes, one byte = 8 vertical pixels with the LSB on top. By default dark pixels are lit
+(black-on-white artwork); --invert lights bright pixels instead. Pixels with alpha below 128 are
+never lit. The image name is the file name without extension (non-identifier characters become
+'_') with the --prefix prepended.
+
+Only the Python standard library is used. Supported PNGs: non-interlaced, grayscale, RGB, palette,
+grayscale+alpha and RGBA, bit depth 1/2/4/8 (8 only for RGB and alpha types).
+
+Example (writes oled_icons.c and oled_icons.h):
+    python3 png2oled.py -o ../../Hardware/oled/oled_icons icons/*.png
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+import zlib
+
+PNG_SIGNATURE = b"\x89PNG\r\n\x1a\n"
+CHANNELS = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}
+
+
+def paeth(a, b, c):
+    """PNG Paeth predictor."""
+    p = a + b - c
+    pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+    if pa <= pb and pa <= pc:
+        return a
+    return b if pb <= pc else c
+
+
+def read_png(path):
+    """Decodes a PNG file into (width, height, rows of (luminance, alpha) tuples)."""
+    with open(path, "rb") as f:
+        data = f.read()
+    if not data.startswith(PNG_SIGNATURE):
+        raise ValueError("%s: not a PNG file" % path)
+
+    pos = len(PNG_SIGNATURE)
+    idat = bytearray()
+    palette = []
+    trns = b""
+    while pos < len(data):
+        length, ctype = struct.unpack(">I4s", data[pos:pos + 8])
+        chunk = data[pos + 8:pos + 8 + length]
+        pos += 12 + length
+        if ctype == b"IHDR":
+            width, height, depth, color, _, _, interlace = struct.unpack(">IIBBBBB", chunk)
+        elif ctype == b"PLTE":
+            palette = [tuple(chunk[i:i + 3]) for i in range(0, len(chunk), 3)]
+        elif ctype == b"tRNS":
+            trns = chunk
+        elif ctype == b"IDAT":
+            idat += chunk
+        elif ctype == b"IEND":
+            break
+    if interlace != 0 or color not in CHANNELS:
+        raise ValueError("%s: unsupported PNG (interlaced or unknown color type)" % path)
+    if depth != 8 and color not in (0, 3):
+        raise ValueError("%s: unsupported bit depth %d" % (path, depth))
+
+    raw = zlib.decompress(bytes(idat))
+    bits = depth * CHANNELS[color]
+    stride = (width * bits + 7) // 8
+    bpp = max(1, bits // 8)
+    rows = []
+    prev = bytearray(stride)
+    pos = 0
+    for _ in range(height):
+        ftype = raw[pos]
+        line = bytearray(raw[pos + 1:pos + 1 + stride])
+        pos += 1 + stride
+        for i in range(stride):
+            a = line[i - bpp] if i >= bpp else 0
+            b = prev[i]
+            c = prev[i - bpp] if i >= bpp else 0
+            if ftype == 1:
+                line[i] = (line[i] + a) & 0xFF
+            elif ftype == 2:
+                line[i] = (line[i] + b) & 0xFF
+            elif ftype == 3:
+                line[i] = (line[i] + ((a + b) >> 1)) & 0xFF
+            elif ftype == 4:
+                line[i] = (line[i] + paeth(a, b, c)) & 0xFF
+        prev = line
+
+        if depth < 8:
+            per_byte = 8 // depth
+            samples = [(line[x // per_byte] >> (8 - depth * (x % per_byte + 1))) & ((1 << depth) - 1)
+                       for x in range(width)]
+        else:
+            samples = None
+
+        pixels = []
+        for x in range(width):
+            if color == 3:
+                idx = samples[x] if samples is not None else line[x]
+                r, g, b = palette[idx]
+                alpha = trns[idx] if idx < len(trns) else 255
+                lum = (r * 299 + g * 587 + b * 114) // 1000
+            elif color == 0:
+                v = samples[x] if samples is not None else line[x]
+                lum = v * 255 // ((1 << depth) - 1)
+                alpha = 255
+            elif color == 4:
+                lum, alpha = line[2 * x], line[2 * x + 1]
+            else:
+                r, g, b = line[x * bpp:x * bpp + 3]
+                lum = (r * 299 + g * 587 + b * 114) // 1000
+                alpha = line[x * bpp + 3] if color == 6 else 255
+            pixels.append((lum, alpha))
+        rows.append(pixels)
+    return width, height, rows
+
+
+def to_native(width, height, rows, invert, threshold):
+    """Packs the image into vertical bytes (bands of width bytes, LSB on top)."""
+    out = bytearray(((height + 7) // 8) * width)
+    for y in range(height):
+        for x in range(width):
+            lum, alpha = rows[y][x]
+            lit = (lum >= threshold) if invert else (lum < threshold)
+            if lit and alpha >= 128:
+                out[(y // 8) * width + x] |= 1 << (y % 8)
+    return out
+
+
+def c_name(path, prefix):
+    """Derives the C identifier of an image from its file name."""
+    base = os.path.splitext(os.path.basename(path))[0]
+    return prefix + re.sub(r"[^0-9A-Za-z_]", "_", base)
+
+
+def main():
+    ap = argparse.ArgumentParser(description="PNG to native OLED image converter")
+    ap.add_argument("png", nargs="+", help="input PNG files")
+    ap.add_argument("-o", "--output", required=True, help="output path without extension (.c and .h are written)")
+    ap.add_argument("--prefix", default="oled_img_", help="prefix of the image names (default: oled_img_)")
+    ap.add_argument("--invert", action="store_true", help="light bright pixels instead of dark ones")
+    ap.add_argument("--threshold", type=int, default=128, help="luminance threshold 0..255 (default: 128)")
+    args = ap.parse_args()
+
+    module = os.path.basename(args.output)
+    guard = re.sub(r"[^0-9A-Za-z]", "_", module).upper() + "_H"
+    inputs = " ".join(os.path.basename(p) for p in args.png)
+    images = []
+    for path in args.png:
+        width, height, rows = read_png(path)
+        if width > 255 or height > 255:
+            sys.exit("%s: images are limited to 255x255 pixels" % path)
+        images.append((c_name(path, args.prefix), width, height, to_native(width, height, rows, args.invert, args.threshold)))
+
+    header = ["", "/**", " * @file %s.h" % module, " * @author Ted Wang",
+              " * @brief Native OLED images generated by Tools/oled_img/png2oled.py from %s." % inputs,
+              " *", " * Do not edit; regenerate from the PNG sources instead.", " */", "",
+              "#ifndef %s" % guard, "#define %s" % guard, "", '#include "oled_blit.h"', "",
+              "#ifdef __cplusplus", 'extern "C" {', "#endif", ""]
+    source = ["/**", " * @file %s.c" % module, " * @author Ted Wang",
+              " * @brief Native OLED images generated by Tools/oled_img/png2oled.py from %s." % inputs,
+              " */", "", '#include "%s.h"' % module, ""]
+    for name, width, height, data in images:
+        header.append("extern const OLED_Image_t %s;    /**< %ux%u */" % (name, width, height))
+        source.append("static const uint8_t %s_data[%u] = {" % (name, len(data)))
+        for i in range(0, len(data), 16):
+            source.append("    " + " ".join("0x%02X," % b for b in data[i:i + 16]))
+        source.append("};")
+        source.append("const OLED_Image_t %s = {%u, %u, %s_data};" % (name, width, height, name))
+        source.append("")
+    header += ["", "#ifdef __cplusplus", "}", "#endif", "", "#endif // %s" % guard, ""]
+
+    with open(args.output + ".h", "w", newline="\n") as f:
+        f.write("\n".join(header))
+    with open(args.output + ".c", "w", newline="\n") as f:
+        f.write("\n".join(source))
+    print("%d image(s) written to %s.c/.h" % (len(images), args.output))
+
+
+if __name__ == "__main__":
+    main()
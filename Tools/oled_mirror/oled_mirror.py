@@ -0,0 +1,194 @@
+#!/usr/bin/env python3
+"""
+@file oled_mirror.py
+@author Ted Wang
+@date 2026-10-17
+@brief Host-side decoder and viewer for the OLED mirror stream (Hardware/oled/oled_mirror.c).
+
+Reads the binary mirror stream from a serial port (pyserial) or a capture file, rebuilds the
+framebuffer from keyframes and XOR-delta frames, and shows it in the terminal (Unicode half
+blocks) and/or writes each frame as a PBM image. Bytes outside of frames (e.g. debug text on the
+same UART) are skipped.
+
+Examples:
+    python3 oled_mirror.py --port /dev/ttyACM0
+    python3 oled_mirror.py --file capture.bin --pbm out/frame_%05d.pbm --quiet
+"""
+
+import argparse
+import sys
+
+SYNC = b"\xA5\x5A"
+HEADER_BYTES = 5
+TRAILER_BYTES = 2
+
+
+def fletcher16(data):
+    """Fletcher-16 checksum as computed by OLED_Mirror_Send()."""
+    sum1 = sum2 = 0
+    for b in data:
+        sum1 = (sum1 + b) % 255
+        sum2 = (sum2 + sum1) % 255
+    return sum1, sum2
+
+
+def unpackbits(data, size):
+    """Decodes PackBits data into exactly size bytes."""
+    out = bytearray()
+    i = 0
+    while len(out) < size:
+        n = data[i]
+        i += 1
+        if n < 128:
+            out += data[i:i + n + 1]
+            i += n + 1
+        elif n > 128:
+            out += bytes([data[i]]) * (257 - n)
+            i += 1
+    if len(out) != size:
+        raise ValueError("PackBits data does not match the frame size")
+    return out
+
+
+class MirrorDecoder:
+    """Incremental stream decoder; feed() returns the frames completed by the new bytes."""
+
+    def __init__(self):
+        self.rx = bytearray()
+        self.fb = None
+        self.tiles_w = 0
+        self.tiles_h = 0
+        self.seq = None
+        self.synced = False
+        self.stats = {"keyframes": 0, "deltas": 0, "bad_checksum": 0, "seq_gaps": 0, "bytes": 0}
+
+    def feed(self, data):
+        self.rx += data
+        self.stats["bytes"] += len(data)
+        frames = []
+        while True:
+            start = self.rx.find(SYNC)
+            if start < 0:
+                del self.rx[:max(0, len(self.rx) - 1)]
+                return frames
+            del self.rx[:start]
+            if len(self.rx) < HEADER_BYTES:
+                return frames
+            length = self.rx[3] | (self.rx[4] << 8)
+            total = HEADER_BYTES + length + TRAILER_BYTES
+            if len(self.rx) < total:
+                return frames
+            frame = bytes(self.rx[:total])
+            if fletcher16(frame[2:HEADER_BYTES + length]) != (frame[-2], frame[-1]):
+                self.stats["bad_checksum"] += 1
+                del self.rx[:2]
+                continue
+            del self.rx[:total]
+            if self._apply(chr(frame[2]), frame[HEADER_BYTES:HEADER_BYTES + length]):
+                frames.append(bytes(self.fb))
+
+    def _apply(self, ftype, payload):
+        seq, tiles_w, tiles_h = payload[0], payload[1], payload[2]
+        size = tiles_w * tiles_h * 8
+        if ftype == "K":
+            self.fb = unpackbits(payload[3:], size)
+            self.tiles_w, self.tiles_h = tiles_w, tiles_h
+            self.synced = True
+            self.stats["keyframes"] += 1
+        elif ftype == "D":
+            expected = None if self.seq is None else (self.seq + 1) & 0xFF
+            if seq != expected:
+                if self.synced:
+                    self.stats["seq_gaps"] += 1
+                self.synced = False
+            self.seq = seq
+            if not self.synced or (tiles_w, tiles_h) != (self.tiles_w, self.tiles_h):
+                return False
+            tiles = tiles_w * tiles_h
+            nbitmap = (tiles + 7) // 8
+            bitmap = payload[3:3 + nbitmap]
+            changed = [t for t in range(tiles) if bitmap[t >> 3] & (1 << (t & 7))]
+            xor = unpackbits(payload[3 + nbitmap:], len(changed) * 8)
+            for k, t in enumerate(changed):
+                for i in range(8):
+                    self.fb[t * 8 + i] ^= xor[k * 8 + i]
+            self.stats["deltas"] += 1
+        else:
+            return False
+        self.seq = seq
+        return True
+
+    @property
+    def width(self):
+        return self.tiles_w * 8
+
+    @property
+    def height(self):
+        return self.tiles_h * 8
+
+    def pixel(self, fb, x, y):
+        """Returns pixel (x, y) of a decoded frame (u8g2 vertical byte layout)."""
+        return (fb[(y >> 3) * self.width + x] >> (y & 7)) & 1
+
+
+def to_text(dec, fb):
+    """Renders a frame with Unicode half blocks (two pixel rows per text line)."""
+    chars = {(0, 0): " ", (1, 0): "▀", (0, 1): "▄", (1, 1): "█"}
+    lines = []
+    for y in range(0, dec.height, 2):
+        lines.append("".join(chars[(dec.pixel(fb, x, y), dec.pixel(fb, x, y + 1))] for x in range(dec.width)))
+    return "\n".join(lines)
+
+
+def write_pbm(dec, fb, path):
+    """Writes a frame as a binary PBM (P4) image."""
+    row_bytes = (dec.width + 7) // 8
+    data = bytearray(row_bytes * dec.height)
+    for y in range(dec.height):
+        for x in range(dec.width):
+            if dec.pixel(fb, x, y):
+                data[y * row_bytes + (x >> 3)] |= 0x80 >> (x & 7)
+    with open(path, "wb") as f:
+        f.write(b"P4\n%d %d\n" % (dec.width, dec.height))
+        f.write(data)
+
+
+def main():
+    ap = argparse.ArgumentParser(description="OLED mirror stream viewer")
+    src = ap.add_mutually_exclusive_group(required=True)
+    src.add_argument("--port", help="serial port (requires pyserial)")
+    src.add_argument("--file", help="captured stream file")
+    ap.add_argument("--baud", type=int, default=115200)
+    ap.add_argument("--pbm", help="PBM output pattern, e.g. frame_%%05d.pbm")
+    ap.add_argument("--quiet", action="store_true", help="do not draw frames in the terminal")
+    args = ap.parse_args()
+
+    dec = MirrorDecoder()
+    count = 0
+
+    def show(frames):
+        nonlocal count
+        for fb in frames:
+            if args.pbm:
+                write_pbm(dec, fb, args.pbm % count)
+            if not args.quiet:
+                sys.stdout.write("\x1b[H" + to_text(dec, fb) + "\n")
+                sys.stdout.write("frame %d  %s\x1b[K\n" % (count, dec.stats))
+                sys.stdout.flush()
+            count += 1
+
+    if args.file:
+        with open(args.file, "rb") as f:
+            show(dec.feed(f.read()))
+    else:
+        import serial
+        with serial.Serial(args.port, args.baud, timeout=0.1) as ser:
+            if not args.quiet:
+                sys.stdout.write("\x1b[2J")
+            while True:
+                show(dec.feed(ser.read(4096)))
+    print("%d frames, %s" % (count, dec.stats))
+
+
+if __name__ == "__main__":
+    main()
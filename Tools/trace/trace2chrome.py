@@ -0,0 +1,268 @@
+#!/usr/bin/env python3
+"""
+@file trace2chrome.py
+@author Ted Wang
+@date 2026-10-17
+@brief Converts the kernel trace stream (Core/Src/trace_recorder.c) to Chrome trace-event JSON.
+
+Reads the binary trace stream from a serial port (pyserial) or a capture file, decodes the 'N'
+(names) and 'T' (records) frames and writes a JSON file for chrome://tracing or
+https://ui.perfetto.dev:
+  - one track per task with a slice for every time it ran (switched in to switched out),
+  - queue, semaphore and mutex operations as instant events on the running task's track,
+  - one track per interrupt with a slice for every handler run,
+  - markers where records were lost (ring full while streaming) or frames were missed.
+Bytes outside of frames (debug text, OLED mirror frames on the same UART) are skipped.
+A summary with the CPU share and switch count of each task is printed.
+
+Send 't' on UART3 to start streaming (and again to stop it).
+
+Examples:
+    python3 trace2chrome.py --port /dev/ttyACM0 --seconds 10 --raw capture.bin -o trace.json
+    python3 trace2chrome.py --file capture.bin -o trace.json
+"""
+
+import argparse
+import json
+import struct
+import sys
+import time
+
+SYNC = b"\xA5\x5A"
+HEADER_BYTES = 5
+TRAILER_BYTES = 2
+RECORD = struct.Struct("<IBBH")
+
+EV_TASK_IN = 1
+EV_TASK_OUT = 2
+EV_QUEUE_SEND = 3
+EV_QUEUE_RECEIVE = 4
+EV_QUEUE_BLOCK_SEND = 5
+EV_QUEUE_BLOCK_RECEIVE = 6
+EV_ISR_ENTER = 7
+EV_ISR_EXIT = 8
+EV_MARK = 9
+
+QUEUE_EVENTS = {
+    EV_QUEUE_SEND: "send",
+    EV_QUEUE_RECEIVE: "receive",
+    EV_QUEUE_BLOCK_SEND: "block on send",
+    EV_QUEUE_BLOCK_RECEIVE: "block on receive",
+}
+
+# STM32F429 interrupt numbers of the handlers with TRACE_ISR_ENTER()/TRACE_ISR_EXIT()
+IRQ_NAMES = {
+    14: "DMA1_Stream3 (USART3 TX)",
+    33: "I2C2_EV",
+    34: "I2C2_ER",
+    39: "USART3",
+    47: "DMA1_Stream7 (I2C2 TX)",
+    57: "DMA2_Stream1 (SPI4 TX)",
+}
+
+PID = 1
+ISR_TID_BASE = 1000
+
+
+def fletcher16(data):
+    """Fletcher-16 checksum as computed by Trace_Frame()."""
+    sum1 = sum2 = 0
+    for b in data:
+        sum1 = (sum1 + b) % 255
+        sum2 = (sum2 + sum1) % 255
+    return sum1, sum2
+
+
+class TraceDecoder:
+    """Incremental stream decoder; feed() converts the records completed by the new bytes."""
+
+    def __init__(self):
+        self.rx = bytearray()
+        self.cpu_hz = None
+        self.tasks = {}
+        self.objects = {}
+        self.events = []
+        self.seq = None
+        self.lost = None
+        self.last_ts = None
+        self.wraps = 0
+        self.first_us = None
+        self.last_us = 0.0
+        self.running = None          # (task, start_us)
+        self.isr_start = {}
+        self.irqs = set()
+        self.run_us = {}
+        self.switches = {}
+        self.stats = {"frames": 0, "records": 0, "lost": 0, "seq_gaps": 0, "bad_checksum": 0,
+                      "no_names": 0, "bytes": 0}
+
+    def feed(self, data):
+        self.rx += data
+        self.stats["bytes"] += len(data)
+        while True:
+            start = self.rx.find(SYNC)
+            if start < 0:
+                del self.rx[:max(0, len(self.rx) - 1)]
+                return
+            del self.rx[:start]
+            if len(self.rx) < HEADER_BYTES:
+                return
+            length = self.rx[3] | (self.rx[4] << 8)
+            total = HEADER_BYTES + length + TRAILER_BYTES
+            if len(self.rx) < total:
+                return
+            frame = bytes(self.rx[:total])
+            if fletcher16(frame[2:HEADER_BYTES + length]) != (frame[-2], frame[-1]):
+                self.stats["bad_checksum"] += 1
+                del self.rx[:2]
+                continue
+            del self.rx[:total]
+            payload = frame[HEADER_BYTES:HEADER_BYTES + length]
+            if frame[2] == ord("N"):
+                self._names(payload)
+            elif frame[2] == ord("T"):
+                self._records(payload)
+
+    def _names(self, payload):
+        self.cpu_hz = struct.unpack_from("<I", payload)[0]
+        i = 4
+        while i + 2 < len(payload):
+            kind, ident = payload[i], payload[i + 1]
+            end = payload.index(b"\0", i + 2)
+            name = payload[i + 2:end].decode("latin-1")
+            (self.tasks if kind == 0 else self.objects)[ident] = name
+            i = end + 1
+        for number, name in self.tasks.items():
+            self._meta(number, name, number)
+        # A new stream: the first records come from the flight recorder, unrelated to the last frame
+        self.seq = None
+        self.lost = None
+        self.running = None
+        self.isr_start = {}
+
+    def _meta(self, tid, name, sort_index):
+        self.events.append({"ph": "M", "pid": PID, "tid": tid, "name": "thread_name", "args": {"name": name}})
+        self.events.append({"ph": "M", "pid": PID, "tid": tid, "name": "thread_sort_index",
+                            "args": {"sort_index": sort_index}})
+
+    def _us(self, ts):
+        if self.last_ts is not None and ts < self.last_ts:
+            self.wraps += 1
+        self.last_ts = ts
+        us = ((self.wraps << 32) + ts) * 1e6 / self.cpu_hz
+        if self.first_us is None:
+            self.first_us = us
+        self.last_us = us - self.first_us
+        return self.last_us
+
+    def _records(self, payload):
+        if self.cpu_hz is None:
+            self.stats["no_names"] += 1
+            return
+        seq, lost = struct.unpack_from("<BI", payload)
+        self.stats["frames"] += 1
+        if self.seq is not None and seq != (self.seq + 1) & 0xFF:
+            self.stats["seq_gaps"] += 1
+            self._gap("frames missed")
+        self.seq = seq
+        if self.lost is not None and lost != self.lost:
+            self.stats["lost"] += lost - self.lost
+            self._gap("%d records lost" % (lost - self.lost))
+        self.lost = lost
+        for off in range(5, len(payload) - RECORD.size + 1, RECORD.size):
+            self._record(*RECORD.unpack_from(payload, off))
+            self.stats["records"] += 1
+
+    def _gap(self, text):
+        # Open slices cannot be trusted across a gap
+        self.running = None
+        self.isr_start = {}
+        self.events.append({"ph": "i", "pid": PID, "tid": 0, "s": "g", "ts": self.last_us, "name": text})
+
+    def _task_name(self, number):
+        return self.tasks.get(number, "task %d" % number)
+
+    def _record(self, ts, event, ident, arg):
+        us = self._us(ts)
+        if event == EV_TASK_IN:
+            self.running = (ident, us)
+            self.switches[ident] = self.switches.get(ident, 0) + 1
+        elif event == EV_TASK_OUT:
+            if self.running is not None and self.running[0] == ident:
+                start = self.running[1]
+                self.events.append({"ph": "X", "pid": PID, "tid": ident, "ts": start, "dur": us - start,
+                                    "name": self._task_name(ident)})
+                self.run_us[ident] = self.run_us.get(ident, 0.0) + us - start
+            self.running = None
+        elif event in QUEUE_EVENTS:
+            tid = self.running[0] if self.running is not None else 0
+            name = "%s %s" % (QUEUE_EVENTS[event], self.objects.get(ident, "queue %d" % ident))
+            self.events.append({"ph": "i", "pid": PID, "tid": tid, "s": "t", "ts": us, "name": name,
+                                "args": {"items": arg}})
+        elif event == EV_ISR_ENTER:
+            if ident not in self.irqs:
+                self.irqs.add(ident)
+                self._meta(ISR_TID_BASE + ident, "IRQ %d %s" % (ident, IRQ_NAMES.get(ident, "")), ISR_TID_BASE + ident)
+            self.isr_start[ident] = us
+        elif event == EV_ISR_EXIT:
+            start = self.isr_start.pop(ident, None)
+            if start is not None:
+                self.events.append({"ph": "X", "pid": PID, "tid": ISR_TID_BASE + ident, "ts": start,
+                                    "dur": us - start, "name": IRQ_NAMES.get(ident, "IRQ %d" % ident)})
+        elif event == EV_MARK:
+            tid = self.running[0] if self.running is not None else 0
+            self.events.append({"ph": "i", "pid": PID, "tid": tid, "s": "t", "ts": us, "name": "mark %d" % ident,
+                                "args": {"arg": arg}})
+
+    def summary(self):
+        lines = ["%(records)d records in %(frames)d frames, %(lost)d lost, %(seq_gaps)d frame gaps, "
+                 "%(bad_checksum)d bad checksums" % self.stats]
+        if self.last_us > 0:
+            lines.append("%.3f s traced" % (self.last_us / 1e6))
+            for number in sorted(set(self.run_us) | set(self.switches)):
+                lines.append("  %-16s %5.1f%%  %6d switches" % (self._task_name(number),
+                                                                 100.0 * self.run_us.get(number, 0.0) / self.last_us,
+                                                                 self.switches.get(number, 0)))
+        return "\n".join(lines)
+
+
+def main():
+    ap = argparse.ArgumentParser(description="kernel trace stream to Chrome trace-event JSON")
+    src = ap.add_mutually_exclusive_group(required=True)
+    src.add_argument("--port", help="serial port (requires pyserial)")
+    src.add_argument("--file", help="captured stream file")
+    ap.add_argument("--baud", type=int, default=115200)
+    ap.add_argument("--seconds", type=float, default=10.0, help="capture time with --port (default 10)")
+    ap.add_argument("--raw", help="also save the received bytes (with --port)")
+    ap.add_argument("-o", "--output", default="trace.json", help="JSON output (default trace.json)")
+    args = ap.parse_args()
+
+    dec = TraceDecoder()
+    if args.file:
+        with open(args.file, "rb") as f:
+            dec.feed(f.read())
+    else:
+        import serial
+        raw = open(args.raw, "wb") if args.raw else None
+        with serial.Serial(args.port, args.baud, timeout=0.1) as ser:
+            ser.write(b"t")
+            end = time.time() + args.seconds
+            while time.time() < end:
+                data = ser.read(4096)
+                dec.feed(data)
+                if raw:
+                    raw.write(data)
+            ser.write(b"t")
+        if raw:
+            raw.close()
+
+    if dec.cpu_hz is None:
+        sys.exit("no names frame received: is streaming on (send 't' on UART3)?")
+    with open(args.output, "w") as f:
+        json.dump({"traceEvents": dec.events, "displayTimeUnit": "ns"}, f)
+    print(dec.summary())
+    print("wrote %s (%d events)" % (args.output, len(dec.events)))
+
+
+if __name__ == "__main__":
+    main()